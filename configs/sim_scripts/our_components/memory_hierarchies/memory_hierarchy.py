@@ -1,4 +1,4 @@
-from m5.objects import L2XBar, SystemXBar, BadAddr, SnoopFilter, Cache
+from m5.objects import L2XBar, SystemXBar, BadAddr, SnoopFilter, Cache, CacheTraceProbe, Bridge
 from gem5.components.cachehierarchies.classic.abstract_classic_cache_hierarchy import (
     AbstractClassicCacheHierarchy
 )
@@ -17,7 +17,10 @@ class CS395T_MemoryHierarchy(AbstractClassicCacheHierarchy):
     def __init__(self, l1i_pref: str, l1i_repl: str, 
                        l1d_pref: str, l1d_repl: str, 
                        l2_pref: str, l2_repl: str, 
-                       llc_pref: str, llc_repl: str):
+                       llc_pref: str, llc_repl: str,
+                       llc_trace: str = None,
+                       memory_eventq: int = None,
+                       memory_link_latency: str = "2ns"):
         print("Creating CS395T_MemoryHierarchy")
         super().__init__()
         self.membus = SystemXBar(width=192)
@@ -31,6 +34,12 @@ class CS395T_MemoryHierarchy(AbstractClassicCacheHierarchy):
         self._l2_repl = l2_repl
         self._llc_pref = llc_pref
         self._llc_repl = llc_repl
+        # Record the requests looked up in the LLC, for replay_llc_trace.py
+        self._llc_trace = llc_trace
+        # Run the memory controllers on their own event queue (thread),
+        # behind bridges adding memory_link_latency to each access
+        self._memory_eventq = memory_eventq
+        self._memory_link_latency = memory_link_latency
 
     @overrides(AbstractClassicCacheHierarchy)
     def get_mem_side_port(self):
@@ -44,8 +53,24 @@ class CS395T_MemoryHierarchy(AbstractClassicCacheHierarchy):
     def incorporate_cache(self, board: AbstractBoard):
         board.connect_system_port(self.membus.cpu_side_ports)
 
-        for cntr in board.get_memory().get_memory_controllers():
-            cntr.port = self.membus.mem_side_ports
+        if self._memory_eventq is None:
+            for cntr in board.get_memory().get_memory_controllers():
+                cntr.port = self.membus.mem_side_ports
+        else:
+            # The bridges are the links between the two event queues, and
+            # their latency the lookahead the queues synchronize on
+            cntrs = board.get_memory().get_memory_controllers()
+            self.membridges = [
+                Bridge(delay=self._memory_link_latency,
+                       mem_side_eventq_index=self._memory_eventq,
+                       req_size=64, resp_size=64,
+                       ranges=[cntr.dram.range])
+                for cntr in cntrs
+            ]
+            for bridge, cntr in zip(self.membridges, cntrs):
+                cntr.eventq_index = self._memory_eventq
+                bridge.cpu_side_port = self.membus.mem_side_ports
+                cntr.port = bridge.mem_side_port
 
         # Create L1s private to each core
         self.l1icaches = [
@@ -82,6 +107,8 @@ class CS395T_MemoryHierarchy(AbstractClassicCacheHierarchy):
         # Create an LLC to be shared by all cores
         # and a coherent crossbar for its bus
         self.llcache = CS395T_LLCache(self._llc_pref, self._llc_repl);
+        if self._llc_trace:
+            self.llcache.trace_probe = CacheTraceProbe(trace_file=self._llc_trace)
         self.llcXbar = L2XBar(width=192, 
                               snoop_filter = SnoopFilter(max_capacity='32MB'))
 
@@ -0,0 +1,63 @@
+"""
+Replay an LLC access trace through a tag store and replacement policy,
+without CPUs or memory, and report the miss rate, the miss rate of
+Belady's MIN and the host time per access. Traces are recorded with
+run_fs_multithread.py --llc-trace.
+
+Example:
+    build/X86/gem5.opt configs/sim_scripts/replay_llc_trace.py \\
+        m5out/llc.trc.gz --repl hawkeye --size 2MB --assoc 16
+"""
+import argparse
+import time
+import m5
+from m5.util import convert
+from m5.objects import *
+
+repl_choices = [ "lru", "ship", "hawkeye", "mockingjay", "flock", "opt" ]
+
+parser = argparse.ArgumentParser(
+    description="Replay an LLC trace through a replacement policy"
+)
+parser.add_argument("trace", type=str, help="trace recorded by CacheTraceProbe")
+parser.add_argument("--repl", type=str, default="lru", help="replacement policy", choices=repl_choices)
+parser.add_argument("--size", type=str, default="2MB", help="cache size")
+parser.add_argument("--assoc", type=int, default=16, help="cache associativity")
+parser.add_argument("--cores", type=int, default=1, help="number of cores sharing the cache (FlockHawkeye)")
+args = parser.parse_args()
+
+block_size = 64
+num_sets = int(convert.toMemorySize(args.size)) // (block_size * args.assoc)
+
+if args.repl == "ship":
+    repl = SHiPPCRP()
+elif args.repl == "hawkeye":
+    repl = HawkeyeRP(num_cache_sets=num_sets, num_cache_ways=args.assoc)
+elif args.repl == "mockingjay":
+    repl = MockingjayRP(num_cache_sets=num_sets, num_cache_ways=args.assoc)
+elif args.repl == "flock":
+    repl = FlockHawkeyeRP(num_cache_sets=num_sets, num_cache_ways=args.assoc,
+                          num_cpus=args.cores)
+elif args.repl == "opt":
+    repl = OPTRP(trace_file=args.trace)
+else:
+    repl = LRURP()
+
+system = System(cache_line_size=block_size)
+system.clk_domain = SrcClockDomain(clock="1GHz", voltage_domain=VoltageDomain())
+system.replayer = CacheTraceReplayer(
+    trace_file=args.trace,
+    size=args.size,
+    assoc=args.assoc,
+    replacement_policy=repl,
+    tags=BaseSetAssoc(),
+)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+start = time.time()
+system.replayer.getCCObject().run()
+print("Total wallclock time: %.2f s" % (time.time() - start))
+
+m5.stats.dump()
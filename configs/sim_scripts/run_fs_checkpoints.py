@@ -55,6 +55,7 @@ parser.add_argument("--warmup", type=int, help="warm up for WARMUP million instr
 parser.add_argument("--insts", type=int, help="simulate for INSTS million instructions after warmup, after restoring from checkpoint")
 parser.add_argument("--init-checkpoint", type=str, help="create a post-kernel-boot checkpoint with atomic core and exit")
 parser.add_argument("--start-from", type=str, help="start benchmark execution from a post-kernel-boot checkpoint in START_FROM")
+parser.add_argument("--memory-checkpoint-format", type=str, default="chunked", choices=["gzip", "chunked", "mapped"], help="format of the memory of created checkpoints; mapped checkpoints are larger but restored instantly, and share their pages across concurrent runs")
 args = parser.parse_args()
 
 requires(
@@ -145,6 +146,7 @@ board = X86Board(
     memory=memory,
     cache_hierarchy=cache_hierarchy,
 )
+board.memory_checkpoint_format = args.memory_checkpoint_format
 
 if(args.benchmark and args.size):
     # GAP command string (copied to disk image and executed)
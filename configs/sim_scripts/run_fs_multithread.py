@@ -44,6 +44,8 @@ parser.add_argument("--size", required=True, type=str, help="input size (small,
 parser.add_argument("--cores", type=int, default=2, help="number of cores")
 parser.add_argument("--nokvm", default=False, action='store_true', help="use atomic core for fast-forwarding instead of KVM")
 parser.add_argument("--o3", default=False, action='store_true', help="use O3 core for ROI instead of Timing")
+parser.add_argument("--llc-trace", type=str, default=None, help="record the LLC accesses to this trace file (see replay_llc_trace.py)")
+parser.add_argument("--parallel-memory", default=False, action='store_true', help="simulate the memory controllers on a thread of their own")
 args = parser.parse_args()
 
 requires(
@@ -63,7 +65,9 @@ cache_hierarchy = CS395T_MemoryHierarchy(
    l2_pref = "none",
    l2_repl = "lru",
    llc_pref = "none",
-   llc_repl = "lru"
+   llc_repl = "lru",
+   llc_trace = args.llc_trace,
+   memory_eventq = 1 if args.parallel_memory else None
 )
 
 # This is hackish, but the SimpleProcessor models only understand the
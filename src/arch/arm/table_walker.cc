@@ -152,7 +152,7 @@ TableWalker::Port::createPacket(
     uint8_t *data, Request::Flags flags, Tick delay,
     Event *event)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         desc_addr, size, flags, requestorId);
     req->taskId(context_switch_task_id::DMA);
 
@@ -2488,7 +2488,7 @@ TableWalker::readDataUntimed(ThreadContext *tc, Addr vaddr, Addr desc_addr,
     Fault fault;
 
     // translate to physical address using the second stage MMU
-    auto req = std::make_shared<Request>();
+    auto req = makeRequest();
     req->setVirt(desc_addr, num_bytes, flags | Request::PT_WALK,
                 requestorId, 0);
 
@@ -2539,7 +2539,7 @@ TableWalker::Stage2Walk::Stage2Walk(TableWalker &_parent,
     : data(_data), numBytes(0), event(_event), parent(_parent),
       oVAddr(vaddr), mode(_mode), tranType(tran_type), fault(NoFault)
 {
-    req = std::make_shared<Request>();
+    req = makeRequest();
 }
 
 void
@@ -144,7 +144,7 @@ BaseMMU::MMUTranslationGen::translate(Range &range) const
         next += pageBytes;
     range.size = std::min(range.size, next - range.vaddr);
 
-    auto req = std::make_shared<Request>(
+    auto req = makeRequest(
             range.vaddr, range.size, flags, Request::funcRequestorId, 0, cid);
 
     range.fault = mmu->translateFunctional(req, tc, mode);
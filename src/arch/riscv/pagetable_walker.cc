@@ -424,7 +424,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     }
     else {
         //If we didn't return, we're setting up another read.
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
 
         delete oldRead;
@@ -467,7 +467,7 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     entry.asid = satp.asid;
 
     Request::Flags flags = Request::PHYSICAL;
-    RequestPtr request = std::make_shared<Request>(
+    RequestPtr request = makeRequest(
         topAddr, sizeof(PTESv39), flags, walker->requestorId);
 
     read = new Packet(request, MemCmd::ReadReq);
@@ -526,7 +526,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         //If we didn't return, we're setting up another read.
         Request::Flags flags = oldRead->req->getFlags();
         flags.set(Request::UNCACHEABLE, uncacheable);
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
         read = new Packet(request, MemCmd::ReadReq);
         read->allocate();
@@ -601,7 +601,7 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     if (!cr4.pcide && cr3.pcd)
         flags.set(Request::UNCACHEABLE);
 
-    RequestPtr request = std::make_shared<Request>(
+    RequestPtr request = makeRequest(
         topAddr, dataSize, flags, walker->requestorId);
 
     read = new Packet(request, MemCmd::ReadReq);
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Free-list pools of fixed-size blocks, for objects allocated and freed
+ * at a high rate on the simulation hot path (packets, requests and their
+ * data). The pools are thread local, so every event queue thread of a
+ * parallel simulation allocates from its own lists without
+ * synchronization. A block freed by another thread than the one that
+ * allocated it simply joins the free list of the freeing thread.
+ */
+
+#ifndef __BASE_FREE_LIST_HH__
+#define __BASE_FREE_LIST_HH__
+
+#include <cstddef>
+#include <new>
+
+namespace gem5
+{
+
+/**
+ * Thread-local free list of blocks of Size bytes aligned to Align bytes.
+ * Blocks are carved from the global heap on demand and kept on the free
+ * list once released, up to MaxCached blocks per thread; the remainder
+ * goes back to the heap. The free lists are deliberately never torn down
+ * so blocks may still be released during static destruction.
+ */
+template <std::size_t Size, std::size_t Align = alignof(std::max_align_t)>
+class FreeList
+{
+  private:
+    struct Node
+    {
+        Node *next;
+    };
+
+    static_assert(Align >= alignof(Node), "Blocks must be able to hold "
+                  "a free list link");
+
+    /** Size of the blocks, rounded up to hold a free list link. */
+    static constexpr std::size_t BlockSize =
+        Size < sizeof(Node) ? sizeof(Node) : Size;
+
+    /** Largest number of free blocks kept by a thread. */
+    static constexpr std::size_t MaxCached = 1 << 16;
+
+    /** Trivially destructible so it is never destroyed before its users. */
+    struct Cache
+    {
+        Node *head;
+        std::size_t count;
+    };
+
+    static inline thread_local Cache cache = {nullptr, 0};
+
+  public:
+    /** Get a block, from the free list if it is not empty. */
+    static void *
+    allocate()
+    {
+        Cache &c = cache;
+        if (Node *node = c.head) {
+            c.head = node->next;
+            --c.count;
+            return node;
+        }
+        return ::operator new(BlockSize, std::align_val_t(Align));
+    }
+
+    /** Release a block obtained from allocate(). */
+    static void
+    deallocate(void *ptr)
+    {
+        if (!ptr)
+            return;
+        Cache &c = cache;
+        if (c.count >= MaxCached) {
+            ::operator delete(ptr, std::align_val_t(Align));
+            return;
+        }
+        Node *node = static_cast<Node *>(ptr);
+        node->next = c.head;
+        c.head = node;
+        ++c.count;
+    }
+
+    /** Number of free blocks held by the calling thread. */
+    static std::size_t cached() { return cache.count; }
+};
+
+/**
+ * Standard allocator drawing single objects from a FreeList sized for
+ * them, and arrays from the global heap. Its main use is
+ * std::allocate_shared, which then places the object and its reference
+ * counts in one pooled block.
+ */
+template <typename T>
+class PoolAllocator
+{
+  public:
+    typedef T value_type;
+
+    PoolAllocator() = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        if (n == 1)
+            return static_cast<T *>(Pool::allocate());
+        return static_cast<T *>(
+            ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void
+    deallocate(T *ptr, std::size_t n)
+    {
+        if (n == 1)
+            Pool::deallocate(ptr);
+        else
+            ::operator delete(ptr, std::align_val_t(alignof(T)));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const { return false; }
+
+  private:
+    typedef FreeList<sizeof(T),
+        (alignof(T) > alignof(std::max_align_t) ?
+         alignof(T) : alignof(std::max_align_t))> Pool;
+};
+
+} // namespace gem5
+
+#endif // __BASE_FREE_LIST_HH__
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "base/free_list.hh"
+
+using namespace gem5;
+
+/** Released blocks are handed out again, most recent first. */
+TEST(FreeListTest, ReusesReleasedBlocks)
+{
+    typedef FreeList<48> Pool;
+    ASSERT_EQ(Pool::cached(), 0);
+
+    void *a = Pool::allocate();
+    void *b = Pool::allocate();
+    EXPECT_NE(a, b);
+
+    Pool::deallocate(a);
+    Pool::deallocate(b);
+    EXPECT_EQ(Pool::cached(), 2);
+
+    EXPECT_EQ(Pool::allocate(), b);
+    EXPECT_EQ(Pool::allocate(), a);
+    EXPECT_EQ(Pool::cached(), 0);
+
+    Pool::deallocate(a);
+    Pool::deallocate(b);
+}
+
+/** Blocks honour the requested alignment. */
+TEST(FreeListTest, Alignment)
+{
+    typedef FreeList<8, 64> Pool;
+    void *a = Pool::allocate();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a) % 64, 0);
+    Pool::deallocate(a);
+}
+
+/** Every thread has a free list of its own. */
+TEST(FreeListTest, ThreadLocal)
+{
+    typedef FreeList<24> Pool;
+    Pool::deallocate(Pool::allocate());
+    ASSERT_EQ(Pool::cached(), 1);
+
+    std::thread other([]() {
+        EXPECT_EQ(Pool::cached(), 0);
+        Pool::deallocate(Pool::allocate());
+        EXPECT_EQ(Pool::cached(), 1);
+    });
+    other.join();
+
+    EXPECT_EQ(Pool::cached(), 1);
+}
+
+/** allocate_shared keeps the object and its counts in a pooled block. */
+TEST(PoolAllocatorTest, AllocateShared)
+{
+    struct Object
+    {
+        uint64_t payload[5];
+    };
+
+    void *block;
+    {
+        auto ptr = std::allocate_shared<Object>(PoolAllocator<Object>());
+        block = ptr.get();
+    }
+    auto ptr = std::allocate_shared<Object>(PoolAllocator<Object>());
+    EXPECT_EQ(ptr.get(), block);
+}
@@ -140,6 +140,14 @@ class RefCountingPtr
             RefCountingPtr<typename std::remove_const<T>::type>,
             RefCountingPtr<T>>;
     friend NonConstT;
+    template <class U>
+    friend class RefCountingPtr;
+
+    /** Whether a pointer to U converts to a pointer to a base class T. */
+    template <class U>
+    static constexpr bool IsUpcast =
+        !std::is_same_v<std::remove_const_t<U>, std::remove_const_t<T>> &&
+        std::is_convertible_v<U *, T *>;
     /** @} */
     /// The stored pointer.
     /// Arguably this should be private.
@@ -210,6 +218,21 @@ class RefCountingPtr
     template <bool B = TisConst>
     RefCountingPtr(const NonConstT &r) { copy(r.data); }
 
+    /// Create a new reference counting pointer to a base class of the
+    /// object another one points to.  Adds a reference.
+    template <class U, class = std::enable_if_t<IsUpcast<U>>>
+    RefCountingPtr(const RefCountingPtr<U> &r) { copy(r.data); }
+
+    /** Move-constructor from a pointer to a derived class.
+     * Does not add a reference.
+     */
+    template <class U, class = std::enable_if_t<IsUpcast<U>>>
+    RefCountingPtr(RefCountingPtr<U> &&r)
+    {
+        data = r.data;
+        r.data = nullptr;
+    }
+
     /// Destroy the pointer and any reference it may hold.
     ~RefCountingPtr() { del(); }
 
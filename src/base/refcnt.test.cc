@@ -70,6 +70,11 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class DerivedTestRC : public TestRC
+{
+};
+typedef RefCountingPtr<DerivedTestRC> DerivedPtr;
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -172,3 +177,22 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, ConstructionFromDerivedPointer)
+{
+    // Construct a Ptr from a pointer to a derived class.
+    DerivedPtr derived = new DerivedTestRC();
+    Ptr fromDerived = derived;
+    EXPECT_EQ(derived.get(), fromDerived.get());
+    EXPECT_EQ(1, liveListSize());
+
+    // Moving the pointer transfers its reference.
+    Ptr movedFromDerived = std::move(derived);
+    EXPECT_EQ(NULL, derived.get());
+    EXPECT_EQ(fromDerived.get(), movedFromDerived.get());
+
+    fromDerived = NULL;
+    EXPECT_EQ(1, liveListSize());
+    movedFromDerived = NULL;
+    EXPECT_EQ(0, liveListSize());
+}
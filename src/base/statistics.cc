@@ -218,6 +218,12 @@ Formula::total() const
     return root ? root->total() : 0.0;
 }
 
+bool
+Formula::totalIsSum() const
+{
+    return root ? root->totalIsSum() : true;
+}
+
 size_type
 Formula::size() const
 {
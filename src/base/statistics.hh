@@ -71,6 +71,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "base/cast.hh"
@@ -852,12 +853,23 @@ class ScalarProxy
      * Increment the stat by 1. This calls the associated storage object inc
      * function.
      */
-    void operator++() { stat.data(index)->inc(1); }
+    void
+    operator++()
+    {
+        stat.data(index)->inc(1);
+        stat.adjustTotal(1);
+    }
+
     /**
      * Decrement the stat by 1. This calls the associated storage object dec
      * function.
      */
-    void operator--() { stat.data(index)->dec(1); }
+    void
+    operator--()
+    {
+        stat.data(index)->dec(1);
+        stat.adjustTotal(-1);
+    }
 
     /** Increment the stat by 1. */
     void operator++(int) { ++*this; }
@@ -873,7 +885,9 @@ class ScalarProxy
     void
     operator=(const U &v)
     {
+        Counter old = stat.data(index)->value();
         stat.data(index)->set(v);
+        stat.adjustTotal(stat.data(index)->value() - old);
     }
 
     /**
@@ -886,6 +900,7 @@ class ScalarProxy
     operator+=(const U &v)
     {
         stat.data(index)->inc(v);
+        stat.adjustTotal(v);
     }
 
     /**
@@ -898,6 +913,7 @@ class ScalarProxy
     operator-=(const U &v)
     {
         stat.data(index)->dec(v);
+        stat.adjustTotal(-static_cast<Counter>(v));
     }
 
     /**
@@ -949,6 +965,13 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
      */
     const Storage *data(off_type index) const { return storage[index]; }
 
+    /**
+     * Called by the proxies after an element has been updated. Plain
+     * vectors recompute their total on demand, so there is nothing to do.
+     * @param delta The change of the updated element.
+     */
+    void adjustTotal(Counter delta) { }
+
     void
     doInit(size_type s)
     {
@@ -1155,6 +1178,9 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
     Storage *data(off_type index) { return storage[index]; }
     const Storage *data(off_type index) const { return storage[index]; }
 
+    /** @sa VectorBase::adjustTotal */
+    void adjustTotal(Counter delta) { }
+
   public:
     Vector2dBase(Group *parent, const char *name,
                  const units::Base *unit,
@@ -1539,6 +1565,14 @@ class Node
      */
     virtual Result total() const = 0;
 
+    /**
+     * Whether total() is the sum of the result vector. Parents can then
+     * combine the totals of their operands instead of reducing over their
+     * result vectors, which is cheap for stats that keep a running total.
+     * @return True if total() == sum(result()).
+     */
+    virtual bool totalIsSum() const { return false; }
+
     /**
      *
      */
@@ -1568,6 +1602,8 @@ class ScalarStatNode : public Node
 
     Result total() const { return data->result(); };
 
+    bool totalIsSum() const { return true; }
+
     size_type size() const { return 1; }
 
     /**
@@ -1601,6 +1637,8 @@ class ScalarProxyNode : public Node
         return proxy.result();
     }
 
+    bool totalIsSum() const { return true; }
+
     size_type
     size() const
     {
@@ -1627,6 +1665,8 @@ class VectorStatNode : public Node
     const VResult &result() const { return data->result(); }
     Result total() const { return data->total(); };
 
+    bool totalIsSum() const { return true; }
+
     size_type size() const { return data->size(); }
 
     std::string str() const { return data->name; }
@@ -1642,6 +1682,7 @@ class ConstNode : public Node
     ConstNode(T s) : vresult(1, (Result)s) {}
     const VResult &result() const { return vresult; }
     Result total() const { return vresult[0]; };
+    bool totalIsSum() const { return true; }
     size_type size() const { return 1; }
     std::string str() const { return std::to_string(vresult[0]); }
 };
@@ -1666,6 +1707,8 @@ class ConstVectorNode : public Node
         return tmp;
     }
 
+    bool totalIsSum() const { return true; }
+
     size_type size() const { return vresult.size(); }
     std::string
     str() const
@@ -1809,20 +1852,24 @@ class BinaryNode : public Node
     Result
     total() const override
     {
-        const VResult &vec = this->result();
-        const VResult &lvec = l->result();
-        const VResult &rvec = r->result();
         Result total = 0.0;
         Result lsum = 0.0;
         Result rsum = 0.0;
         Op op;
 
-        assert(lvec.size() > 0 && rvec.size() > 0);
-        assert(lvec.size() == rvec.size() ||
-               lvec.size() == 1 || rvec.size() == 1);
+        size_type lsize = l->size();
+        size_type rsize = r->size();
+        assert(lsize > 0 && rsize > 0);
+        assert(lsize == rsize || lsize == 1 || rsize == 1);
 
         /** If vectors are the same divide their sums (x0+x1)/(y0+y1) */
-        if (lvec.size() == rvec.size() && lvec.size() > 1) {
+        if (lsize == rsize && lsize > 1) {
+            /** The operands may already know their sums */
+            if (l->totalIsSum() && r->totalIsSum())
+                return op(l->total(), r->total());
+
+            const VResult &lvec = l->result();
+            const VResult &rvec = r->result();
             for (off_type i = 0; i < size(); ++i) {
                 lsum += lvec[i];
                 rsum += rvec[i];
@@ -1831,6 +1878,7 @@ class BinaryNode : public Node
         }
 
         /** Otherwise divide each item by the divisor */
+        const VResult &vec = this->result();
         for (off_type i = 0; i < size(); ++i) {
             total += vec[i];
         }
@@ -1838,6 +1886,16 @@ class BinaryNode : public Node
         return total;
     }
 
+    bool
+    totalIsSum() const override
+    {
+        // Only same-sized vectors have their total computed from the sums
+        // of their operands, which is the sum of the results for + and -
+        return l->size() != r->size() || l->size() == 1 ||
+            std::is_same<Op, std::plus<Result>>::value ||
+            std::is_same<Op, std::minus<Result>>::value;
+    }
+
     size_type
     size() const override
     {
@@ -2025,6 +2083,57 @@ class Vector : public VectorBase<Vector, StatStor>
     }
 };
 
+/**
+ * A vector of scalar stats that keeps a running total of its elements,
+ * updated through the element proxies. total() is then a load rather than
+ * a reduction over the vector, which matters for stats (and the formulas
+ * built on top of them) that are read while simulating.
+ * @sa Stat, Vector, VectorBase, StatStor
+ */
+class TotalledVector : public VectorBase<TotalledVector, StatStor>
+{
+  private:
+    friend class ScalarProxy<TotalledVector>;
+
+    /** The sum of all the elements. */
+    Counter runningTotal = 0;
+
+    void adjustTotal(Counter delta) { runningTotal += delta; }
+
+  public:
+    TotalledVector(Group *parent = nullptr)
+        : VectorBase<TotalledVector, StatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    TotalledVector(Group *parent, const char *name,
+                   const char *desc = nullptr)
+        : VectorBase<TotalledVector, StatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    TotalledVector(Group *parent, const char *name, const units::Base *unit,
+                   const char *desc = nullptr)
+        : VectorBase<TotalledVector, StatStor>(parent, name, unit, desc)
+    {
+    }
+
+    /**
+     * Return the running total of all entries in this vector.
+     * @return The total of all vector entries.
+     */
+    Result total() const { return runningTotal; }
+
+    void
+    reset()
+    {
+        VectorBase<TotalledVector, StatStor>::reset();
+        runningTotal = 0;
+    }
+};
+
 /**
  * A vector of Average stats.
  * @sa Stat, VectorBase, AvgStor
@@ -2608,6 +2717,12 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
      */
     Result total() const;
 
+    /**
+     * Whether total() is the sum of the result vector.
+     * @sa Node::totalIsSum
+     */
+    bool totalIsSum() const;
+
     /**
      * Return the number of elements in the tree.
      */
@@ -2640,6 +2755,7 @@ class FormulaNode : public Node
     size_type size() const { return formula.size(); }
     const VResult &result() const { formula.result(vec); return vec; }
     Result total() const { return formula.total(); }
+    bool totalIsSum() const { return formula.totalIsSum(); }
 
     std::string str() const { return formula.str(); }
 };
@@ -2708,6 +2824,14 @@ class Temp
         : node(new VectorStatNode(s.info()))
     { }
 
+    /**
+     * Create a new VectorStatNode.
+     * @param s The TotalledVector stat.
+     */
+    Temp(const TotalledVector &s)
+        : node(new VectorStatNode(s.info()))
+    { }
+
     Temp(const AverageVector &s)
         : node(new VectorStatNode(s.info()))
     { }
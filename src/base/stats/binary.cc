@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cassert>
+#include <cstring>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+namespace
+{
+
+constexpr char Magic[8] = "gem5bst";
+
+uint64_t
+padding(uint64_t size)
+{
+    return (8 - size % 8) % 8;
+}
+
+bool
+sameValue(double a, double b)
+{
+    // Compare the representations, so that NaNs are not seen as changes
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+template <typename T>
+void
+put(std::ostream &os, T value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+std::string
+subname(const std::vector<std::string> &subnames, size_type i)
+{
+    if (i < subnames.size() && !subnames[i].empty())
+        return subnames[i];
+    return std::to_string(i);
+}
+
+} // anonymous namespace
+
+Binary::Binary(const std::string &file, bool desc)
+    : fname(file), enableDescriptions(desc), writtenColumns(0), dumpCount(0)
+{
+    static_assert(sizeof(double) == 8, "Unexpected size of double");
+    // The file is documented (and read back) as little-endian
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                  "Binary stats are only supported on little-endian hosts");
+
+    stream.open(fname, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!valid())
+        fatal("Unable to open statistics file '%s' for writing\n", fname);
+
+    stream.write(Magic, sizeof(Magic));
+    put<uint32_t>(stream, Version);
+    put<uint32_t>(stream, 0);
+}
+
+Binary::~Binary()
+{
+}
+
+void
+Binary::begin()
+{
+    changedColumns.clear();
+    changedValues.clear();
+}
+
+void
+Binary::end()
+{
+    assert(valid());
+
+    if (writtenColumns < columns.size()) {
+        uint64_t size = 2 * sizeof(uint32_t);
+        for (uint32_t i = writtenColumns; i < columns.size(); ++i) {
+            const Column &col = columns[i];
+            size += col.name.size() + col.desc.size() + col.unit.size() + 3;
+        }
+        writeRecordHeader(SchemaRecord, size + padding(size));
+        put<uint32_t>(stream, writtenColumns);
+        put<uint32_t>(stream, columns.size() - writtenColumns);
+        for (uint32_t i = writtenColumns; i < columns.size(); ++i) {
+            const Column &col = columns[i];
+            stream.write(col.name.c_str(), col.name.size() + 1);
+            stream.write(col.desc.c_str(), col.desc.size() + 1);
+            stream.write(col.unit.c_str(), col.unit.size() + 1);
+        }
+        pad(size);
+        writtenColumns = columns.size();
+    }
+
+    const uint64_t count = changedColumns.size();
+    const uint64_t ids_size = count * sizeof(uint32_t);
+    writeRecordHeader(DumpRecord, sizeof(uint64_t) + 2 * sizeof(uint32_t) +
+                      ids_size + padding(ids_size) + count * sizeof(double));
+    put<uint64_t>(stream, dumpCount);
+    put<uint32_t>(stream, count);
+    put<uint32_t>(stream, 0);
+    stream.write(reinterpret_cast<const char *>(changedColumns.data()),
+                 ids_size);
+    pad(ids_size);
+    stream.write(reinterpret_cast<const char *>(changedValues.data()),
+                 count * sizeof(double));
+    stream.flush();
+
+    dumpCount++;
+}
+
+bool
+Binary::valid() const
+{
+    return stream.good();
+}
+
+std::string
+Binary::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return path.top() + "." + name;
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    if (path.empty()) {
+        path.push(name);
+    } else {
+        path.push(path.top() + "." + name);
+    }
+}
+
+void
+Binary::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+uint32_t
+Binary::column(const std::string &name, const Info &info)
+{
+    auto it = columnIds.find(name);
+    if (it != columnIds.end())
+        return it->second;
+
+    const uint32_t id = columns.size();
+    columns.push_back({name, enableDescriptions ? info.desc : "",
+                       info.unit ? info.unit->getUnitString() : ""});
+    columnIds.emplace(name, id);
+    last.push_back(0.0);
+    return id;
+}
+
+template <typename Names>
+void
+Binary::record(const Info &info, const std::vector<double> &values,
+               Names &&get_names)
+{
+    std::vector<uint32_t> &ids = statColumns[info.id];
+    if (ids.size() != values.size()) {
+        names.clear();
+        get_names(names);
+        assert(names.size() == values.size());
+
+        ids.clear();
+        for (const auto &name : names)
+            ids.push_back(column(name, info));
+    }
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        const uint32_t id = ids[i];
+        if (!sameValue(last[id], values[i])) {
+            last[id] = values[i];
+            changedColumns.push_back(id);
+            changedValues.push_back(values[i]);
+        }
+    }
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    values.assign(1, info.result());
+    record(info, values, [&](std::vector<std::string> &names) {
+        names.push_back(statName(info.name));
+    });
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &result = info.result();
+    values.assign(result.begin(), result.end());
+    record(info, values, [&](std::vector<std::string> &names) {
+        const std::string base = statName(info.name) + info.separatorString;
+        for (size_type i = 0; i < result.size(); ++i)
+            names.push_back(base + subname(info.subnames, i));
+    });
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    values.assign(info.cvec.begin(), info.cvec.end());
+    record(info, values, [&](std::vector<std::string> &names) {
+        for (size_type i = 0; i < info.x; ++i) {
+            const std::string base =
+                statName(info.name + "_" + subname(info.subnames, i)) +
+                info.separatorString;
+            for (size_type j = 0; j < info.y; ++j)
+                names.push_back(base + subname(info.y_subnames, j));
+        }
+    });
+}
+
+void
+Binary::flattenDist(const DistData &data, std::vector<double> &values)
+{
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+    values.push_back(data.logs);
+    values.push_back(data.min_val);
+    values.push_back(data.max_val);
+    values.push_back(data.underflow);
+    values.push_back(data.overflow);
+    values.push_back(data.min);
+    values.push_back(data.bucket_size);
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Binary::distNames(const std::string &base, const std::string &sep,
+                  const DistData &data, std::vector<std::string> &names)
+{
+    for (const char *field : {"samples", "sum", "squares", "logs",
+                              "min_value", "max_value", "underflows",
+                              "overflows", "min", "bucket_size"}) {
+        names.push_back(base + sep + field);
+    }
+    for (size_type i = 0; i < data.cvec.size(); ++i)
+        names.push_back(base + sep + "bucket" + std::to_string(i));
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    values.clear();
+    flattenDist(info.data, values);
+    record(info, values, [&](std::vector<std::string> &names) {
+        distNames(statName(info.name), info.separatorString, info.data,
+                  names);
+    });
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    values.clear();
+    for (const auto &data : info.data)
+        flattenDist(data, values);
+    record(info, values, [&](std::vector<std::string> &names) {
+        for (size_type i = 0; i < info.data.size(); ++i) {
+            distNames(statName(info.name) + info.separatorString +
+                      subname(info.subnames, i), info.separatorString,
+                      info.data[i], names);
+        }
+    });
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    // Keep the columns of the keys that went away, e.g. after a reset,
+    // and output them as 0, otherwise the readers would keep their last
+    // count. The keys seen only grow, so the cached columns are rebuilt
+    // whenever a new key shows up.
+    auto &keys = sparseKeys[info.id];
+    for (const auto &entry : info.data.cmap)
+        keys.insert(entry.first);
+
+    values.assign(1, info.data.samples);
+    for (const auto key : keys) {
+        auto it = info.data.cmap.find(key);
+        values.push_back(it == info.data.cmap.end() ? 0 : it->second);
+    }
+
+    record(info, values, [&](std::vector<std::string> &names) {
+        const std::string base = statName(info.name) + info.separatorString;
+        names.push_back(base + "samples");
+        for (const auto key : keys)
+            names.push_back(csprintf("%s%s", base, key));
+    });
+}
+
+void
+Binary::writeRecordHeader(RecordType type, uint64_t size)
+{
+    put<uint32_t>(stream, type);
+    put<uint32_t>(stream, 0);
+    put<uint64_t>(stream, size);
+}
+
+void
+Binary::pad(uint64_t size)
+{
+    static const char zeros[8] = {};
+    stream.write(zeros, padding(size));
+}
+
+std::unique_ptr<Output>
+initBinary(const std::string &filename, bool desc)
+{
+    return std::unique_ptr<Output>(
+        new Binary(simout.resolve(filename), desc));
+}
+
+} // namespace statistics
+} // namespace gem5
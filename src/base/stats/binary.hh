@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Compact binary stat output. The stat schema (one column per value,
+ * named like in the text output) is written once, and every dump is a
+ * record holding only the columns whose value changed since the previous
+ * dump. All fields are little-endian and 8-byte aligned so that the file
+ * can be memory-mapped and decoded as arrays (see util/bstats.py):
+ *
+ *   Header:  char magic[8] = "gem5bst"; uint32 version; uint32 reserved
+ *   Record:  uint32 type; uint32 reserved; uint64 payload size
+ *   Schema:  uint32 first column; uint32 count;
+ *            count x { name\0 desc\0 unit\0 }, padded to 8 bytes
+ *   Dump:    uint64 dump; uint32 count; uint32 reserved;
+ *            uint32 column[count], padded to 8 bytes; double value[count]
+ *
+ * A schema record precedes the first dump that uses any of its columns.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
+namespace statistics
+{
+
+class Binary : public Output
+{
+  public:
+    static constexpr uint32_t Version = 1;
+
+    enum RecordType : uint32_t
+    {
+        SchemaRecord = 1,
+        DumpRecord = 2,
+    };
+
+    Binary(const std::string &file, bool desc);
+    ~Binary();
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** A column of the schema. */
+    struct Column
+    {
+        std::string name;
+        std::string desc;
+        std::string unit;
+    };
+
+    /** Full name of a stat in the current group. */
+    std::string statName(const std::string &name) const;
+
+    /**
+     * Record the values of a stat. The columns of the stat are looked up
+     * by the stat id, and only rebuilt from their names (creating new
+     * ones as needed) the first time the stat is seen or when its number
+     * of values changes.
+     *
+     * @param info The stat.
+     * @param values Its values, flattened.
+     * @param names Called to get the names of the columns when needed.
+     */
+    template <typename Names>
+    void record(const Info &info, const std::vector<double> &values,
+                Names &&names);
+
+    /** Get the column of a name, adding it to the schema if needed. */
+    uint32_t column(const std::string &name, const Info &info);
+
+    /** Append the values of a distribution and their names. */
+    static void flattenDist(const DistData &data,
+                            std::vector<double> &values);
+    static void distNames(const std::string &base, const std::string &sep,
+                          const DistData &data,
+                          std::vector<std::string> &names);
+
+    /** Write a record with the given payload size and type. */
+    void writeRecordHeader(RecordType type, uint64_t size);
+    void pad(uint64_t size);
+
+    const std::string fname;
+    const bool enableDescriptions;
+
+    std::ofstream stream;
+    std::stack<std::string> path;
+
+    /** Schema, and the first column not yet written to the file. */
+    std::vector<Column> columns;
+    std::unordered_map<std::string, uint32_t> columnIds;
+    uint32_t writtenColumns;
+
+    /** Columns of every stat, indexed by stat id. */
+    std::unordered_map<int, std::vector<uint32_t>> statColumns;
+
+    /** Keys seen so far of every sparse histogram, indexed by stat id. */
+    std::unordered_map<int, std::set<Counter>> sparseKeys;
+
+    /** Last value written of every column. */
+    std::vector<double> last;
+
+    /** Changes of the current dump. */
+    std::vector<uint32_t> changedColumns;
+    std::vector<double> changedValues;
+
+    /** Scratch storage to flatten stats. */
+    std::vector<double> values;
+    std::vector<std::string> names;
+
+    uint64_t dumpCount;
+};
+
+std::unique_ptr<Output> initBinary(const std::string &filename,
+                                   bool desc = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/stats/binary.hh"
+#include "base/stats/info.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class TestScalarInfo : public statistics::ScalarInfo
+{
+  public:
+    double val = 0;
+
+    TestScalarInfo(const std::string &_name)
+    {
+        setName(_name, false);
+        flags = statistics::display;
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { val = 0; }
+    bool zero() const override { return val == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::Counter value() const override { return val; }
+    statistics::Result result() const override { return val; }
+    statistics::Result total() const override { return val; }
+};
+
+class TestVectorInfo : public statistics::VectorInfo
+{
+  public:
+    statistics::VCounter vals;
+    mutable statistics::VResult results;
+
+    TestVectorInfo(const std::string &_name, size_t size)
+        : vals(size, 0.0)
+    {
+        setName(_name, false);
+        flags = statistics::display;
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    statistics::size_type size() const override { return vals.size(); }
+    const statistics::VCounter &value() const override { return vals; }
+
+    const statistics::VResult &
+    result() const override
+    {
+        results.assign(vals.begin(), vals.end());
+        return results;
+    }
+
+    statistics::Result total() const override { return 0; }
+};
+
+class TestSparseHistInfo : public statistics::SparseHistInfo
+{
+  public:
+    TestSparseHistInfo(const std::string &_name)
+    {
+        setName(_name, false);
+        flags = statistics::display;
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+
+    void
+    reset() override
+    {
+        data.samples = 0;
+        data.cmap.clear();
+    }
+
+    bool zero() const override { return data.samples == 0; }
+    void visit(statistics::Output &visitor) override { visitor.visit(*this); }
+
+    void
+    sample(statistics::Counter key)
+    {
+        data.samples++;
+        data.cmap[key]++;
+    }
+};
+
+/** The contents of a binary stat file, decoded. */
+struct Decoded
+{
+    std::vector<std::string> names;
+    std::vector<std::string> units;
+    /** Changes of every dump. */
+    std::vector<std::map<std::string, double>> dumps;
+};
+
+template <typename T>
+T
+get(const std::string &data, size_t &pos)
+{
+    T value;
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+Decoded
+decode(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    const std::string data((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+    Decoded decoded;
+
+    EXPECT_EQ(std::string(data.c_str()), "gem5bst");
+    size_t pos = 8;
+    EXPECT_EQ(get<uint32_t>(data, pos), statistics::Binary::Version);
+    pos += 4;
+
+    while (pos < data.size()) {
+        const auto type = get<uint32_t>(data, pos);
+        pos += 4;
+        const auto size = get<uint64_t>(data, pos);
+        EXPECT_EQ(size % 8, 0);
+        size_t p = pos;
+        if (type == statistics::Binary::SchemaRecord) {
+            EXPECT_EQ(get<uint32_t>(data, p), decoded.names.size());
+            const auto count = get<uint32_t>(data, p);
+            for (uint32_t i = 0; i < count; ++i) {
+                std::string fields[3];
+                for (auto &field : fields) {
+                    field = data.c_str() + p;
+                    p += field.size() + 1;
+                }
+                decoded.names.push_back(fields[0]);
+                decoded.units.push_back(fields[2]);
+            }
+        } else {
+            EXPECT_EQ(type, statistics::Binary::DumpRecord);
+            EXPECT_EQ(get<uint64_t>(data, p), decoded.dumps.size());
+            const auto count = get<uint32_t>(data, p);
+            p += 4;
+            size_t value_pos = p + (count * 4 + 7) / 8 * 8;
+            std::map<std::string, double> changes;
+            for (uint32_t i = 0; i < count; ++i) {
+                const auto column = get<uint32_t>(data, p);
+                EXPECT_LT(column, decoded.names.size());
+                changes[decoded.names[column]] =
+                    get<double>(data, value_pos);
+            }
+            EXPECT_EQ(value_pos, pos + size);
+            decoded.dumps.push_back(changes);
+        }
+        pos += size;
+    }
+    EXPECT_EQ(pos, data.size());
+
+    return decoded;
+}
+
+class StatsBinaryTest : public testing::Test
+{
+  protected:
+    std::string path;
+
+    void
+    SetUp() override
+    {
+        char name[] = "/tmp/stats_binary_testXXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        path = name;
+    }
+
+    void TearDown() override { std::remove(path.c_str()); }
+};
+
+} // anonymous namespace
+
+/** Test that only the values changed since the previous dump are written. */
+TEST_F(StatsBinaryTest, DeltaDumps)
+{
+    TestScalarInfo scalar("insts");
+    TestVectorInfo vector("misses", 3);
+    vector.subnames = {"read", "", "write"};
+
+    {
+        statistics::Binary output(path, true);
+        auto dump = [&]() {
+            output.begin();
+            output.beginGroup("system");
+            output.beginGroup("cpu");
+            scalar.visit(output);
+            output.endGroup();
+            vector.visit(output);
+            output.endGroup();
+            output.end();
+        };
+
+        scalar.val = 10;
+        vector.vals = {1, 0, 3};
+        dump();
+
+        scalar.val = 20;
+        dump();
+
+        vector.vals = {1, 2, 0};
+        dump();
+    }
+
+    Decoded decoded = decode(path);
+    ASSERT_EQ(decoded.names, (std::vector<std::string>{
+        "system.cpu.insts", "system.misses::read", "system.misses::1",
+        "system.misses::write"}));
+    ASSERT_EQ(decoded.dumps.size(), 3);
+
+    // The first dump only holds the non-zero values
+    EXPECT_EQ(decoded.dumps[0], (std::map<std::string, double>{
+        {"system.cpu.insts", 10}, {"system.misses::read", 1},
+        {"system.misses::write", 3}}));
+    EXPECT_EQ(decoded.dumps[1], (std::map<std::string, double>{
+        {"system.cpu.insts", 20}}));
+    EXPECT_EQ(decoded.dumps[2], (std::map<std::string, double>{
+        {"system.misses::1", 2}, {"system.misses::write", 0}}));
+}
+
+/** Test that unchanged dumps are empty, and hidden stats are not output. */
+TEST_F(StatsBinaryTest, EmptyDumps)
+{
+    TestScalarInfo scalar("shown");
+    TestScalarInfo hidden("hidden");
+    hidden.flags = statistics::none;
+    scalar.val = 1;
+    hidden.val = 2;
+
+    {
+        statistics::Binary output(path, false);
+        for (int i = 0; i < 2; ++i) {
+            output.begin();
+            scalar.visit(output);
+            hidden.visit(output);
+            output.end();
+        }
+    }
+
+    Decoded decoded = decode(path);
+    ASSERT_EQ(decoded.names, std::vector<std::string>{"shown"});
+    ASSERT_EQ(decoded.dumps.size(), 2);
+    EXPECT_EQ(decoded.dumps[0].size(), 1);
+    EXPECT_TRUE(decoded.dumps[1].empty());
+}
+
+/** Test that the keys missing after a reset are written as 0. */
+TEST_F(StatsBinaryTest, SparseHistReset)
+{
+    TestSparseHistInfo hist("lat");
+
+    {
+        statistics::Binary output(path, false);
+        auto dump = [&]() {
+            output.begin();
+            hist.visit(output);
+            output.end();
+        };
+
+        hist.sample(10);
+        hist.sample(10);
+        hist.sample(30);
+        dump();
+
+        hist.reset();
+        hist.sample(20);
+        dump();
+
+        hist.sample(30);
+        dump();
+    }
+
+    Decoded decoded = decode(path);
+    ASSERT_EQ(decoded.names, (std::vector<std::string>{
+        "lat::samples", "lat::10", "lat::30", "lat::20"}));
+    ASSERT_EQ(decoded.dumps.size(), 3);
+
+    EXPECT_EQ(decoded.dumps[0], (std::map<std::string, double>{
+        {"lat::samples", 3}, {"lat::10", 2}, {"lat::30", 1}}));
+    EXPECT_EQ(decoded.dumps[1], (std::map<std::string, double>{
+        {"lat::samples", 1}, {"lat::10", 0}, {"lat::20", 1},
+        {"lat::30", 0}}));
+    EXPECT_EQ(decoded.dumps[2], (std::map<std::string, double>{
+        {"lat::samples", 2}, {"lat::30", 1}}));
+}
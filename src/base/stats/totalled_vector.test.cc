@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/stats/storage.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * The storage and running total of a TotalledVector, without the stat
+ * info, so that the element proxy that updates them can be tested on its
+ * own.
+ */
+class FakeVector
+{
+  private:
+    std::vector<statistics::StatStor> storage;
+
+    Counter runningTotal = 0;
+
+  public:
+    FakeVector() : storage(3, statistics::StatStor(nullptr)) {}
+
+    statistics::StatStor *data(statistics::off_type index) { return &storage[index]; }
+
+    void adjustTotal(Counter delta) { runningTotal += delta; }
+
+    statistics::ScalarProxy<FakeVector>
+    operator[](statistics::off_type index)
+    {
+        return statistics::ScalarProxy<FakeVector>(*this, index);
+    }
+
+    statistics::Result total() const { return runningTotal; }
+
+    statistics::Result
+    sum() const
+    {
+        statistics::Result sum = 0;
+        for (const auto &element : storage)
+            sum += element.result();
+        return sum;
+    }
+};
+
+} // anonymous namespace
+
+/**
+ * Update the elements through their proxies and check that the running
+ * total follows the sum of the elements.
+ */
+class TotalledVectorTest : public testing::Test
+{
+  protected:
+    FakeVector totalled;
+
+    void
+    expectTotal(statistics::Result expected)
+    {
+        EXPECT_EQ(totalled.total(), expected);
+        EXPECT_EQ(totalled.sum(), expected);
+    }
+};
+
+/** Test adding and subtracting unsigned values. */
+TEST_F(TotalledVectorTest, AddSubtractUnsigned)
+{
+    totalled[0] += 5u;
+    totalled[1] += uint64_t(7);
+    expectTotal(12);
+
+    totalled[0] -= 2u;
+    totalled[1] -= uint64_t(3);
+    totalled[2] -= uint8_t(1);
+    expectTotal(6);
+    EXPECT_EQ(totalled[2].value(), -1);
+}
+
+/** Test incrementing and decrementing the elements. */
+TEST_F(TotalledVectorTest, IncrementDecrement)
+{
+    ++totalled[0];
+    totalled[2]++;
+    totalled[2]++;
+    expectTotal(3);
+
+    --totalled[0];
+    totalled[2]--;
+    expectTotal(1);
+}
+
+/** Test assigning unsigned values to the elements. */
+TEST_F(TotalledVectorTest, AssignUnsigned)
+{
+    totalled[1] = 10u;
+    expectTotal(10);
+
+    totalled[1] = 4u;
+    totalled[2] = uint64_t(2);
+    expectTotal(6);
+}
@@ -31,10 +31,20 @@
 
 #include "base/trace.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "base/atomicio.hh"
 #include "base/logging.hh"
@@ -53,6 +63,14 @@ name()
     return default_name;
 }
 
+#if defined(__linux__)
+// Bounds of the loaded image of the executable, which hold its string
+// literals. They are weak so that their absence only disables the
+// detection of static format strings.
+extern "C" const char __ehdr_start[] __attribute__((weak));
+extern "C" const char edata[] __attribute__((weak));
+#endif
+
 namespace gem5
 {
 
@@ -170,5 +188,386 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     }
 }
 
+namespace
+{
+
+/**
+ * Whether a string is part of the executable image, and can thus be
+ * defined once and then referred to by its address.
+ */
+bool
+isStaticString(const char *str)
+{
+#if defined(__linux__)
+    return __ehdr_start && edata && str >= __ehdr_start && str < edata;
+#else
+    return false;
+#endif
+}
+
+std::mutex loggersMutex;
+std::vector<BinaryLogger *> loggers;
+
+void
+flushLoggers()
+{
+    std::lock_guard<std::mutex> lock(loggersMutex);
+    for (auto *logger : loggers)
+        logger->flush();
+}
+
+/** Check the stream of a binary logger, which is not for a terminal. */
+std::ostream &
+binaryStream(std::ostream &stream)
+{
+    fatal_if(&stream == &std::cout || &stream == &std::cerr,
+             "Binary debug output cannot be written to the standard output "
+             "or error, set a file with --debug-file\n");
+    return stream;
+}
+
+} // anonymous namespace
+
+struct BinaryLogger::Writer
+{
+    /** Size of a buffer, and number of buffers before logging blocks. */
+    static constexpr size_t ChunkSize = 1 << 20;
+    static constexpr size_t MaxChunks = 64;
+
+    struct Chunk
+    {
+        uint32_t thread = 0;
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+
+    /** Stream buffer recording the text written to it line by line. */
+    class TextBuf : public std::streambuf
+    {
+      protected:
+        BinaryLogger &logger;
+        std::string line;
+
+      public:
+        TextBuf(BinaryLogger &logger) : logger(logger) {}
+
+        int_type
+        overflow(int_type c) override
+        {
+            if (c != traits_type::eof()) {
+                line += traits_type::to_char_type(c);
+                if (c == '\n')
+                    sync();
+            }
+            return c;
+        }
+
+        int
+        sync() override
+        {
+            if (!line.empty()) {
+                logger.logMessage(MaxTick, "", "", line);
+                line.clear();
+            }
+            return 0;
+        }
+    };
+
+    static std::atomic<uint64_t> nextId;
+    /** The writer and buffer of the current thread. */
+    static thread_local uint64_t ownerId;
+    static thread_local ThreadBuffer *buffer;
+
+    const uint64_t id;
+    std::ostream &stream;
+
+    std::mutex mutex;
+    /** Signaled when a chunk has been submitted. */
+    std::condition_variable submitted;
+    /** Signaled when a chunk has been written. */
+    std::condition_variable written;
+
+    std::deque<Chunk> pending;
+    std::vector<Chunk> freeChunks;
+    size_t allocated = 0;
+    bool writing = false;
+    bool stop = false;
+
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    TextBuf textBuf;
+    std::ostream text;
+
+    std::thread thread;
+
+    Writer(BinaryLogger &logger, std::ostream &stream)
+        : id(++nextId), stream(stream), textBuf(logger), text(&textBuf),
+          thread([this]() { run(); })
+    {}
+
+    /** Get a chunk of at least size bytes, waiting for one if needed. */
+    Chunk
+    get(std::unique_lock<std::mutex> &lock, size_t size)
+    {
+        Chunk chunk;
+        if (size > ChunkSize) {
+            chunk.data.reset(new char[size]);
+            chunk.capacity = size;
+            return chunk;
+        }
+
+        written.wait(lock, [this]() {
+            return !freeChunks.empty() || allocated < MaxChunks;
+        });
+        if (!freeChunks.empty()) {
+            chunk = std::move(freeChunks.back());
+            freeChunks.pop_back();
+            chunk.size = 0;
+        } else {
+            chunk.data.reset(new char[ChunkSize]);
+            chunk.capacity = ChunkSize;
+            allocated++;
+        }
+        return chunk;
+    }
+
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            submitted.wait(lock, [this]() {
+                return !pending.empty() || stop;
+            });
+            if (pending.empty())
+                return;
+
+            Chunk chunk = std::move(pending.front());
+            pending.pop_front();
+            writing = true;
+            lock.unlock();
+
+            const uint32_t header[2] = {chunk.thread, 0};
+            const uint64_t size = chunk.size;
+            stream.write((const char *)header, sizeof(header));
+            stream.write((const char *)&size, sizeof(size));
+            stream.write(chunk.data.get(), chunk.size);
+
+            lock.lock();
+            writing = false;
+            if (chunk.capacity == ChunkSize)
+                freeChunks.push_back(std::move(chunk));
+            written.notify_all();
+        }
+    }
+};
+
+std::atomic<uint64_t> BinaryLogger::Writer::nextId(0);
+thread_local uint64_t BinaryLogger::Writer::ownerId = 0;
+thread_local BinaryLogger::ThreadBuffer *BinaryLogger::Writer::buffer =
+    nullptr;
+
+struct BinaryLogger::ThreadBuffer
+{
+    Writer &writer;
+    const uint32_t thread;
+    Writer::Chunk chunk;
+
+    /** Strings and format strings already defined by this thread. */
+    std::unordered_map<std::string, uint32_t> strings;
+    std::unordered_set<const char *> formats;
+
+    ThreadBuffer(Writer &writer, uint32_t thread)
+        : writer(writer), thread(thread), strings({{"", 0}})
+    {}
+
+    /** Reserve size bytes at the end of the buffer. */
+    char *
+    reserve(size_t size)
+    {
+        if (chunk.size + size > chunk.capacity) {
+            std::unique_lock<std::mutex> lock(writer.mutex);
+            if (chunk.size) {
+                writer.pending.push_back(std::move(chunk));
+                writer.submitted.notify_one();
+            }
+            chunk = writer.get(lock, size);
+            chunk.thread = thread;
+        }
+        char *p = chunk.data.get() + chunk.size;
+        chunk.size += size;
+        return p;
+    }
+
+    /** Get the id of a string, defining it if needed. */
+    uint32_t
+    stringId(const std::string &str)
+    {
+        auto it = strings.find(str);
+        if (it != strings.end())
+            return it->second;
+
+        const uint32_t id = strings.size();
+        strings.emplace(str, id);
+        const uint32_t len = str.size();
+        char *p = reserve(1 + 2 * sizeof(uint32_t) + len);
+        *p++ = StringRecord;
+        p = putValue(p, id);
+        p = putValue(p, len);
+        std::memcpy(p, str.data(), len);
+        return id;
+    }
+
+    /** Define a format string if needed. */
+    void
+    defineFormat(const char *fmt)
+    {
+        if (isStaticString(fmt) && !formats.insert(fmt).second)
+            return;
+
+        const uint32_t len = std::strlen(fmt);
+        char *p = reserve(1 + sizeof(uint64_t) + sizeof(uint32_t) + len);
+        *p++ = FormatRecord;
+        p = putValue<uint64_t>(p, (uintptr_t)fmt);
+        p = putValue(p, len);
+        std::memcpy(p, fmt, len);
+    }
+};
+
+BinaryLogger::BinaryLogger(std::ostream &stream)
+    : writer(new Writer(*this, binaryStream(stream)))
+{
+    binary = this;
+
+    const char magic[8] = "gem5dbt";
+    const uint32_t header[2] = {Version, 0};
+    stream.write(magic, sizeof(magic));
+    stream.write((const char *)header, sizeof(header));
+
+    std::lock_guard<std::mutex> lock(loggersMutex);
+    static bool registered = false;
+    if (!registered) {
+        std::atexit(flushLoggers);
+        registered = true;
+    }
+    loggers.push_back(this);
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(loggersMutex);
+        loggers.erase(std::find(loggers.begin(), loggers.end(), this));
+    }
+
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        writer->stop = true;
+    }
+    writer->submitted.notify_one();
+    writer->thread.join();
+}
+
+BinaryLogger::ThreadBuffer &
+BinaryLogger::buffer()
+{
+    if (Writer::ownerId != writer->id) {
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        writer->buffers.emplace_back(
+            new ThreadBuffer(*writer, writer->buffers.size()));
+        Writer::buffer = writer->buffers.back().get();
+        Writer::ownerId = writer->id;
+    }
+    return *Writer::buffer;
+}
+
+namespace
+{
+
+uint8_t
+messageOptions()
+{
+    return (debug::FmtFlag ? 1 : 0) | (debug::FmtTicksOff ? 2 : 0);
+}
+
+} // anonymous namespace
+
+char *
+BinaryLogger::beginMessage(Tick when, const std::string &name,
+                           const std::string &flag, const char *fmt,
+                           uint8_t num_args, size_t args_size)
+{
+    ThreadBuffer &buf = buffer();
+    const uint32_t name_id = buf.stringId(name);
+    const uint32_t flag_id = buf.stringId(flag);
+    buf.defineFormat(fmt);
+
+    char *p = buf.reserve(3 + sizeof(uint64_t) + 2 * sizeof(uint32_t) +
+                          sizeof(uint64_t) + args_size);
+    *p++ = MessageRecord;
+    *p++ = messageOptions();
+    *p++ = num_args;
+    p = putValue<uint64_t>(p, when);
+    p = putValue(p, name_id);
+    p = putValue(p, flag_id);
+    p = putValue<uint64_t>(p, (uintptr_t)fmt);
+
+    if (debug::FmtStackTrace) {
+        print_backtrace();
+        STATIC_ERR("\n");
+    }
+
+    return p;
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    ThreadBuffer &buf = buffer();
+    const uint32_t name_id = buf.stringId(name);
+    const uint32_t flag_id = buf.stringId(flag);
+    const uint32_t len = message.size();
+
+    char *p = buf.reserve(2 + sizeof(uint64_t) + 3 * sizeof(uint32_t) + len);
+    *p++ = TextRecord;
+    *p++ = messageOptions();
+    p = putValue<uint64_t>(p, when);
+    p = putValue(p, name_id);
+    p = putValue(p, flag_id);
+    p = putValue(p, len);
+    std::memcpy(p, message.data(), len);
+}
+
+std::ostream &
+BinaryLogger::getOstream()
+{
+    return writer->text;
+}
+
+void
+BinaryLogger::flush()
+{
+    writer->text.flush();
+
+    std::unique_lock<std::mutex> lock(writer->mutex);
+    for (auto &buf : writer->buffers) {
+        if (buf->chunk.size) {
+            writer->pending.push_back(std::move(buf->chunk));
+            buf->chunk = Writer::Chunk();
+        }
+    }
+    writer->submitted.notify_one();
+    writer->written.wait(lock, [this]() {
+        return writer->pending.empty() && !writer->writing;
+    });
+    writer->stream.flush();
+}
+
 } // namespace trace
 } // namespace gem5
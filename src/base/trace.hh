@@ -32,9 +32,13 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -53,6 +57,8 @@ namespace gem5
 
 namespace trace {
 
+class BinaryLogger;
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -61,6 +67,9 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Set if the messages are recorded without being formatted */
+    BinaryLogger *binary = nullptr;
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -74,14 +83,7 @@ class Logger
     template <typename ...Args>
     void dprintf_flag(Tick when, const std::string &name,
             const std::string &flag,
-            const char *fmt, const Args &...args)
-    {
-        if (!name.empty() && ignore.match(name))
-            return;
-        std::ostringstream line;
-        ccprintf(line, fmt, args...);
-        logMessage(when, name, flag, line.str());
-    }
+            const char *fmt, const Args &...args);
 
     /** Dump a block of data of length len */
     void dump(Tick when, const std::string &name,
@@ -124,6 +126,221 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/**
+ * Logger recording messages in a compact binary form, to be decoded
+ * offline by util/decode_debug_trace.py. Instead of being formatted, a
+ * message is recorded as a pointer to its format string followed by its
+ * raw arguments. Records are appended to a buffer of the logging thread,
+ * which is handed over to a background thread writing it to the output
+ * stream once full.
+ *
+ * Only arithmetic types, strings and pointers are recorded raw. Messages
+ * with arguments of other types are formatted as usual, and recorded as
+ * text, like the output of getOstream().
+ *
+ * The file starts with the magic "gem5dbt\0", a 32-bit version and 32
+ * reserved bits. It is followed by the buffers of all threads, each with
+ * a header made of the 32-bit id of the thread, 32 reserved bits and the
+ * 64-bit size of the buffer. The names, flags and format strings used by
+ * the messages of a thread are defined by records of its buffers when
+ * they are first used.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    static constexpr uint32_t Version = 1;
+
+    enum RecordType : uint8_t
+    {
+        FormatRecord = 1,
+        StringRecord = 2,
+        MessageRecord = 3,
+        TextRecord = 4,
+    };
+
+    /** Types of the arguments. Integers are ORed with their size. */
+    enum ArgType : uint8_t
+    {
+        SignedArg = 0x10,
+        UnsignedArg = 0x20,
+        SignedCharArg = 0x31,
+        UnsignedCharArg = 0x32,
+        BoolArg = 0x40,
+        FloatArg = 0x50,
+        StringArg = 0x60,
+        PointerArg = 0x70,
+    };
+
+    BinaryLogger(std::ostream &stream);
+    ~BinaryLogger();
+
+    template <typename ...Args>
+    void log(Tick when, const std::string &name, const std::string &flag,
+             const char *fmt, const Args &...args);
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    /** Messages written to this stream are recorded line by line. */
+    std::ostream &getOstream() override;
+
+    /**
+     * Write all the records to the output stream. This must only be
+     * called when no other thread is logging.
+     */
+    void flush();
+
+    /** Whether an argument type can be recorded without formatting it. */
+    template <typename T>
+    static constexpr bool
+    isRaw()
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_pointer_v<U>) {
+            using P = std::remove_cv_t<std::remove_pointer_t<U>>;
+            // Other character pointers are printed as strings by
+            // ostreams, and the others as addresses
+            return !std::is_function_v<P> &&
+                !std::is_volatile_v<std::remove_pointer_t<U>> &&
+                !std::is_same_v<P, signed char> &&
+                !std::is_same_v<P, unsigned char>;
+        } else {
+            return std::is_same_v<U, std::string> ||
+                std::is_same_v<U, bool> || std::is_same_v<U, char> ||
+                std::is_same_v<U, signed char> ||
+                std::is_same_v<U, unsigned char> ||
+                std::is_same_v<U, float> || std::is_same_v<U, double> ||
+                (std::is_integral_v<U> && sizeof(U) <= 8 &&
+                 !std::is_same_v<U, wchar_t> &&
+                 !std::is_same_v<U, char16_t> &&
+                 !std::is_same_v<U, char32_t>);
+        }
+    }
+
+  protected:
+    struct Writer;
+    struct ThreadBuffer;
+
+    /** Buffer of the current thread. */
+    ThreadBuffer &buffer();
+
+    /** Size of the record of an argument. */
+    template <typename T>
+    static size_t
+    argSize(const T &arg)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, std::string>) {
+            return 1 + sizeof(uint32_t) + arg.size();
+        } else if constexpr (std::is_pointer_v<U> &&
+                std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>,
+                               char>) {
+            const char *str = arg;
+            return 1 + sizeof(uint32_t) + (str ? std::strlen(str) : 0);
+        } else if constexpr (std::is_pointer_v<U> ||
+                std::is_floating_point_v<U>) {
+            return 1 + 8;
+        } else {
+            return 1 + sizeof(U);
+        }
+    }
+
+    template <typename T>
+    static char *
+    putValue(char *p, const T &value)
+    {
+        std::memcpy(p, &value, sizeof(value));
+        return p + sizeof(value);
+    }
+
+    static char *
+    putString(char *p, const char *str, uint32_t len)
+    {
+        *p++ = StringArg;
+        p = putValue(p, len);
+        std::memcpy(p, str, len);
+        return p + len;
+    }
+
+    /** Append the record of an argument at p. */
+    template <typename T>
+    static char *
+    putArg(char *p, const T &arg)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, std::string>) {
+            return putString(p, arg.data(), arg.size());
+        } else if constexpr (std::is_pointer_v<U> &&
+                std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>,
+                               char>) {
+            const char *str = arg;
+            return putString(p, str ? str : "", str ? std::strlen(str) : 0);
+        } else if constexpr (std::is_pointer_v<U>) {
+            *p++ = PointerArg;
+            return putValue<uint64_t>(p, (uintptr_t)arg);
+        } else if constexpr (std::is_same_v<U, bool>) {
+            *p++ = BoolArg;
+            return putValue<uint8_t>(p, arg);
+        } else if constexpr (std::is_floating_point_v<U>) {
+            *p++ = FloatArg;
+            return putValue<double>(p, arg);
+        } else if constexpr (std::is_same_v<U, char> ||
+                std::is_same_v<U, signed char> ||
+                std::is_same_v<U, unsigned char>) {
+            *p++ = std::is_signed_v<U> ? SignedCharArg : UnsignedCharArg;
+            return putValue(p, arg);
+        } else {
+            *p++ = (std::is_signed_v<U> ? SignedArg : UnsignedArg) |
+                sizeof(U);
+            return putValue(p, arg);
+        }
+    }
+
+    /**
+     * Define the name, flag and format of a message if needed, and
+     * reserve space for its record.
+     *
+     * @return Where the arguments must be written.
+     */
+    char *beginMessage(Tick when, const std::string &name,
+                       const std::string &flag, const char *fmt,
+                       uint8_t num_args, size_t args_size);
+
+    std::unique_ptr<Writer> writer;
+};
+
+template <typename ...Args>
+void
+Logger::dprintf_flag(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const Args &...args)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+    if (binary) {
+        binary->log(when, name, flag, fmt, args...);
+        return;
+    }
+    std::ostringstream line;
+    ccprintf(line, fmt, args...);
+    logMessage(when, name, flag, line.str());
+}
+
+template <typename ...Args>
+void
+BinaryLogger::log(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, const Args &...args)
+{
+    if constexpr ((isRaw<Args>() && ...) && sizeof...(Args) < 256) {
+        [[maybe_unused]] char *p = beginMessage(when, name, flag, fmt,
+            sizeof...(Args), (argSize(args) + ... + 0));
+        ((p = putArg(p, args)), ...);
+    } else {
+        std::ostringstream line;
+        ccprintf(line, fmt, args...);
+        logMessage(when, name, flag, line.str());
+    }
+}
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
@@ -28,8 +28,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/gtest/logging.hh"
@@ -608,3 +612,143 @@ TEST(TraceTest, GlobalName)
     DPRINTF(TraceTestDebugFlag, "Test message");
     ASSERT_EQ(getString(trace::output()), "");
 }
+
+/** A type recorded as text by the binary logger. */
+struct TraceTestValue
+{
+    int value;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const TraceTestValue &value)
+{
+    return os << "value" << value.value;
+}
+
+/**
+ * Split the chunks of a binary trace in records. The records are only
+ * split, and their contents returned raw.
+ */
+std::vector<std::pair<int, std::string>>
+getBinaryRecords(const std::string &trace)
+{
+    std::vector<std::pair<int, std::string>> records;
+
+    EXPECT_EQ(std::string(trace.c_str()), "gem5dbt");
+    size_t pos = 16;
+    while (pos < trace.size()) {
+        uint64_t size;
+        std::memcpy(&size, trace.data() + pos + 8, sizeof(size));
+        pos += 16;
+        const size_t end = pos + size;
+        while (pos < end) {
+            const int type = trace[pos];
+            size_t len = 0;
+            uint32_t str_len;
+            switch (type) {
+              case trace::BinaryLogger::FormatRecord:
+                std::memcpy(&str_len, trace.data() + pos + 9, 4);
+                len = 13 + str_len;
+                break;
+              case trace::BinaryLogger::StringRecord:
+                std::memcpy(&str_len, trace.data() + pos + 5, 4);
+                len = 9 + str_len;
+                break;
+              case trace::BinaryLogger::TextRecord:
+                std::memcpy(&str_len, trace.data() + pos + 18, 4);
+                len = 22 + str_len;
+                break;
+              default:
+                // Messages are the last record of these tests
+                EXPECT_EQ(type, trace::BinaryLogger::MessageRecord);
+                len = end - pos;
+                break;
+            }
+            records.emplace_back(type, trace.substr(pos + 1, len - 1));
+            pos += len;
+        }
+    }
+
+    return records;
+}
+
+/** Test that a message with raw arguments is recorded unformatted. */
+TEST(TraceTest, BinaryLoggerMessage)
+{
+    std::stringstream ss;
+    {
+        trace::BinaryLogger logger(ss);
+        logger.dprintf_flag(Tick(100), "Foo", "Flag", "Test %s %d",
+            "message", 217);
+    }
+
+    auto records = getBinaryRecords(ss.str());
+    ASSERT_EQ(records.size(), 4);
+    EXPECT_EQ(records[0].first, trace::BinaryLogger::StringRecord);
+    EXPECT_EQ(records[0].second.substr(8), "Foo");
+    EXPECT_EQ(records[1].first, trace::BinaryLogger::StringRecord);
+    EXPECT_EQ(records[1].second.substr(8), "Flag");
+    EXPECT_EQ(records[2].first, trace::BinaryLogger::FormatRecord);
+    EXPECT_EQ(records[2].second.substr(12), "Test %s %d");
+
+    // Options, number of arguments, tick, name, flag and format, then the
+    // arguments
+    const std::string &message = records[3].second;
+    ASSERT_EQ(message.size(), 26 + 12 + 5);
+    EXPECT_EQ(message[1], 2);
+    uint64_t tick;
+    uint32_t name, flag;
+    std::memcpy(&tick, message.data() + 2, sizeof(tick));
+    std::memcpy(&name, message.data() + 10, sizeof(name));
+    std::memcpy(&flag, message.data() + 14, sizeof(flag));
+    EXPECT_EQ(tick, 100);
+    EXPECT_EQ(name, 1);
+    EXPECT_EQ(flag, 2);
+    EXPECT_EQ(message[26], trace::BinaryLogger::StringArg);
+    EXPECT_EQ(message.substr(31, 7), "message");
+    EXPECT_EQ(message[38], trace::BinaryLogger::SignedArg | 4);
+    int value;
+    std::memcpy(&value, message.data() + 39, sizeof(value));
+    EXPECT_EQ(value, 217);
+}
+
+/** Test that a message with other arguments is recorded as text. */
+TEST(TraceTest, BinaryLoggerText)
+{
+    std::stringstream ss;
+    {
+        trace::BinaryLogger logger(ss);
+        logger.dprintf_flag(Tick(100), "Foo", "", "Test %d %s", 5,
+            TraceTestValue{3});
+    }
+
+    auto records = getBinaryRecords(ss.str());
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].first, trace::BinaryLogger::StringRecord);
+    EXPECT_EQ(records[1].first, trace::BinaryLogger::TextRecord);
+    EXPECT_EQ(records[1].second.substr(21), "Test 5 value3");
+}
+
+/** Test that ignored objects are not recorded. */
+TEST(TraceTest, BinaryLoggerIgnore)
+{
+    std::stringstream ss;
+    {
+        trace::BinaryLogger logger(ss);
+        ObjectMatch ignore_foo("Foo");
+        logger.setIgnore(ignore_foo);
+        logger.dprintf_flag(Tick(100), "Foo", "", "Test message");
+        logger.logMessage(Tick(100), "Foo", "", "Test message");
+    }
+
+    EXPECT_TRUE(getBinaryRecords(ss.str()).empty());
+}
+
+/** Test that binary output is not written to the standard streams. */
+TEST(TraceTest, BinaryLoggerStdStreams)
+{
+    gtestLogOutput.str("");
+    ASSERT_ANY_THROW(trace::BinaryLogger logger(std::cout));
+    EXPECT_NE(gtestLogOutput.str().find("--debug-file"), std::string::npos);
+    ASSERT_ANY_THROW(trace::BinaryLogger logger(std::cerr));
+}
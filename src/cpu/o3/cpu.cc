@@ -1540,7 +1540,7 @@ CPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        makeRequest(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(thread[tid]->contextId());
@@ -84,10 +84,10 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = makeRequest();
+    data_read_req = makeRequest();
+    data_write_req = makeRequest();
+    data_amo_req = makeRequest();
 }
 
 
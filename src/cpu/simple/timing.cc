@@ -463,7 +463,7 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -545,7 +545,7 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -601,9 +601,9 @@ TimingSimpleCPU::initiateMemAMO(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
-                            dataRequestorId(), pc, thread->contextId(),
-                            std::move(amo_op));
+    RequestPtr req = makeRequest(addr, size, flags,
+                                 dataRequestorId(), pc, thread->contextId(),
+                                 std::move(amo_op));
 
     assert(req->hasAtomicOpFunctor());
 
@@ -698,7 +698,7 @@ TimingSimpleCPU::fetch()
 
     if (needToFetch) {
         _status = BaseSimpleCPU::Running;
-        RequestPtr ifetch_req = std::make_shared<Request>();
+        RequestPtr ifetch_req = makeRequest();
         ifetch_req->taskId(taskId());
         ifetch_req->setContext(thread->contextId());
         setupFetchRequest(ifetch_req);
@@ -1244,7 +1244,7 @@ TimingSimpleCPU::initiateMemMgmtCmd(Request::Flags flags)
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
@@ -1300,7 +1300,7 @@ TimingSimpleCPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
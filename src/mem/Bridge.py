@@ -61,6 +61,12 @@ class Bridge(ClockedObject):
     req_size = Param.Unsigned(16, "The number of requests to buffer")
     resp_size = Param.Unsigned(16, "The number of responses to buffer")
     delay = Param.Latency("0ns", "The latency of this bridge")
+    mem_side_eventq_index = Param.Int(
+        -1,
+        "Event queue of the memory side, to link two threads of a "
+        "parallel simulation (-1 for the one of the CPU side, "
+        "eventq_index)",
+    )
     ranges = VectorParam.AddrRange(
         [AllMemory], "Address ranges to pass through the bridge"
     )
@@ -69,6 +69,16 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # Skip the refresh events of the ranks while the controller is idle,
+    # and account for the refreshes in bulk when it is next accessed, or
+    # when the stats are dumped or reset. Only used with the powerdown
+    # states disabled, as idle ranks otherwise enter self-refresh. Keep
+    # this off until tests/gem5/dram-lowp/lazy-refresh-run.py has been seen
+    # to pass, it has not been validated against the eager refresh yet.
+    lazy_refresh = Param.Bool(
+        False, "Account for the refreshes of an idle controller lazily"
+    )
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
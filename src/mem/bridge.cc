@@ -46,9 +46,11 @@
 
 #include "mem/bridge.hh"
 
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/Bridge.hh"
 #include "params/Bridge.hh"
+#include "sim/simulate.hh"
 
 namespace gem5
 {
@@ -72,8 +74,8 @@ Bridge::BridgeRequestPort::BridgeRequestPort(const std::string& _name,
                                            Cycles _delay, int _req_limit)
     : RequestPort(_name, &_bridge), bridge(_bridge),
       cpuSidePort(_cpuSidePort),
-      delay(_delay), reqQueueLimit(_req_limit),
-      sendEvent([this]{ trySendTiming(); }, _name)
+      delay(_delay), reqQueueLimit(_req_limit), inFlight(0),
+      retryWanted(false), sendEvent([this]{ trySendTiming(); }, _name)
 {
 }
 
@@ -82,8 +84,24 @@ Bridge::Bridge(const Params &p)
       cpuSidePort(p.name + ".cpu_side_port", *this, memSidePort,
                 ticksToCycles(p.delay), p.resp_size, p.ranges),
       memSidePort(p.name + ".mem_side_port", *this, cpuSidePort,
-                 ticksToCycles(p.delay), p.req_size)
+                 ticksToCycles(p.delay), p.req_size),
+      memSideQueue(p.mem_side_eventq_index < 0 ? eventQueue() :
+                   getEventQueue(p.mem_side_eventq_index)),
+      crossing(memSideQueue != eventQueue()),
+      lookahead(cyclesToTicks(ticksToCycles(p.delay))),
+      toMemSide(memSideQueue, p.name + ".crossing"),
+      toCpuSide(eventQueue(), p.name + ".crossing")
+{
+}
+
+Tick
+Bridge::edge(Cycles cycles) const
 {
+    if (!crossing)
+        return clockEdge(cycles);
+
+    return divCeil(curTick(), clockPeriod()) * clockPeriod() +
+        cyclesToTicks(cycles);
 }
 
 Port &
@@ -107,6 +125,9 @@ Bridge::init()
 
     // notify the request side  of our address ranges
     cpuSidePort.sendRangeChange();
+
+    if (crossing)
+        declareLookahead(name(), lookahead);
 }
 
 bool
@@ -118,7 +139,16 @@ Bridge::BridgeResponsePort::respQueueFull() const
 bool
 Bridge::BridgeRequestPort::reqQueueFull() const
 {
-    return transmitList.size() == reqQueueLimit;
+    if (!bridge.crossing)
+        return transmitList.size() == reqQueueLimit;
+
+    // The queue is drained on the other thread. Ask for a retry before
+    // looking again, so that a request leaving the queue in between
+    // does not go unnoticed.
+    if (inFlight < reqQueueLimit)
+        return false;
+    retryWanted = true;
+    return inFlight == reqQueueLimit;
 }
 
 bool
@@ -137,8 +167,7 @@ Bridge::BridgeRequestPort::recvTimingResp(PacketPtr pkt)
     Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
     pkt->headerDelay = pkt->payloadDelay = 0;
 
-    cpuSidePort.schedTimingResp(pkt, bridge.clockEdge(delay) +
-                              receive_delay);
+    cpuSidePort.schedTimingResp(pkt, bridge.edge(delay) + receive_delay);
 
     return true;
 }
@@ -191,7 +220,7 @@ Bridge::BridgeResponsePort::recvTimingReq(PacketPtr pkt)
             Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
             pkt->headerDelay = pkt->payloadDelay = 0;
 
-            memSidePort.schedTimingReq(pkt, bridge.clockEdge(delay) +
+            memSidePort.schedTimingReq(pkt, bridge.edge(delay) +
                                       receive_delay);
         }
     }
@@ -215,13 +244,25 @@ Bridge::BridgeResponsePort::retryStalledReq()
 
 void
 Bridge::BridgeRequestPort::schedTimingReq(PacketPtr pkt, Tick when)
+{
+    if (bridge.crossing) {
+        ++inFlight;
+        bridge.toMemSide.post(when,
+            [this, pkt]() { queueTimingReq(pkt, curTick()); });
+    } else {
+        queueTimingReq(pkt, when);
+    }
+}
+
+void
+Bridge::BridgeRequestPort::queueTimingReq(PacketPtr pkt, Tick when)
 {
     // If we're about to put this packet at the head of the queue, we
     // need to schedule an event to do the transmit.  Otherwise there
     // should already be an event scheduled for sending the head
     // packet.
     if (transmitList.empty()) {
-        bridge.schedule(sendEvent, when);
+        bridge.memSideQueue->schedule(&sendEvent, when);
     }
 
     assert(transmitList.size() != reqQueueLimit);
@@ -232,6 +273,17 @@ Bridge::BridgeRequestPort::schedTimingReq(PacketPtr pkt, Tick when)
 
 void
 Bridge::BridgeResponsePort::schedTimingResp(PacketPtr pkt, Tick when)
+{
+    if (bridge.crossing) {
+        bridge.toCpuSide.post(when,
+            [this, pkt]() { queueTimingResp(pkt, curTick()); });
+    } else {
+        queueTimingResp(pkt, when);
+    }
+}
+
+void
+Bridge::BridgeResponsePort::queueTimingResp(PacketPtr pkt, Tick when)
 {
     // If we're about to put this packet at the head of the queue, we
     // need to schedule an event to do the transmit.  Otherwise there
@@ -267,15 +319,23 @@ Bridge::BridgeRequestPort::trySendTiming()
         if (!transmitList.empty()) {
             DeferredPacket next_req = transmitList.front();
             DPRINTF(Bridge, "Scheduling next send\n");
-            bridge.schedule(sendEvent, std::max(next_req.tick,
-                                                bridge.clockEdge()));
+            bridge.memSideQueue->schedule(&sendEvent,
+                std::max(next_req.tick, bridge.edge(Cycles(0))));
         }
 
         // if we have stalled a request due to a full request queue,
         // then send a retry at this point, also note that if the
         // request we stalled was waiting for the response queue
         // rather than the request queue we might stall it again
-        cpuSidePort.retryStalledReq();
+        if (!bridge.crossing) {
+            cpuSidePort.retryStalledReq();
+        } else {
+            --inFlight;
+            if (retryWanted.exchange(false)) {
+                bridge.toCpuSide.post(bridge.edge(delay),
+                    [this]() { cpuSidePort.retryStalledReq(); });
+            }
+        }
     }
 
     // if the send failed, then we try again once we receive a retry,
@@ -309,7 +369,7 @@ Bridge::BridgeResponsePort::trySendTiming()
             DeferredPacket next_resp = transmitList.front();
             DPRINTF(Bridge, "Scheduling next send\n");
             bridge.schedule(sendEvent, std::max(next_resp.tick,
-                                                bridge.clockEdge()));
+                                                bridge.edge(Cycles(0))));
         }
 
         // if there is space in the request queue and we were stalling
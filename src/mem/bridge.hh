@@ -47,9 +47,11 @@
 #ifndef __MEM_BRIDGE_HH__
 #define __MEM_BRIDGE_HH__
 
+#include <atomic>
 #include <deque>
 
 #include "base/types.hh"
+#include "mem/crossing_channel.hh"
 #include "mem/port.hh"
 #include "params/Bridge.hh"
 #include "sim/clocked_object.hh"
@@ -69,6 +71,16 @@ namespace gem5
  * before forwarding the request. If there is no space present, then
  * the bridge will delay accepting the packet until space becomes
  * available.
+ *
+ * The two sides of the bridge may run on different event queues
+ * (eventq_index and mem_side_eventq_index), making it a link between
+ * two threads of a parallel simulation. Each side then owns its queue
+ * and handles its packets on its own thread, and packets cross over
+ * as events posted to the event queue of the other side, at least one
+ * bridge delay in the future. The delay is declared as the lookahead
+ * of the link, see declareLookahead(). Atomic and functional accesses
+ * still go straight through, so they are only safe when the threads
+ * are not running.
  */
 class Bridge : public ClockedObject
 {
@@ -158,6 +170,9 @@ class Bridge : public ClockedObject
         /** Send event for the response queue. */
         EventFunctionWrapper sendEvent;
 
+        /** Queue a response on the CPU side. */
+        void queueTimingResp(PacketPtr pkt, Tick when);
+
       public:
 
         /**
@@ -247,6 +262,18 @@ class Bridge : public ClockedObject
         /** Max queue size for request packets */
         const unsigned int reqQueueLimit;
 
+        /**
+         * When the sides of the bridge run on different threads, the
+         * requests accepted on the CPU side and not sent yet, including
+         * the ones still crossing over, and whether the CPU side waits
+         * for a retry.
+         */
+        std::atomic<unsigned int> inFlight;
+        mutable std::atomic<bool> retryWanted;
+
+        /** Queue a request on the memory side. */
+        void queueTimingReq(PacketPtr pkt, Tick when);
+
         /**
          * Handle send event, scheduled when the packet at the head of
          * the outbound queue is ready to transmit (for timing
@@ -316,6 +343,30 @@ class Bridge : public ClockedObject
     /** Request port of the bridge. */
     BridgeRequestPort memSidePort;
 
+    /** Event queue of the memory side of the bridge. */
+    EventQueue *const memSideQueue;
+
+    /** Whether the two sides run on different event queues. */
+    const bool crossing;
+
+    /** Smallest latency through the bridge, in ticks. */
+    const Tick lookahead;
+
+    /**
+     * Clock edge the given number of cycles after the current one. The
+     * threads of a crossing bridge cannot share the clock cache of the
+     * ClockedObject, so they compute it from scratch.
+     */
+    Tick edge(Cycles cycles) const;
+
+    /**
+     * Actions posted by each side to the other when crossing, in order:
+     * requests to the memory side, and responses and retries to the CPU
+     * side.
+     */
+    CrossingChannel toMemSide;
+    CrossingChannel toCpuSide;
+
   public:
 
     Port &getPort(const std::string &if_name,
@@ -115,6 +115,11 @@ class BaseCache(ClockedObject):
     prefetch_on_pf_hit = Param.Bool(
         False, "Notify the hardware prefetcher on hit on prefetched lines"
     )
+    warm_prefetcher = Param.Bool(
+        False,
+        "Train the hardware prefetcher with the accesses of the atomic mode "
+        "(functional warming), dropping the prefetches it generates",
+    )
 
     tags = Param.BaseTags(BaseSetAssoc(), "Tag store")
     replacement_policy = Param.BaseReplacementPolicy(
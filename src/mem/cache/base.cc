@@ -85,6 +85,7 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       tags(p.tags),
       compressor(p.compressor),
       prefetcher(p.prefetcher),
+      warmPrefetcher(p.warm_prefetcher),
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
       tempBlockWriteback(nullptr),
@@ -135,6 +136,10 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
         "Compressed cache %s does not have a compression algorithm", name());
     if (compressor)
         compressor->setCache(this);
+
+    fatal_if(cache_level >= MemTelemetry::MaxCacheLevels,
+        "The level of cache %s must be less than %d", name(),
+        MemTelemetry::MaxCacheLevels);
 }
 
 BaseCache::~BaseCache()
@@ -246,8 +251,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
-            req2->setCacheStats(cache_level, stats.overallMisses.total(), stats.overallAccessLatency.total());
+            RequestPtr req2 = makeRequest(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -430,6 +434,7 @@ BaseCache::recvTimingReq(PacketPtr pkt)
         // Note that lat is passed by reference here. The function
         // access() will set the lat value.
         satisfied = access(pkt, blk, lat, writebacks);
+        ppAccess->notify(AccessInfo{pkt, satisfied});
 
         // After the evicted blocks are selected, they must be forwarded
         // to the write buffer to ensure they logically precede anything
@@ -490,14 +495,6 @@ BaseCache::recvTimingResp(PacketPtr pkt)
 {
     assert(pkt->isResponse());
 
-    // if (pkt->req->hasDRAMStats()) {
-    //     dram_count[0] = pkt->req->getDRAMAccess();
-    //     dram_count[1] = pkt->req->getDRAMMissRate();
-    //     dram_count[2] = pkt->req->getDRAMHitRate();
-    // }
-
-    // TODO: Recalculate FCP if DRAM statistics is changed
-
     // all header delay should be paid for by the crossbar, unless
     // this is a prefetch response from above
     panic_if(pkt->headerDelay != 0 && pkt->cmd != MemCmd::HardPFResp,
@@ -653,6 +650,7 @@ BaseCache::recvAtomic(PacketPtr pkt)
     CacheBlk *blk = nullptr;
     PacketList writebacks;
     bool satisfied = access(pkt, blk, lat, writebacks);
+    ppAccess->notify(AccessInfo{pkt, satisfied});
 
     if (pkt->isClean() && blk && blk->isSet(CacheBlk::DirtyBit)) {
         // A cache clean opearation is looking for a dirty
@@ -685,6 +683,13 @@ BaseCache::recvAtomic(PacketPtr pkt)
     // for an example (though we'd want to issue the prefetch(es)
     // immediately rather than calling requestMemSideBus() as we do
     // there).
+    //
+    // The prefetcher may however be trained, to warm its tables while
+    // fast-forwarding; the prefetches it generates are then dropped.
+    // It is trained directly, so the other listeners of the Hit and Miss
+    // probes still only see timing accesses.
+    if (prefetcher && warmPrefetcher)
+        prefetcher->warm(pkt, !satisfied);
 
     // do any writebacks resulting from the response handling
     doWritebacksAtomic(writebacks);
@@ -1709,9 +1714,8 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
-    req->setCacheStats(cache_level, stats.overallMisses.total(), stats.overallAccessLatency.total());
 
     if (blk->isSecure())
         req->setFlags(Request::SECURE);
@@ -1753,9 +1757,8 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
-    req->setCacheStats(cache_level, stats.overallMisses.total(), stats.overallAccessLatency.total());
 
     if (blk->isSecure()) {
         req->setFlags(Request::SECURE);
@@ -1828,9 +1831,8 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = makeRequest(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
-        request->setCacheStats(cache_level, stats.overallMisses.total(), stats.overallAccessLatency.total());
 
         request->taskId(blk.getTaskId());
         if (blk.isSecure()) {
@@ -2531,6 +2533,8 @@ BaseCache::regProbePoints()
     ppHit = new ProbePointArg<PacketPtr>(this->getProbeManager(), "Hit");
     ppMiss = new ProbePointArg<PacketPtr>(this->getProbeManager(), "Miss");
     ppFill = new ProbePointArg<PacketPtr>(this->getProbeManager(), "Fill");
+    ppAccess =
+        new ProbePointArg<AccessInfo>(this->getProbeManager(), "Access");
     ppDataUpdate =
         new ProbePointArg<DataUpdate>(this->getProbeManager(), "Data Update");
 }
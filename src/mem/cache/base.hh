@@ -64,6 +64,7 @@
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/write_queue.hh"
 #include "mem/cache/write_queue_entry.hh"
+#include "mem/mem_telemetry.hh"
 #include "mem/packet.hh"
 #include "mem/packet_queue.hh"
 #include "mem/qport.hh"
@@ -117,6 +118,18 @@ class BaseCache : public ClockedObject
         NUM_BLOCKED_CAUSES
     };
 
+    /**
+     * A request looked up in the tags, and whether it was satisfied there.
+     * @sa ppAccess
+     */
+    struct AccessInfo
+    {
+        /** The request, before it is turned into a response. */
+        PacketPtr pkt;
+        /** Whether the request was satisfied by this cache. */
+        bool hit;
+    };
+
     /**
      * A data contents update is composed of the updated block's address,
      * the old contents, and the new contents.
@@ -379,6 +392,14 @@ class BaseCache : public ClockedObject
     /** Prefetcher */
     prefetch::Base *prefetcher;
 
+    /**
+     * Whether the prefetcher is trained by the accesses of the atomic
+     * mode, in which no prefetch is issued. This warms the tables of the
+     * prefetcher, along with the tags and the replacement state, while
+     * fast-forwarding with an atomic CPU.
+     */
+    const bool warmPrefetcher;
+
     /** To probe when a cache hit occurs */
     ProbePointArg<PacketPtr> *ppHit;
 
@@ -388,6 +409,12 @@ class BaseCache : public ClockedObject
     /** To probe when a cache fill occurs */
     ProbePointArg<PacketPtr> *ppFill;
 
+    /**
+     * To probe when a request is looked up in the tags, both in timing and
+     * in atomic mode, e.g. to record the access stream of a cache.
+     */
+    ProbePointArg<AccessInfo> *ppAccess;
+
     /**
      * To probe when the contents of a block are updated. Content updates
      * include data fills, overwrites, and invalidations, which means that
@@ -1027,20 +1054,20 @@ class BaseCache : public ClockedObject
 
         /** Number of hits per thread for each type of command.
             @sa Packet::Command */
-        statistics::Vector hits;
+        statistics::TotalledVector hits;
         /** Number of misses per thread for each type of command.
             @sa Packet::Command */
-        statistics::Vector misses;
+        statistics::TotalledVector misses;
         /**
          * Total number of ticks per thread/command spent waiting for a hit.
          * Used to calculate the average hit latency.
          */
-        statistics::Vector hitLatency;
+        statistics::TotalledVector hitLatency;
         /**
          * Total number of ticks per thread/command spent waiting for a miss.
          * Used to calculate the average miss latency.
          */
-        statistics::Vector missLatency;
+        statistics::TotalledVector missLatency;
         /** The number of accesses per command and thread. */
         statistics::Formula accesses;
         /** Access latency */
@@ -1326,6 +1353,7 @@ class BaseCache : public ClockedObject
     {
         assert(pkt->req->requestorId() < system->maxRequestors());
         stats.cmdStats(pkt).misses[pkt->req->requestorId()]++;
+        publishAccess(pkt, true);
         pkt->req->incAccessDepth();
         if (missCount) {
             --missCount;
@@ -1337,6 +1365,28 @@ class BaseCache : public ClockedObject
     {
         assert(pkt->req->requestorId() < system->maxRequestors());
         stats.cmdStats(pkt).hits[pkt->req->requestorId()]++;
+        publishAccess(pkt, false);
+    }
+
+    /**
+     * Publish an access of a levelled cache to the memory telemetry,
+     * attributing it to the context that issued the request.
+     */
+    void publishAccess(PacketPtr pkt, bool miss)
+    {
+        if (cache_level >= 0 && pkt->req->hasContextId()) {
+            system->getMemTelemetry().cacheAccess(
+                cache_level, pkt->req->contextId(), miss);
+        }
+    }
+
+    /** Publish the latency of a serviced miss to the memory telemetry. */
+    void publishMissLatency(PacketPtr pkt, Tick latency)
+    {
+        if (cache_level >= 0 && pkt->req->hasContextId()) {
+            system->getMemTelemetry().cacheMissLatency(
+                cache_level, pkt->req->contextId(), latency);
+        }
     }
 
     /**
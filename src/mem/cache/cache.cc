@@ -378,11 +378,10 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
-                                                    pkt->req->getSize(),
-                                                    pkt->req->getFlags(),
-                                                    pkt->req->requestorId());
-            req->setCacheStats(cache_level, stats.overallMisses.total(), stats.overallAccessLatency.total());
+            RequestPtr req = makeRequest(pkt->req->getPaddr(),
+                                         pkt->req->getSize(),
+                                         pkt->req->getFlags(),
+                                         pkt->req->requestorId());
             pf = new Packet(req, pkt->cmd);
             pf->allocate();
             assert(pf->matchAddr(pkt));
@@ -805,6 +804,8 @@ Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk)
                 stats.cmdStats(tgt_pkt)
                     .missLatency[tgt_pkt->req->requestorId()] +=
                     completion_time - target.recvTime;
+                publishMissLatency(tgt_pkt,
+                                   completion_time - target.recvTime);
 
                 if (tgt_pkt->cmd == MemCmd::LockedRMWReadReq) {
                     // We're going to leave a target in the MSHR until the
@@ -964,9 +965,8 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = makeRequest(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
-    req->setCacheStats(cache_level, stats.overallMisses.total(), stats.overallAccessLatency.total());
 
     if (blk->isSecure())
         req->setFlags(Request::SECURE);
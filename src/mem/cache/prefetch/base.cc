@@ -272,6 +272,13 @@ Base::probeNotify(const PacketPtr &pkt, bool miss)
     }
 }
 
+void
+Base::warm(const PacketPtr &pkt, bool miss)
+{
+    probeNotify(pkt, miss);
+    squashPrefetches();
+}
+
 void
 Base::regProbeListeners()
 {
@@ -387,6 +387,23 @@ class Base : public ClockedObject
 
     virtual Tick nextPrefetchReadyTime() const = 0;
 
+    /**
+     * Drop the prefetches generated so far and not issued yet. This is
+     * used when the prefetcher is only trained, e.g., by the accesses of
+     * the atomic mode during functional warming.
+     */
+    virtual void squashPrefetches() = 0;
+
+    /**
+     * Train the prefetcher with an access that is not notified through
+     * the probes, e.g., an access of the atomic mode during functional
+     * warming, and drop the prefetches it generates.
+     *
+     * @param pkt The memory request to train with
+     * @param miss Whether the access missed in the cache
+     */
+    virtual void warm(const PacketPtr &pkt, bool miss);
+
     void
     prefetchUnused()
     {
@@ -91,5 +91,19 @@ Multi::getPacket()
     return nullptr;
 }
 
+void
+Multi::squashPrefetches()
+{
+    for (auto pf : prefetchers)
+        pf->squashPrefetches();
+}
+
+void
+Multi::warm(const PacketPtr &pkt, bool miss)
+{
+    for (auto pf : prefetchers)
+        pf->warm(pkt, miss);
+}
+
 } // namespace prefetch
 } // namespace gem5
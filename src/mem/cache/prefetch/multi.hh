@@ -60,6 +60,8 @@ class Multi : public Base
     void setCache(BaseCache *_cache) override;
     PacketPtr getPacket() override;
     Tick nextPrefetchReadyTime() const override;
+    void squashPrefetches() override;
+    void warm(const PacketPtr &pkt, bool miss) override;
 
     /** @{ */
     /**
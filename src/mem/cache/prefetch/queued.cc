@@ -61,8 +61,8 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = makeRequest(paddr, blk_size,
+                                 0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
@@ -262,6 +262,17 @@ Queued::getPacket()
     return pkt;
 }
 
+void
+Queued::squashPrefetches()
+{
+    // Prefetches waiting for a translation are left alone, they may be
+    // in the middle of a translation
+    for (DeferredPacket &p : pfq) {
+        delete p.pkt;
+    }
+    pfq.clear();
+}
+
 Queued::QueuedStats::QueuedStats(statistics::Group *parent)
     : statistics::Group(parent),
     ADD_STAT(pfIdentified, statistics::units::Count::get(),
@@ -374,7 +385,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = makeRequest(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -206,6 +206,8 @@ class Queued : public Base
         return pfq.empty() ? MaxTick : pfq.front().tick;
     }
 
+    void squashPrefetches() override;
+
     void printQueue(const std::list<DeferredPacket> &queue) const;
 
   private:
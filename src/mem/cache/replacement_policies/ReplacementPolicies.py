@@ -79,6 +79,31 @@ class LRURP(BaseReplacementPolicy):
     cxx_header = "mem/cache/replacement_policies/lru_rp.hh"
 
 
+class OPTRP(BaseReplacementPolicy):
+    """
+    Belady's optimal policy, driven by a trace of this cache's accesses
+    recorded by CacheTraceProbe in a previous run of the same access
+    stream. Only usable with BaseSetAssoc tags.
+    """
+
+    type = "OPTRP"
+    cxx_class = "gem5::replacement_policy::OPT"
+    cxx_header = "mem/cache/replacement_policies/opt_rp.hh"
+
+    trace_file = Param.String("Cache trace giving the future accesses")
+    index_file = Param.String(
+        "",
+        "Next-use index of the trace, built from it if it does not exist. "
+        "Rejected if the trace has changed since it was built. Defaults to "
+        "<trace_file>.nui",
+    )
+    pending_misses = Param.Unsigned(
+        64,
+        "Number of last misses whose next use is kept until their block "
+        "is inserted, at least the number of MSHRs of the cache",
+    )
+
+
 class BIPRP(LRURP):
     type = "BIPRP"
     cxx_class = "gem5::replacement_policy::BIP"
@@ -190,6 +215,8 @@ class HawkeyeRP(BaseReplacementPolicy):
         8. num_sampled_sets (Number of sets in sampled cache)
         9. timer_size (Number of bits for timestamp)
         10. cache_partition_on (Enable cache parition enforcement mechanism)
+        11. num_sampled_ways, sampled_tag_bits, sampled_timestamp_bits
+            (Geometry of the sampled sets)
     """
 
     type = "HawkeyeRP"
@@ -207,6 +234,15 @@ class HawkeyeRP(BaseReplacementPolicy):
     )
     num_sampled_sets = Param.Int(300, "Number of sets in sampled cache")
     timer_size = Param.Int(1 << 10, "Number of bits for timestamp")
+    num_sampled_ways = Param.Unsigned(
+        8, "Number of ways per sampled set (4, 5, 8, 16 or 32)"
+    )
+    sampled_tag_bits = Param.Unsigned(
+        16, "Number of bits of the sampled address tags"
+    )
+    sampled_timestamp_bits = Param.Unsigned(
+        8, "Number of bits of the sampled timestamps"
+    )
     num_cpus = Param.Int(1, "Number of CPU cores")
     cache_level = Param.Int(1, "Cache level")
 
@@ -223,6 +259,8 @@ class MockingjayRP(BaseReplacementPolicy):
         8. num_sampled_sets (Number of sets in sampled cache)
         9. timer_size (Number of bits for timestamp)
         10. cache_partition_on (Enable cache parition enforcement mechanism)
+        11. num_sampled_ways, sampled_tag_bits, sampled_timestamp_bits
+            (Geometry of the sampled sets)
     """
 
     type = "MockingjayRP"
@@ -239,6 +277,15 @@ class MockingjayRP(BaseReplacementPolicy):
     )
     num_sampled_sets = Param.Int(512, "Number of sets in sampled cache")
     timer_size = Param.Int(8, "Number of bits for timestamp")
+    num_sampled_ways = Param.Unsigned(
+        5, "Number of ways per sampled set (4, 5, 8, 16 or 32)"
+    )
+    sampled_tag_bits = Param.Unsigned(
+        10, "Number of bits of the sampled address tags"
+    )
+    sampled_timestamp_bits = Param.Unsigned(
+        8, "Number of bits of the sampled timestamps"
+    )
     num_cpus = Param.Int(1, "Number of cores")
     num_clock_bits = Param.Int(3, "Number of bits for aging clock")
     num_internal_sampled_sets = Param.Int(4, "Number of sets for sub-sampled cache")
@@ -255,6 +302,8 @@ class FlockHawkeyeRP(BaseReplacementPolicy):
         7. pred_num_bits_per_entry (Number of counter bits per entry in predictor)
         8. num_sampled_sets (Number of sets in sampled cache)
         9. timer_size (Number of bits for timestamp)
+        10. num_sampled_ways, sampled_tag_bits, sampled_timestamp_bits
+            (Geometry of the sampled sets)
     """
 
     type = "FlockHawkeyeRP"
@@ -272,5 +321,17 @@ class FlockHawkeyeRP(BaseReplacementPolicy):
     )
     num_sampled_sets = Param.Int(300, "Number of sets in sampled cache")
     timer_size = Param.Int(1 << 10, "Number of bits for timestamp")
+    num_sampled_ways = Param.Unsigned(
+        8, "Number of ways per sampled set (4, 5, 8, 16 or 32)"
+    )
+    sampled_tag_bits = Param.Unsigned(
+        16, "Number of bits of the sampled address tags"
+    )
+    sampled_timestamp_bits = Param.Unsigned(
+        8, "Number of bits of the sampled timestamps"
+    )
     num_cpus = Param.Int(1, "Number of CPU cores")
-    cache_level = Param.Int(1, "Cache level")
\ No newline at end of file
+    cache_level = Param.Int(1, "Cache level")
+    system = Param.System(
+        Parent.any, "System whose memory telemetry drives the partitioning"
+    )
@@ -124,7 +124,9 @@ class Base : public SimObject
                            const ReplacementCandidates& candidates) const = 0;
 
     /**
-     * Instantiate a replacement data entry.
+     * Instantiate a replacement data entry. Policies may either allocate
+     * a standalone replacement data, or keep the state of all their
+     * entries in a FlatReplState and return a handle into it.
      *
      * @return A shared pointer to the new replacement data.
      */
@@ -28,11 +28,13 @@
 
 #include "mem/cache/replacement_policies/brrip_rp.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 
 #include "base/logging.hh" // For fatal_if
 #include "base/random.hh"
+#include "mem/cache/replacement_policies/victim_kernel.hh"
 #include "params/BRRIPRP.hh"
 
 namespace gem5
@@ -43,54 +45,51 @@ namespace replacement_policy
 {
 
 BRRIP::BRRIP(const Params &p)
-  : Base(p), numRRPVBits(p.num_bits), hitPriority(p.hit_priority),
-    btp(p.btp)
+  : Base(p), numRRPVBits(p.num_bits),
+    maxRRPV(numRRPVBits <= 8 ? (1 << numRRPVBits) - 1 : 0),
+    hitPriority(p.hit_priority), btp(p.btp)
 {
     fatal_if(numRRPVBits <= 0, "There should be at least one bit per RRPV.\n");
+    fatal_if(numRRPVBits > 8, "RRPVs are stored in a byte.\n");
 }
 
 void
 BRRIP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
-
     // Invalidate entry
-    casted_replacement_data->valid = false;
+    replState.valid[replState.index(replacement_data)] = false;
 }
 
 void
 BRRIP::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    uint8_t &rrpv = replState.value[replState.index(replacement_data)];
 
     // Update RRPV if not 0 yet
     // Every hit in HP mode makes the entry the last to be evicted, while
     // in FP mode a hit makes the entry less likely to be evicted
     if (hitPriority) {
-        casted_replacement_data->rrpv.reset();
-    } else {
-        casted_replacement_data->rrpv--;
+        rrpv = 0;
+    } else if (rrpv > 0) {
+        rrpv--;
     }
 }
 
 void
 BRRIP::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
 {
-    std::shared_ptr<BRRIPReplData> casted_replacement_data =
-        std::static_pointer_cast<BRRIPReplData>(replacement_data);
+    const uint32_t index = replState.index(replacement_data);
 
     // Reset RRPV
     // Replacement data is inserted as "long re-reference" if lower than btp,
     // "distant re-reference" otherwise
-    casted_replacement_data->rrpv.saturate();
+    replState.value[index] = maxRRPV;
     if (random_mt.random<unsigned>(1, 100) <= btp) {
-        casted_replacement_data->rrpv--;
+        replState.value[index]--;
     }
 
     // Mark entry as ready to be used
-    casted_replacement_data->valid = true;
+    replState.valid[index] = true;
 }
 
 ReplaceableEntry*
@@ -99,26 +98,29 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
+    // The ways of a set are usually instantiated consecutively, in which
+    // case their RRPVs can be scanned in place
+    uint32_t first;
+    if (replState.contiguous(candidates, first)) {
+        return candidates[findRRPVVictim(&replState.value[first],
+            &replState.valid[first], candidates.size(), maxRRPV)];
+    }
+
     // Use first candidate as dummy victim
     ReplaceableEntry* victim = candidates[0];
-
-    // Store victim->rrpv in a variable to improve code readability
-    int victim_RRPV = std::static_pointer_cast<BRRIPReplData>(
-                        victim->replacementData)->rrpv;
+    int victim_RRPV = replState.value[replState.index(victim)];
 
     // Visit all candidates to find victim
     for (const auto& candidate : candidates) {
-        std::shared_ptr<BRRIPReplData> candidate_repl_data =
-            std::static_pointer_cast<BRRIPReplData>(
-                candidate->replacementData);
+        const uint32_t index = replState.index(candidate);
 
         // Stop searching for victims if an invalid entry is found
-        if (!candidate_repl_data->valid) {
+        if (!replState.valid[index]) {
             return candidate;
         }
 
         // Update victim entry if necessary
-        int candidate_RRPV = candidate_repl_data->rrpv;
+        int candidate_RRPV = replState.value[index];
         if (candidate_RRPV > victim_RRPV) {
             victim = candidate;
             victim_RRPV = candidate_RRPV;
@@ -127,15 +129,14 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
 
     // Get difference of victim's RRPV to the highest possible RRPV in
     // order to update the RRPV of all the other entries accordingly
-    int diff = std::static_pointer_cast<BRRIPReplData>(
-        victim->replacementData)->rrpv.saturate();
+    int diff = maxRRPV - victim_RRPV;
 
     // No need to update RRPV if there is no difference
     if (diff > 0){
         // Update RRPV of all candidates
         for (const auto& candidate : candidates) {
-            std::static_pointer_cast<BRRIPReplData>(
-                candidate->replacementData)->rrpv += diff;
+            uint8_t &rrpv = replState.value[replState.index(candidate)];
+            rrpv = std::min(rrpv + diff, (int)maxRRPV);
         }
     }
 
@@ -145,7 +146,7 @@ BRRIP::getVictim(const ReplacementCandidates& candidates) const
 std::shared_ptr<ReplacementData>
 BRRIP::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new BRRIPReplData(numRRPVBits));
+    return replState.instantiate();
 }
 
 } // namespace replacement_policy
@@ -52,8 +52,8 @@
 #ifndef __MEM_CACHE_REPLACEMENT_POLICIES_BRRIP_RP_HH__
 #define __MEM_CACHE_REPLACEMENT_POLICIES_BRRIP_RP_HH__
 
-#include "base/sat_counter.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/flat_repl_state.hh"
 
 namespace gem5
 {
@@ -67,30 +67,6 @@ namespace replacement_policy
 class BRRIP : public Base
 {
   protected:
-    /** BRRIP-specific implementation of replacement data. */
-    struct BRRIPReplData : ReplacementData
-    {
-        /**
-         * Re-Reference Interval Prediction Value.
-         * Some values have specific names (according to the paper):
-         * 0 -> near-immediate re-rereference interval
-         * max_RRPV-1 -> long re-rereference interval
-         * max_RRPV -> distant re-rereference interval
-         */
-        SatCounter8 rrpv;
-
-        /** Whether the entry is valid. */
-        bool valid;
-
-        /**
-         * Default constructor. Invalidate data.
-         */
-        BRRIPReplData(const int num_bits)
-            : rrpv(num_bits), valid(false)
-        {
-        }
-    };
-
     /**
      * Number of RRPV bits. An entry that saturates its RRPV has the longest
      * possible re-reference interval, that is, it is likely not to be used
@@ -99,6 +75,9 @@ class BRRIP : public Base
      */
     const unsigned numRRPVBits;
 
+    /** Saturated RRPV value; the distant re-reference interval. */
+    const uint8_t maxRRPV;
+
     /**
      * The hit priority (HP) policy replaces entries that do not receive cache
      * hits over any cache entry that receives a hit, while the frequency
@@ -112,6 +91,15 @@ class BRRIP : public Base
      */
     const unsigned btp;
 
+    /**
+     * Re-Reference Interval Prediction Value and validity of all entries.
+     * Some RRPV values have specific names (according to the paper):
+     * 0 -> near-immediate re-rereference interval
+     * max_RRPV-1 -> long re-rereference interval
+     * max_RRPV -> distant re-rereference interval
+     */
+    mutable FlatReplState<uint8_t> replState;
+
   public:
     typedef BRRIPRPParams Params;
     BRRIP(const Params &p);
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Policy-owned, struct-of-arrays storage for the replacement data of the
+ * RRIP-like policies.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_FLAT_REPL_STATE_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_FLAT_REPL_STATE_HH__
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+/**
+ * Replacement data of an entry whose state is kept by its policy in a
+ * FlatReplState. It only records where that state lives.
+ */
+struct FlatReplData : ReplacementData
+{
+    /** Slot of the entry in the arrays of the policy's FlatReplState. */
+    const uint32_t index;
+
+    FlatReplData(uint32_t _index) : index(_index) {}
+};
+
+/**
+ * Replacement state stored as a struct of arrays owned by the policy,
+ * instead of as one heap-allocated ReplacementData per entry.
+ *
+ * Slots are handed out in instantiation order. Since the set-associative
+ * tags instantiate the ways of a set one after the other, the state of a
+ * set is contiguous in every array, and a victim search touches a couple
+ * of cache lines instead of dereferencing one pointer per way. All the
+ * handles given to the entries share a single control block, so apart
+ * from the amortised growth of the arrays instantiating an entry does not
+ * allocate. Entries instantiated in any other order (e.g., by the
+ * prefetcher tables or Ruby) still work, they only lose the locality and
+ * the vectorised scans of victim_kernel.hh.
+ *
+ * The policies that use it do not also support one ReplacementData per
+ * entry. Both layouts hold the same state and pick the same victims, so
+ * a second layout would only duplicate every accessor of the policies.
+ *
+ * @tparam Value Type of the per-entry re-reference prediction.
+ */
+template <typename Value>
+class FlatReplState
+{
+  private:
+    /** Handles of the entries; a deque so that they never move. */
+    std::shared_ptr<std::deque<FlatReplData>> handles;
+
+  public:
+    /** Re-reference prediction of each entry (e.g., RRPV, ETR). */
+    std::vector<Value> value;
+
+    /** Whether each entry is valid. */
+    std::vector<uint8_t> valid;
+
+    /** Whether each entry has been predicted to be cache-friendly. */
+    std::vector<uint8_t> friendly;
+
+    /** Context that last accessed each entry. */
+    std::vector<ContextID> contextId;
+
+    FlatReplState()
+      : handles(std::make_shared<std::deque<FlatReplData>>())
+    {
+    }
+
+    /**
+     * Allocate the slot of a new, invalid entry.
+     *
+     * @param init Initial re-reference prediction of the entry.
+     * @return The handle to be stored as the entry's replacement data.
+     */
+    std::shared_ptr<ReplacementData>
+    instantiate(Value init = 0)
+    {
+        const uint32_t slot = handles->size();
+        handles->emplace_back(slot);
+        value.push_back(init);
+        valid.push_back(false);
+        friendly.push_back(false);
+        contextId.push_back(0);
+        return std::shared_ptr<ReplacementData>(handles, &handles->back());
+    }
+
+    /** Number of slots handed out so far. */
+    std::size_t size() const { return handles->size(); }
+
+    /**
+     * Get the slot of an entry from its replacement data.
+     *
+     * @param replacement_data A handle returned by instantiate().
+     * @return The slot of the entry in the arrays.
+     */
+    static uint32_t
+    index(const std::shared_ptr<ReplacementData> &replacement_data)
+    {
+        return static_cast<const FlatReplData *>(
+            replacement_data.get())->index;
+    }
+
+    static uint32_t
+    index(const ReplaceableEntry *entry)
+    {
+        return index(entry->replacementData);
+    }
+
+    /**
+     * Check whether the state of some entries occupies consecutive slots,
+     * in order, so that it can be scanned directly in the arrays.
+     *
+     * @param entries The entries, e.g., the replacement candidates.
+     * @param first Slot of the first entry.
+     * @return Whether the slots of the entries are consecutive.
+     */
+    static bool
+    contiguous(const std::vector<ReplaceableEntry *> &entries,
+               uint32_t &first)
+    {
+        first = index(entries[0]);
+        for (std::size_t i = 1; i < entries.size(); i++) {
+            if (index(entries[i]) != first + i) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_FLAT_REPL_STATE_HH__
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/cache/replacement_policies/flat_repl_state.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+TEST(FlatReplStateTest, SlotsAreHandedOutInOrder)
+{
+    FlatReplState<uint8_t> state;
+    std::vector<std::shared_ptr<ReplacementData>> data;
+    for (int i = 0; i < 32; i++) {
+        data.push_back(state.instantiate(3));
+    }
+
+    ASSERT_EQ(state.size(), 32);
+    ASSERT_EQ(state.value.size(), 32);
+    for (int i = 0; i < 32; i++) {
+        ASSERT_EQ(FlatReplState<uint8_t>::index(data[i]), i);
+        ASSERT_EQ(state.value[i], 3);
+        ASSERT_FALSE(state.valid[i]);
+        ASSERT_FALSE(state.friendly[i]);
+    }
+}
+
+TEST(FlatReplStateTest, HandlesShareOwnership)
+{
+    std::shared_ptr<ReplacementData> first;
+    std::shared_ptr<ReplacementData> last;
+    {
+        FlatReplState<int8_t> state;
+        first = state.instantiate();
+        for (int i = 0; i < 1000; i++) {
+            last = state.instantiate();
+        }
+        ASSERT_EQ(first.use_count(), last.use_count());
+    }
+
+    // The handles outlive the state that created them, and growing the
+    // state did not move them
+    ASSERT_EQ(FlatReplState<int8_t>::index(first), 0);
+    ASSERT_EQ(FlatReplState<int8_t>::index(last), 1000);
+}
+
+TEST(FlatReplStateTest, IndexFromEntry)
+{
+    FlatReplState<uint8_t> state;
+    ReplaceableEntry entries[4];
+    for (auto &entry : entries) {
+        entry.replacementData = state.instantiate();
+    }
+    state.value[FlatReplState<uint8_t>::index(&entries[2])] = 7;
+    ASSERT_EQ(state.value[2], 7);
+}
+
+TEST(FlatReplStateTest, Contiguous)
+{
+    FlatReplState<uint8_t> state;
+    ReplaceableEntry entries[8];
+    std::vector<ReplaceableEntry *> set;
+    for (auto &entry : entries) {
+        entry.replacementData = state.instantiate();
+        set.push_back(&entry);
+    }
+
+    uint32_t first = 0;
+    ASSERT_TRUE(FlatReplState<uint8_t>::contiguous(set, first));
+    ASSERT_EQ(first, 0);
+
+    std::vector<ReplaceableEntry *> upper(set.begin() + 4, set.end());
+    ASSERT_TRUE(FlatReplState<uint8_t>::contiguous(upper, first));
+    ASSERT_EQ(first, 4);
+
+    std::swap(set[2], set[3]);
+    ASSERT_FALSE(FlatReplState<uint8_t>::contiguous(set, first));
+}
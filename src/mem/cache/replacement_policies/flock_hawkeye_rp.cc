@@ -1,9 +1,15 @@
 #include "mem/cache/replacement_policies/flock_hawkeye_rp.hh"
 
+#include <algorithm>
+
 #include "base/logging.hh"
 #include "params/FlockHawkeyeRP.hh"
 #include "debug/CacheRepl.hh"
 #include "base/trace.hh"
+#include "mem/cache/replacement_policies/partition_solver.hh"
+#include "mem/cache/replacement_policies/victim_kernel.hh"
+#include "mem/mem_telemetry.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -13,8 +19,15 @@ namespace replacement_policy
 {
 
 
-FlockHawkeye::FlockHawkeye(const Params &p) : Base(p), _num_rrpv_bits(p.num_rrpv_bits), _log2_block_size((int) std::log2(p.cache_block_size)), _log2_num_cache_sets((int) std::log2(p.num_cache_sets)),
-                                    _num_cpus(p.num_cpus), _num_cache_ways(p.num_cache_ways), _cache_level(p.cache_level), repartition(0), dram_latency(0) {
+FlockHawkeye::FlockHawkeye(const Params &p) : Base(p), stats(this, p.num_cpus), _num_rrpv_bits(p.num_rrpv_bits), _log2_block_size((int) std::log2(p.cache_block_size)), _log2_num_cache_sets((int) std::log2(p.num_cache_sets)),
+                                    _num_cpus(p.num_cpus), _num_cache_ways(p.num_cache_ways), _cache_level(p.cache_level), _system(p.system), _max_rrpv((1 << p.num_rrpv_bits) - 1),
+                                    repartition(0), reaging(0), dram_latency(0) {
+    fatal_if(p.num_rrpv_bits > 8, "RRPVs are stored in a byte");
+    fatal_if(p.cache_level >= MemTelemetry::MaxCacheLevels ||
+             p.num_cpus > MemTelemetry::MaxContexts,
+             "The memory telemetry tracks at most %d cache levels and %d cores",
+             MemTelemetry::MaxCacheLevels, MemTelemetry::MaxContexts);
+
     // Paramters:
     //  1. num_rrpv_bits (RRPV bits)
     //  2. num_cache_sets (Number of target cache sets)
@@ -30,7 +43,8 @@ FlockHawkeye::FlockHawkeye(const Params &p) : Base(p), _num_rrpv_bits(p.num_rrpv
     dram_stats[1] = 0;
     
     for (int i = 0; i < p.num_cpus; i++) {
-        samplers.push_back(std::make_unique<HistorySampler>(p.num_sampled_sets, p.num_cache_sets, p.cache_block_size, p.timer_size));
+        samplers.push_back(HistorySampler::create(p.num_sampled_sets, p.num_cache_sets, p.cache_block_size, p.timer_size,
+                                                  p.num_sampled_ways, p.sampled_tag_bits, p.sampled_timestamp_bits));
         predictors.push_back(std::make_unique<PCBasedPredictor>(p.num_pred_entries, p.num_pred_bits));
         opt_vectors.push_back(std::make_unique<OccupencyVector>(p.num_cache_ways, p.optgen_vector_size));
         for (int i = 0; i <= p.num_cache_ways; i++) {
@@ -42,10 +56,18 @@ FlockHawkeye::FlockHawkeye(const Params &p) : Base(p), _num_rrpv_bits(p.num_rrpv
 
     curr_partition.resize(p.num_cpus, 0);
     ratio_counter.resize(p.num_cpus);
+    aging_cores.resize(p.num_cpus, false);
+    inst_count.resize(p.num_cpus, 0);
+    cpi_stats.resize(p.num_cpus, 0);
+
+    // One entry per core for this cache and every level above it. The
+    // FCP always looks at L1I, L1D and L2, which are reported as not
+    // available when this cache is above them.
+    level_stats.resize((std::max(p.cache_level, 2) + 1) * p.num_cpus);
 
     // Initilize the stats for the cache use Flock (LLC)
     for (int i = 0; i < p.num_cpus; i++) {
-        cache_stats[std::make_pair(p.cache_level, i)] = std::make_pair(0, 0);
+        levelStats(p.cache_level, i).valid = true;
     }
 
     DPRINTF(CacheRepl, "Cache Initialization ---- Number of Cache Sets: %d, Cache Block Size: %d, Number of Cache Ways: %d\n", p.num_cache_sets, p.cache_block_size, p.num_cache_ways);
@@ -57,99 +79,70 @@ FlockHawkeye::FlockHawkeye(const Params &p) : Base(p), _num_rrpv_bits(p.num_rrpv
 
 void FlockHawkeye::invalidate(const std::shared_ptr<ReplacementData> &replacement_data)
 {
-    std::shared_ptr<FlockHawkeyeReplData> casted_replacement_data =
-        std::static_pointer_cast<FlockHawkeyeReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     // Invalidate entry
 
     // TODO: If it is sampled cache line, then that cache line should be invalidated also.
-    casted_replacement_data->valid = false;
-    casted_replacement_data->is_cache_friendly = false;
+    repl_state.valid[index] = false;
+    repl_state.friendly[index] = false;
 }
 
 void FlockHawkeye::access(const PacketPtr pkt, bool hit, const ReplacementCandidates& candidates) {
 
-    // TODO: This function may calculate miss twice
-
-    // If the packet is requests, then it should be from higher level caches in multi-level cache hierarchy
-    // It should bring higher level cache statistics
-    if (pkt->isRequest() && pkt->req->hasCacheStats()) {
-        // Key: Cache level
-        // Value: Cache miss and access
-        std::unordered_map<int, std::pair<double, double>>::iterator it = pkt->req->getCacheStatsBegin();
-        std::unordered_map<int, std::pair<double, double>>::iterator it_end = pkt->req->getCacheStatsEnd();
-
-        for (; it != it_end; it++) {
-            // Different cores will have different private L1 and L2 caches
-            // So core id is necessary in the key
-            std::pair<int, ContextID> key = std::make_pair(it->first, pkt->req->contextId());
-            if (cache_stats.find(key) != cache_stats.end()) {
-                if (cache_stats[key].first <= ((Counter) it->second.first) && cache_stats[key].second <= pkt->req->getInstCount()) {
-                    // TODO: Should not update new statistics
-                    cache_stats[key] = std::make_pair((Counter) it->second.first, pkt->req->getInstCount());
-                    cache_latency_stats[key] = it->second.second;
-                }
-            } else {
-                cache_stats[key] = std::make_pair((Counter) it->second.first, pkt->req->getInstCount());
-                cache_latency_stats[key] = it->second.second;
-
-            }
-            DPRINTF(CacheRepl, "Cache statistics from high level caches -- Cache level: %d, Core id: %d, Miss count: %ld, Inst count: %ld, Average access latency: %.4f\n", 
-                    key.first, key.second, cache_stats[key].first, cache_stats[key].second, cache_latency_stats[key]);
+    // Statistics of the other cache levels and DRAM are not carried by the
+    // packets anymore, they are pulled from the memory telemetry when a new
+    // partitioning epoch starts (see pullTelemetry)
+    // Only the requests of the cores sharing this cache are accounted
+    const ContextID core_id = pkt->isRequest() && pkt->req->hasContextId() ? pkt->req->contextId() : InvalidContextID;
+    if (core_id >= 0 && core_id < _num_cpus) {
+        if (pkt->req->hasInstCount()) {
+            inst_count[core_id] = std::max(inst_count[core_id], pkt->req->getInstCount());
         }
-    }
 
-    // If the packet is response, then it should come from DRAM (LLC is the last one in cache system)
-    if (pkt->isResponse() && pkt->req->hasDRAMStats()) {
-        Counter temp_access = (Counter) pkt->req->getDRAMAccess();
-        Counter temp_hit = (Counter) pkt->req->getDRAMRowHit();
-        if (temp_access <= dram_stats[0] && temp_hit <= dram_stats[1]) {
-            dram_stats[0] = temp_access;
-            dram_stats[1] = temp_hit;
-            dram_latency = pkt->req->getAccessLatency();
-            dram_ready = true;
-        }
-        DPRINTF(CacheRepl, "Cache statistics from low level memory -- DRAM access: %ld, DRAM Row Hit: %ld, Average access latency: %.4f\n", 
-                dram_stats[0], dram_stats[1], dram_latency);
-    }
-
-    if (pkt->isRequest()) {
+        LevelStats &own_stats = levelStats(_cache_level, core_id);
         // Access count
-        cache_stats[std::make_pair(_cache_level, pkt->req->contextId())].second += 1;
+        own_stats.count += 1;
         // Miss count
-        cache_stats[std::make_pair(_cache_level, pkt->req->contextId())].first += (!hit);
-    }
+        own_stats.misses += (!hit);
 
-    // The packet come from CPU should have current running cycles if it is a timing CPU
-    // CPI can get from cycles and instruction count when CPU set these two stats at the same time
-    if (pkt->isRequest() && pkt->req->hasContextId() && pkt->req->hasInstCount() && pkt->req->hasNumCycles()) {
-        cpi_stats[pkt->req->contextId()] = pkt->req->getNumCycles() / pkt->req->getInstCount();
-        DPRINTF(CacheRepl, "CPI from CPU -- CPI: %.4f\n", cpi_stats[pkt->req->contextId()]);
+        // The packet come from CPU should have current running cycles if it is a timing CPU
+        // CPI can get from cycles and instruction count when CPU set these two stats at the same time
+        if (pkt->req->hasInstCount() && pkt->req->hasNumCycles()) {
+            cpi_stats[core_id] = pkt->req->getNumCycles() / pkt->req->getInstCount();
+            DPRINTF(CacheRepl, "CPI from CPU -- CPI: %.4f\n", cpi_stats[core_id]);
+        }
     }
 
     // Aging scheme
     // If the cache line is cache-averse, RRPV should always be 7 and have the highest priority to be victim no matter which core it is
     // If the cache line is cache-friendly, RRPV should be at most 6 and it will be aged based on ratio counter for each cache access 
     // (This is different from Hawkeye since the latter only age when cache miss)
+    // The lines of all the cores whose aging counter expired are aged in a single pass over the set
+    bool any_aging = false;
     for (int i = 0; i < _num_cpus; i++) {
         if (ratio_counter[i].counter >= ratio_counter[i].ratio_max) {
-            for (const auto& candidate : candidates) {
-                std::shared_ptr<FlockHawkeyeReplData> candidate_repl_data =
-                    std::static_pointer_cast<FlockHawkeyeReplData>(
-                        candidate->replacementData);
-                // TODO: Is saturated counter support comparison?
-                if (candidate_repl_data->valid) {
-                    gem5_assert(candidate_repl_data->rrpv == 7 && !candidate_repl_data->is_cache_friendly, "Cache-averse line will always have 7 RRPV value");
-                    if (candidate_repl_data->valid && candidate_repl_data->context_id == i && candidate_repl_data->rrpv < 6) {
-                        candidate_repl_data->rrpv++;
-                    }
-                }
-            }
-            ratio_counter[i].counter = 0;   
+            aging_cores[i] = true;
+            any_aging = true;
+            ratio_counter[i].counter = 0;
         } else {
+            aging_cores[i] = false;
             ratio_counter[i].counter += 1;
         }
     }
+    if (any_aging) {
+        for (const auto& candidate : candidates) {
+            const uint32_t index = repl_state.index(candidate);
+            if (repl_state.valid[index]) {
+                gem5_assert(repl_state.value[index] == 7 && !repl_state.friendly[index], "Cache-averse line will always have 7 RRPV value");
+                const ContextID owner = repl_state.contextId[index];
+                if (owner >= 0 && owner < _num_cpus && aging_cores[owner] && repl_state.value[index] < 6) {
+                    repl_state.value[index]++;
+                    stats.agedLines[owner]++;
+                }
+            }
+        }
+    }
 
     // TODO: What's the frequency of recalculating the partition size and aging counter?
     repartition += 1;
@@ -157,12 +150,14 @@ void FlockHawkeye::access(const PacketPtr pkt, bool hit, const ReplacementCandid
         DPRINTF(CacheRepl, "Partition -- Re-partition starts\n");
         setNewPartition();   
         repartition = 0;
+        stats.repartitions++;
     }
     reaging += 1;
     if (reaging == REAGING_SIZE) {
         DPRINTF(CacheRepl, "Aging Counter -- Re-aging starts\n");
         setAgingCounter();
         reaging = 0;
+        stats.reagings++;
     }
 }
 
@@ -170,27 +165,30 @@ ReplaceableEntry* FlockHawkeye::getVictim(const ReplacementCandidates& candidate
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
+    // Scan the RRPVs in place when the ways of the set are stored consecutively
+    uint32_t first;
+    if (repl_state.contiguous(candidates, first)) {
+        return candidates[findFirstMaxRRPV(&repl_state.value[first], &repl_state.valid[first], candidates.size())];
+    }
+
     // Use first candidate as dummy victim
     ReplaceableEntry* victim = candidates[0];
 
     // Store victim->rrpv in a variable to improve code readability
-    int victim_RRPV = std::static_pointer_cast<FlockHawkeyeReplData>(
-                        victim->replacementData)->rrpv;
+    int victim_RRPV = repl_state.value[repl_state.index(victim)];
 
     // Visit all candidates to find victim
     // If there is no invalid cache line, the one with highest RRPV will be evicted
     for (const auto& candidate : candidates) {
-        std::shared_ptr<FlockHawkeyeReplData> candidate_repl_data =
-            std::static_pointer_cast<FlockHawkeyeReplData>(
-                candidate->replacementData);
+        const uint32_t index = repl_state.index(candidate);
 
         // Stop searching for victims if an invalid entry is found
-        if (!candidate_repl_data->valid) {
+        if (!repl_state.valid[index]) {
             return candidate;
         }
 
         // Update victim entry if necessary
-        int candidate_RRPV = candidate_repl_data->rrpv;
+        int candidate_RRPV = repl_state.value[index];
         if (candidate_RRPV > victim_RRPV) {
             victim = candidate;
             victim_RRPV = candidate_RRPV;
@@ -201,8 +199,7 @@ ReplaceableEntry* FlockHawkeye::getVictim(const ReplacementCandidates& candidate
 }
 
 void FlockHawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_data, const PacketPtr pkt) {
-    std::shared_ptr<FlockHawkeyeReplData> casted_replacement_data =
-        std::static_pointer_cast<FlockHawkeyeReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     // TODO: Which requests should we monitor?
     if (!pkt->isRequest() || !pkt->req->hasPC() || !pkt->req->hasContextId()) {
@@ -216,20 +213,16 @@ void FlockHawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_dat
 
     // Cache friendly line should be 0 again when being re-accessed
     // Cache averse line should always be 7
-    if (casted_replacement_data->is_cache_friendly) {
-        casted_replacement_data->rrpv.reset();
-    } else {
-        casted_replacement_data->rrpv.saturate();
-    }
-    casted_replacement_data->context_id = pkt->req->contextId();
+    repl_state.value[index] = repl_state.friendly[index] ? 0 : _max_rrpv;
+    repl_state.contextId[index] = pkt->req->contextId();
 
     int set = (pkt->getAddr() >> _log2_block_size) & ((1 << _log2_num_cache_sets) - 1);
 
     DPRINTF(CacheRepl, "Cache hit ---- Request Address: 0x%.8x, Set Index: %d, PC: 0x%.8x\n", pkt->getAddr(), set, pkt->req->getPC());
 
-    // Warning: Timestamp is 8-bit integer in this design
-    uint8_t curr_timestamp;
-    uint8_t last_timestamp;
+    // Timestamps have sampled_timestamp_bits bits
+    uint32_t curr_timestamp;
+    uint32_t last_timestamp;
     uint16_t last_PC;
 
     if (samplers[component_index]->sample(pkt->getAddr(), pkt->req->getPC(), &curr_timestamp, set, &last_PC, &last_timestamp)) {
@@ -249,13 +242,12 @@ void FlockHawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_dat
 }
 
 std::shared_ptr<ReplacementData> FlockHawkeye::instantiateEntry() {
-    return std::shared_ptr<ReplacementData>(new FlockHawkeyeReplData(_num_rrpv_bits));
+    return repl_state.instantiate();
 }
 
 void FlockHawkeye::reset(const std::shared_ptr<ReplacementData>& replacement_data, const PacketPtr pkt) {
 
-    std::shared_ptr<FlockHawkeyeReplData> casted_replacement_data =
-        std::static_pointer_cast<FlockHawkeyeReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     if (!pkt->isRequest() || !pkt->req->hasPC() || !pkt->req->hasContextId()) {
         return;
@@ -268,26 +260,20 @@ void FlockHawkeye::reset(const std::shared_ptr<ReplacementData>& replacement_dat
 
     bool is_friendly = predictors[component_index]->predict(pkt->req->getPC());
 
-    casted_replacement_data->is_cache_friendly = is_friendly;
+    repl_state.friendly[index] = is_friendly;
+    repl_state.value[index] = is_friendly ? _max_rrpv : 0;
+    repl_state.valid[index] = true;
+    repl_state.contextId[index] = pkt->req->contextId();
 
-    if (is_friendly) {
-        casted_replacement_data->rrpv.saturate();
-    } else {
-        casted_replacement_data->rrpv.reset();
-    }
-
-    casted_replacement_data->valid = true;
-    casted_replacement_data->context_id = pkt->req->contextId();
-
-    DPRINTF(CacheRepl, "Cache miss handling ---- New Cache Line: Friendliness %d RRPV: %d Valid: %d\n", casted_replacement_data->is_cache_friendly, 
-            casted_replacement_data->rrpv, casted_replacement_data->valid);
+    DPRINTF(CacheRepl, "Cache miss handling ---- New Cache Line: Friendliness %d RRPV: %d Valid: %d\n", repl_state.friendly[index],
+            repl_state.value[index], repl_state.valid[index]);
 
     int set = (pkt->getAddr() >> _log2_block_size) & ((1 << _log2_num_cache_sets) - 1);
 
     DPRINTF(CacheRepl, "Cache miss handling ---- Request Address: 0x%.8x, Set Index: %d, PC: 0x%.8x\n", pkt->getAddr(), set, pkt->req->getPC());
 
-    uint8_t curr_timestamp;
-    uint8_t last_timestamp;
+    uint32_t curr_timestamp;
+    uint32_t last_timestamp;
     uint16_t last_PC;
 
     if (samplers[component_index]->sample(pkt->getAddr(), pkt->req->getPC(), &curr_timestamp, set, &last_PC, &last_timestamp)) {
@@ -320,32 +306,32 @@ double FlockHawkeye::getCurrFCP(int core_id) {
     //  2. mr1, mr2, and mr3 can be calculated
     //  3. T2, T3, and Tdram are not quite sured (Can be fixed number or other numbers)
     // Level 0 and Level 1
-    std::pair<int, ContextID> key_l1i = std::make_pair(0, core_id);
-    std::pair<int, ContextID> key_l1d = std::make_pair(1, core_id);
-    if (cache_stats.find(key_l1i) == cache_stats.end() || cache_stats.find(key_l1d) == cache_stats.end()) {
+    const LevelStats &stats_l1i = levelStats(0, core_id);
+    const LevelStats &stats_l1d = levelStats(1, core_id);
+    if (!stats_l1i.valid || !stats_l1d.valid) {
         return -1.0;
     }
     // TODO: How to combine L1I and L1D
-    Counter misses_l1 = cache_stats[key_l1i].first + cache_stats[key_l1d].first;
-    Counter inst_l1 = std::max(cache_stats[key_l1i].second, cache_stats[key_l1d].second);
+    Counter misses_l1 = stats_l1i.misses + stats_l1d.misses;
+    Counter inst_l1 = std::max(stats_l1i.count, stats_l1d.count);
     double mr1 = ((double) misses_l1) / ((double) inst_l1);
 
     // Level 2
-    std::pair<int, ContextID> key_l2 = std::make_pair(2, core_id);
-    if (cache_stats.find(key_l2) == cache_stats.end()) {
+    const LevelStats &stats_l2 = levelStats(2, core_id);
+    if (!stats_l2.valid) {
         return -1.0;
     }
-    Counter misses_l2 = cache_stats[key_l2].first + cache_stats[key_l2].first;
-    Counter inst_l2 = cache_stats[key_l2].second;
+    Counter misses_l2 = stats_l2.misses + stats_l2.misses;
+    Counter inst_l2 = stats_l2.count;
     double mr2 = ((double) misses_l2) / ((double) inst_l2);
     
     // Level 3
-    std::pair<int, ContextID> key_l3 = std::make_pair(_cache_level, core_id);
-    if (cache_stats.find(key_l3) == cache_stats.end()) {
+    const LevelStats &stats_l3 = levelStats(_cache_level, core_id);
+    if (!stats_l3.valid) {
         return -1.0;
     }
-    Counter misses_l3 = cache_stats[key_l3].first + cache_stats[key_l3].first;
-    Counter inst_l3 = cache_stats[key_l3].second;
+    Counter misses_l3 = stats_l3.misses + stats_l3.misses;
+    Counter inst_l3 = stats_l3.count;
     double mr3 = ((double) misses_l3) / ((double) inst_l3);
 
     // DRAM
@@ -357,102 +343,170 @@ double FlockHawkeye::getCurrFCP(int core_id) {
     gem5_assert(mr2 >= mr3, "Miss rate difference can not be negative");
 
     // TODO: DRAM latency should based on epoch behavior
-    double fcp = (mr1 - mr2) * cache_latency_stats[key_l2] + (mr2 - mr3) * cache_latency_stats[key_l3] + mr3 * dram_latency;
+    double fcp = (mr1 - mr2) * stats_l2.latency + (mr2 - mr3) * stats_l3.latency + mr3 * dram_latency;
 
     DPRINTF(CacheRepl, "FCP ---- mr1: %.4f, mr2: %.4f, mr3: %.4f\n, fcp: %.4f", mr1, mr2, mr3, fcp);
-    DPRINTF(CacheRepl, "FCP ---- L2 latency: %.4f, L3 latency: %.4f, DRAM latency: %.4f\n", cache_latency_stats[key_l2], cache_latency_stats[key_l3], dram_latency);
+    DPRINTF(CacheRepl, "FCP ---- L2 latency: %.4f, L3 latency: %.4f, DRAM latency: %.4f\n", stats_l2.latency, stats_l3.latency, dram_latency);
     
     return fcp;
 }
 
-double FlockHawkeye::getProjFCP(int core_id, int partition) {
+void FlockHawkeye::getProjFCP(int core_id, std::vector<double> &proj_fcp) {
     // TODO:
     //  1. mr1, mr2 is the same as current FCP
     //  2. miss count under 10% higher partition can be linear interpolation based on current miss count, sampled projected miss count, sampled miss count
     //  3. T2, and T3 are not quite sured (Can be fixed number or other numbers)
     //  4. Tdram should based on rowhits, rowmisses, DRAM average latency, sampled projected miss count, sampled miss count, and current miss count
 
+    // The whole curve is -1 until the statistics of every level are known
+    proj_fcp.assign(_num_cache_ways + 1, -1.0);
 
     // Level 0 and Level 1
-    std::pair<int, ContextID> key_l1i = std::make_pair(0, core_id);
-    std::pair<int, ContextID> key_l1d = std::make_pair(1, core_id);
-    if (cache_stats.find(key_l1i) == cache_stats.end() || cache_stats.find(key_l1d) == cache_stats.end()) {
-        return -1.0;
+    const LevelStats &stats_l1i = levelStats(0, core_id);
+    const LevelStats &stats_l1d = levelStats(1, core_id);
+    if (!stats_l1i.valid || !stats_l1d.valid) {
+        return;
     }
     // TODO: How to combine L1I and L1D
-    Counter misses_l1 = cache_stats[key_l1i].first + cache_stats[key_l1d].first;
-    Counter inst_l1 = std::max(cache_stats[key_l1i].second, cache_stats[key_l1d].second);
+    Counter misses_l1 = stats_l1i.misses + stats_l1d.misses;
+    Counter inst_l1 = std::max(stats_l1i.count, stats_l1d.count);
     double mr1 = ((double) misses_l1) / ((double) inst_l1);
 
     // Level 2
-    std::pair<int, ContextID> key_l2 = std::make_pair(2, core_id);
-    if (cache_stats.find(key_l2) == cache_stats.end()) {
-        return -1.0;
+    const LevelStats &stats_l2 = levelStats(2, core_id);
+    if (!stats_l2.valid) {
+        return;
     }
-    Counter misses_l2 = cache_stats[key_l2].first + cache_stats[key_l2].first;
-    Counter inst_l2 = cache_stats[key_l2].second;
+    Counter misses_l2 = stats_l2.misses + stats_l2.misses;
+    Counter inst_l2 = stats_l2.count;
     double mr2 = ((double) misses_l2) / ((double) inst_l2);
     
     // Level 3
-    std::pair<int, ContextID> key_l3 = std::make_pair(_cache_level, core_id);
-    if (cache_stats.find(key_l3) == cache_stats.end()) {
-        return -1.0;
+    const LevelStats &stats_l3 = levelStats(_cache_level, core_id);
+    if (!stats_l3.valid) {
+        return;
     }
-    Counter misses_l3 = cache_stats[key_l3].first + cache_stats[key_l3].first;
-    Counter inst_l3 = cache_stats[key_l3].second;
+    Counter misses_l3 = stats_l3.misses + stats_l3.misses;
+    Counter inst_l3 = stats_l3.count;
     double mr3 = ((double) misses_l3) / ((double) inst_l3);
 
-    double frac = proj_vectors[core_id * (_num_cache_ways + 1) + partition]->get_num_opt_misses(proj_vectors[core_id * (_num_cache_ways + 1) + 
-        partition]->getCacheSize()) / opt_vectors[core_id]->get_num_opt_misses(opt_vectors[core_id]->getCacheSize());
-    double mr3_proj = frac * mr3;
-
     // DRAM
     if (!dram_ready) {
-        return -1.0;
+        return;
     }
-    // double est_miss_count = mr3_proj * misses_l3;
-    double dram_latency_proj = ((dram_stats[0] - dram_stats[1]) / dram_stats[1]) * mr3_proj * dram_latency;
-    
+
     gem5_assert(mr1 >= mr2, "Miss rate difference can not be negative");
     gem5_assert(mr2 >= mr3, "Miss rate difference can not be negative");
-    double fcp = (mr1 - mr2) * cache_latency_stats[key_l2] + (mr2 - mr3_proj) * cache_latency_stats[key_l3] + mr3_proj * dram_latency_proj;
-    
-    DPRINTF(CacheRepl, "FCP ---- mr1: %.4f, mr2: %.4f, mr3: %.4f\n, fcp: %.4f", mr1, mr2, mr3, fcp);
-    DPRINTF(CacheRepl, "FCP ---- L2 latency: %.4f, L3 latency: %.4f, DRAM latency: %.4f\n", cache_latency_stats[key_l2], cache_latency_stats[key_l3], dram_latency);
 
-    return fcp;
+    // Only the projected L3 miss rate depends on the partition
+    const double opt_misses = opt_vectors[core_id]->get_num_opt_misses(opt_vectors[core_id]->getCacheSize());
+    for (int partition = 0; partition <= _num_cache_ways; partition++) {
+        OccupencyVector &proj = *proj_vectors[core_id * (_num_cache_ways + 1) + partition];
+        double frac = proj.get_num_opt_misses(proj.getCacheSize()) / opt_misses;
+        double mr3_proj = frac * mr3;
+
+        // double est_miss_count = mr3_proj * misses_l3;
+        double dram_latency_proj = ((dram_stats[0] - dram_stats[1]) / dram_stats[1]) * mr3_proj * dram_latency;
+
+        proj_fcp[partition] = (mr1 - mr2) * stats_l2.latency + (mr2 - mr3_proj) * stats_l3.latency + mr3_proj * dram_latency_proj;
+    }
+
+    DPRINTF(CacheRepl, "FCP ---- mr1: %.4f, mr2: %.4f, mr3: %.4f\n", mr1, mr2, mr3);
+    DPRINTF(CacheRepl, "FCP ---- L2 latency: %.4f, L3 latency: %.4f, DRAM latency: %.4f\n", stats_l2.latency, stats_l3.latency, dram_latency);
 }
 
-void FlockHawkeye::setNewPartition() {
-    // TODO:
-    //  Paper: Algorithm 1 Heuristic for Scalable Partitioning
-
-    int total_credit = _num_cache_ways;
-    std::vector<int> temp_partition;
-    temp_partition.resize(_num_cpus, 0);
-    while (total_credit > 0) {
-        int max_core_id = -1;
-        double max_gain = 0.0;
-        for (int i = 0; i < _num_cpus; i++) {
-            int gain = (getProjFCP(i, temp_partition[i] + 1) - getProjFCP(i, temp_partition[0])) / cpi_stats[i];
-            if (gain > max_gain) {
-                max_gain = gain;
-                max_core_id = i;
+void FlockHawkeye::pullTelemetry() {
+    const MemTelemetry &telemetry = _system->getMemTelemetry();
+
+    // Levels above the current one are private to each core and keyed by the core id
+    for (int i = 0; i < _num_cpus; i++) {
+        for (int level = 0; level < _cache_level; level++) {
+            MemTelemetry::CacheSnapshot snapshot = telemetry.cache(level, i);
+            if (snapshot.accesses == 0) {
+                continue;
             }
+            LevelStats &entry = levelStats(level, i);
+            entry.misses = snapshot.misses;
+            entry.count = inst_count[i];
+            entry.latency = snapshot.avgAccessLatency();
+            entry.valid = true;
+            DPRINTF(CacheRepl, "Cache statistics from high level caches -- Cache level: %d, Core id: %d, Miss count: %ld, Inst count: %ld, Average access latency: %.4f\n",
+                    level, i, entry.misses, entry.count, entry.latency);
+        }
+
+        // The access latency of this cache is published by the cache itself
+        MemTelemetry::CacheSnapshot snapshot = telemetry.cache(_cache_level, i);
+        levelStats(_cache_level, i).latency = snapshot.avgAccessLatency();
+    }
+
+    MemTelemetry::DRAMSnapshot dram = telemetry.dramStats();
+    if (dram.bursts != 0) {
+        dram_stats[0] = dram.bursts;
+        dram_stats[1] = dram.rowHits;
+        dram_latency = dram.avgAccessLatency();
+        dram_ready = true;
+    }
+    DPRINTF(CacheRepl, "Cache statistics from low level memory -- DRAM access: %ld, DRAM Row Hit: %ld, Average access latency: %.4f\n",
+            dram_stats[0], dram_stats[1], dram_latency);
+}
+
+FlockHawkeye::PartitionSnapshot FlockHawkeye::takePartitionSnapshot() {
+    PartitionSnapshot snapshot;
+    snapshot.proj_fcp.resize(_num_cpus);
+    for (int i = 0; i < _num_cpus; i++) {
+        getProjFCP(i, snapshot.proj_fcp[i]);
+        snapshot.curr_fcp.push_back(getCurrFCP(i));
+    }
+    snapshot.cpi = cpi_stats;
+    return snapshot;
+}
+
+FlockHawkeye::PartitionDecision FlockHawkeye::solvePartition(const PartitionSnapshot &snapshot, int num_ways) {
+    // Paper: Algorithm 1 Heuristic for Scalable Partitioning, with the allocation done by UCP lookahead
+    // The cost of a core is its projected FCP weighted by its CPI; cores whose FCP is not known yet have a flat curve
+    const int num_cpus = snapshot.proj_fcp.size();
+    std::vector<std::vector<double>> cost(num_cpus, std::vector<double>(num_ways + 1, 0.0));
+    for (int i = 0; i < num_cpus; i++) {
+        const std::vector<double> &proj_fcp = snapshot.proj_fcp[i];
+        if (std::any_of(proj_fcp.begin(), proj_fcp.end(), [](double fcp) { return fcp < 0; })) {
+            continue;
+        }
+        const double cpi = snapshot.cpi[i] > 0 ? snapshot.cpi[i] : 1.0;
+        for (int ways = 0; ways <= num_ways; ways++) {
+            cost[i][ways] = proj_fcp[ways] / cpi;
         }
-        
-        gem5_assert(max_core_id != 1, "If there is partition budget, it should be dispatched");
-        temp_partition[max_core_id] = temp_partition[max_core_id] + std::floor(0.1 * _num_cache_ways);
-        total_credit = total_credit - std::floor(0.1 * _num_cache_ways);
     }
 
-    curr_partition = std::move(temp_partition);
+    PartitionDecision decision;
+    decision.partition = lookaheadPartition(cost, num_ways);
+    decision.curr_fcp = snapshot.curr_fcp;
+    for (int i = 0; i < num_cpus; i++) {
+        decision.proj_fcp.push_back(snapshot.proj_fcp[i][decision.partition[i]]);
+    }
+    return decision;
+}
+
+void FlockHawkeye::applyPartition(const PartitionDecision &decision) {
+    curr_partition = decision.partition;
 
     for (int i = 0; i < _num_cpus; i++) {
         opt_vectors[i]->setCacheSize(curr_partition[i]);
+        stats.partition[i] = curr_partition[i];
+        stats.currFCP[i] = decision.curr_fcp[i];
+        stats.projFCP[i] = decision.proj_fcp[i];
+        DPRINTF(CacheRepl, "Partition -- Core %d: %d ways, projected FCP: %.4f\n", i, curr_partition[i], decision.proj_fcp[i]);
     }
 }
 
+void FlockHawkeye::setNewPartition() {
+    // Statistics from the rest of the memory system only need to be as fresh as the partitioning epoch
+    pullTelemetry();
+
+    // The snapshot reads each level once per core, and the solver is linear in the number of ways per core, so the
+    // partition is decided and applied right at the epoch boundary
+    applyPartition(solvePartition(takePartitionSnapshot(), _num_cache_ways));
+}
+
 void FlockHawkeye::setAgingCounter() {
     // TODO:
     //  Based on different cache access, set the aging counter
@@ -460,23 +514,40 @@ void FlockHawkeye::setAgingCounter() {
     Counter min_access = 0;
 
     for (int i = 0; i < _num_cpus; i++) {
-        std::pair<int, ContextID> key = std::make_pair(_cache_level, i);
-        if (cache_stats[key].second != 0 && cache_stats[key].second > min_access) {
+        const Counter accesses = levelStats(_cache_level, i).count;
+        if (accesses != 0 && accesses > min_access) {
             min_access_idx = i;
-            min_access = cache_stats[key].second;
+            min_access = accesses;
         }
     }
 
     if (min_access_idx != -1) {
         for (int i = 0; i < _num_cpus; i++) {
-            std::pair<int, ContextID> key = std::make_pair(_cache_level, i);
-            if (cache_stats[key].second != 0) {
-                ratio_counter[i].ratio_max = cache_stats[key].second / min_access - 1;
+            const Counter accesses = levelStats(_cache_level, i).count;
+            if (accesses != 0) {
+                ratio_counter[i].ratio_max = accesses / min_access - 1;
                 gem5_assert(ratio_counter[i].ratio_max >= 0, "Ratio counter cannot be negative");
             }
+            stats.agingRatio[i] = ratio_counter[i].ratio_max;
         }
     }
 }
 
+FlockHawkeye::FlockHawkeyeStats::FlockHawkeyeStats(statistics::Group *parent, int num_cpus)
+    : statistics::Group(parent),
+      ADD_STAT(partition, statistics::units::Count::get(), "Ways given to each core by the last repartitioning"),
+      ADD_STAT(currFCP, statistics::units::Tick::get(), "Fetch cost of each core when the partition was decided"),
+      ADD_STAT(projFCP, statistics::units::Tick::get(), "Projected fetch cost of each core under its partition"),
+      ADD_STAT(agingRatio, statistics::units::Count::get(), "Accesses between two agings of each core's lines"),
+      ADD_STAT(agedLines, statistics::units::Count::get(), "Cache-friendly lines aged, per owner core"),
+      ADD_STAT(repartitions, statistics::units::Count::get(), "Number of repartitioning epochs"),
+      ADD_STAT(reagings, statistics::units::Count::get(), "Number of aging counter updates") {
+    partition.init(num_cpus);
+    currFCP.init(num_cpus);
+    projFCP.init(num_cpus);
+    agingRatio.init(num_cpus);
+    agedLines.init(num_cpus);
+}
+
 } // namespace replacement_policy
 } // namespace gem5
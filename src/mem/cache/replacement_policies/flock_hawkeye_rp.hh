@@ -8,11 +8,12 @@
 #define __MEM_CACHE_REPLACEMENT_POLICIES_HAWKEYE_RP_HH__
 
 #include <vector>
-#include <map>
 
 #include "base/sat_counter.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/flat_repl_state.hh"
 #include "mem/cache/tags/hawkeye_sampler.hh"
 
 namespace gem5
@@ -32,32 +33,6 @@ namespace replacement_policy
 class FlockHawkeye : public Base
 {
   protected:
-    struct FlockHawkeyeReplData : ReplacementData
-    {
-        /**
-         * Re-Reference Interval Prediction Value.
-         * 0 -> cache friently (hit, miss)
-         * max_RRPV-1 -> cache-averse (hit, miss)
-         * RRPV value will be aged when cache miss occurs on a cache friendly line
-         *
-         * Allow multiple max_RRPV-1 to exist and will choose based on the index of the cache line
-         */
-        SatCounter8 rrpv;
-
-        /** Cacheline type */
-        bool is_cache_friendly;
-
-        /** Whether the entry is valid. */
-        bool valid;
-
-        int context_id;
-
-        /**
-         * Default constructor. Invalidate data.
-         */
-        FlockHawkeyeReplData(const int num_bits) : rrpv(num_bits), is_cache_friendly(false), valid(false), context_id(0) {}
-    };
-
     struct RatioCounter {
       int counter;
 
@@ -66,6 +41,68 @@ class FlockHawkeye : public Base
       RatioCounter() : counter(0), ratio_max(0) {}
     };
 
+    /** Statistics of one cache level as seen by one core */
+    struct LevelStats {
+      Counter misses;
+
+      /** Accesses for the cache using Flock, instructions for the levels above it */
+      Counter count;
+
+      /** Average access latency */
+      double latency;
+
+      /** Whether the statistics of this level have been received yet */
+      bool valid;
+
+      LevelStats() : misses(0), count(0), latency(0), valid(false) {}
+    };
+
+    /** Per-core cost curves taken at the end of a partitioning epoch */
+    struct PartitionSnapshot {
+      /** Projected FCP of each core for every way count, -1 if unknown */
+      std::vector<std::vector<double>> proj_fcp;
+
+      std::vector<double> curr_fcp;
+
+      std::vector<double> cpi;
+    };
+
+    /** Outcome of solving a snapshot */
+    struct PartitionDecision {
+      std::vector<int> partition;
+
+      std::vector<double> curr_fcp;
+
+      /** Projected FCP of each core under its new partition */
+      std::vector<double> proj_fcp;
+    };
+
+    static PartitionDecision solvePartition(const PartitionSnapshot &snapshot, int num_ways);
+
+    struct FlockHawkeyeStats : public statistics::Group
+    {
+        FlockHawkeyeStats(statistics::Group *parent, int num_cpus);
+
+        /** Ways given to each core by the last repartitioning */
+        statistics::Vector partition;
+
+        /** FCP of each core when the partition was decided */
+        statistics::Vector currFCP;
+
+        /** Projected FCP of each core under the partition it was given */
+        statistics::Vector projFCP;
+
+        /** Number of accesses between two agings of each core's lines */
+        statistics::Vector agingRatio;
+
+        /** Number of cache-friendly lines aged, per owner core */
+        statistics::Vector agedLines;
+
+        statistics::Scalar repartitions;
+
+        statistics::Scalar reagings;
+    } stats;
+
   public:
     typedef FlockHawkeyeRPParams Params;
     FlockHawkeye(const Params &p);
@@ -98,19 +135,38 @@ class FlockHawkeye : public Base
 
     const int _cache_level;
 
+    /** System whose memory telemetry feeds the partitioning */
+    const System *_system;
+
+    /** Maximum RRPV value */
+    const uint8_t _max_rrpv;
+
+    /**
+     * Re-Reference Interval Prediction Value, friendliness, validity and owner of every cache line.
+     * 0 -> cache friently (hit, miss)
+     * max_RRPV-1 -> cache-averse (hit, miss)
+     * RRPV value will be aged when cache miss occurs on a cache friendly line
+     *
+     * Allow multiple max_RRPV-1 to exist and will choose based on the index of the cache line
+     */
+    mutable FlatReplState<uint8_t> repl_state;
+
     // TODO: All per core infomation should be the same replacement policy class
     std::vector<RatioCounter> ratio_counter;
 
+    /** Cores whose lines are aged on the current access */
+    std::vector<uint8_t> aging_cores;
+
     // Partition budget
     std::vector<int> curr_partition; 
 
-    /** Cache level + CPU id -> Cache miss count + Inst count*/
-    std::map<std::pair<int, ContextID>, std::pair<Counter, Counter>> cache_stats;
+    /** Cache level + CPU id -> Miss count, Inst count, access latency; indexed by level * num_cpus + CPU id */
+    std::vector<LevelStats> level_stats;
 
-    /** Cache level access latency + Number of cycles */
-    std::map<std::pair<int, ContextID>, double> cache_latency_stats;
+    std::vector<double> cpi_stats;
 
-    std::map<ContextID, double> cpi_stats;
+    /** Latest instruction count seen from each core */
+    std::vector<Counter> inst_count;
 
     Counter repartition;
 
@@ -122,9 +178,21 @@ class FlockHawkeye : public Base
 
     bool dram_ready = false;
 
+    /** Refresh the statistics of other cache levels and DRAM from the memory telemetry */
+    void pullTelemetry();
+
+    LevelStats &levelStats(int level, ContextID core_id) {
+      return level_stats[level * _num_cpus + core_id];
+    }
+
     double getCurrFCP(int core_id); 
 
-    double getProjFCP(int core_id, int partition);
+    /** Projected FCP of a core for every way count, -1 if unknown */
+    void getProjFCP(int core_id, std::vector<double> &proj_fcp);
+
+    PartitionSnapshot takePartitionSnapshot();
+
+    void applyPartition(const PartitionDecision &decision);
 
     void setNewPartition();
 
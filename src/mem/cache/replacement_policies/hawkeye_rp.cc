@@ -1,6 +1,7 @@
 #include "mem/cache/replacement_policies/hawkeye_rp.hh"
 
 #include "base/logging.hh"
+#include "mem/cache/replacement_policies/victim_kernel.hh"
 #include "params/HawkeyeRP.hh"
 
 namespace gem5
@@ -12,7 +13,9 @@ namespace replacement_policy
 
 
 Hawkeye::Hawkeye(const Params &p) : Base(p), _num_rrpv_bits(p.num_rrpv_bits), _log2_block_size((int) std::log2(p.cache_block_size)), _log2_num_cache_sets((int) std::log2(p.num_cache_sets)),
-                                    _num_cpus(p.num_cpus), _num_cache_ways(p.num_cache_ways), _cache_level(p.cache_level) {
+                                    _num_cpus(p.num_cpus), _num_cache_ways(p.num_cache_ways), _cache_level(p.cache_level), _max_rrpv((1 << p.num_rrpv_bits) - 1) {
+    fatal_if(p.num_rrpv_bits > 8, "RRPVs are stored in a byte");
+
     // Paramters:
     //  1. num_rrpv_bits (RRPV bits)
     //  2. num_cache_sets (Number of target cache sets)
@@ -24,7 +27,8 @@ Hawkeye::Hawkeye(const Params &p) : Base(p), _num_rrpv_bits(p.num_rrpv_bits), _l
     //  8. num_sampled_sets (Number of sets in sampled cache)
     //  9. timer_size (The size of timer for recording current timestamp)
 
-    sampler = std::make_unique<HistorySampler>(p.num_sampled_sets, p.num_cache_sets, p.cache_block_size, p.timer_size);
+    sampler = HistorySampler::create(p.num_sampled_sets, p.num_cache_sets, p.cache_block_size, p.timer_size,
+                                     p.num_sampled_ways, p.sampled_tag_bits, p.sampled_timestamp_bits);
     predictor = std::make_unique<PCBasedPredictor>(p.num_pred_entries, p.num_pred_bits);
     for (int i = 0; i < p.num_cache_sets; i++) {
         opt_vector.push_back(std::make_unique<OccupencyVector>(p.num_cache_ways, p.optgen_vector_size));
@@ -38,14 +42,13 @@ Hawkeye::Hawkeye(const Params &p) : Base(p), _num_rrpv_bits(p.num_rrpv_bits), _l
 
 void Hawkeye::invalidate(const std::shared_ptr<ReplacementData> &replacement_data)
 {
-    std::shared_ptr<HawkeyeReplData> casted_replacement_data =
-        std::static_pointer_cast<HawkeyeReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     // Invalidate entry
 
     // TODO: If it is sampled cache line, then that cache line should be invalidated also.
-    casted_replacement_data->valid = false;
-    casted_replacement_data->is_cache_friendly = false;
+    repl_state.valid[index] = false;
+    repl_state.friendly[index] = false;
 }
 
 void Hawkeye::access(const PacketPtr pkt, bool hit, const ReplacementCandidates& candidates) {}
@@ -54,28 +57,35 @@ ReplaceableEntry* Hawkeye::getVictim(const ReplacementCandidates& candidates) co
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
+    // Scan the RRPVs in place when the ways of the set are stored consecutively
+    uint32_t first;
+    if (repl_state.contiguous(candidates, first)) {
+        int way = findFirstMaxRRPV(&repl_state.value[first], &repl_state.valid[first], candidates.size());
+        if (repl_state.valid[first + way]) {
+            ageFriendlyRRPV(&repl_state.value[first], &repl_state.valid[first], &repl_state.friendly[first], candidates.size(), 6);
+        }
+        return candidates[way];
+    }
+
     // Use first candidate as dummy victim
     ReplaceableEntry* victim = candidates[0];
 
     // Store victim->rrpv in a variable to improve code readability
-    int victim_RRPV = std::static_pointer_cast<HawkeyeReplData>(
-                        victim->replacementData)->rrpv;
+    int victim_RRPV = repl_state.value[repl_state.index(victim)];
 
     // Visit all candidates to find victim
     // If there is no invalid cache line, the one with highest RRPV will be evicted
     // TODO: Bypass cache should be possible (return nullptr)
     for (const auto& candidate : candidates) {
-        std::shared_ptr<HawkeyeReplData> candidate_repl_data =
-            std::static_pointer_cast<HawkeyeReplData>(
-                candidate->replacementData);
+        const uint32_t index = repl_state.index(candidate);
 
         // Stop searching for victims if an invalid entry is found
-        if (!candidate_repl_data->valid) {
+        if (!repl_state.valid[index]) {
             return candidate;
         }
 
         // Update victim entry if necessary
-        int candidate_RRPV = candidate_repl_data->rrpv;
+        int candidate_RRPV = repl_state.value[index];
         if (candidate_RRPV > victim_RRPV) {
             victim = candidate;
             victim_RRPV = candidate_RRPV;
@@ -84,22 +94,19 @@ ReplaceableEntry* Hawkeye::getVictim(const ReplacementCandidates& candidates) co
 
     // Update RRPV of all candidates
     for (const auto& candidate : candidates) {
-        std::shared_ptr<HawkeyeReplData> temp =
-            std::static_pointer_cast<HawkeyeReplData>(candidate->replacementData);
-        // TODO: Is saturated counter support comparison?
+        const uint32_t index = repl_state.index(candidate);
         // TODO: Hard code 3-bit RRPV here
-        if (temp->valid && temp->is_cache_friendly && temp->rrpv < 6) {
-            temp->rrpv++;
+        if (repl_state.valid[index] && repl_state.friendly[index] && repl_state.value[index] < 6) {
+            repl_state.value[index]++;
         }
-        panic_if(temp->rrpv > 6 && temp->is_cache_friendly, "Friendly cache should never be the maximum value of RRPV (6)");
+        panic_if(repl_state.value[index] > 6 && repl_state.friendly[index], "Friendly cache should never be the maximum value of RRPV (6)");
     }
 
     return victim;
 }
 
 void Hawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_data, const PacketPtr pkt) {
-    std::shared_ptr<HawkeyeReplData> casted_replacement_data =
-        std::static_pointer_cast<HawkeyeReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     // TODO: Which requests should we monitor?
     if (!pkt->isRequest() || !pkt->req->hasPC() || !pkt->req->hasContextId()) {
@@ -110,20 +117,16 @@ void Hawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_data, co
 
     DPRINTF(HawkeyeReplDebug, "Cache hit ---- Packet type having PC: %s\n", pkt->cmdString());
 
-    if (casted_replacement_data->is_cache_friendly) {
-        casted_replacement_data->reset();
-    } else {
-        casted_replacement_data->saturate();
-    }
-    casted_replacement_data->context_id = pkt->req->contextId();
+    repl_state.value[index] = repl_state.friendly[index] ? 0 : _max_rrpv;
+    repl_state.contextId[index] = pkt->req->contextId();
 
     int set = (pkt->getAddr() >> _log2_block_size) & ((1 << _log2_num_cache_sets) - 1);
 
     DPRINTF(HawkeyeReplDebug, "Cache hit ---- Request Address: 0x%.8x, Set Index: %d, PC: 0x%.8x\n", pkt->getAddr(), set, pkt->req->getPC());
 
-    // Warning: Timestamp is 8-bit integer in this design
-    uint8_t curr_timestamp = 0;
-    uint8_t last_timestamp = 0;
+    // Timestamps have sampled_timestamp_bits bits
+    uint32_t curr_timestamp = 0;
+    uint32_t last_timestamp = 0;
     uint16_t last_PC = 0;
 
     if (sampler->sample(pkt->getAddr(), pkt->req->getPC(), &curr_timestamp, set, &last_PC, &last_timestamp)) {
@@ -139,13 +142,12 @@ void Hawkeye::touch(const std::shared_ptr<ReplacementData>& replacement_data, co
 }
 
 std::shared_ptr<ReplacementData> Hawkeye::instantiateEntry() {
-    return std::shared_ptr<ReplacementData>(new HawkeyeReplData(_num_rrpv_bits));
+    return repl_state.instantiate();
 }
 
 void Hawkeye::reset(const std::shared_ptr<ReplacementData>& replacement_data, const PacketPtr pkt) {
 
-    std::shared_ptr<HawkeyeReplData> casted_replacement_data =
-        std::static_pointer_cast<HawkeyeReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     if (!pkt->isResponse() || !pkt->req->hasPC() || !pkt->req->hasContextId()) {
         DPRINTF(HawkeyeReplDebug, "Cache miss (Packet not valid for further action) ---- Request: %d, PC %d, Context ID: %d\n", pkt->isRequest(), pkt->req->hasPC(), pkt->req->hasContextId());
@@ -157,26 +159,20 @@ void Hawkeye::reset(const std::shared_ptr<ReplacementData>& replacement_data, co
 
     bool is_friendly = predictor->predict(pkt->req->getPC());
 
-    casted_replacement_data->is_cache_friendly = is_friendly;
-
-    if (is_friendly) {
-        casted_replacement_data->reset();
-    } else {
-        casted_replacement_data->saturate();        
-    }
-
-    casted_replacement_data->valid = true;
-    casted_replacement_data->context_id = pkt->req->contextId();
+    repl_state.friendly[index] = is_friendly;
+    repl_state.value[index] = is_friendly ? 0 : _max_rrpv;
+    repl_state.valid[index] = true;
+    repl_state.contextId[index] = pkt->req->contextId();
 
-    DPRINTF(HawkeyeReplDebug, "Cache miss handling ---- New Cache Line: Friendliness %d RRPV: %d Valid: %d\n", casted_replacement_data->is_cache_friendly, 
-            casted_replacement_data->rrpv, casted_replacement_data->valid);
+    DPRINTF(HawkeyeReplDebug, "Cache miss handling ---- New Cache Line: Friendliness %d RRPV: %d Valid: %d\n", repl_state.friendly[index],
+            repl_state.value[index], repl_state.valid[index]);
 
     int set = (pkt->getAddr() >> _log2_block_size) & ((1 << _log2_num_cache_sets) - 1);
 
     DPRINTF(HawkeyeReplDebug, "Cache miss handling ---- Request Address: 0x%.8x, Set Index: %d, PC: 0x%.8x\n", pkt->getAddr(), set, pkt->req->getPC());
 
-    uint8_t curr_timestamp = 0;
-    uint8_t last_timestamp = 0;
+    uint32_t curr_timestamp = 0;
+    uint32_t last_timestamp = 0;
     uint16_t last_PC = 0;
 
     if (sampler->sample(pkt->getAddr(), pkt->req->getPC(), &curr_timestamp, set, &last_PC, &last_timestamp)) {
@@ -10,6 +10,7 @@
 #include "base/sat_counter.hh"
 #include "base/types.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/flat_repl_state.hh"
 #include "mem/cache/tags/hawkeye_sampler.hh"
 #include "base/trace.hh"
 #include "debug/HawkeyeReplDebug.hh"
@@ -26,42 +27,6 @@ namespace replacement_policy
 class Hawkeye : public Base
 {
   protected:
-    struct HawkeyeReplData : ReplacementData
-    {
-        /**
-         * Re-Reference Interval Prediction Value.
-         * 0 -> cache friently (hit, miss)
-         * max_RRPV-1 -> cache-averse (hit, miss)
-         * RRPV value will be aged when cache miss occurs on a cache friendly line
-         *
-         * Allow multiple max_RRPV-1 to exist and will choose based on the index of the cache line
-         */
-        int rrpv;
-
-        int max_rrpv;
-
-        /** Cacheline type */
-        bool is_cache_friendly;
-
-        /** Whether the entry is valid. */
-        bool valid;
-
-        int context_id;
-
-        void saturate() {
-          rrpv = max_rrpv;
-        }
-
-        void reset() {
-          rrpv = 0;
-        }
-
-        /**
-         * Default constructor. Invalidate data.
-         */
-        HawkeyeReplData(const int num_bits) : rrpv(0), max_rrpv((1 << num_bits) - 1), is_cache_friendly(false), valid(false), context_id(0) {}
-    };
-
     struct RatioCounter {
       int counter;
 
@@ -99,6 +64,19 @@ class Hawkeye : public Base
 
     const int _cache_level;
 
+    /** Maximum RRPV value */
+    const uint8_t _max_rrpv;
+
+    /**
+     * Re-Reference Interval Prediction Value, friendliness, validity and owner of every cache line.
+     * 0 -> cache friently (hit, miss)
+     * max_RRPV-1 -> cache-averse (hit, miss)
+     * RRPV value will be aged when cache miss occurs on a cache friendly line
+     *
+     * Allow multiple max_RRPV-1 to exist and will choose based on the index of the cache line
+     */
+    mutable FlatReplState<uint8_t> repl_state;
+
     void access(const PacketPtr pkt, bool hit, const ReplacementCandidates& candidates) override;
 
     /**
@@ -1,5 +1,6 @@
 #include "mem/cache/replacement_policies/mockingjay_rp.hh"
 #include "base/logging.hh" // For fatal_if
+#include "mem/cache/replacement_policies/victim_kernel.hh"
 #include "params/MockingjayRP.hh"
 #include "debug/MockingjayDebug.hh"
 
@@ -22,9 +23,13 @@ namespace replacement_policy
  *    9. timer_size (Number of bits for timestamp)
  *    10. cache_partition_on (Enable cache parition enforcement mechanism)
  */
-Mockingjay::Mockingjay(const Params &p) : Base(p), _num_etr_bits(p.num_etr_bits) {
-    sampled_cache = std::make_unique<SampledCache>(p.num_sampled_sets, p.num_cache_sets, p.cache_block_size, p.timer_size, p.num_cpus, p.num_internal_sampled_sets);
-    predictor = std::make_unique<ReuseDistPredictor>(p.num_pred_entries, p.num_pred_bits, p.num_clock_bits, p.num_cpus);
+Mockingjay::Mockingjay(const Params &p) : Base(p), _num_etr_bits(p.num_etr_bits), _abs_max_etr((1 << (p.num_etr_bits - 1)) - 1) {
+    fatal_if(p.num_etr_bits > 8, "ETRs are stored in a byte");
+
+    sampled_cache = SampledCache::create(p.num_sampled_sets, p.num_cache_sets, p.cache_block_size, p.timer_size, p.num_cpus, p.num_internal_sampled_sets,
+                                         p.num_sampled_ways, p.sampled_tag_bits, p.sampled_timestamp_bits);
+    predictor = std::make_unique<ReuseDistPredictor>(p.num_pred_entries, p.num_pred_bits, p.num_clock_bits, p.num_cpus,
+                                                     sampled_cache->getTimestampPeriod());
     age_ctr.resize(p.num_cache_sets, 0);
     _log2_block_size = (int) std::log2(p.cache_block_size);
     _log2_num_cache_sets = (int) std::log2(p.num_cache_sets);
@@ -39,40 +44,58 @@ Mockingjay::Mockingjay(const Params &p) : Base(p), _num_etr_bits(p.num_etr_bits)
 
 void Mockingjay::invalidate(const std::shared_ptr<ReplacementData> &replacement_data)
 {
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     // Invalidate entry
     // TODO: If it is sampled cache line, then that cache line should be invalidated also.
-    casted_replacement_data->valid = false;
-    casted_replacement_data->etr = 0;
+    repl_state.valid[index] = false;
+    repl_state.value[index] = 0;
+}
+
+void Mockingjay::aging(const ReplacementCandidates& candidates) {
+    uint32_t first;
+    if (repl_state.contiguous(candidates, first)) {
+        ageETR(&repl_state.value[first], candidates.size(), _abs_max_etr);
+        return;
+    }
+
+    for (const auto &candidate : candidates) {
+        int8_t &etr = repl_state.value[repl_state.index(candidate)];
+        if (std::abs(etr) < _abs_max_etr) {
+            etr -= 1;
+        }
+    }
 }
 
 ReplaceableEntry* Mockingjay::getVictim(const ReplacementCandidates& candidates) const {
     // There must be at least one replacement candidate
     assert(candidates.size() > 0);
 
+    // Scan the ETRs in place when the ways of the set are stored consecutively
+    uint32_t first;
+    if (repl_state.contiguous(candidates, first)) {
+        return candidates[findETRVictim(&repl_state.value[first], &repl_state.valid[first], candidates.size())];
+    }
+
     // Use first candidate as dummy victim
     ReplaceableEntry* victim = candidates[0];
 
     // Store victim->etr in a variable to improve code readability
-    int victim_etr = std::static_pointer_cast<MockingjayReplData>(victim->replacementData)->etr;
+    int victim_etr = repl_state.value[repl_state.index(victim)];
     int abs_victim_etr = std::abs(victim_etr);
 
     // Visit all candidates to find victim
     for (const auto& candidate : candidates) {
-        std::shared_ptr<MockingjayReplData> candidate_repl_data =
-            std::static_pointer_cast<MockingjayReplData>(
-                candidate->replacementData);
+        const uint32_t index = repl_state.index(candidate);
 
         // Stop searching for victims if an invalid entry is found
-        if (!candidate_repl_data->valid) {
+        if (!repl_state.valid[index]) {
             return candidate;
         }
 
         // Update victim entry if necessary
         // Choose the one with maximum reuse distance (ETR allow negative value to avoid cache line s)
-        int candidate_etr = candidate_repl_data->etr;
+        int candidate_etr = repl_state.value[index];
         int abs_candidate_etr = std::abs(candidate_etr);
         if (abs_candidate_etr > abs_victim_etr || ((abs_candidate_etr == abs_victim_etr) && (candidate_etr < 0))) {
             victim = candidate;
@@ -85,8 +108,7 @@ ReplaceableEntry* Mockingjay::getVictim(const ReplacementCandidates& candidates)
 }
 
 void Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data, const PacketPtr pkt, const ReplacementCandidates& candidates) {
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
 
     // TODO: Which requests should we monitor?
     if (!pkt->isRequest() || !pkt->req->hasPC() || !pkt->req->hasContextId()) {
@@ -100,9 +122,9 @@ void Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data,
 
     DPRINTF(MockingjayDebug, "Cache hit ---- Request Address: 0x%.8x, Set Index: %d, PC: 0x%.8x\n", pkt->getAddr(), set, pkt->req->getPC());
 
-    // Warning: Timestamp is 8-bit integer in this design
-    uint8_t curr_timestamp = 0;
-    uint8_t last_timestamp = 0;
+    // Timestamps have sampled_timestamp_bits bits
+    uint32_t curr_timestamp = 0;
+    uint32_t last_timestamp = 0;
     uint16_t last_PC = 0;
     bool evict = false;
     bool sample_hit = false;
@@ -124,25 +146,19 @@ void Mockingjay::touch(const std::shared_ptr<ReplacementData>& replacement_data,
     } else {
         age_ctr[set] = 0;
 
-        for (const auto &candidate : candidates) {
-            std::shared_ptr<MockingjayReplData> candidate_repl_data =
-                std::static_pointer_cast<MockingjayReplData>(
-                    candidate->replacementData);
-            candidate_repl_data->aging();
-        }
+        aging(candidates);
     }
-    casted_replacement_data->etr = predictor->predict(pkt->req->getPC(), true, pkt->req->contextId(), casted_replacement_data->abs_max_etr);
-    DPRINTF(MockingjayDebug, "Cache hit ---- ETR update: %d, INF_ETR: %d\n", casted_replacement_data->etr, casted_replacement_data->abs_max_etr);
+    repl_state.value[index] = predictor->predict(pkt->req->getPC(), true, pkt->req->contextId(), _abs_max_etr);
+    DPRINTF(MockingjayDebug, "Cache hit ---- ETR update: %d, INF_ETR: %d\n", repl_state.value[index], _abs_max_etr);
 }
 
 std::shared_ptr<ReplacementData> Mockingjay::instantiateEntry() {
-    return std::shared_ptr<ReplacementData>(new MockingjayReplData(_num_etr_bits));
+    return repl_state.instantiate();
 }
 
 void Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data, const PacketPtr pkt, const ReplacementCandidates& candidates) {
     
-    std::shared_ptr<MockingjayReplData> casted_replacement_data =
-        std::static_pointer_cast<MockingjayReplData>(replacement_data);
+    const uint32_t index = repl_state.index(replacement_data);
     
     // TODO: Which requests should we monitor?
     if (!pkt->isResponse() || !pkt->req->hasPC() || !pkt->req->hasContextId()) {
@@ -150,7 +166,7 @@ void Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data,
     }
 
     // ETR for replacement_data should be the maximum absolute value in the whole set
-    if (predictor->bypass(pkt->req->getPC(), casted_replacement_data->etr, false, pkt->req->contextId(), casted_replacement_data->valid)) {
+    if (predictor->bypass(pkt->req->getPC(), repl_state.value[index], false, pkt->req->contextId(), repl_state.valid[index])) {
         DPRINTF(MockingjayDebug, "Cache miss ---- Bypass cache: PC: 0x%.8x\n", pkt->req->getPC());
         return;
     }
@@ -162,9 +178,9 @@ void Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data,
 
     DPRINTF(MockingjayDebug, "Cache miss ---- Request Address: 0x%.8x, Set Index: %d, PC: 0x%.8x\n", pkt->getAddr(), set, pkt->req->getPC());
 
-    // Warning: Timestamp is 8-bit integer in this design
-    uint8_t curr_timestamp = 0;
-    uint8_t last_timestamp = 0;
+    // Timestamps have sampled_timestamp_bits bits
+    uint32_t curr_timestamp = 0;
+    uint32_t last_timestamp = 0;
     uint16_t last_PC = 0;
     bool evict = false;
     bool sample_hit = false;
@@ -186,18 +202,13 @@ void Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data,
     } else {
         age_ctr[set] = 0;
 
-        for (const auto &candidate : candidates) {
-            std::shared_ptr<MockingjayReplData> candidate_repl_data =
-                std::static_pointer_cast<MockingjayReplData>(
-                    candidate->replacementData);
-            candidate_repl_data->aging();
-        }
+        aging(candidates);
     }
 
     // replacement status update
-    casted_replacement_data->etr = predictor->predict(pkt->getAddr(), false, pkt->req->contextId(), casted_replacement_data->abs_max_etr);
-    DPRINTF(MockingjayDebug, "Cache miss ---- ETR update: %d, INF_ETR: %d\n", casted_replacement_data->etr, casted_replacement_data->abs_max_etr);
-    casted_replacement_data->valid = true;
+    repl_state.value[index] = predictor->predict(pkt->getAddr(), false, pkt->req->contextId(), _abs_max_etr);
+    DPRINTF(MockingjayDebug, "Cache miss ---- ETR update: %d, INF_ETR: %d\n", repl_state.value[index], _abs_max_etr);
+    repl_state.valid[index] = true;
 }
 
 void Mockingjay::reset(const std::shared_ptr<ReplacementData>& replacement_data) const {
@@ -10,6 +10,7 @@
 #include "base/sat_counter.hh"
 #include "base/types.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/flat_repl_state.hh"
 #include "mem/cache/tags/mockingjay_sampler.hh"
 
 namespace gem5
@@ -23,33 +24,6 @@ namespace replacement_policy
 
 class Mockingjay : public Base
 {
-  protected:
-    struct MockingjayReplData : ReplacementData
-    {
-        /**
-         * ETR Value
-         * 
-         * TODO: More detail comments
-         */
-        int8_t etr;
-
-        const int abs_max_etr;
-
-        /** Whether the entry is valid. */
-        bool valid;
-
-        void aging() {
-          if (std::abs(etr) < abs_max_etr) {
-            etr -= 1;
-          }
-        }
-
-        /**
-         * Default constructor. Invalidate data.
-         */
-        MockingjayReplData(const int num_bits) : etr(0), abs_max_etr((1 << (num_bits - 1)) - 1), valid(false) {}
-    };
-
   public:
     typedef MockingjayRPParams Params;
     Mockingjay(const Params &p);
@@ -64,6 +38,15 @@ class Mockingjay : public Base
     /** Number of bits of ETR counter */
     const int _num_etr_bits;
 
+    /** Maximum absolute value of ETR counter */
+    const int _abs_max_etr;
+
+    /**
+     * ETR value and validity of every cache line.
+     * ETR allows negative values for the lines whose reuse is overdue.
+     */
+    FlatReplState<int8_t> repl_state;
+
     /** Clock age counter for each set */
     std::vector<uint8_t> age_ctr;
 
@@ -76,6 +59,9 @@ class Mockingjay : public Base
     /** Numer of bits of aging clock */
     int _num_clock_bits;
 
+    /** Age the ETR of all the lines of a set */
+    void aging(const ReplacementCandidates& candidates);
+
     /**
      * Invalidate replacement data to set it as the next probable victim.
      *
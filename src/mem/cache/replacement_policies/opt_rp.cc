@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/opt_rp.hh"
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/cache/trace/trace_probe.hh"
+#include "params/OPTRP.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+OPT::OPT(const Params &p)
+  : Base(p), index(NextUseIndex::load(p.trace_file, p.index_file)),
+    blockBits(floorLog2(index->blockSize())), seq(0),
+    lastNextUse(NextUseIndex::NEVER),
+    pendingNextUse(p.pending_misses, {MaxAddr, NextUseIndex::NEVER}),
+    pendingHead(0)
+{
+    fatal_if(p.pending_misses == 0, "%s: pending_misses must be positive",
+             name());
+}
+
+uint64_t
+OPT::nextUse(Addr block)
+{
+    if (seq >= index->size()) {
+        warn_once("%s: ran past the end of the recorded trace, blocks are "
+                  "not reused anymore\n", name());
+        return NextUseIndex::NEVER;
+    }
+
+    const NextUseIndex::Entry &entry = (*index)[seq++];
+    warn_if_once(entry.block != block,
+                 "%s: the accesses diverged from the recorded trace at "
+                 "access %d\n", name(), seq - 1);
+    return entry.nextUse;
+}
+
+void
+OPT::access(const PacketPtr pkt, bool hit,
+            const ReplacementCandidates& candidates)
+{
+    if (!CacheTraceProbe::traces(pkt))
+        return;
+
+    const Addr block = pkt->getAddr() >> blockBits;
+    lastNextUse = nextUse(block);
+    if (hit)
+        return;
+
+    for (auto &pending : pendingNextUse) {
+        if (pending.first == block) {
+            pending.second = lastNextUse;
+            return;
+        }
+    }
+    pendingNextUse[pendingHead] = {block, lastNextUse};
+    pendingHead = (pendingHead + 1) % pendingNextUse.size();
+}
+
+void
+OPT::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+{
+    const uint32_t index = replState.index(replacement_data);
+    replState.valid[index] = false;
+    replState.value[index] = NextUseIndex::NEVER;
+}
+
+void
+OPT::touch(const std::shared_ptr<ReplacementData>& replacement_data,
+           const PacketPtr pkt)
+{
+    // Hits are touched right after their lookup
+    replState.value[replState.index(replacement_data)] = lastNextUse;
+}
+
+void
+OPT::touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    panic("OPT needs the accessed packet to follow the trace.");
+}
+
+void
+OPT::reset(const std::shared_ptr<ReplacementData>& replacement_data,
+           const PacketPtr pkt)
+{
+    const uint32_t index = replState.index(replacement_data);
+    replState.valid[index] = true;
+
+    // Blocks filled without a lookup (e.g. prefetches) are not in the
+    // trace, and are the first to go
+    replState.value[index] = NextUseIndex::NEVER;
+    const Addr block = pkt->getAddr() >> blockBits;
+    for (auto &pending : pendingNextUse) {
+        if (pending.first == block) {
+            replState.value[index] = pending.second;
+            pending.first = MaxAddr;
+            break;
+        }
+    }
+}
+
+void
+OPT::reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+{
+    panic("OPT needs the accessed packet to follow the trace.");
+}
+
+ReplaceableEntry*
+OPT::getVictim(const ReplacementCandidates& candidates) const
+{
+    // There must be at least one replacement candidate
+    assert(candidates.size() > 0);
+
+    ReplaceableEntry* victim = candidates[0];
+    uint64_t victim_next_use = 0;
+    for (const auto& candidate : candidates) {
+        const uint32_t index = replState.index(candidate);
+        if (!replState.valid[index])
+            return candidate;
+
+        if (replState.value[index] > victim_next_use) {
+            victim = candidate;
+            victim_next_use = replState.value[index];
+        }
+    }
+
+    return victim;
+}
+
+std::shared_ptr<ReplacementData>
+OPT::instantiateEntry()
+{
+    return replState.instantiate(NextUseIndex::NEVER);
+}
+
+} // namespace replacement_policy
+} // namespace gem5
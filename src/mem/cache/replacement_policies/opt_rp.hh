@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of Belady's optimal (OPT) replacement policy, driven by the
+ * recorded future accesses of the cache.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_OPT_RP_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_OPT_RP_HH__
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/flat_repl_state.hh"
+#include "mem/cache/trace/next_use_index.hh"
+
+namespace gem5
+{
+
+struct OPTRPParams;
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+/**
+ * Belady's MIN: evict the block whose next access is the furthest in the
+ * future. The future comes from a trace of this cache's accesses recorded
+ * by CacheTraceProbe in a previous run, through its next-use index. The
+ * policy counts the accesses it sees the same way the probe records them,
+ * so the simulated run must issue the same access stream (e.g. when
+ * replayed by CacheTraceReplayer, or for a deterministic workload with a
+ * cache hierarchy whose upper levels are unchanged). This gives an upper
+ * bound to normalize the other policies with, in the same cache model.
+ *
+ * Only usable with BaseSetAssoc tags, which report every lookup through
+ * access().
+ */
+class OPT : public Base
+{
+  protected:
+    /** Next-use index of the recorded trace */
+    std::unique_ptr<NextUseIndex> index;
+
+    /** log2 of the block size of the trace */
+    const int blockBits;
+
+    /** Sequence number of the next access, in the trace */
+    uint64_t seq;
+
+    /** Next use of the block of the last access */
+    uint64_t lastNextUse;
+
+    /**
+     * Next use of the blocks of the last misses, until they are inserted.
+     * Some misses never insert their block (e.g. write misses that do not
+     * allocate), so this only keeps the last few ones, overwriting the
+     * oldest first. There must be at least as many as the misses the
+     * cache can have outstanding.
+     */
+    std::vector<std::pair<Addr, uint64_t>> pendingNextUse;
+
+    /** Entry of pendingNextUse to overwrite next */
+    size_t pendingHead;
+
+    /** Next use of the block of each entry */
+    mutable FlatReplState<uint64_t> replState;
+
+    /** Look up the next use of a block at the current position */
+    uint64_t nextUse(Addr block);
+
+  public:
+    typedef OPTRPParams Params;
+    OPT(const Params &p);
+    ~OPT() = default;
+
+    /**
+     * Advance in the trace and look up the next use of the accessed block.
+     */
+    void access(const PacketPtr pkt, bool hit,
+                const ReplacementCandidates& candidates) override;
+
+    /**
+     * Invalidate replacement data to set it as the next probable victim.
+     *
+     * @param replacement_data Replacement data to be invalidated.
+     */
+    void invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
+                                                                    override;
+
+    /**
+     * Set the next use of a block that hit.
+     *
+     * @param replacement_data Replacement data to be touched.
+     * @param pkt Packet that generated this access.
+     */
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data,
+               const PacketPtr pkt) override;
+    void touch(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Set the next use of a block being inserted, from its lookup.
+     *
+     * @param replacement_data Replacement data to be reset.
+     * @param pkt Packet that generated this insertion.
+     */
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data,
+               const PacketPtr pkt) override;
+    void reset(const std::shared_ptr<ReplacementData>& replacement_data) const
+                                                                     override;
+
+    /**
+     * Find the victim: an invalid entry if any, otherwise the entry whose
+     * next use is the furthest.
+     *
+     * @param candidates Replacement candidates, selected by indexing policy.
+     * @return Replacement entry to be replaced.
+     */
+    ReplaceableEntry* getVictim(const ReplacementCandidates& candidates) const
+                                                                     override;
+
+    std::shared_ptr<ReplacementData> instantiateEntry() override;
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_OPT_RP_HH__
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/partition_solver.hh"
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+std::vector<int>
+lookaheadPartition(const std::vector<std::vector<double>> &cost, int ways)
+{
+    const int num_cores = cost.size();
+    std::vector<int> partition(num_cores, 0);
+    if (num_cores == 0)
+        return partition;
+
+    for (const auto &curve : cost) {
+        panic_if(curve.size() != (size_t)ways + 1,
+                 "A cost curve needs an entry per way count in [0, %d]",
+                 ways);
+    }
+
+    int balance = ways;
+    while (balance > 0) {
+        int best_core = -1;
+        int best_block = 0;
+        double best_gain = 0;
+        for (int core = 0; core < num_cores; core++) {
+            const auto &curve = cost[core];
+            const int base = partition[core];
+            for (int block = 1; block <= balance; block++) {
+                const double gain =
+                    (curve[base] - curve[base + block]) / block;
+                if (gain > best_gain) {
+                    best_core = core;
+                    best_block = block;
+                    best_gain = gain;
+                }
+            }
+        }
+
+        if (best_core < 0)
+            break;
+        partition[best_core] += best_block;
+        balance -= best_block;
+    }
+
+    // Nobody gains from the remaining ways
+    for (int core = 0; balance > 0; core = (core + 1) % num_cores) {
+        partition[core]++;
+        balance--;
+    }
+
+    return partition;
+}
+
+} // namespace replacement_policy
+} // namespace gem5
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Way-partitioning solver used by the FlockHawkeye replacement policy to
+ * split the ways of a shared cache among cores from their projected cost
+ * curves.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_PARTITION_SOLVER_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_PARTITION_SOLVER_HH__
+
+#include <vector>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+/**
+ * Split ways among cores with the lookahead allocator of Utility-Based
+ * Cache Partitioning (Qureshi and Patt, MICRO'06). At each step every
+ * core is offered its best block of extra ways, the one with the largest
+ * cost reduction per way, and the core with the best offer gets it. This
+ * handles non-convex cost curves, which a one-way-at-a-time greedy does
+ * not, in O(cores * ways^2).
+ *
+ * Ways nobody benefits from are handed out round-robin, so that the
+ * whole cache is always allocated.
+ *
+ * @param cost cost[c][w] is the cost of core c when given w ways, for w
+ *        in [0, ways]. Lower is better.
+ * @param ways Number of ways to allocate.
+ * @return The number of ways of each core, summing to ways.
+ */
+std::vector<int> lookaheadPartition(
+    const std::vector<std::vector<double>> &cost, int ways);
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_PARTITION_SOLVER_HH__
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "mem/cache/replacement_policies/partition_solver.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+TEST(PartitionSolverTest, PrefersLargerGain)
+{
+    // Core 0 benefits from every way, core 1 saturates after two
+    std::vector<std::vector<double>> cost = {
+        {10, 9, 8, 7, 6},
+        {10, 5, 3, 3, 3},
+    };
+    ASSERT_EQ(lookaheadPartition(cost, 4), std::vector<int>({2, 2}));
+}
+
+TEST(PartitionSolverTest, LooksAhead)
+{
+    // Core 1 only benefits from a block of three ways, which a one-way
+    // greedy would never give it
+    std::vector<std::vector<double>> cost = {
+        {10, 9, 8.5, 8.2, 8},
+        {10, 10, 10, 1, 1},
+    };
+    ASSERT_EQ(lookaheadPartition(cost, 4), std::vector<int>({1, 3}));
+}
+
+TEST(PartitionSolverTest, FlatCurves)
+{
+    // Ways nobody gains from are spread round-robin
+    std::vector<std::vector<double>> cost(3, std::vector<double>(9, 1.0));
+    std::vector<int> partition = lookaheadPartition(cost, 8);
+    ASSERT_EQ(partition, std::vector<int>({3, 3, 2}));
+}
+
+TEST(PartitionSolverTest, AllocatesEveryWay)
+{
+    std::vector<std::vector<double>> cost;
+    for (int core = 0; core < 64; core++) {
+        std::vector<double> curve;
+        for (int ways = 0; ways <= 16; ways++)
+            curve.push_back(100.0 / (1 + ways * (core % 5)));
+        cost.push_back(curve);
+    }
+    std::vector<int> partition = lookaheadPartition(cost, 16);
+    ASSERT_EQ(std::accumulate(partition.begin(), partition.end(), 0), 16);
+    for (int core = 0; core < 64; core += 5)
+        ASSERT_EQ(partition[core], 0);
+}
@@ -39,36 +39,6 @@ namespace gem5
 namespace replacement_policy
 {
 
-SHiP::SHiPReplData::SHiPReplData(int num_bits)
-  : BRRIPReplData(num_bits), signature(0), outcome(false)
-{
-}
-
-SHiP::SignatureType
-SHiP::SHiPReplData::getSignature() const
-{
-    return signature;
-}
-
-void
-SHiP::SHiPReplData::setSignature(SignatureType new_signature)
-{
-    signature = new_signature;
-    outcome = false;
-}
-
-void
-SHiP::SHiPReplData::setReReferenced()
-{
-    outcome = true;
-}
-
-bool
-SHiP::SHiPReplData::wasReReferenced() const
-{
-    return outcome;
-}
-
 SHiP::SHiP(const Params &p)
   : BRRIP(p), insertionThreshold(p.insertion_threshold / 100.0),
     SHCT(p.shct_size, SatCounter8(numRRPVBits))
@@ -78,13 +48,12 @@ SHiP::SHiP(const Params &p)
 void
 SHiP::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    const uint32_t index = replState.index(replacement_data);
 
     // The predictor is detrained when an entry that has not been re-
     // referenced since insertion is invalidated
-    if (casted_replacement_data->wasReReferenced()) {
-        SHCT[casted_replacement_data->getSignature()]--;
+    if (outcomes[index]) {
+        SHCT[signatures[index]]--;
     }
 
     BRRIP::invalidate(replacement_data);
@@ -94,13 +63,10 @@ void
 SHiP::touch(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
-
     // When a hit happens the SHCT entry indexed by the signature is
     // incremented
     SHCT[getSignature(pkt)]++;
-    casted_replacement_data->setReReferenced();
+    outcomes[replState.index(replacement_data)] = true;
 
     // This was a hit; update replacement data accordingly
     BRRIP::touch(replacement_data);
@@ -117,20 +83,21 @@ void
 SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data,
     const PacketPtr pkt)
 {
-    std::shared_ptr<SHiPReplData> casted_replacement_data =
-        std::static_pointer_cast<SHiPReplData>(replacement_data);
+    const uint32_t index = replState.index(replacement_data);
 
     // Get signature
     const SignatureType signature = getSignature(pkt);
 
-    // Store signature
-    casted_replacement_data->setSignature(signature);
+    // Store signature and reset outcome
+    signatures[index] = signature;
+    outcomes[index] = false;
 
     // If SHCT for signature is set, predict intermediate re-reference.
     // Predict distant re-reference otherwise
     BRRIP::reset(replacement_data);
-    if (SHCT[signature].calcSaturation() >= insertionThreshold) {
-        casted_replacement_data->rrpv--;
+    if (SHCT[signature].calcSaturation() >= insertionThreshold &&
+        replState.value[index] > 0) {
+        replState.value[index]--;
     }
 }
 
@@ -144,7 +111,9 @@ SHiP::reset(const std::shared_ptr<ReplacementData>& replacement_data)
 std::shared_ptr<ReplacementData>
 SHiP::instantiateEntry()
 {
-    return std::shared_ptr<ReplacementData>(new SHiPReplData(numRRPVBits));
+    signatures.push_back(0);
+    outcomes.push_back(false);
+    return BRRIP::instantiateEntry();
 }
 
 SHiPMem::SHiPMem(const SHiPMemRPParams &p) : SHiP(p) {}
@@ -60,39 +60,17 @@ class SHiP : public BRRIP
   protected:
     typedef std::size_t SignatureType;
 
-    /** SHiP-specific implementation of replacement data. */
-    class SHiPReplData : public BRRIPReplData
-    {
-      private:
-        /** Signature that caused the insertion of this entry. */
-        SignatureType signature;
-
-        /** Outcome of insertion; set to one if entry is re-referenced. */
-        bool outcome;
-
-      public:
-        SHiPReplData(int num_bits);
-
-        /** Get entry's signature. */
-        SignatureType getSignature() const;
-
-        /**
-         * Set this entry's signature and reset outcome.
-         *
-         * @param signature New signature value/
-         */
-        void setSignature(SignatureType signature);
-
-        /** Set that this entry has been re-referenced. */
-        void setReReferenced();
-
-        /**
-         * Get whether entry has been re-referenced since insertion.
-         *
-         * @return True if entry has been re-referenced since insertion.
-         */
-        bool wasReReferenced() const;
-    };
+    /**
+     * Signature that caused the insertion of each entry. Indexed by the
+     * slots of the BRRIP replacement state.
+     */
+    std::vector<SignatureType> signatures;
+
+    /**
+     * Outcome of the insertion of each entry; set to one if the entry is
+     * re-referenced.
+     */
+    std::vector<uint8_t> outcomes;
 
     /**
      * Saturation percentage at which an entry starts being inserted as
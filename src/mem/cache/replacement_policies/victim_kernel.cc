@@ -0,0 +1,535 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/replacement_policies/victim_kernel.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "base/bitfield.hh"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VICTIM_KERNEL_SIMD 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define VICTIM_KERNEL_SIMD 1
+#endif
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+namespace scalar
+{
+
+int
+findFirstMaxRRPV(const uint8_t *rrpv, const uint8_t *valid, int num_ways)
+{
+    int victim = 0;
+    for (int way = 0; way < num_ways; way++) {
+        if (!valid[way]) {
+            return way;
+        }
+        if (rrpv[way] > rrpv[victim]) {
+            victim = way;
+        }
+    }
+    return victim;
+}
+
+int
+findRRPVVictim(uint8_t *rrpv, const uint8_t *valid, int num_ways,
+               uint8_t max_rrpv)
+{
+    const int victim = findFirstMaxRRPV(rrpv, valid, num_ways);
+    if (!valid[victim] || rrpv[victim] >= max_rrpv) {
+        return victim;
+    }
+
+    const int diff = max_rrpv - rrpv[victim];
+    for (int way = 0; way < num_ways; way++) {
+        rrpv[way] = std::min(rrpv[way] + diff, (int)max_rrpv);
+    }
+    return victim;
+}
+
+int
+findETRVictim(const int8_t *etr, const uint8_t *valid, int num_ways)
+{
+    int victim = 0;
+    int abs_victim_etr = std::abs(etr[0]);
+    for (int way = 0; way < num_ways; way++) {
+        if (!valid[way]) {
+            return way;
+        }
+        const int abs_etr = std::abs(etr[way]);
+        if (abs_etr > abs_victim_etr ||
+            (abs_etr == abs_victim_etr && etr[way] < 0)) {
+            victim = way;
+            abs_victim_etr = abs_etr;
+        }
+    }
+    return victim;
+}
+
+void
+ageFriendlyRRPV(uint8_t *rrpv, const uint8_t *valid,
+                const uint8_t *friendly, int num_ways, uint8_t limit)
+{
+    for (int way = 0; way < num_ways; way++) {
+        if (valid[way] && friendly[way] && rrpv[way] < limit) {
+            rrpv[way]++;
+        }
+    }
+}
+
+void
+ageETR(int8_t *etr, int num_ways, int abs_max_etr)
+{
+    for (int way = 0; way < num_ways; way++) {
+        if (std::abs(etr[way]) < abs_max_etr) {
+            etr[way] -= 1;
+        }
+    }
+}
+
+} // namespace scalar
+
+#ifdef VICTIM_KERNEL_SIMD
+
+namespace
+{
+
+/*
+ * Element-wise operations on bytes, for every vector width in use.
+ */
+inline __m128i eq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+inline __m128i
+negative(__m128i a)
+{
+    return _mm_cmpgt_epi8(_mm_setzero_si128(), a);
+}
+inline __m128i maxU(__m128i a, __m128i b) { return _mm_max_epu8(a, b); }
+inline __m128i minU(__m128i a, __m128i b) { return _mm_min_epu8(a, b); }
+inline __m128i addSatU(__m128i a, __m128i b) { return _mm_adds_epu8(a, b); }
+inline __m128i add(__m128i a, __m128i b) { return _mm_add_epi8(a, b); }
+inline __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi8(a, b); }
+inline __m128i bitXor(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+/** ~a & b */
+inline __m128i andNot(__m128i a, __m128i b) { return _mm_andnot_si128(a, b); }
+inline __m128i fold(__m128i v) { return v; }
+
+#if defined(__AVX2__)
+inline __m256i eq(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+inline __m256i
+negative(__m256i a)
+{
+    return _mm256_cmpgt_epi8(_mm256_setzero_si256(), a);
+}
+inline __m256i maxU(__m256i a, __m256i b) { return _mm256_max_epu8(a, b); }
+inline __m256i minU(__m256i a, __m256i b) { return _mm256_min_epu8(a, b); }
+inline __m256i
+addSatU(__m256i a, __m256i b)
+{
+    return _mm256_adds_epu8(a, b);
+}
+inline __m256i add(__m256i a, __m256i b) { return _mm256_add_epi8(a, b); }
+inline __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi8(a, b); }
+inline __m256i
+bitXor(__m256i a, __m256i b)
+{
+    return _mm256_xor_si256(a, b);
+}
+/** ~a & b */
+inline __m256i
+andNot(__m256i a, __m256i b)
+{
+    return _mm256_andnot_si256(a, b);
+}
+/** Unsigned byte maximum of both halves. */
+inline __m128i
+fold(__m256i v)
+{
+    return _mm_max_epu8(_mm256_castsi256_si128(v),
+                        _mm256_extracti128_si256(v, 1));
+}
+#endif
+
+/*
+ * Chunks of a set, from a full vector down to a single byte. The narrow
+ * chunks are held in the low bytes of an SSE register whose other bytes
+ * are zero, and their masks only cover the bytes loaded, so that the
+ * kernels can handle any number of ways without ever reading past the
+ * end of the set.
+ */
+struct Chunk16
+{
+    typedef __m128i Vec;
+    static constexpr int Bytes = 16;
+    static Vec load(const void *p) { return _mm_loadu_si128((const Vec *)p); }
+    static void store(void *p, Vec v) { _mm_storeu_si128((Vec *)p, v); }
+    static Vec splat(uint8_t x) { return _mm_set1_epi8((char)x); }
+    static Vec zero() { return _mm_setzero_si128(); }
+    static uint32_t mask(Vec v) { return _mm_movemask_epi8(v); }
+};
+
+struct Chunk8 : public Chunk16
+{
+    static constexpr int Bytes = 8;
+    static Vec load(const void *p) { return _mm_loadl_epi64((const Vec *)p); }
+    static void store(void *p, Vec v) { _mm_storel_epi64((Vec *)p, v); }
+    static uint32_t mask(Vec v) { return _mm_movemask_epi8(v) & 0xff; }
+};
+
+struct Chunk4 : public Chunk16
+{
+    static constexpr int Bytes = 4;
+    static Vec
+    load(const void *p)
+    {
+        int32_t bytes;
+        std::memcpy(&bytes, p, sizeof(bytes));
+        return _mm_cvtsi32_si128(bytes);
+    }
+    static void
+    store(void *p, Vec v)
+    {
+        const int32_t bytes = _mm_cvtsi128_si32(v);
+        std::memcpy(p, &bytes, sizeof(bytes));
+    }
+    static uint32_t mask(Vec v) { return _mm_movemask_epi8(v) & 0xf; }
+};
+
+struct Chunk1 : public Chunk16
+{
+    static constexpr int Bytes = 1;
+    static Vec
+    load(const void *p)
+    {
+        return _mm_cvtsi32_si128(*(const uint8_t *)p);
+    }
+    static void
+    store(void *p, Vec v)
+    {
+        *(uint8_t *)p = _mm_cvtsi128_si32(v);
+    }
+    static uint32_t mask(Vec v) { return _mm_movemask_epi8(v) & 0x1; }
+};
+
+#if defined(__AVX2__)
+struct Chunk32
+{
+    typedef __m256i Vec;
+    static constexpr int Bytes = 32;
+    static Vec
+    load(const void *p)
+    {
+        return _mm256_loadu_si256((const Vec *)p);
+    }
+    static void store(void *p, Vec v) { _mm256_storeu_si256((Vec *)p, v); }
+    static Vec splat(uint8_t x) { return _mm256_set1_epi8((char)x); }
+    static Vec zero() { return _mm256_setzero_si256(); }
+    static uint32_t mask(Vec v) { return _mm256_movemask_epi8(v); }
+};
+#endif
+
+/**
+ * Split [0, n) in chunks, the widest first, and call f(chunk, offset) on
+ * each of them, chunk being an instance of the chunk type, until f
+ * returns true.
+ *
+ * @return Whether f stopped the iteration.
+ */
+template <typename F>
+inline bool
+forChunks(int n, F &&f)
+{
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + Chunk32::Bytes <= n; i += Chunk32::Bytes) {
+        if (f(Chunk32(), i)) {
+            return true;
+        }
+    }
+#endif
+    for (; i + Chunk16::Bytes <= n; i += Chunk16::Bytes) {
+        if (f(Chunk16(), i)) {
+            return true;
+        }
+    }
+    if (i + Chunk8::Bytes <= n) {
+        if (f(Chunk8(), i)) {
+            return true;
+        }
+        i += Chunk8::Bytes;
+    }
+    if (i + Chunk4::Bytes <= n) {
+        if (f(Chunk4(), i)) {
+            return true;
+        }
+        i += Chunk4::Bytes;
+    }
+    for (; i < n; i++) {
+        if (f(Chunk1(), i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Largest unsigned byte of a vector. */
+inline uint8_t
+horizontalMax(__m128i m)
+{
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 8));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 4));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 2));
+    m = _mm_max_epu8(m, _mm_srli_si128(m, 1));
+    return _mm_cvtsi128_si32(m) & 0xff;
+}
+
+/** Absolute value of signed bytes; -128 becomes the unsigned 128. */
+template <typename Vec>
+inline Vec
+absolute(Vec v)
+{
+    const Vec sign = negative(v);
+    return sub(bitXor(v, sign), sign);
+}
+
+/** Index of the first byte equal to x, or -1. */
+int
+firstEqual(const uint8_t *v, int n, uint8_t x)
+{
+    int found = -1;
+    forChunks(n, [&](auto chunk, int i) {
+        typedef decltype(chunk) C;
+        const uint32_t m = C::mask(eq(C::load(v + i), C::splat(x)));
+        if (m) {
+            found = i + ctz32(m);
+        }
+        return m != 0;
+    });
+    return found;
+}
+
+/** Index of the last byte equal to x, or -1. */
+int
+lastEqual(const uint8_t *v, int n, uint8_t x)
+{
+    int found = -1;
+    forChunks(n, [&](auto chunk, int i) {
+        typedef decltype(chunk) C;
+        const uint32_t m = C::mask(eq(C::load(v + i), C::splat(x)));
+        if (m) {
+            found = i + findMsbSet(m);
+        }
+        return false;
+    });
+    return found;
+}
+
+/** Largest unsigned byte of an array. */
+uint8_t
+maxOf(const uint8_t *v, int n)
+{
+    // The unused bytes of the narrow chunks are zero, which is neutral
+    __m128i acc = _mm_setzero_si128();
+    forChunks(n, [&](auto chunk, int i) {
+        typedef decltype(chunk) C;
+        acc = _mm_max_epu8(acc, fold(C::load(v + i)));
+        return false;
+    });
+    return horizontalMax(acc);
+}
+
+/** Largest absolute value of an array of signed bytes. */
+int
+maxAbsOf(const int8_t *v, int n)
+{
+    __m128i acc = _mm_setzero_si128();
+    forChunks(n, [&](auto chunk, int i) {
+        typedef decltype(chunk) C;
+        acc = _mm_max_epu8(acc, fold(absolute(C::load(v + i))));
+        return false;
+    });
+    return horizontalMax(acc);
+}
+
+} // anonymous namespace
+
+int
+findFirstMaxRRPV(const uint8_t *rrpv, const uint8_t *valid, int num_ways)
+{
+    const int invalid = firstEqual(valid, num_ways, 0);
+    if (invalid >= 0) {
+        return invalid;
+    }
+    return firstEqual(rrpv, num_ways, maxOf(rrpv, num_ways));
+}
+
+int
+findRRPVVictim(uint8_t *rrpv, const uint8_t *valid, int num_ways,
+               uint8_t max_rrpv)
+{
+    const int invalid = firstEqual(valid, num_ways, 0);
+    if (invalid >= 0) {
+        return invalid;
+    }
+
+    const uint8_t victim_rrpv = maxOf(rrpv, num_ways);
+    const int victim = firstEqual(rrpv, num_ways, victim_rrpv);
+    if (victim_rrpv >= max_rrpv) {
+        return victim;
+    }
+
+    const uint8_t diff = max_rrpv - victim_rrpv;
+    forChunks(num_ways, [&](auto chunk, int i) {
+        typedef decltype(chunk) C;
+        C::store(rrpv + i, minU(addSatU(C::load(rrpv + i), C::splat(diff)),
+                                C::splat(max_rrpv)));
+        return false;
+    });
+    return victim;
+}
+
+int
+findETRVictim(const int8_t *etr, const uint8_t *valid, int num_ways)
+{
+    const int invalid = firstEqual(valid, num_ways, 0);
+    if (invalid >= 0) {
+        return invalid;
+    }
+
+    // Overdue lines win the ties, the last one of them being chosen
+    const int abs_max = maxAbsOf(etr, num_ways);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(etr);
+    const int overdue = lastEqual(bytes, num_ways, (uint8_t)-abs_max);
+    if (abs_max > 0 && overdue >= 0) {
+        return overdue;
+    }
+    return firstEqual(bytes, num_ways, (uint8_t)abs_max);
+}
+
+void
+ageFriendlyRRPV(uint8_t *rrpv, const uint8_t *valid,
+                const uint8_t *friendly, int num_ways, uint8_t limit)
+{
+    if (limit == 0) {
+        return;
+    }
+
+    // rrpv < limit <=> min(rrpv, limit - 1) == rrpv
+    forChunks(num_ways, [&](auto chunk, int i) {
+        typedef decltype(chunk) C;
+        const auto v = C::load(rrpv + i);
+        const auto aging =
+            andNot(eq(C::load(valid + i), C::zero()),
+                   andNot(eq(C::load(friendly + i), C::zero()),
+                          eq(minU(v, C::splat(limit - 1)), v)));
+        // Lanes to be aged are all ones, i.e., -1
+        C::store(rrpv + i, sub(v, aging));
+        return false;
+    });
+}
+
+void
+ageETR(int8_t *etr, int num_ways, int abs_max_etr)
+{
+    // |etr| < abs_max_etr <=> max(|etr|, abs_max_etr) != |etr|
+    const uint8_t bound = std::clamp(abs_max_etr, 0, 255);
+    forChunks(num_ways, [&](auto chunk, int i) {
+        typedef decltype(chunk) C;
+        const auto v = C::load(etr + i);
+        const auto a = absolute(v);
+        const auto ones = eq(C::zero(), C::zero());
+        const auto aging = bitXor(eq(maxU(a, C::splat(bound)), a), ones);
+        C::store(etr + i, add(v, aging));
+        return false;
+    });
+}
+
+const char *
+victimKernelISA()
+{
+#if defined(__AVX2__)
+    return "avx2";
+#else
+    return "sse2";
+#endif
+}
+
+#else // !VICTIM_KERNEL_SIMD
+
+int
+findFirstMaxRRPV(const uint8_t *rrpv, const uint8_t *valid, int num_ways)
+{
+    return scalar::findFirstMaxRRPV(rrpv, valid, num_ways);
+}
+
+int
+findRRPVVictim(uint8_t *rrpv, const uint8_t *valid, int num_ways,
+               uint8_t max_rrpv)
+{
+    return scalar::findRRPVVictim(rrpv, valid, num_ways, max_rrpv);
+}
+
+int
+findETRVictim(const int8_t *etr, const uint8_t *valid, int num_ways)
+{
+    return scalar::findETRVictim(etr, valid, num_ways);
+}
+
+void
+ageFriendlyRRPV(uint8_t *rrpv, const uint8_t *valid,
+                const uint8_t *friendly, int num_ways, uint8_t limit)
+{
+    scalar::ageFriendlyRRPV(rrpv, valid, friendly, num_ways, limit);
+}
+
+void
+ageETR(int8_t *etr, int num_ways, int abs_max_etr)
+{
+    scalar::ageETR(etr, num_ways, abs_max_etr);
+}
+
+const char *
+victimKernelISA()
+{
+    return "scalar";
+}
+
+#endif // VICTIM_KERNEL_SIMD
+
+} // namespace replacement_policy
+} // namespace gem5
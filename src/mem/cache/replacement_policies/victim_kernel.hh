@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Kernels scanning the packed replacement state of a set (see
+ * FlatReplState), shared by the RRIP-like replacement policies. Each
+ * kernel has an SSE2 or AVX2 implementation, chosen at compile time from
+ * the target ISA, and a portable scalar fallback with the exact same
+ * semantics.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_VICTIM_KERNEL_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_VICTIM_KERNEL_HH__
+
+#include <cstdint>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+GEM5_DEPRECATED_NAMESPACE(ReplacementPolicy, replacement_policy);
+namespace replacement_policy
+{
+
+/**
+ * Find the victim of an RRIP set and age it: the first invalid way if
+ * there is any, otherwise the first way holding the largest RRPV. In the
+ * latter case every RRPV of the set is increased (saturating at max_rrpv)
+ * by the distance of the victim's RRPV to max_rrpv.
+ *
+ * @param rrpv RRPVs of the ways of the set.
+ * @param valid Validity of the ways of the set.
+ * @param num_ways Number of ways of the set.
+ * @param max_rrpv Saturated RRPV.
+ * @return The way of the victim.
+ */
+int findRRPVVictim(uint8_t *rrpv, const uint8_t *valid, int num_ways,
+                   uint8_t max_rrpv);
+
+/**
+ * Find the first invalid way, or else the first way holding the largest
+ * RRPV, without aging.
+ */
+int findFirstMaxRRPV(const uint8_t *rrpv, const uint8_t *valid,
+                     int num_ways);
+
+/**
+ * Find the victim of a Mockingjay set: the first invalid way if there is
+ * any, otherwise the way with the largest absolute ETR. Among the ways
+ * with the largest absolute ETR the last overdue (negative) one is
+ * preferred, and the first one if none is overdue.
+ */
+int findETRVictim(const int8_t *etr, const uint8_t *valid, int num_ways);
+
+/**
+ * Age the cache-friendly lines of a Hawkeye set: increment the RRPV of
+ * every valid friendly way whose RRPV is below limit.
+ */
+void ageFriendlyRRPV(uint8_t *rrpv, const uint8_t *valid,
+                     const uint8_t *friendly, int num_ways, uint8_t limit);
+
+/**
+ * Age the lines of a Mockingjay set: decrement every ETR whose absolute
+ * value is below abs_max_etr.
+ */
+void ageETR(int8_t *etr, int num_ways, int abs_max_etr);
+
+/** Name of the instruction set the kernels have been compiled for. */
+const char *victimKernelISA();
+
+/**
+ * Scalar implementations of the kernels. They are used when no vector
+ * instruction set is available, and serve as reference otherwise.
+ */
+namespace scalar
+{
+
+int findRRPVVictim(uint8_t *rrpv, const uint8_t *valid, int num_ways,
+                   uint8_t max_rrpv);
+int findFirstMaxRRPV(const uint8_t *rrpv, const uint8_t *valid,
+                     int num_ways);
+int findETRVictim(const int8_t *etr, const uint8_t *valid, int num_ways);
+void ageFriendlyRRPV(uint8_t *rrpv, const uint8_t *valid,
+                     const uint8_t *friendly, int num_ways, uint8_t limit);
+void ageETR(int8_t *etr, int num_ways, int abs_max_etr);
+
+} // namespace scalar
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_VICTIM_KERNEL_HH__
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/cache/replacement_policies/victim_kernel.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+/** Ways of the sets checked; covers the vector widths and their tails. */
+const std::vector<int> numWays = {1, 2, 4, 7, 8, 12, 15, 16, 17, 31, 32, 33,
+                                  48, 64, 67};
+
+/** Fill a set with random values in [0, max_value] and a few holes. */
+void
+fillSet(std::mt19937 &gen, int num_ways, int max_value, bool holes,
+        std::vector<uint8_t> &value, std::vector<uint8_t> &valid)
+{
+    std::uniform_int_distribution<int> dist(0, max_value);
+    std::uniform_int_distribution<int> hole(0, 4 * num_ways);
+    value.resize(num_ways);
+    valid.resize(num_ways);
+    for (int way = 0; way < num_ways; way++) {
+        value[way] = dist(gen);
+        valid[way] = !holes || hole(gen) != 0;
+    }
+}
+
+} // anonymous namespace
+
+TEST(VictimKernelTest, FindRRPVVictim)
+{
+    std::mt19937 gen(0);
+    std::vector<uint8_t> rrpv, valid;
+    for (int num_ways : numWays) {
+        for (int max_rrpv : {1, 3, 7, 255}) {
+            for (int i = 0; i < 200; i++) {
+                fillSet(gen, num_ways, max_rrpv, i % 2, rrpv, valid);
+                std::vector<uint8_t> expected = rrpv;
+
+                const int ref = scalar::findRRPVVictim(expected.data(),
+                    valid.data(), num_ways, max_rrpv);
+                ASSERT_EQ(findFirstMaxRRPV(rrpv.data(), valid.data(),
+                                           num_ways), ref);
+                ASSERT_EQ(findRRPVVictim(rrpv.data(), valid.data(),
+                                         num_ways, max_rrpv), ref);
+                ASSERT_EQ(rrpv, expected);
+            }
+        }
+    }
+}
+
+TEST(VictimKernelTest, FindETRVictim)
+{
+    std::mt19937 gen(1);
+    std::vector<uint8_t> etr, valid;
+    for (int num_ways : numWays) {
+        // Narrow ranges make ties between positive and negative ETRs common
+        for (int max_value : {2, 8, 255}) {
+            for (int i = 0; i < 200; i++) {
+                fillSet(gen, num_ways, max_value, i % 2, etr, valid);
+                const int8_t *signed_etr =
+                    reinterpret_cast<const int8_t *>(etr.data());
+                if (max_value < 255) {
+                    for (auto &e : etr) {
+                        e = (uint8_t)(e - max_value / 2);
+                    }
+                }
+
+                ASSERT_EQ(findETRVictim(signed_etr, valid.data(), num_ways),
+                          scalar::findETRVictim(signed_etr, valid.data(),
+                                                num_ways));
+            }
+        }
+    }
+}
+
+TEST(VictimKernelTest, AgeFriendlyRRPV)
+{
+    std::mt19937 gen(2);
+    std::vector<uint8_t> rrpv, valid, friendly, unused;
+    for (int num_ways : numWays) {
+        for (int i = 0; i < 200; i++) {
+            fillSet(gen, num_ways, 7, true, rrpv, valid);
+            fillSet(gen, num_ways, 1, false, friendly, unused);
+            std::vector<uint8_t> expected = rrpv;
+
+            scalar::ageFriendlyRRPV(expected.data(), valid.data(),
+                                    friendly.data(), num_ways, 6);
+            ageFriendlyRRPV(rrpv.data(), valid.data(), friendly.data(),
+                            num_ways, 6);
+            ASSERT_EQ(rrpv, expected);
+        }
+    }
+}
+
+TEST(VictimKernelTest, AgeETR)
+{
+    std::mt19937 gen(3);
+    std::vector<uint8_t> etr, unused;
+    for (int num_ways : numWays) {
+        for (int abs_max_etr : {0, 1, 15, 127, 300}) {
+            fillSet(gen, num_ways, 255, false, etr, unused);
+            std::vector<uint8_t> expected = etr;
+
+            scalar::ageETR(reinterpret_cast<int8_t *>(expected.data()),
+                           num_ways, abs_max_etr);
+            ageETR(reinterpret_cast<int8_t *>(etr.data()), num_ways,
+                   abs_max_etr);
+            ASSERT_EQ(etr, expected);
+        }
+    }
+}
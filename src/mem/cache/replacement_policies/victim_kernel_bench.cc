@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Micro-benchmark of the RRIP victim selection: pointer-chasing through
+ * one heap-allocated replacement data per block, as the policies used to
+ * do, against the scalar and vectorised scans of the packed state.
+ */
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "mem/cache/replacement_policies/victim_kernel.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+constexpr int NumSets = 4096;
+constexpr int Iterations = 4000000;
+constexpr uint8_t MaxRRPV = 7;
+
+/** Per-block replacement data, as allocated by instantiateEntry(). */
+struct BlockReplData
+{
+    uint8_t rrpv;
+    bool valid;
+};
+
+/** A block only reaching its replacement data through a pointer. */
+struct Block
+{
+    std::shared_ptr<BlockReplData> replacementData;
+};
+
+/** Former BRRIP::getVictim, on one set of candidates. */
+int
+pointerVictim(const std::vector<Block *> &candidates)
+{
+    int victim = 0;
+    int victim_rrpv = candidates[0]->replacementData->rrpv;
+    for (int way = 0; way < candidates.size(); way++) {
+        const auto &data = candidates[way]->replacementData;
+        if (!data->valid) {
+            return way;
+        }
+        if (data->rrpv > victim_rrpv) {
+            victim = way;
+            victim_rrpv = data->rrpv;
+        }
+    }
+    const int diff = MaxRRPV - victim_rrpv;
+    if (diff > 0) {
+        for (auto candidate : candidates) {
+            auto &rrpv = candidate->replacementData->rrpv;
+            rrpv = std::min(rrpv + diff, (int)MaxRRPV);
+        }
+    }
+    return victim;
+}
+
+template <typename F>
+double
+nsPerVictim(F select_victim)
+{
+    std::mt19937 gen(0);
+    std::vector<int> sets(Iterations);
+    for (auto &set : sets) {
+        set = gen() % NumSets;
+    }
+
+    unsigned checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int set : sets) {
+        checksum += select_victim(set);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // Keep the compiler from dropping the selections
+    if (checksum == 1) {
+        cprintf("");
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+        Iterations;
+}
+
+void
+benchmark(int num_ways)
+{
+    std::mt19937 gen(1);
+
+    // Flat state, and the same state spread over the heap
+    std::vector<uint8_t> rrpv(NumSets * num_ways);
+    std::vector<uint8_t> valid(NumSets * num_ways, true);
+    std::vector<Block> blocks(NumSets * num_ways);
+    std::vector<std::vector<Block *>> candidates(NumSets);
+    std::vector<std::shared_ptr<int>> padding;
+    for (int i = 0; i < NumSets * num_ways; i++) {
+        rrpv[i] = gen() % (MaxRRPV + 1);
+        blocks[i].replacementData =
+            std::make_shared<BlockReplData>(BlockReplData{rrpv[i], true});
+        padding.push_back(std::make_shared<int>(0));
+        candidates[i / num_ways].push_back(&blocks[i]);
+    }
+    std::vector<uint8_t> scalar_rrpv = rrpv;
+
+    const double pointer_ns = nsPerVictim([&](int set) {
+        return pointerVictim(candidates[set]);
+    });
+    const double scalar_ns = nsPerVictim([&](int set) {
+        return scalar::findRRPVVictim(&scalar_rrpv[set * num_ways],
+            &valid[set * num_ways], num_ways, MaxRRPV);
+    });
+    const double kernel_ns = nsPerVictim([&](int set) {
+        return findRRPVVictim(&rrpv[set * num_ways], &valid[set * num_ways],
+                              num_ways, MaxRRPV);
+    });
+
+    cprintf("%2d ways: pointer %6.2f ns, flat scalar %6.2f ns, "
+            "flat %s %6.2f ns (%.1fx)\n", num_ways, pointer_ns, scalar_ns,
+            victimKernelISA(), kernel_ns, pointer_ns / kernel_ns);
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+    for (int num_ways : {8, 16, 32}) {
+        benchmark(num_ways);
+    }
+    return 0;
+}
@@ -21,13 +21,14 @@ uint64_t CRC( uint64_t _blockAddress ) {
     return _returnVal;
 }
 
-OccupencyVector::OccupencyVector(const uint64_t cache_size, const uint64_t capacity): num_cache(0), num_dont_cache(0), access(0), CACHE_SIZE(cache_size), vector_size(capacity) {
-    liveness_history.resize(capacity, 0);
+OccupencyVector::OccupencyVector(const uint64_t cache_size, const uint64_t capacity)
+    : liveness_history(capacity), num_cache(cache_size + 1, 0), num_dont_cache(cache_size + 1, 0), access(0),
+      CACHE_SIZE(cache_size), vector_size(capacity) {
 }
 
 void OccupencyVector::add_access(uint64_t curr_quanta) {
     access++;
-    liveness_history[curr_quanta] = 0;
+    liveness_history.clear(curr_quanta);
 }
 
 uint64_t OccupencyVector::get_vector_size() {
@@ -35,66 +36,47 @@ uint64_t OccupencyVector::get_vector_size() {
 }
 
 void OccupencyVector::add_prefetch(uint64_t curr_quanta) {
-    liveness_history[curr_quanta] = 0;
+    liveness_history.clear(curr_quanta);
 }
 
-bool OccupencyVector::should_cache(uint64_t curr_quanta, uint64_t last_quanta) {
-    bool is_cache = true;
-
-    if (num_cache.find(CACHE_SIZE) == num_cache.end()) {
-        num_cache[CACHE_SIZE] = 0;
-    }
-    if (num_dont_cache.find(CACHE_SIZE) == num_dont_cache.end()) {
-        num_dont_cache[CACHE_SIZE] = 0;
+void OccupencyVector::setCacheSize(uint64_t cache_size) {
+    CACHE_SIZE = cache_size;
+    if (num_cache.size() <= cache_size) {
+        num_cache.resize(cache_size + 1, 0);
+        num_dont_cache.resize(cache_size + 1, 0);
     }
+}
 
-    unsigned int i = last_quanta;
-    while (i != curr_quanta)
-    {
-        if (liveness_history[i] >= CACHE_SIZE)
-        {
-            is_cache = false;
-            break;
-        }
-
-        i = (i+1) % liveness_history.size();
-    }
+bool OccupencyVector::should_cache(uint64_t curr_quanta, uint64_t last_quanta) {
+    // The sampler timestamps can be wider than the vector, fold them into the ring
+    last_quanta %= vector_size;
+    assert(curr_quanta < vector_size);
 
+    // The line would have been kept by OPT if no quantum of its lifetime [last, curr) is already full
+    bool is_cache = liveness_history.max(last_quanta, curr_quanta) < CACHE_SIZE;
 
-    //if ((is_cache) && (last_quanta != curr_quanta))
-    if ((is_cache))
-    {
-        i = last_quanta;
-        while (i != curr_quanta)
-        {
-            liveness_history[i]++;
-            i = (i+1) % liveness_history.size();
-        }
-        assert(i == curr_quanta);
+    if (is_cache) {
+        liveness_history.increment(last_quanta, curr_quanta);
+        num_cache[CACHE_SIZE]++;
+    } else {
+        num_dont_cache[CACHE_SIZE]++;
     }
 
-    if (is_cache) num_cache[CACHE_SIZE]++;
-    else num_dont_cache[CACHE_SIZE]++;
-
     return is_cache;
 }
 
 uint64_t OccupencyVector::get_num_opt_hits(int cache_size) {
-    if (num_cache.find(cache_size) == num_cache.end()) {
+    if (cache_size < 0 || (size_t)cache_size >= num_cache.size()) {
         return 0;
     }
     return num_cache[cache_size];
-
-    // uint64_t num_opt_misses = access - num_cache;
-    // return num_opt_misses;
 }
 
 uint64_t OccupencyVector::get_num_opt_misses(int cache_size) {
-    if (num_dont_cache.find(cache_size) == num_dont_cache.end()) {
+    if (cache_size < 0 || (size_t)cache_size >= num_dont_cache.size()) {
         return 0;
     }
     return num_dont_cache[cache_size];
-
 }
 
 PCBasedPredictor::PCBasedPredictor(const int num_entries, const int bits_per_entry): num_entries(num_entries), bits_per_entry(bits_per_entry) {
@@ -131,50 +113,66 @@ int PCBasedPredictor::log2_num_entries() {
     return (int) std::log2(num_entries);
 }
 
-HistorySampler::HistorySampler(const int num_sets, const int num_cache_sets, const int cache_block_size, const int timer_size)
-    : _num_sets(num_sets), _num_cache_sets(num_cache_sets), _cache_block_size(cache_block_size), _timer_size(timer_size) {
-    sample_data = new CacheSet[num_sets];
-    set_timestamp_counter = new uint64_t[num_sets];
-    for (int i = 0; i < num_sets; i++) {
-        set_timestamp_counter[i] = 0;
-    }
+HistorySampler::HistorySampler(const int num_sets, const int num_cache_sets, const int cache_block_size, const int timer_size,
+                               const int tag_bits, const int timestamp_bits)
+    : _num_sets(num_sets), _num_cache_sets(num_cache_sets), _cache_block_size(cache_block_size), _timer_size(timer_size),
+      _address_tag_mask(mask(tag_bits)), _timestamp_mask(mask(timestamp_bits)), set_timestamp_counter(num_sets, 0) {
     _log2_num_sets = (int) std::log2(num_sets);
     _log2_cache_block_size = (int) std::log2(cache_block_size);
 }
 
-HistorySampler::~HistorySampler() {
-    delete[] sample_data;
-    delete[] set_timestamp_counter;
+std::unique_ptr<HistorySampler> HistorySampler::create(const int num_sets, const int num_cache_sets, const int cache_block_size,
+                                                       const int timer_size, const int num_ways, const int tag_bits,
+                                                       const int timestamp_bits) {
+    return dispatchSampledGeometry(num_ways, tag_bits, timestamp_bits, [&](auto ways, auto tag, auto timestamp) {
+        return std::unique_ptr<HistorySampler>(
+            new GenericHistorySampler<decltype(ways)::value, decltype(tag), decltype(timestamp)>(
+                num_sets, num_cache_sets, cache_block_size, timer_size, tag_bits, timestamp_bits));
+    });
 }
 
-bool HistorySampler::sample(uint64_t addr, uint64_t PC, uint8_t *curr_timestamp, int set, uint16_t *last_PC, uint8_t *last_timestamp) {
-    if (SAMPLED_SET(set, _num_cache_sets)) {
+bool HistorySampler::isSampledSet(int set) const {
+    return SAMPLED_SET(set, _num_cache_sets);
+}
 
-        DPRINTF(HawkeyeReplDebug, "Sampler ---- Set hit: Set %d\n", set);
+template <int Ways, typename Tag, typename Timestamp>
+bool GenericHistorySampler<Ways, Tag, Timestamp>::sample(uint64_t addr, uint64_t PC, uint32_t *curr_timestamp, int set, uint16_t *last_PC, uint32_t *last_timestamp) {
+    if (!isSampledSet(set)) {
+        return false;
+    }
 
-        uint64_t set_index = (addr >> _log2_cache_block_size) % _num_sets;
-        uint16_t addr_tag = CRC(addr >> (_log2_cache_block_size + _log2_num_sets)) & ADDRESS_TAG_MASK;
-        uint16_t hashed_pc = CRC(PC) & HASHED_PC_MASK;
-        uint8_t timestamp = set_timestamp_counter[set_index];
+    DPRINTF(HawkeyeReplDebug, "Sampler ---- Set hit: Set %d\n", set);
 
-        DPRINTF(HawkeyeReplDebug, "Sampler ---- Set info: Set index %d, Address Tag: 0x%.8x, Hased PC: 0x%.8x, Current Timestamp: %d\n", set_index, addr_tag, hashed_pc, timestamp);
+    uint64_t set_index = (addr >> _log2_cache_block_size) % _num_sets;
+    Tag addr_tag = CRC(addr >> (_log2_cache_block_size + _log2_num_sets)) & _address_tag_mask;
+    uint16_t hashed_pc = CRC(PC) & HASHED_PC_MASK;
+    Timestamp timestamp = set_timestamp_counter[set_index] & _timestamp_mask;
 
-        *curr_timestamp = timestamp;
+    DPRINTF(HawkeyeReplDebug, "Sampler ---- Set info: Set index %d, Address Tag: 0x%.8x, Hased PC: 0x%.8x, Current Timestamp: %d\n", set_index, addr_tag, hashed_pc, timestamp);
 
-        if (!sample_data[set_index].access(addr_tag, hashed_pc, timestamp, last_PC, last_timestamp)) {
-            sample_data[set_index].insert(addr_tag, hashed_pc, timestamp);
-            set_timestamp_counter[set_index] = (set_timestamp_counter[set_index] + 1) % _timer_size;
+    *curr_timestamp = timestamp;
+    set_timestamp_counter[set_index] = (set_timestamp_counter[set_index] + 1) % _timer_size;
 
-            DPRINTF(HawkeyeReplDebug, "Sampler ---- Sampler miss handling: Last timestamp: %d, Current Timestamp: %d\n", *last_timestamp, timestamp);
-            return false;
+    auto &sampled_set = sample_data[set_index];
+    int way = sampled_set.find(addr_tag);
+    if (way < 0) {
+        // Fill the first invalid way, or replace the least recently used one
+        way = sampled_set.firstInvalid();
+        if (way < 0) {
+            way = sampled_set.lruWay();
         }
+        sampled_set.fill(way, addr_tag, hashed_pc, timestamp);
 
-        set_timestamp_counter[set_index] = (set_timestamp_counter[set_index] + 1) % _timer_size;
-        DPRINTF(HawkeyeReplDebug, "Sampler ---- Sampler hit: Last timestamp: %d, Current Timestamp: %d\n", *last_timestamp, timestamp);
-        return true;
-    } else {
+        DPRINTF(HawkeyeReplDebug, "Sampler ---- Sampler miss handling: Current Timestamp: %d\n", timestamp);
         return false;
     }
+
+    *last_PC = sampled_set.signature(way);
+    *last_timestamp = sampled_set.timestamp(way);
+    sampled_set.access(way, hashed_pc, timestamp);
+
+    DPRINTF(HawkeyeReplDebug, "Sampler ---- Sampler hit: Last timestamp: %d, Current Timestamp: %d\n", *last_timestamp, timestamp);
+    return true;
 }
 
 
@@ -4,145 +4,40 @@
  * Reference link: https://www.cs.utexas.edu/~lin/papers/isca16.pdf
  */
 
+#ifndef __MEM_CACHE_TAGS_HAWKEYE_SAMPLER_HH__
+#define __MEM_CACHE_TAGS_HAWKEYE_SAMPLER_HH__
+
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <set>
 #include <vector>
-#include <unordered_map>
 #include "base/sat_counter.hh"
 #include "base/trace.hh"
 #include "debug/HawkeyeReplDebug.hh"
+#include "mem/cache/tags/liveness_tree.hh"
+#include "mem/cache/tags/sampled_set.hh"
 
 namespace gem5 {
 
-// Warning: Sampled cache way is fixed (8)
-static constexpr uint32_t NUM_WAY_CACHE_SET = 8;
-static constexpr uint32_t HASHED_PC_LEN = 13;
-static constexpr uint64_t HASHED_PC_MASK = ((1 << HASHED_PC_LEN) - 1);
-static constexpr uint32_t TIMESTAMP_LEN = 8;
-static constexpr uint64_t TIMESTAMP_LEN_MASK = ((1 << TIMESTAMP_LEN) - 1);
-static constexpr uint32_t ADDRESS_TAG_LEN = 16;
-static constexpr uint64_t ADDRESS_TAG_MASK = ((1 << ADDRESS_TAG_LEN) - 1);
-
-
 /**
- * Entry: 2-byte Address, 2-byte PC, 1-byte timestamp
+ * Entry: Address tag, hashed PC, timestamp
  *
  * Sample the whold cache with 64 random sets. The prediction need 8x history of set associativity
  *
- * Set-associative cache: Each set has 128 entries (??? Which structure of this sampled cache)
+ * The geometry of the sampled sets (ways, tag and timestamp bits) is configurable, see GenericHistorySampler
  *
  * LRU replacement policy
  */
 class HistorySampler
 {
+  public:
+    /** Number of bits of the hashed PCs, which index the predictor */
+    static constexpr uint32_t HASHED_PC_LEN = 13;
+    static constexpr uint64_t HASHED_PC_MASK = ((1 << HASHED_PC_LEN) - 1);
 
   protected:
-    struct CacheLine
-    {
-
-      bool valid;
-
-      uint8_t lru;
-
-      uint64_t _address;
-
-      uint64_t _pc;
-
-      uint64_t _timestamp;
-
-      uint16_t getAddress() {
-        gem5_assert(_address < (1 << ADDRESS_TAG_LEN), "Address bits are wrong");
-        return _address;
-      }
-
-      uint16_t getPC() {
-        gem5_assert(_pc < (1 << HASHED_PC_LEN), "PC bits are wrong");
-        return _pc;
-      }
-
-      uint8_t getTimestamp() {
-        gem5_assert(_timestamp < (1 << TIMESTAMP_LEN), "timestamp bits are wrong");
-        return _timestamp;
-      }
-
-      void setPC(uint16_t PC) {
-        _pc = PC;
-      }
-
-      void setTimestamp(uint8_t timestamp) {
-        _timestamp = timestamp;
-      }
-
-      void setAddrTag(uint16_t addrtag) {
-        _address = addrtag;
-      }
-
-      CacheLine() : valid(false), lru(0), _address(0), _pc(0), _timestamp(0) {};
-
-    };
-
-    struct CacheSet
-    {
-      struct CacheLine ways[NUM_WAY_CACHE_SET];
-
-      void insert(uint16_t addr_tag, uint16_t PC, uint8_t timestamp) {
-        // Assume address and PC has been translated
-        bool debug_insert = false;
-
-        for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-          if (!ways[i].valid || (ways[i].valid && ways[i].lru == 0)) {
-            for (int j = 0; j < NUM_WAY_CACHE_SET; j++) {
-              if (ways[j].valid && ways[j].lru > 0) {
-                ways[j].lru -= 1;
-              }
-            }
-            ways[i].lru = NUM_WAY_CACHE_SET - 1;
-            ways[i].setAddrTag(addr_tag);
-            ways[i].setPC(PC);
-            ways[i].setTimestamp(timestamp);
-            ways[i].valid = true;
-
-            debug_insert = true;
-            break;
-          }
-        }
-
-        gem5_assert(debug_insert, "Sampled cache insert fails");
-      }
-
-      bool access(uint16_t addr_tag, uint16_t PC, uint8_t timestamp, uint16_t *last_PC, uint8_t *last_timestamp) {
-
-        for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-          if (ways[i].valid && addr_tag == ways[i].getAddress()) {
-            *last_PC = ways[i].getPC();
-            *last_timestamp = ways[i].getTimestamp();
-
-            ways[i].setPC(PC);
-            ways[i].setTimestamp(timestamp);
-
-            for (int j = 0; j < NUM_WAY_CACHE_SET; j++) {
-              if (ways[j].lru > ways[i].lru) {
-                ways[j].lru -= 1;
-              }
-            }
-            ways[i].lru = NUM_WAY_CACHE_SET - 1;
-            DPRINTF(HawkeyeReplDebug, "Sampler Cache Access ---- Sampler hit: Last timestamp: %d, Current Timestamp: %d, Valid: %d\n", *last_timestamp, timestamp, ways[i].valid);
-            return true;
-          }
-        }
-        return false;
-      }
-
-      CacheSet() {};
-    };
-
-  private:
-    struct CacheSet *sample_data;
-
-    uint64_t *set_timestamp_counter;
-
     // Sampler sets
     int _num_sets;
 
@@ -157,27 +52,78 @@ class HistorySampler
 
     int _timer_size;
 
-  public:
+    uint64_t _address_tag_mask;
 
-    HistorySampler(const int num_sets, const int num_cache_sets, const int cache_block_size, const int timer_size);
+    uint64_t _timestamp_mask;
 
-    ~HistorySampler();
+    std::vector<uint64_t> set_timestamp_counter;
 
-    bool sample(uint64_t addr, uint64_t PC, uint8_t *curr_timestamp, int set, uint16_t *last_PC, uint8_t *last_timestamp);
+    /** Whether a set of the target cache is sampled */
+    bool isSampledSet(int set) const;
+
+    HistorySampler(const int num_sets, const int num_cache_sets, const int cache_block_size, const int timer_size,
+                   const int tag_bits, const int timestamp_bits);
+
+  public:
+
+    virtual ~HistorySampler() = default;
+
+    /**
+     * Create a sampler with the given geometry.
+     *
+     * @param num_ways Number of ways of each sampled set
+     * @param tag_bits Number of bits of the address tags
+     * @param timestamp_bits Number of bits of the timestamps
+     */
+    static std::unique_ptr<HistorySampler> create(const int num_sets, const int num_cache_sets, const int cache_block_size,
+                                                  const int timer_size, const int num_ways, const int tag_bits,
+                                                  const int timestamp_bits);
+
+    /**
+     * Record an access to the target cache if its set is sampled.
+     *
+     * @return Whether the access hit in the sampler, in which case last_PC and last_timestamp describe the previous access to the line
+     */
+    virtual bool sample(uint64_t addr, uint64_t PC, uint32_t *curr_timestamp, int set, uint16_t *last_PC, uint32_t *last_timestamp) = 0;
 
     uint64_t getCurrentTimestamp(int set);
 
 };
 
+/**
+ * History sampler whose sets have Ways ways, address tags stored as Tag and timestamps stored as Timestamp.
+ */
+template <int Ways, typename Tag, typename Timestamp>
+class GenericHistorySampler : public HistorySampler
+{
+  private:
+    std::vector<SampledSet<Ways, Tag, Timestamp>> sample_data;
+
+  public:
+    GenericHistorySampler(const int num_sets, const int num_cache_sets, const int cache_block_size, const int timer_size,
+                          const int tag_bits, const int timestamp_bits)
+        : HistorySampler(num_sets, num_cache_sets, cache_block_size, timer_size, tag_bits, timestamp_bits),
+          sample_data(num_sets) {}
+
+    bool sample(uint64_t addr, uint64_t PC, uint32_t *curr_timestamp, int set, uint16_t *last_PC, uint32_t *last_timestamp) override;
+};
+
+/**
+ * OPTgen occupancy vector: a ring of per-quantum liveness counters backed by a LivenessTree, so that deciding
+ * whether a reuse would have hit under OPT and recording it are logarithmic in the vector size.
+ *
+ * OPT hits and misses are counted per cache size the vector was run with, see setCacheSize().
+ */
 class OccupencyVector
 {
 
   private:
-    std::vector<unsigned int> liveness_history;
+    LivenessTree liveness_history;
 
-    std::unordered_map<int, uint64_t> num_cache;
+    /** OPT hits and misses, indexed by the cache size they were decided with */
+    std::vector<uint64_t> num_cache;
 
-    std::unordered_map<int, uint64_t> num_dont_cache;
+    std::vector<uint64_t> num_dont_cache;
 
     uint64_t access;
 
@@ -206,9 +152,7 @@ class OccupencyVector
 
     uint64_t get_vector_size();
 
-    void setCacheSize(uint64_t cache_size) {
-      CACHE_SIZE = cache_size;
-    }
+    void setCacheSize(uint64_t cache_size);
 
     uint64_t getCacheSize() {
       return CACHE_SIZE;
@@ -246,4 +190,6 @@ class PCBasedPredictor
     int log2_num_entries();
 };
 
-}
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_HAWKEYE_SAMPLER_HH__
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Occupancy history of the OPTgen simulation used by the Hawkeye family
+ * of replacement policies.
+ */
+
+#ifndef __MEM_CACHE_TAGS_LIVENESS_TREE_HH__
+#define __MEM_CACHE_TAGS_LIVENESS_TREE_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * A circular buffer of occupancy counters with logarithmic range
+ * queries. OPTgen asks, for every sampled reuse, whether any time quantum
+ * between the previous and the current access to a line is already full,
+ * and if not increments every counter in that interval. Walking the
+ * interval makes both operations linear in the reuse distance; keeping the
+ * counters in the leaves of a segment tree with lazy range increments
+ * makes them O(log n).
+ *
+ * Intervals are given as [first, last) slot indices of the ring and wrap
+ * around the end of the buffer when last < first. An interval with
+ * first == last is empty.
+ */
+class LivenessTree
+{
+  private:
+    /** Number of slots of the ring */
+    const uint32_t capacity;
+
+    /** Maximum of each node's subtree, including its own pending add */
+    std::vector<uint32_t> maxima;
+
+    /** Increment still to be pushed down to each node's children */
+    std::vector<uint32_t> pending;
+
+    void
+    push(uint32_t node)
+    {
+        if (pending[node]) {
+            for (uint32_t child : {2 * node, 2 * node + 1}) {
+                maxima[child] += pending[node];
+                pending[child] += pending[node];
+            }
+            pending[node] = 0;
+        }
+    }
+
+    uint32_t
+    maxOf(uint32_t node, uint32_t lo, uint32_t hi,
+          uint32_t first, uint32_t last)
+    {
+        if (first <= lo && hi <= last)
+            return maxima[node];
+        push(node);
+        const uint32_t mid = (lo + hi) / 2;
+        uint32_t result = 0;
+        if (first < mid)
+            result = maxOf(2 * node, lo, mid, first, last);
+        if (mid < last)
+            result = std::max(result, maxOf(2 * node + 1, mid, hi,
+                                            first, last));
+        return result;
+    }
+
+    void
+    addTo(uint32_t node, uint32_t lo, uint32_t hi,
+          uint32_t first, uint32_t last)
+    {
+        if (first <= lo && hi <= last) {
+            maxima[node]++;
+            pending[node]++;
+            return;
+        }
+        push(node);
+        const uint32_t mid = (lo + hi) / 2;
+        if (first < mid)
+            addTo(2 * node, lo, mid, first, last);
+        if (mid < last)
+            addTo(2 * node + 1, mid, hi, first, last);
+        maxima[node] = std::max(maxima[2 * node], maxima[2 * node + 1]);
+    }
+
+    void
+    clearAt(uint32_t node, uint32_t lo, uint32_t hi, uint32_t slot)
+    {
+        if (hi - lo == 1) {
+            maxima[node] = 0;
+            return;
+        }
+        push(node);
+        const uint32_t mid = (lo + hi) / 2;
+        if (slot < mid)
+            clearAt(2 * node, lo, mid, slot);
+        else
+            clearAt(2 * node + 1, mid, hi, slot);
+        maxima[node] = std::max(maxima[2 * node], maxima[2 * node + 1]);
+    }
+
+  public:
+    LivenessTree(uint32_t capacity)
+        : capacity(capacity), maxima(4 * capacity, 0),
+          pending(4 * capacity, 0)
+    {
+        fatal_if(capacity == 0, "The liveness history cannot be empty");
+    }
+
+    uint32_t size() const { return capacity; }
+
+    /** Largest counter in the circular interval [first, last) */
+    uint32_t
+    max(uint32_t first, uint32_t last)
+    {
+        if (first == last)
+            return 0;
+        if (first < last)
+            return maxOf(1, 0, capacity, first, last);
+        uint32_t result = maxOf(1, 0, capacity, first, capacity);
+        if (last > 0)
+            result = std::max(result, maxOf(1, 0, capacity, 0, last));
+        return result;
+    }
+
+    /** Increment every counter in the circular interval [first, last) */
+    void
+    increment(uint32_t first, uint32_t last)
+    {
+        if (first == last)
+            return;
+        if (first < last) {
+            addTo(1, 0, capacity, first, last);
+        } else {
+            addTo(1, 0, capacity, first, capacity);
+            if (last > 0)
+                addTo(1, 0, capacity, 0, last);
+        }
+    }
+
+    /** Reset the counter of a slot, which starts a new time quantum */
+    void clear(uint32_t slot) { clearAt(1, 0, capacity, slot); }
+
+    /** Value of a single counter */
+    uint32_t
+    at(uint32_t slot)
+    {
+        return maxOf(1, 0, capacity, slot, slot + 1);
+    }
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_LIVENESS_TREE_HH__
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/liveness_tree.hh"
+
+using namespace gem5;
+
+TEST(LivenessTreeTest, Wraparound)
+{
+    LivenessTree tree(8);
+    ASSERT_EQ(tree.max(0, 8 % 8), 0);
+
+    tree.increment(6, 2);
+    ASSERT_EQ(tree.at(6), 1);
+    ASSERT_EQ(tree.at(7), 1);
+    ASSERT_EQ(tree.at(0), 1);
+    ASSERT_EQ(tree.at(1), 1);
+    ASSERT_EQ(tree.at(2), 0);
+    ASSERT_EQ(tree.at(5), 0);
+    ASSERT_EQ(tree.max(2, 6), 0);
+    ASSERT_EQ(tree.max(5, 3), 1);
+
+    // Empty interval
+    tree.increment(3, 3);
+    ASSERT_EQ(tree.max(3, 3), 0);
+    ASSERT_EQ(tree.max(0, 8 % 8), 0);
+
+    tree.clear(7);
+    ASSERT_EQ(tree.at(7), 0);
+    ASSERT_EQ(tree.at(6), 1);
+}
+
+/** Compare against the linear walk OPTgen used to do */
+TEST(LivenessTreeTest, MatchesLinearWalk)
+{
+    for (uint32_t capacity : {1u, 7u, 128u, 1000u}) {
+        LivenessTree tree(capacity);
+        std::vector<uint32_t> ref(capacity, 0);
+        std::mt19937 rng(capacity);
+
+        for (int i = 0; i < 20000; i++) {
+            const uint32_t first = rng() % capacity;
+            const uint32_t last = rng() % capacity;
+            const uint32_t limit = rng() % 16;
+
+            uint32_t expected = 0;
+            for (uint32_t j = first; j != last; j = (j + 1) % capacity)
+                expected = std::max(expected, ref[j]);
+            ASSERT_EQ(tree.max(first, last), expected);
+
+            if (expected < limit) {
+                tree.increment(first, last);
+                for (uint32_t j = first; j != last; j = (j + 1) % capacity)
+                    ref[j]++;
+            }
+
+            tree.clear(last);
+            ref[last] = 0;
+        }
+
+        for (uint32_t j = 0; j < capacity; j++)
+            ASSERT_EQ(tree.at(j), ref[j]);
+    }
+}
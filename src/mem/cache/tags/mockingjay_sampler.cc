@@ -48,7 +48,7 @@ uint64_t get_pc_signature(uint64_t pc, bool hit, bool prefetch, uint32_t core, u
             pc = pc | 1;
         }
         pc = CRC_HASH(pc);
-        pc = (pc << (64 - HASHED_PC_LEN)) >> (64 - HASHED_PC_LEN);
+        pc = (pc << (64 - SampledCache::HASHED_PC_LEN)) >> (64 - SampledCache::HASHED_PC_LEN);
     } else {
         pc = pc << 1;
         if (prefetch) {
@@ -57,13 +57,15 @@ uint64_t get_pc_signature(uint64_t pc, bool hit, bool prefetch, uint32_t core, u
         pc = pc << 2;
         pc = pc | core;
         pc = CRC_HASH(pc);
-        pc = (pc << (64 - HASHED_PC_LEN)) >> (64 - HASHED_PC_LEN);
+        pc = (pc << (64 - SampledCache::HASHED_PC_LEN)) >> (64 - SampledCache::HASHED_PC_LEN);
     }
     return pc;
 }
 
-ReuseDistPredictor::ReuseDistPredictor(const int num_entries, const int bits_per_entry, const int aging_clock_size, const int num_cpus) : 
-                                       num_entries(num_entries), bits_per_entry(bits_per_entry), _granularity(aging_clock_size), _num_cpus(num_cpus) {
+ReuseDistPredictor::ReuseDistPredictor(const int num_entries, const int bits_per_entry, const int aging_clock_size, const int num_cpus,
+                                       const int timestamp_period) :
+                                       num_entries(num_entries), bits_per_entry(bits_per_entry), _granularity(aging_clock_size), _num_cpus(num_cpus),
+                                       _timestamp_period(timestamp_period) {
     counters = new int[num_entries];
     for (int i = 0; i < num_entries; i++) {
         counters[i] = -1;
@@ -76,7 +78,7 @@ ReuseDistPredictor::~ReuseDistPredictor() {
     delete[] counters;
 }
 
-void ReuseDistPredictor::train(uint64_t last_PC, bool sampled_cache_hit, uint8_t curr_timestamp, uint8_t last_timestamp, bool evict) {
+void ReuseDistPredictor::train(uint64_t last_PC, bool sampled_cache_hit, uint32_t curr_timestamp, uint32_t last_timestamp, bool evict) {
     // TODO: Mockingjay train mechanism
     // Sampled cache hit
     //  1. If it first-time train, then use difference directly
@@ -86,7 +88,7 @@ void ReuseDistPredictor::train(uint64_t last_PC, bool sampled_cache_hit, uint8_t
     if (sampled_cache_hit) {
         DPRINTF(MockingjayDebug, "Predictor (train) ---- Sample cached hit: Last signature %ld, Current timestamp: %d, Last Timestamp: %d\n", 
                 last_PC, curr_timestamp, last_timestamp);
-        int sample = time_elapsed(curr_timestamp, last_timestamp);
+        int sample = time_elapsed(curr_timestamp, last_timestamp, _timestamp_period);
         if (sample <= max_value) {
             if (counters[last_PC] == -1) {
                 counters[last_PC] = sample;
@@ -157,26 +159,63 @@ int ReuseDistPredictor::getInfRd() {
     return max_value;
 }
 
-SampledCache::SampledCache(const int num_sampled_sets, const int num_cache_sets, const int cache_block_size, const int timer_size, 
-                           const int num_cpus, const int num_sampled_internal_sets)
-    : _num_sampled_sets(num_sampled_sets), _num_cache_sets(num_cache_sets), _cache_block_size(cache_block_size), _timer_size(1 << timer_size), 
-        _num_cpus(num_cpus), _num_sampled_internal_sets(num_sampled_internal_sets) {
-    sample_data = new CacheSet[num_sampled_sets];
-    set_timestamp_counter = new uint64_t[num_sampled_sets];
-    for (int i = 0; i < num_sampled_sets; i++) {
-        set_timestamp_counter[i] = 0;
-    }
+SampledCache::SampledCache(const int num_sampled_sets, const int num_cache_sets, const int cache_block_size, const int timer_size,
+                           const int num_cpus, const int num_sampled_internal_sets, const int tag_bits, const int timestamp_bits)
+    : _num_sampled_sets(num_sampled_sets), _num_cache_sets(num_cache_sets), _cache_block_size(cache_block_size), _timer_size(1 << timer_size),
+        _num_cpus(num_cpus), _num_sampled_internal_sets(num_sampled_internal_sets), _address_tag_mask(mask(tag_bits)),
+        _timestamp_mask(mask(timestamp_bits)), _timestamp_period(1 << std::min(timer_size, timestamp_bits)),
+        set_timestamp_counter(num_sampled_sets, 0) {
     _log2_num_sampled_sets = (int) std::log2(num_sampled_sets);
     _log2_cache_block_size = (int) std::log2(cache_block_size);
     _log2_sampled_internal_sets = (int) std::log2(num_sampled_internal_sets);
 }
 
-SampledCache::~SampledCache() {
-    delete[] sample_data;
-    delete[] set_timestamp_counter;
+std::unique_ptr<SampledCache> SampledCache::create(const int num_sampled_sets, const int num_cache_sets, const int cache_block_size,
+                                                   const int timer_size, const int num_cpus, const int num_sampled_internal_sets,
+                                                   const int num_ways, const int tag_bits, const int timestamp_bits) {
+    return dispatchSampledGeometry(num_ways, tag_bits, timestamp_bits, [&](auto ways, auto tag, auto timestamp) {
+        return std::unique_ptr<SampledCache>(
+            new GenericSampledCache<decltype(ways)::value, decltype(tag), decltype(timestamp)>(
+                num_sampled_sets, num_cache_sets, cache_block_size, timer_size, num_cpus, num_sampled_internal_sets,
+                tag_bits, timestamp_bits));
+    });
+}
+
+template <int Ways, typename Tag, typename Timestamp>
+bool GenericSampledCache<Ways, Tag, Timestamp>::insert(SampledSet<Ways, Tag, Timestamp> &sampled_set, Tag addr_tag, uint16_t PC,
+                                                       Timestamp timestamp, uint32_t *evict_timestamp, uint16_t *evict_signature,
+                                                       uint64_t inf_rd) {
+    // Assume address and PC has been translated
+    bool insert_with_evict = true;
+    int evict_way = sampled_set.lastInvalid();
+
+    if (evict_way >= 0) {
+        insert_with_evict = false;
+    } else {
+        // Lines that have not been reused for longer than the infinite reuse distance are scans
+        for (int i = 0; i < Ways; i++) {
+            if (time_elapsed(timestamp, sampled_set.timestamp(i), _timestamp_period) > inf_rd) {
+                evict_way = i;
+            }
+        }
+    }
+
+    if (evict_way < 0) {
+        evict_way = sampled_set.lruWay();
+        gem5_assert(evict_way >= 0, "There should be one cache line evicted.");
+    }
+
+    *evict_signature = sampled_set.signature(evict_way);
+    *evict_timestamp = sampled_set.timestamp(evict_way);
+    sampled_set.fill(evict_way, addr_tag, PC, timestamp);
+
+    return insert_with_evict;
 }
 
-bool SampledCache:: sample(uint64_t addr, uint64_t PC, uint8_t *curr_timestamp, int set, uint16_t *last_PC, uint8_t *last_timestamp, bool hit, bool *evict, bool *sampled_hit, int core_id, uint64_t inf_rd) {
+template <int Ways, typename Tag, typename Timestamp>
+bool GenericSampledCache<Ways, Tag, Timestamp>::sample(uint64_t addr, uint64_t PC, uint32_t *curr_timestamp, int set, uint16_t *last_PC,
+                                                       uint32_t *last_timestamp, bool hit, bool *evict, bool *sampled_hit, int core_id,
+                                                       uint64_t inf_rd) {
     int log2_num_cache_sets = (int) std::log2(_num_cache_sets);
     int log2_num_sets = _log2_num_sampled_sets - _log2_sampled_internal_sets;
     uint64_t num_sets_mask = (1 << log2_num_sets) - 1;
@@ -186,26 +225,30 @@ bool SampledCache:: sample(uint64_t addr, uint64_t PC, uint8_t *curr_timestamp,
         
         DPRINTF(MockingjayDebug, "Sampler ---- Set hit: Cache Set index %d\n", set);
 
-        uint16_t addr_tag = (addr >> (_log2_cache_block_size + _log2_sampled_internal_sets + log2_num_cache_sets)) & ADDRESS_TAG_MASK;
+        Tag addr_tag = (addr >> (_log2_cache_block_size + _log2_sampled_internal_sets + log2_num_cache_sets)) & _address_tag_mask;
 
         uint16_t addr_tag_to_set = (addr >> (_log2_cache_block_size + log2_num_cache_sets)) & num_sampled_internal_sets_mask;
         uint64_t set_index = (addr_tag_to_set << log2_num_sets) | (set & num_sets_mask);
         gem5_assert(set_index < _num_sampled_sets, "Set index should be within sampled set entries, Index: %d", set_index);
 
         uint16_t hashed_pc = get_pc_signature(PC, hit, false, core_id, _num_cpus) & HASHED_PC_MASK;
-        uint8_t timestamp = set_timestamp_counter[set_index];
+        Timestamp timestamp = set_timestamp_counter[set_index] & _timestamp_mask;
 
         DPRINTF(MockingjayDebug, "Sampler ---- Set info: Set index %d, Address Tag: 0x%.8x, Hased PC: 0x%.8x, Current Timestamp: %d\n", set_index, addr_tag, hashed_pc, timestamp);
 
         *curr_timestamp = timestamp;
+        set_timestamp_counter[set_index] = (set_timestamp_counter[set_index] + 1) % _timer_size;
 
-        if (!sample_data[set_index].access(addr_tag, hashed_pc, timestamp, last_PC, last_timestamp)) {
-            set_timestamp_counter[set_index] = (set_timestamp_counter[set_index] + 1) % _timer_size;
-            *evict = sample_data[set_index].insert(addr_tag, hashed_pc, timestamp, last_timestamp, last_PC, inf_rd);
+        auto &sampled_set = sample_data[set_index];
+        int way = sampled_set.find(addr_tag);
+        if (way < 0) {
+            *evict = insert(sampled_set, addr_tag, hashed_pc, timestamp, last_timestamp, last_PC, inf_rd);
             *sampled_hit = false;
             DPRINTF(MockingjayDebug, "Sampler ---- Sampler miss handling: Last timestamp: %d, Current Timestamp: %d\n", *last_timestamp, set_timestamp_counter[set_index]);
         } else {
-            set_timestamp_counter[set_index] = (set_timestamp_counter[set_index] + 1) % _timer_size;
+            *last_PC = sampled_set.signature(way);
+            *last_timestamp = sampled_set.timestamp(way);
+            sampled_set.access(way, hashed_pc, timestamp);
             *evict = false;
             *sampled_hit = true;
             DPRINTF(MockingjayDebug, "Sampler ---- Sampler hit: Last timestamp: %d, Current Timestamp: %d\n", *last_timestamp, set_timestamp_counter[set_index]);
@@ -216,4 +259,4 @@ bool SampledCache:: sample(uint64_t addr, uint64_t PC, uint8_t *curr_timestamp,
     }
 }
 
-}
\ No newline at end of file
+} // namespace gem5
@@ -4,196 +4,50 @@
  * Reference link: https://www.cs.utexas.edu/~lin/papers/hpca22.pdf
  *
  */
+#ifndef __MEM_CACHE_TAGS_MOCKINGJAY_SAMPLER_HH__
+#define __MEM_CACHE_TAGS_MOCKINGJAY_SAMPLER_HH__
+
 #include <cassert>
 #include <cstdint>
+#include <memory>
 #include <random>
 #include <set>
+#include <vector>
 #include "base/trace.hh"
 #include "debug/MockingjayDebug.hh"
 #include "base/sat_counter.hh"
+#include "mem/cache/tags/sampled_set.hh"
 
 namespace gem5 {
 
-static constexpr uint32_t NUM_WAY_CACHE_SET = 5;
-static constexpr uint32_t HASHED_PC_LEN = 11;
-static constexpr uint64_t HASHED_PC_MASK = ((1 << HASHED_PC_LEN) - 1);
-static constexpr uint32_t TIMESTAMP_LEN = 8;
-static constexpr uint64_t TIMESTAMP_LEN_MASK = ((1 << TIMESTAMP_LEN) - 1);
-static constexpr uint32_t ADDRESS_TAG_LEN = 10;
-static constexpr uint64_t ADDRESS_TAG_MASK = ((1 << ADDRESS_TAG_LEN) - 1);
-
-static int time_elapsed(int global, int local) {
+/**
+ * Time elapsed between two timestamps of a counter wrapping around every period ticks
+ */
+static inline int time_elapsed(int global, int local, int period) {
     if (global >= local) {
         return global - local;
     }
-    global = global + (1 << TIMESTAMP_LEN);
+    global = global + period;
     return global - local;
 }
 
 /**
- * Entry: 2-byte Address, 2-byte PC, 1-byte timestamp
+ * Entry: Address tag, hashed PC, timestamp
  *
  * Sample the whold cache with 64 random sets. The prediction need 8x history of set associativity
  *
- * Set-associative cache: Each set has 128 entries (??? Which structure of this sampled cache)
+ * The geometry of the sampled sets (ways, tag and timestamp bits) is configurable, see GenericSampledCache
  *
  * LRU replacement policy
  */
 class SampledCache
 {
+  public:
+    /** Number of bits of the hashed PCs, which index the predictor */
+    static constexpr uint32_t HASHED_PC_LEN = 11;
+    static constexpr uint64_t HASHED_PC_MASK = ((1 << HASHED_PC_LEN) - 1);
 
   protected:
-    struct CacheLine
-    {
-
-      bool valid;
-
-      uint8_t lru;
-
-      uint64_t _address;
-
-      uint64_t _pc;
-
-      uint64_t _timestamp;
-
-      uint16_t getAddress() {
-        gem5_assert(_address < (1 << ADDRESS_TAG_LEN), "Address bits are wrong, address: 0x%.8x", _address);
-        return _address;
-      }
-
-      uint16_t getPC() {
-        gem5_assert(_pc < (1 << HASHED_PC_LEN), "PC bits are wrong");
-        return _pc;
-      }
-
-      uint8_t getTimestamp() {
-        gem5_assert(_timestamp < (1 << TIMESTAMP_LEN), "timestamp bits are wrong");
-        return _timestamp;
-      }
-
-      void setPC(uint16_t PC) {
-        gem5_assert(_pc < (1 << HASHED_PC_LEN), "PC bits are wrong");
-        _pc = PC;
-      }
-
-      void setTimestamp(uint8_t timestamp) {
-        gem5_assert(_timestamp < (1 << TIMESTAMP_LEN), "timestamp bits are wrong");
-        _timestamp = timestamp;
-      }
-
-      void setAddrTag(uint16_t addrtag) {
-        gem5_assert(addrtag < (1 << ADDRESS_TAG_LEN), "Address bits are wrong");
-        _address = addrtag;
-      }
-
-      CacheLine() : valid(false), lru(0), _address(0), _pc(0), _timestamp(0) {};
-
-    };
-
-    struct CacheSet
-    {
-      struct CacheLine ways[NUM_WAY_CACHE_SET];
-
-      bool insert(uint16_t addr_tag, uint16_t PC, uint8_t timestamp, uint8_t *evict_timestamp, uint16_t *evict_signature, uint64_t inf_rd) {
-        // Assume address and PC has been translated
-        bool insert_with_evict = false;
-        int evict_way = -1;
-        int evict_lru = NUM_WAY_CACHE_SET;
-
-        for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-          if (!ways[i].valid) {
-            evict_way = i;
-            evict_lru = 0;
-          }
-        }
-
-        // Only one way will be evicted
-        if (evict_way < 0) {
-          for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-            if (time_elapsed(timestamp, ways[i].getTimestamp()) > inf_rd) {
-              evict_way = i;
-              evict_lru = ways[i].lru;
-              insert_with_evict = true;
-            }
-          }
-        }
-
-        if (evict_way < 0) {
-          for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-            if (ways[i].valid && ways[i].lru < evict_lru) {
-              evict_lru = ways[i].lru;
-              evict_way = i;
-            } else if (ways[i].valid && ways[i].lru == evict_lru) {
-              panic("LRU for sampled cache should not have the same value: Evict way: %d, Evict LRU value: %d, LRU: %d %d %d %d %d", 
-                    evict_way, evict_lru, ways[0].lru, ways[1].lru, ways[2].lru, ways[3].lru, ways[4].lru);
-            }
-          }
-          gem5_assert(evict_way >= 0, "There should be one cache line evicted.");
-          insert_with_evict = true;
-        }
-
-        *evict_signature = ways[evict_way].getPC();
-        *evict_timestamp = ways[evict_way].getTimestamp();
-        for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-          if (ways[i].valid && ways[i].lru > evict_lru) {
-            gem5_assert(ways[i].lru > 0, "LRU bit cannot be negative");
-            ways[i].lru -= 1;
-          }
-        }
-        ways[evict_way].lru = NUM_WAY_CACHE_SET - 1;
-        ways[evict_way].setAddrTag(addr_tag);
-        ways[evict_way].setPC(PC);
-        ways[evict_way].setTimestamp(timestamp);
-        ways[evict_way].valid = true;
-
-        return insert_with_evict;
-      }
-
-      bool access(uint16_t addr_tag, uint16_t PC, uint8_t timestamp, uint16_t *last_PC, uint8_t *last_timestamp) {
-
-        for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-          if (ways[i].valid && addr_tag == ways[i].getAddress()) {
-            *last_PC = ways[i].getPC();
-            *last_timestamp = ways[i].getTimestamp();
-
-            ways[i].setPC(PC);
-            ways[i].setTimestamp(timestamp);
-
-            for (int j = 0; j < NUM_WAY_CACHE_SET; j++) {
-              if (ways[j].lru > ways[i].lru) {
-                ways[j].lru -= 1;
-              }
-            }
-            ways[i].lru = NUM_WAY_CACHE_SET - 1;
-            return true;
-          }
-        }
-        return false;
-      }
-
-      bool invalidate(uint16_t addr_tag) {
-        for (int i = 0; i < NUM_WAY_CACHE_SET; i++) {
-          if (addr_tag == ways[i].getAddress()) {
-            ways[i].valid = false;
-            for (int j = 0; j < NUM_WAY_CACHE_SET; j++) {
-              if (i != j && ways[j].lru > ways[i].lru) {
-                ways[j].lru -= 1;
-              }
-            }
-            return true;
-          }
-        }
-        return false;
-      }
-
-      CacheSet() {};
-    };
-
-  private:
-    struct CacheSet *sample_data;
-
-    uint64_t *set_timestamp_counter;
-
     int _num_sampled_sets;
 
     int _num_cache_sets;
@@ -212,18 +66,72 @@ class SampledCache
 
     int _log2_sampled_internal_sets;
 
+    uint64_t _address_tag_mask;
+
+    uint64_t _timestamp_mask;
+
+    /** Period of the stored timestamps, after which they wrap around */
+    int _timestamp_period;
+
+    std::vector<uint64_t> set_timestamp_counter;
+
+    SampledCache(const int num_sampled_sets, const int num_cache_sets, const int cache_block_size, const int timer_size,
+                 const int num_cpus, const int num_sampled_internal_sets, const int tag_bits, const int timestamp_bits);
+
   public:
 
-    SampledCache(const int num_sampled_sets, const int num_cache_sets, const int cache_block_size, const int timer_size, const int num_cpus, const int num_sampled_internal_sets);
+    virtual ~SampledCache() = default;
 
-    ~SampledCache();
+    /**
+     * Create a sampled cache with the given geometry.
+     *
+     * @param num_ways Number of ways of each sampled set
+     * @param tag_bits Number of bits of the address tags
+     * @param timestamp_bits Number of bits of the timestamps
+     */
+    static std::unique_ptr<SampledCache> create(const int num_sampled_sets, const int num_cache_sets, const int cache_block_size,
+                                                const int timer_size, const int num_cpus, const int num_sampled_internal_sets,
+                                                const int num_ways, const int tag_bits, const int timestamp_bits);
 
-    bool sample(uint64_t addr, uint64_t PC, uint8_t *curr_timestamp, int set, uint16_t *last_PC, uint8_t *last_timestamp, bool hit, bool *evict, bool *sample_hit, int core_id, uint64_t inf_rd);
+    virtual bool sample(uint64_t addr, uint64_t PC, uint32_t *curr_timestamp, int set, uint16_t *last_PC, uint32_t *last_timestamp,
+                        bool hit, bool *evict, bool *sample_hit, int core_id, uint64_t inf_rd) = 0;
+
+    /** Period of the timestamps returned by sample */
+    int getTimestampPeriod() const { return _timestamp_period; }
 
     uint64_t getCurrentTimestamp(int set);
 
 };
 
+/**
+ * Sampled cache whose sets have Ways ways, address tags stored as Tag and timestamps stored as Timestamp.
+ */
+template <int Ways, typename Tag, typename Timestamp>
+class GenericSampledCache : public SampledCache
+{
+  private:
+    std::vector<SampledSet<Ways, Tag, Timestamp>> sample_data;
+
+    /**
+     * Insert a line in a set, replacing (in order of preference) the last invalid way, the last line whose reuse distance
+     * is over inf_rd, or the least recently used line.
+     *
+     * @return Whether a valid line has been evicted, in which case evict_signature and evict_timestamp describe it
+     */
+    bool insert(SampledSet<Ways, Tag, Timestamp> &sampled_set, Tag addr_tag, uint16_t PC, Timestamp timestamp,
+                uint32_t *evict_timestamp, uint16_t *evict_signature, uint64_t inf_rd);
+
+  public:
+    GenericSampledCache(const int num_sampled_sets, const int num_cache_sets, const int cache_block_size, const int timer_size,
+                        const int num_cpus, const int num_sampled_internal_sets, const int tag_bits, const int timestamp_bits)
+        : SampledCache(num_sampled_sets, num_cache_sets, cache_block_size, timer_size, num_cpus, num_sampled_internal_sets,
+                       tag_bits, timestamp_bits),
+          sample_data(num_sampled_sets) {}
+
+    bool sample(uint64_t addr, uint64_t PC, uint32_t *curr_timestamp, int set, uint16_t *last_PC, uint32_t *last_timestamp,
+                bool hit, bool *evict, bool *sample_hit, int core_id, uint64_t inf_rd) override;
+};
+
 /**
  * 3-bit saturating counter, high-order bit determines whether it is cache-averse (0) or cache-friendly (1)
  *
@@ -248,13 +156,17 @@ class ReuseDistPredictor
 
     int _num_cpus;
 
+    /** Period of the sampler timestamps */
+    int _timestamp_period;
+
   public:
 
-    ReuseDistPredictor(const int num_entries, const int bits_per_entry, const int aging_clock_size, const int num_cpus);
+    ReuseDistPredictor(const int num_entries, const int bits_per_entry, const int aging_clock_size, const int num_cpus,
+                       const int timestamp_period);
 
     ~ReuseDistPredictor();
 
-    void train(uint64_t last_PC, bool sampled_cache_hit, uint8_t curr_timestamp, uint8_t last_timestamp, bool evict);
+    void train(uint64_t last_PC, bool sampled_cache_hit, uint32_t curr_timestamp, uint32_t last_timestamp, bool evict);
 
     uint16_t predict(uint64_t PC, bool hit, int core_id, int etr_inf);
 
@@ -265,4 +177,6 @@ class ReuseDistPredictor
     int getInfRd();
 };
 
-}
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_MOCKINGJAY_SAMPLER_HH__
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Sets of the sampled caches used by the Hawkeye and Mockingjay
+ * replacement policies to observe the reuse of a few sets of the target
+ * cache.
+ */
+
+#ifndef __MEM_CACHE_TAGS_SAMPLED_SET_HH__
+#define __MEM_CACHE_TAGS_SAMPLED_SET_HH__
+
+#include <cstdint>
+#include <type_traits>
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * A set of a sampled cache, storing for each way an address tag, the
+ * signature (hashed PC) of its last access and the timestamp of that
+ * access. The fields are kept in packed arrays so that a lookup is a
+ * single compare over the tag array, and recency is tracked with per-way
+ * age stamps rather than LRU ranks, so that an access is O(1) instead of
+ * renumbering all the ways.
+ *
+ * @tparam Ways Associativity of the set, at most 64.
+ * @tparam Tag Storage of the address tags.
+ * @tparam Timestamp Storage of the timestamps.
+ */
+template <int Ways, typename Tag, typename Timestamp>
+class SampledSet
+{
+    static_assert(Ways > 0 && Ways <= 64, "Unsupported number of ways");
+    static_assert(std::is_unsigned_v<Tag> && std::is_unsigned_v<Timestamp>,
+                  "Tags and timestamps are unsigned");
+
+  private:
+    Tag tags[Ways] = {};
+    uint16_t signatures[Ways] = {};
+    Timestamp timestamps[Ways] = {};
+
+    /** Value of useClock when each way was last accessed. */
+    uint64_t lastUse[Ways] = {};
+
+    /** Number of accesses to the set so far. */
+    uint64_t useClock = 0;
+
+    /** Bit i is set if way i is valid. */
+    uint64_t validWays = 0;
+
+    static constexpr uint64_t AllWays = mask(Ways);
+
+  public:
+    static constexpr int NumWays = Ways;
+
+    /**
+     * Look an address tag up.
+     *
+     * @return The way holding the tag, or -1 on a miss.
+     */
+    int
+    find(Tag tag) const
+    {
+        uint64_t matches = 0;
+        for (int way = 0; way < Ways; way++) {
+            matches |= uint64_t(tags[way] == tag) << way;
+        }
+        matches &= validWays;
+        return matches ? ctz64(matches) : -1;
+    }
+
+    bool isValid(int way) const { return validWays & (1ULL << way); }
+    bool isFull() const { return validWays == AllWays; }
+
+    /** First invalid way, or -1 if the set is full. */
+    int
+    firstInvalid() const
+    {
+        return isFull() ? -1 : ctz64(~validWays & AllWays);
+    }
+
+    /** Last invalid way, or -1 if the set is full. */
+    int
+    lastInvalid() const
+    {
+        return isFull() ? -1 : findMsbSet(~validWays & AllWays);
+    }
+
+    /** Least recently used valid way, or -1 if the set is empty. */
+    int
+    lruWay() const
+    {
+        int victim = -1;
+        for (int way = 0; way < Ways; way++) {
+            if (isValid(way) &&
+                (victim < 0 || lastUse[way] < lastUse[victim])) {
+                victim = way;
+            }
+        }
+        return victim;
+    }
+
+    Tag tag(int way) const { return tags[way]; }
+    uint16_t signature(int way) const { return signatures[way]; }
+    Timestamp timestamp(int way) const { return timestamps[way]; }
+
+    /** Record an access to a way, making it the most recently used. */
+    void
+    access(int way, uint16_t signature, Timestamp timestamp)
+    {
+        signatures[way] = signature;
+        timestamps[way] = timestamp;
+        lastUse[way] = ++useClock;
+    }
+
+    /** Store a new tag in a way, making it the most recently used. */
+    void
+    fill(int way, Tag tag, uint16_t signature, Timestamp timestamp)
+    {
+        tags[way] = tag;
+        validWays |= 1ULL << way;
+        access(way, signature, timestamp);
+    }
+
+    /**
+     * Invalidate a way. Its fields are kept, as the policies may still
+     * read the signature and timestamp of a way being replaced.
+     */
+    void invalidate(int way) { validWays &= ~(1ULL << way); }
+};
+
+/**
+ * Call f(ways, tag, timestamp) with ways a std::integral_constant holding
+ * the number of ways, and tag and timestamp value-initialised objects of
+ * the smallest unsigned types able to hold tags and timestamps of the
+ * given widths. This maps run-time sampler parameters to one of the
+ * supported SampledSet instantiations.
+ */
+template <typename F>
+auto
+dispatchSampledGeometry(int ways, int tag_bits, int timestamp_bits, F &&f)
+{
+    fatal_if(tag_bits < 1 || tag_bits > 32,
+             "Sampled tags must have between 1 and 32 bits, not %d.",
+             tag_bits);
+    fatal_if(timestamp_bits < 1 || timestamp_bits > 16,
+             "Sampled timestamps must have between 1 and 16 bits, not %d.",
+             timestamp_bits);
+
+    auto with_timestamp = [&](auto w, auto tag) {
+        return timestamp_bits <= 8 ? f(w, tag, uint8_t()) :
+                                     f(w, tag, uint16_t());
+    };
+    auto with_tag = [&](auto w) {
+        return tag_bits <= 16 ? with_timestamp(w, uint16_t()) :
+                                with_timestamp(w, uint32_t());
+    };
+
+    switch (ways) {
+      case 4:
+        return with_tag(std::integral_constant<int, 4>());
+      case 5:
+        return with_tag(std::integral_constant<int, 5>());
+      case 8:
+        return with_tag(std::integral_constant<int, 8>());
+      case 16:
+        return with_tag(std::integral_constant<int, 16>());
+      case 32:
+        return with_tag(std::integral_constant<int, 32>());
+      default:
+        fatal("Sampled caches can have 4, 5, 8, 16 or 32 ways, not %d.",
+              ways);
+    }
+}
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_SAMPLED_SET_HH__
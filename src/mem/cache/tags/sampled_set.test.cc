@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/cache/tags/sampled_set.hh"
+
+using namespace gem5;
+
+TEST(SampledSetTest, FillAndFind)
+{
+    SampledSet<8, uint16_t, uint8_t> set;
+    ASSERT_EQ(set.find(0), -1);
+    ASSERT_EQ(set.firstInvalid(), 0);
+    ASSERT_EQ(set.lastInvalid(), 7);
+    ASSERT_EQ(set.lruWay(), -1);
+
+    set.fill(3, 0xbeef, 12, 200);
+    ASSERT_EQ(set.find(0xbeef), 3);
+    ASSERT_EQ(set.signature(3), 12);
+    ASSERT_EQ(set.timestamp(3), 200);
+    ASSERT_EQ(set.firstInvalid(), 0);
+
+    set.invalidate(3);
+    ASSERT_EQ(set.find(0xbeef), -1);
+    // The fields of an invalidated way are kept
+    ASSERT_EQ(set.signature(3), 12);
+}
+
+TEST(SampledSetTest, LeastRecentlyUsed)
+{
+    SampledSet<5, uint16_t, uint8_t> set;
+    for (int way = 0; way < 5; way++) {
+        set.fill(way, way + 100, 0, 0);
+    }
+    ASSERT_TRUE(set.isFull());
+    ASSERT_EQ(set.firstInvalid(), -1);
+    ASSERT_EQ(set.lruWay(), 0);
+
+    set.access(0, 1, 1);
+    ASSERT_EQ(set.lruWay(), 1);
+    set.access(2, 1, 1);
+    set.access(1, 1, 1);
+    ASSERT_EQ(set.lruWay(), 3);
+
+    set.invalidate(3);
+    ASSERT_EQ(set.lruWay(), 4);
+    ASSERT_EQ(set.lastInvalid(), 3);
+}
+
+TEST(SampledSetTest, WideGeometry)
+{
+    SampledSet<32, uint32_t, uint16_t> set;
+    for (int way = 0; way < 32; way++) {
+        set.fill(way, 0x10000 + way, way, 1000 + way);
+    }
+    for (int way = 0; way < 32; way++) {
+        ASSERT_EQ(set.find(0x10000 + way), way);
+        ASSERT_EQ(set.timestamp(way), 1000 + way);
+    }
+    ASSERT_EQ(set.find(0), -1);
+}
+
+TEST(SampledSetTest, Dispatch)
+{
+    auto geometry = [](int ways, int tag_bits, int timestamp_bits) {
+        return dispatchSampledGeometry(ways, tag_bits, timestamp_bits,
+            [](auto w, auto tag, auto timestamp) {
+                return std::make_tuple(decltype(w)::value, sizeof(tag),
+                                       sizeof(timestamp));
+            });
+    };
+    ASSERT_EQ(geometry(8, 16, 8), std::make_tuple(8, 2ul, 1ul));
+    ASSERT_EQ(geometry(5, 10, 8), std::make_tuple(5, 2ul, 1ul));
+    ASSERT_EQ(geometry(32, 20, 12), std::make_tuple(32, 4ul, 2ul));
+}
@@ -0,0 +1,91 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import *
+from m5.objects.Probe import ProbeListenerObject
+from m5.objects.ReplacementPolicies import *
+from m5.objects.Tags import *
+
+
+class CacheTraceProbe(ProbeListenerObject):
+    """
+    Records the requests looked up in the tags of a cache (its Access
+    probe point) into a compressed trace that CacheTraceReplayer can
+    replay. Make it a child of the cache to record, or set its manager.
+    """
+
+    type = "CacheTraceProbe"
+    cxx_header = "mem/cache/trace/trace_probe.hh"
+    cxx_class = "gem5::CacheTraceProbe"
+
+    trace_file = Param.String(
+        "",
+        "Trace output file, relative to the output directory. Defaults to "
+        "<name>.trc.gz",
+    )
+    system = Param.System(Parent.any, "System the cache belongs to")
+
+
+class CacheTraceReplayer(SimObject):
+    """
+    Replays a trace recorded by CacheTraceProbe through a tag store and
+    replacement policy, without CPUs or memory, and reports the miss rate,
+    the miss rate of Belady's MIN and the host time per access. Call
+    run() on the C++ object after m5.instantiate().
+    """
+
+    type = "CacheTraceReplayer"
+    cxx_header = "mem/cache/trace/trace_replayer.hh"
+    cxx_class = "gem5::CacheTraceReplayer"
+
+    cxx_exports = [PyBindMethod("run")]
+
+    trace_file = Param.String("Trace to replay")
+    index_file = Param.String(
+        "",
+        "Next-use index of the trace the misses of Belady's MIN are counted "
+        "with, built from it if it does not exist. Defaults to "
+        "<trace_file>.nui",
+    )
+    system = Param.System(Parent.any, "System the replayer belongs to")
+
+    # The cache parameters the tags get from their parent
+    size = Param.MemorySize("Capacity in bytes")
+    assoc = Param.Unsigned(16, "Associativity")
+    tag_latency = Param.Cycles(1, "Tag lookup latency")
+    warmup_percentage = Param.Percent(
+        0, "Percentage of tags to be touched to warm up the cache"
+    )
+    sequential_access = Param.Bool(
+        False, "Whether to access tags and data sequentially"
+    )
+
+    replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy"
+    )
+    tags = Param.BaseTags(BaseSetAssoc(), "Tag store")
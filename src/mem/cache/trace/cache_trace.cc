@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/trace/cache_trace.hh"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/cache/trace/next_use_index.hh"
+
+namespace gem5
+{
+
+CacheTraceWriter::CacheTraceWriter(const std::string &filename,
+                                   unsigned block_size)
+    : file(gzopen(filename.c_str(), "wb")), filename(filename)
+{
+    fatal_if(!file, "Can't open cache trace %s for writing\n", filename);
+
+    CacheTraceHeader header;
+    header.blockSize = block_size;
+    fatal_if(gzwrite(file, &header, sizeof(header)) != sizeof(header),
+             "Can't write the header of cache trace %s\n", filename);
+
+    buffer.reserve(BUFFER_RECORDS);
+}
+
+CacheTraceWriter::~CacheTraceWriter()
+{
+    close();
+}
+
+void
+CacheTraceWriter::flush()
+{
+    if (buffer.empty())
+        return;
+
+    const int bytes = buffer.size() * sizeof(CacheTraceRecord);
+    fatal_if(gzwrite(file, buffer.data(), bytes) != bytes,
+             "Write failed on cache trace %s\n", filename);
+    buffer.clear();
+}
+
+void
+CacheTraceWriter::close()
+{
+    if (!file)
+        return;
+
+    flush();
+    fatal_if(gzclose(file), "Close failed on cache trace %s\n", filename);
+    file = nullptr;
+}
+
+CacheTraceReader::CacheTraceReader(const std::string &filename)
+    : file(gzopen(filename.c_str(), "rb")), filename(filename)
+{
+    fatal_if(!file, "Can't open cache trace %s\n", filename);
+
+    fatal_if(gzread(file, &header, sizeof(header)) != sizeof(header) ||
+             header.magic != CacheTraceHeader::MAGIC,
+             "%s is not a cache trace\n", filename);
+    fatal_if(header.version != CacheTraceHeader::VERSION,
+             "Cache trace %s has version %d, expected %d\n", filename,
+             header.version, CacheTraceHeader::VERSION);
+
+    buffer.reserve(CacheTraceWriter::BUFFER_RECORDS);
+}
+
+CacheTraceReader::~CacheTraceReader()
+{
+    gzclose(file);
+}
+
+bool
+CacheTraceReader::fill()
+{
+    buffer.resize(CacheTraceWriter::BUFFER_RECORDS);
+    const int bytes = gzread(file, buffer.data(),
+                             buffer.size() * sizeof(CacheTraceRecord));
+    fatal_if(bytes < 0, "Read failed on cache trace %s\n", filename);
+    warn_if(bytes % sizeof(CacheTraceRecord),
+            "Cache trace %s ends with a partial record\n", filename);
+
+    buffer.resize(bytes / sizeof(CacheTraceRecord));
+    next = 0;
+    return !buffer.empty();
+}
+
+std::vector<CacheTraceRecord>
+CacheTraceReader::readAll()
+{
+    std::vector<CacheTraceRecord> records(buffer.begin() + next,
+                                          buffer.end());
+    next = buffer.size();
+    while (fill())
+        records.insert(records.end(), buffer.begin(), buffer.end());
+    return records;
+}
+
+namespace
+{
+
+/**
+ * Belady's MIN on the accesses [0, num_accesses), access(i) giving the
+ * block of the i-th access and the position of the next access to it.
+ */
+template <typename Access>
+uint64_t
+simulateBelady(uint64_t num_accesses, Access access, unsigned num_sets,
+               unsigned assoc)
+{
+    struct Line
+    {
+        Addr block;
+        uint64_t nextUse;
+    };
+    std::vector<std::vector<Line>> sets(num_sets);
+
+    uint64_t misses = 0;
+    for (uint64_t i = 0; i < num_accesses; i++) {
+        const auto [block, next_use] = access(i);
+        std::vector<Line> &set = sets[block % num_sets];
+
+        auto line = std::find_if(set.begin(), set.end(),
+            [block = block](const Line &l) { return l.block == block; });
+        if (line == set.end()) {
+            misses++;
+            if (set.size() < assoc) {
+                set.push_back({block, next_use});
+                continue;
+            }
+            line = std::max_element(set.begin(), set.end(),
+                [](const Line &a, const Line &b) {
+                    return a.nextUse < b.nextUse;
+                });
+            line->block = block;
+        }
+        line->nextUse = next_use;
+    }
+
+    return misses;
+}
+
+} // anonymous namespace
+
+uint64_t
+countBeladyMisses(const std::vector<CacheTraceRecord> &records,
+                  unsigned block_size, unsigned num_sets, unsigned assoc)
+{
+    const int block_bits = floorLog2(block_size);
+    const uint64_t never = std::numeric_limits<uint64_t>::max();
+
+    // Position of the next reference to the block of each record
+    std::vector<uint64_t> next_use(records.size());
+    std::unordered_map<Addr, uint64_t> last_seen;
+    for (uint64_t i = records.size(); i-- > 0; ) {
+        const Addr block = records[i].addr >> block_bits;
+        auto it = last_seen.find(block);
+        next_use[i] = it == last_seen.end() ? never : it->second;
+        last_seen[block] = i;
+    }
+
+    return simulateBelady(records.size(),
+        [&](uint64_t i) {
+            return std::make_pair(records[i].addr >> block_bits,
+                                  next_use[i]);
+        }, num_sets, assoc);
+}
+
+uint64_t
+countBeladyMisses(const NextUseIndex &index, unsigned num_sets,
+                  unsigned assoc)
+{
+    return simulateBelady(index.size(),
+        [&](uint64_t i) {
+            return std::make_pair(index[i].block, index[i].nextUse);
+        }, num_sets, assoc);
+}
+
+} // namespace gem5
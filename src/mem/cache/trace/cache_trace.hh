@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Compressed traces of the requests looked up in the tags of a cache,
+ * recorded by CacheTraceProbe and replayed by CacheTraceReplayer to
+ * evaluate replacement policies without simulating the rest of the
+ * system.
+ */
+
+#ifndef __MEM_CACHE_TRACE_CACHE_TRACE_HH__
+#define __MEM_CACHE_TRACE_CACHE_TRACE_HH__
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class NextUseIndex;
+
+/**
+ * One request of a cache access trace. Records are stored in host byte
+ * order, and the command is the MemCmd::Command of the build that
+ * recorded them, so traces are meant to be replayed by the same build.
+ */
+struct CacheTraceRecord
+{
+    enum Flags : uint8_t
+    {
+        /** The request hit in the cache that recorded it */
+        Hit = 0x1,
+        /** The request carries a PC */
+        HasPC = 0x2,
+        /** The request carries a context id */
+        HasContext = 0x4,
+        /** The request belongs to the secure address space */
+        Secure = 0x8
+    };
+
+    Addr addr;
+    Addr pc;
+    ContextID contextId;
+    uint8_t cmd;
+    uint8_t flags;
+    uint16_t reserved;
+
+    bool hit() const { return flags & Hit; }
+    bool hasPC() const { return flags & HasPC; }
+    bool hasContext() const { return flags & HasContext; }
+    bool isSecure() const { return flags & Secure; }
+};
+
+static_assert(sizeof(CacheTraceRecord) == 24,
+              "Cache trace records are stored as is");
+
+/** Leading bytes of every cache trace file */
+struct CacheTraceHeader
+{
+    static constexpr uint64_t MAGIC = 0x4543415254354d47; // "GM5TRACE"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    /** Block size of the cache that recorded the trace */
+    uint32_t blockSize = 0;
+};
+
+/**
+ * Write cache trace records to a gzip file, buffering them so that the
+ * compressor sees large chunks.
+ */
+class CacheTraceWriter
+{
+  private:
+    gzFile file;
+    const std::string filename;
+    std::vector<CacheTraceRecord> buffer;
+
+  public:
+    /** Number of records buffered before they are compressed */
+    static constexpr size_t BUFFER_RECORDS = 4096;
+
+    CacheTraceWriter(const std::string &filename, unsigned block_size);
+    ~CacheTraceWriter();
+
+    CacheTraceWriter(const CacheTraceWriter &) = delete;
+    CacheTraceWriter &operator=(const CacheTraceWriter &) = delete;
+
+    void
+    write(const CacheTraceRecord &record)
+    {
+        buffer.push_back(record);
+        if (buffer.size() == BUFFER_RECORDS)
+            flush();
+    }
+
+    /** Compress the buffered records */
+    void flush();
+
+    /** Flush and close the file, further writes are not allowed */
+    void close();
+};
+
+/**
+ * Read the records of a cache trace. Uncompressed traces are read as
+ * well, zlib passes them through.
+ */
+class CacheTraceReader
+{
+  private:
+    gzFile file;
+    const std::string filename;
+    CacheTraceHeader header;
+    std::vector<CacheTraceRecord> buffer;
+    size_t next = 0;
+
+    /** Refill the buffer, returning false at the end of the trace */
+    bool fill();
+
+  public:
+    CacheTraceReader(const std::string &filename);
+    ~CacheTraceReader();
+
+    CacheTraceReader(const CacheTraceReader &) = delete;
+    CacheTraceReader &operator=(const CacheTraceReader &) = delete;
+
+    unsigned blockSize() const { return header.blockSize; }
+
+    /**
+     * Read the next record.
+     *
+     * @param record Filled with the next record of the trace.
+     * @return False if the end of the trace was reached.
+     */
+    bool
+    read(CacheTraceRecord &record)
+    {
+        if (next == buffer.size() && !fill())
+            return false;
+        record = buffer[next++];
+        return true;
+    }
+
+    /** Read all the remaining records */
+    std::vector<CacheTraceRecord> readAll();
+};
+
+/**
+ * Count the misses of Belady's MIN policy on a trace: on a miss, the
+ * block whose next reference is the furthest in the future is evicted.
+ * Every missing block is allocated, as in the cache being evaluated.
+ * Blocks are mapped to sets with modulo indexing.
+ *
+ * @param records The trace.
+ * @param block_size Cache block size in bytes, a power of two.
+ * @param num_sets Number of sets of the cache.
+ * @param assoc Associativity of the cache.
+ * @return The number of misses.
+ */
+uint64_t countBeladyMisses(const std::vector<CacheTraceRecord> &records,
+                           unsigned block_size, unsigned num_sets,
+                           unsigned assoc);
+
+/**
+ * Count the misses of Belady's MIN policy on a trace through its
+ * next-use index, streaming the index rather than loading the trace.
+ *
+ * @param index Next-use index of the trace.
+ * @param num_sets Number of sets of the cache.
+ * @param assoc Associativity of the cache.
+ * @return The number of misses.
+ */
+uint64_t countBeladyMisses(const NextUseIndex &index, unsigned num_sets,
+                           unsigned assoc);
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TRACE_CACHE_TRACE_HH__
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+#include "mem/cache/trace/cache_trace.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+CacheTraceRecord
+makeRecord(Addr addr)
+{
+    CacheTraceRecord record = {};
+    record.addr = addr;
+    return record;
+}
+
+std::vector<CacheTraceRecord>
+makeTrace(const std::vector<Addr> &blocks)
+{
+    std::vector<CacheTraceRecord> records;
+    for (Addr block : blocks)
+        records.push_back(makeRecord(block * 64));
+    return records;
+}
+
+} // anonymous namespace
+
+TEST(CacheTraceTest, RoundTrip)
+{
+    char filename[] = "/tmp/cache_trace_testXXXXXX";
+    const int fd = mkstemp(filename);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    // Enough records to go through several buffers
+    const size_t num_records = 3 * CacheTraceWriter::BUFFER_RECORDS + 5;
+    {
+        CacheTraceWriter writer(filename, 64);
+        for (size_t i = 0; i < num_records; i++) {
+            CacheTraceRecord record = makeRecord(i * 64);
+            record.pc = 0x400000 + i;
+            record.contextId = i % 4;
+            record.cmd = i % 3;
+            record.flags = CacheTraceRecord::HasPC |
+                (i % 2 ? CacheTraceRecord::Hit : 0);
+            writer.write(record);
+        }
+    }
+
+    CacheTraceReader reader(filename);
+    ASSERT_EQ(reader.blockSize(), 64);
+
+    CacheTraceRecord first;
+    ASSERT_TRUE(reader.read(first));
+    ASSERT_EQ(first.addr, 0);
+    ASSERT_FALSE(first.hit());
+
+    const std::vector<CacheTraceRecord> rest = reader.readAll();
+    ASSERT_EQ(rest.size(), num_records - 1);
+    for (size_t i = 1; i < num_records; i++) {
+        const CacheTraceRecord &record = rest[i - 1];
+        ASSERT_EQ(record.addr, i * 64);
+        ASSERT_EQ(record.pc, 0x400000 + i);
+        ASSERT_EQ(record.contextId, i % 4);
+        ASSERT_EQ(record.cmd, i % 3);
+        ASSERT_TRUE(record.hasPC());
+        ASSERT_FALSE(record.hasContext());
+        ASSERT_EQ(record.hit(), i % 2 == 1);
+    }
+
+    CacheTraceRecord end;
+    ASSERT_FALSE(reader.read(end));
+
+    unlink(filename);
+}
+
+TEST(CacheTraceTest, BeladyFullyAssociative)
+{
+    // Classic example: MIN keeps the blocks reused soonest
+    const auto trace = makeTrace({1, 2, 3, 1, 2, 4, 1, 2, 3, 4});
+    // 1 2 3 miss; 1 2 hit; 4 misses evicting 3 (never used before 1, 2);
+    // 1 2 hit; 3 misses evicting 1 or 2; 4 hits
+    ASSERT_EQ(countBeladyMisses(trace, 64, 1, 3), 5);
+    ASSERT_EQ(countBeladyMisses(trace, 64, 1, 4), 4);
+    ASSERT_EQ(countBeladyMisses(trace, 64, 1, 1), 10);
+}
+
+TEST(CacheTraceTest, BeladySets)
+{
+    // Blocks 0 and 2 go to set 0, 1 and 3 to set 1: no conflicts with two
+    // ways per set
+    const auto trace = makeTrace({0, 1, 2, 3, 0, 1, 2, 3});
+    ASSERT_EQ(countBeladyMisses(trace, 64, 2, 2), 4);
+    ASSERT_EQ(countBeladyMisses(trace, 64, 2, 1), 8);
+    ASSERT_EQ(countBeladyMisses(trace, 64, 4, 1), 4);
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/trace/next_use_index.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <unordered_map>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/cache/trace/cache_trace.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+struct stat
+statTrace(const std::string &trace_file)
+{
+    struct stat st;
+    fatal_if(stat(trace_file.c_str(), &st) != 0,
+             "Can't stat cache trace %s: %s\n", trace_file, strerror(errno));
+    return st;
+}
+
+} // anonymous namespace
+
+void
+NextUseIndex::build(const std::string &trace_file,
+                    const std::string &index_file)
+{
+    // Taken first, so that a trace modified while it is read no longer
+    // matches the index
+    const struct stat trace_st = statTrace(trace_file);
+
+    uint64_t num_entries = 0;
+    unsigned block_size;
+    {
+        CacheTraceReader reader(trace_file);
+        block_size = reader.blockSize();
+        CacheTraceRecord record;
+        while (reader.read(record))
+            num_entries++;
+    }
+    fatal_if(!isPowerOf2(block_size),
+             "Cache trace %s has an invalid block size %d\n", trace_file,
+             block_size);
+
+    const int fd = open(index_file.c_str(), O_RDWR | O_CREAT | O_TRUNC,
+                        0644);
+    fatal_if(fd < 0, "Can't create next-use index %s: %s\n", index_file,
+             strerror(errno));
+    const size_t size = sizeof(Header) + num_entries * sizeof(Entry);
+    fatal_if(ftruncate(fd, size) != 0, "Can't size next-use index %s: %s\n",
+             index_file, strerror(errno));
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         fd, 0);
+    fatal_if(mapping == MAP_FAILED, "Can't map next-use index %s: %s\n",
+             index_file, strerror(errno));
+    close(fd);
+
+    Header *header = new (mapping) Header;
+    header->blockSize = block_size;
+    header->numEntries = num_entries;
+    header->traceSize = trace_st.st_size;
+    header->traceMtime = trace_st.st_mtime;
+    Entry *entries = reinterpret_cast<Entry *>(header + 1);
+
+    // Every access is a next use of the previous access to its block
+    const int block_bits = floorLog2(block_size);
+    std::unordered_map<Addr, uint64_t> last_access;
+    CacheTraceReader reader(trace_file);
+    CacheTraceRecord record;
+    for (uint64_t seq = 0; seq < num_entries && reader.read(record); seq++) {
+        const Addr block = record.addr >> block_bits;
+        entries[seq] = {block, NEVER};
+        auto it = last_access.emplace(block, seq);
+        if (!it.second) {
+            entries[it.first->second].nextUse = seq;
+            it.first->second = seq;
+        }
+    }
+
+    fatal_if(msync(mapping, size, MS_SYNC) != 0,
+             "Can't write next-use index %s: %s\n", index_file,
+             strerror(errno));
+    munmap(mapping, size);
+}
+
+std::unique_ptr<NextUseIndex>
+NextUseIndex::load(const std::string &trace_file, std::string index_file)
+{
+    if (index_file.empty())
+        index_file = trace_file + ".nui";
+
+    struct stat st;
+    if (stat(index_file.c_str(), &st) != 0) {
+        inform("Building next-use index %s from %s\n", index_file,
+               trace_file);
+        build(trace_file, index_file);
+    }
+
+    auto index = std::make_unique<NextUseIndex>(index_file);
+    fatal_if(!index->matches(trace_file),
+             "Next-use index %s was not built from the current %s, remove "
+             "it to have it rebuilt\n", index_file, trace_file);
+    return index;
+}
+
+NextUseIndex::NextUseIndex(const std::string &index_file)
+{
+    const int fd = open(index_file.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open next-use index %s: %s\n", index_file,
+             strerror(errno));
+    struct stat st;
+    fatal_if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header),
+             "%s is not a next-use index\n", index_file);
+    mappingSize = st.st_size;
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    fatal_if(mapping == MAP_FAILED, "Can't map next-use index %s: %s\n",
+             index_file, strerror(errno));
+    close(fd);
+
+    // Accesses are looked up in order
+    madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+
+    header = static_cast<const Header *>(mapping);
+    entries = reinterpret_cast<const Entry *>(header + 1);
+    fatal_if(header->magic != Header::MAGIC ||
+             header->version != Header::VERSION ||
+             mappingSize != sizeof(Header) +
+                 header->numEntries * sizeof(Entry),
+             "%s is not a valid next-use index\n", index_file);
+}
+
+bool
+NextUseIndex::matches(const std::string &trace_file) const
+{
+    const struct stat st = statTrace(trace_file);
+    return header->traceSize == (uint64_t)st.st_size &&
+        header->traceMtime == (int64_t)st.st_mtime;
+}
+
+NextUseIndex::~NextUseIndex()
+{
+    munmap(mapping, mappingSize);
+}
+
+} // namespace gem5
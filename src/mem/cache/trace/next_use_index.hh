@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Next-use index of a cache trace, giving for every access of the trace
+ * the position of the next access to the same block. Used by the OPT
+ * replacement policy.
+ */
+
+#ifndef __MEM_CACHE_TRACE_NEXT_USE_INDEX_HH__
+#define __MEM_CACHE_TRACE_NEXT_USE_INDEX_HH__
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A memory-mapped file holding, for each access of a cache trace, the
+ * block it accessed and the sequence number of the next access to that
+ * block. The file is mapped read-only and private, so that traces much
+ * larger than the host memory can be used: only the pages around the
+ * current position of the simulation are resident.
+ */
+class NextUseIndex
+{
+  public:
+    /** Next use of a block that is not accessed again */
+    static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+    struct Entry
+    {
+        /** Block address (address divided by the block size) */
+        Addr block;
+        /** Sequence number of the next access to the block */
+        uint64_t nextUse;
+    };
+
+    struct Header
+    {
+        static constexpr uint64_t MAGIC = 0x5845444e4955354d; // "M5UINDEX"
+        static constexpr uint32_t VERSION = 2;
+
+        uint64_t magic = MAGIC;
+        uint32_t version = VERSION;
+        uint32_t blockSize = 0;
+        /** Number of entries, one per record of the trace */
+        uint64_t numEntries = 0;
+        /** Size of the trace file the index was built from */
+        uint64_t traceSize = 0;
+        /** Modification time of the trace file, in seconds */
+        int64_t traceMtime = 0;
+    };
+
+    /**
+     * Build the index of a cache trace. The trace is streamed twice, once
+     * to size the index and once to fill it through a shared mapping, so
+     * only the blocks of the trace's footprint are kept in memory.
+     *
+     * @param trace_file Trace recorded by CacheTraceProbe.
+     * @param index_file Index to create.
+     */
+    static void build(const std::string &trace_file,
+                      const std::string &index_file);
+
+    /**
+     * Map the index of a cache trace, building it first if it does not
+     * exist. An index that was not built from the current version of the
+     * trace is rejected.
+     *
+     * @param trace_file Trace recorded by CacheTraceProbe.
+     * @param index_file Index of the trace, <trace_file>.nui if empty.
+     */
+    static std::unique_ptr<NextUseIndex> load(const std::string &trace_file,
+                                              std::string index_file);
+
+    /** Map an index built by build() */
+    NextUseIndex(const std::string &index_file);
+    ~NextUseIndex();
+
+    NextUseIndex(const NextUseIndex &) = delete;
+    NextUseIndex &operator=(const NextUseIndex &) = delete;
+
+    /**
+     * Whether the index was built from the current version of a trace,
+     * as far as the size and modification time of the file tell.
+     *
+     * @param trace_file Trace the index is used with.
+     */
+    bool matches(const std::string &trace_file) const;
+
+    uint64_t size() const { return header->numEntries; }
+
+    unsigned blockSize() const { return header->blockSize; }
+
+    const Entry &operator[](uint64_t seq) const { return entries[seq]; }
+
+  private:
+    void *mapping;
+    size_t mappingSize;
+    const Header *header;
+    const Entry *entries;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TRACE_NEXT_USE_INDEX_HH__
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "mem/cache/trace/cache_trace.hh"
+#include "mem/cache/trace/next_use_index.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+std::string
+tempFile()
+{
+    char filename[] = "/tmp/next_use_index_testXXXXXX";
+    const int fd = mkstemp(filename);
+    close(fd);
+    return filename;
+}
+
+} // anonymous namespace
+
+TEST(NextUseIndexTest, Build)
+{
+    const std::string trace_file = tempFile();
+    const std::string index_file = tempFile();
+
+    // Offsets within a block refer to the same block
+    const std::vector<Addr> addrs = {0x0, 0x40, 0x8, 0x80, 0x44, 0x0};
+    {
+        CacheTraceWriter writer(trace_file, 64);
+        for (Addr addr : addrs) {
+            CacheTraceRecord record = {};
+            record.addr = addr;
+            writer.write(record);
+        }
+    }
+
+    NextUseIndex::build(trace_file, index_file);
+    NextUseIndex index(index_file);
+    ASSERT_EQ(index.size(), addrs.size());
+    ASSERT_EQ(index.blockSize(), 64);
+
+    const std::vector<uint64_t> next_use = {2, 4, 5, NextUseIndex::NEVER,
+        NextUseIndex::NEVER, NextUseIndex::NEVER};
+    for (uint64_t seq = 0; seq < addrs.size(); seq++) {
+        ASSERT_EQ(index[seq].block, addrs[seq] / 64);
+        ASSERT_EQ(index[seq].nextUse, next_use[seq]);
+    }
+
+    unlink(trace_file.c_str());
+    unlink(index_file.c_str());
+}
+
+TEST(NextUseIndexTest, EmptyTrace)
+{
+    const std::string trace_file = tempFile();
+    const std::string index_file = tempFile();
+    {
+        CacheTraceWriter writer(trace_file, 128);
+    }
+
+    NextUseIndex::build(trace_file, index_file);
+    NextUseIndex index(index_file);
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_EQ(index.blockSize(), 128);
+
+    unlink(trace_file.c_str());
+    unlink(index_file.c_str());
+}
+
+TEST(NextUseIndexTest, MatchesTrace)
+{
+    const std::string trace_file = tempFile();
+    const std::string index_file = tempFile();
+    auto write_trace = [&](unsigned num_records) {
+        CacheTraceWriter writer(trace_file, 64);
+        for (unsigned i = 0; i < num_records; i++) {
+            CacheTraceRecord record = {};
+            record.addr = i * 64;
+            writer.write(record);
+        }
+    };
+
+    write_trace(100);
+    NextUseIndex::build(trace_file, index_file);
+    {
+        NextUseIndex index(index_file);
+        ASSERT_TRUE(index.matches(trace_file));
+    }
+
+    // Another trace is not matched, by size
+    write_trace(5000);
+    {
+        NextUseIndex index(index_file);
+        ASSERT_FALSE(index.matches(trace_file));
+    }
+
+    NextUseIndex::build(trace_file, index_file);
+    {
+        NextUseIndex index(index_file);
+        ASSERT_TRUE(index.matches(trace_file));
+        ASSERT_EQ(index.size(), 5000);
+    }
+
+    // or by modification time
+    struct stat st;
+    ASSERT_EQ(stat(trace_file.c_str(), &st), 0);
+    struct utimbuf times = {st.st_atime, st.st_mtime - 10};
+    ASSERT_EQ(utime(trace_file.c_str(), &times), 0);
+    {
+        NextUseIndex index(index_file);
+        ASSERT_FALSE(index.matches(trace_file));
+    }
+
+    unlink(trace_file.c_str());
+    unlink(index_file.c_str());
+}
+
+TEST(NextUseIndexTest, Load)
+{
+    const std::string trace_file = tempFile();
+    {
+        CacheTraceWriter writer(trace_file, 64);
+        CacheTraceRecord record = {};
+        writer.write(record);
+    }
+
+    // The index is built next to the trace when missing
+    const std::string index_file = trace_file + ".nui";
+    ASSERT_NE(access(index_file.c_str(), F_OK), 0);
+    auto index = NextUseIndex::load(trace_file, "");
+    ASSERT_EQ(access(index_file.c_str(), F_OK), 0);
+    ASSERT_EQ(index->size(), 1);
+
+    unlink(trace_file.c_str());
+    unlink(index_file.c_str());
+}
+
+TEST(NextUseIndexTest, BeladyMisses)
+{
+    const std::string trace_file = tempFile();
+    const std::string index_file = tempFile();
+
+    std::vector<CacheTraceRecord> records;
+    uint64_t x = 5;
+    for (unsigned i = 0; i < 10000; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        CacheTraceRecord record = {};
+        record.addr = (x >> 33) % 4096 * 64 + i % 64;
+        records.push_back(record);
+    }
+    {
+        CacheTraceWriter writer(trace_file, 64);
+        for (const auto &record : records)
+            writer.write(record);
+    }
+
+    NextUseIndex::build(trace_file, index_file);
+    NextUseIndex index(index_file);
+    for (unsigned num_sets : {1, 16, 64}) {
+        for (unsigned assoc : {1, 4, 16}) {
+            ASSERT_EQ(countBeladyMisses(index, num_sets, assoc),
+                      countBeladyMisses(records, 64, num_sets, assoc));
+        }
+    }
+
+    unlink(trace_file.c_str());
+    unlink(index_file.c_str());
+}
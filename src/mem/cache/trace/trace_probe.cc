@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/trace/trace_probe.hh"
+
+#include "base/callback.hh"
+#include "base/output.hh"
+#include "params/CacheTraceProbe.hh"
+#include "sim/core.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+CacheTraceProbe::CacheTraceProbe(const CacheTraceProbeParams &p)
+    : ProbeListenerObject(p)
+{
+    // Relative paths are in the simulation output directory
+    const std::string filename = simout.resolve(
+        p.trace_file != "" ? p.trace_file : name() + ".trc.gz");
+    trace = std::make_unique<CacheTraceWriter>(
+        filename, p.system->cacheLineSize());
+
+    // The destructor is not called on exit
+    registerExitCallback([this]() { trace->close(); });
+}
+
+void
+CacheTraceProbe::regProbeListeners()
+{
+    typedef ProbeListenerArg<CacheTraceProbe, BaseCache::AccessInfo>
+        AccessListener;
+    listeners.push_back(new AccessListener(this, "Access",
+                                           &CacheTraceProbe::record));
+}
+
+void
+CacheTraceProbe::record(const BaseCache::AccessInfo &info)
+{
+    const PacketPtr pkt = info.pkt;
+    if (!traces(pkt))
+        return;
+
+    CacheTraceRecord record = {};
+    record.addr = pkt->getAddr();
+    record.cmd = pkt->cmd.toInt();
+    record.flags = (info.hit ? CacheTraceRecord::Hit : 0) |
+        (pkt->isSecure() ? CacheTraceRecord::Secure : 0);
+    if (pkt->req->hasPC()) {
+        record.pc = pkt->req->getPC();
+        record.flags |= CacheTraceRecord::HasPC;
+    }
+    if (pkt->req->hasContextId()) {
+        record.contextId = pkt->req->contextId();
+        record.flags |= CacheTraceRecord::HasContext;
+    }
+    trace->write(record);
+}
+
+} // namespace gem5
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Probe listener recording the requests looked up in the tags of a cache.
+ */
+
+#ifndef __MEM_CACHE_TRACE_TRACE_PROBE_HH__
+#define __MEM_CACHE_TRACE_TRACE_PROBE_HH__
+
+#include <memory>
+
+#include "mem/cache/base.hh"
+#include "mem/cache/trace/cache_trace.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+struct CacheTraceProbeParams;
+
+/**
+ * Record the Access probe point of a cache into a cache trace: the
+ * address, PC and context of every request looked up in its tags, and
+ * whether it hit. Clean evictions and cache maintenance operations are
+ * left out, as they do not allocate.
+ */
+class CacheTraceProbe : public ProbeListenerObject
+{
+  public:
+    CacheTraceProbe(const CacheTraceProbeParams &params);
+
+    void regProbeListeners() override;
+
+    void record(const BaseCache::AccessInfo &info);
+
+    /**
+     * Whether an access is recorded. Consumers of the trace, such as the
+     * OPT replacement policy, use this to stay in step with it.
+     */
+    static bool
+    traces(const PacketPtr pkt)
+    {
+        return !pkt->isCleanEviction() && !pkt->req->isCacheMaintenance();
+    }
+
+  private:
+    std::unique_ptr<CacheTraceWriter> trace;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TRACE_TRACE_PROBE_HH__
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/cache/trace/trace_replayer.hh"
+
+#include <chrono>
+
+#include "base/logging.hh"
+#include "mem/cache/cache_blk.hh"
+#include "mem/cache/tags/base.hh"
+#include "mem/cache/trace/next_use_index.hh"
+#include "mem/packet.hh"
+#include "params/CacheTraceReplayer.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+RequestPtr
+makeReplayRequest(const CacheTraceRecord &record, unsigned blk_size,
+                  RequestorID requestor_id)
+{
+    const Request::Flags flags =
+        record.isSecure() ? Request::SECURE : Request::Flags(0);
+    RequestPtr req = makeRequest(
+        record.addr & ~Addr(blk_size - 1), blk_size, flags, requestor_id);
+    if (record.hasPC())
+        req->setPC(record.pc);
+    if (record.hasContext())
+        req->setContext(record.contextId);
+    return req;
+}
+
+void
+makeReplayFill(Packet &pkt)
+{
+    if (pkt.needsResponse())
+        pkt.makeResponse();
+}
+
+CacheTraceReplayer::CacheTraceReplayer(const CacheTraceReplayerParams &p)
+    : SimObject(p), tags(p.tags), traceFile(p.trace_file),
+      indexFile(p.index_file),
+      blkSize(p.system->cacheLineSize()), assoc(p.assoc),
+      numSets(p.size / (p.assoc * blkSize)),
+      requestorId(p.system->getRequestorId(this)), stats(this)
+{
+    fatal_if(numSets == 0, "%s: the cache must have at least one set",
+             name());
+}
+
+void
+CacheTraceReplayer::replay(const CacheTraceRecord &record)
+{
+    Packet pkt(makeReplayRequest(record, blkSize, requestorId),
+               MemCmd(record.cmd));
+
+    stats.accesses++;
+    stats.recordedMisses += !record.hit();
+
+    Cycles lat;
+    if (tags->accessBlock(&pkt, lat))
+        return;
+
+    // Allocate on every miss, evicting as BaseCache::allocateBlock would
+    stats.misses++;
+    std::vector<CacheBlk*> evict_blks;
+    CacheBlk *victim = tags->findVictim(pkt.getAddr(), pkt.isSecure(),
+                                        blkSize * 8, evict_blks);
+    for (CacheBlk *blk : evict_blks) {
+        if (blk->isValid()) {
+            stats.evictions++;
+            tags->invalidate(blk);
+        }
+    }
+    makeReplayFill(pkt);
+    tags->insertBlock(&pkt, victim);
+    victim->setCoherenceBits(CacheBlk::ReadableBit);
+}
+
+void
+CacheTraceReplayer::run()
+{
+    // Nothing may run at the ticks the replay goes through
+    fatal_if(!eventQueue()->empty(), "%s: the replay must be run before "
+             "anything is scheduled\n", name());
+
+    CacheTraceReader reader(traceFile);
+    warn_if(reader.blockSize() != blkSize,
+            "%s: trace %s was recorded with %d-byte blocks, replaying with "
+            "%d-byte blocks\n", name(), traceFile, reader.blockSize(),
+            blkSize);
+
+    // The trace is streamed in chunks, decompressing a chunk is kept out
+    // of the measured time
+    std::vector<CacheTraceRecord> chunk;
+    chunk.reserve(CacheTraceWriter::BUFFER_RECORDS);
+    std::chrono::duration<double> host_time(0);
+    uint64_t num_records = 0;
+    while (true) {
+        chunk.clear();
+        CacheTraceRecord record;
+        while (chunk.size() < CacheTraceWriter::BUFFER_RECORDS &&
+               reader.read(record)) {
+            chunk.push_back(record);
+        }
+        if (chunk.empty())
+            break;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const CacheTraceRecord &record : chunk) {
+            setCurTick(curTick() + 1);
+            replay(record);
+        }
+        host_time += std::chrono::steady_clock::now() - start;
+        num_records += chunk.size();
+    }
+    stats.hostSeconds = host_time.count();
+
+    const auto index = NextUseIndex::load(traceFile, indexFile);
+    stats.optMisses = countBeladyMisses(*index, numSets, assoc);
+
+    const double accesses = std::max<uint64_t>(num_records, 1);
+    inform("%s: %d accesses, miss rate %.4f (recorded %.4f, OPT %.4f), "
+           "%.1f ns/access\n", name(), num_records,
+           stats.misses.value() / accesses,
+           stats.recordedMisses.value() / accesses,
+           stats.optMisses.value() / accesses,
+           host_time.count() * 1e9 / accesses);
+}
+
+CacheTraceReplayer::ReplayerStats::ReplayerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(accesses, statistics::units::Count::get(),
+               "Number of requests replayed"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of replayed requests that missed"),
+      ADD_STAT(evictions, statistics::units::Count::get(),
+               "Number of valid blocks evicted by the replayed misses"),
+      ADD_STAT(recordedMisses, statistics::units::Count::get(),
+               "Number of replayed requests that missed when recorded"),
+      ADD_STAT(optMisses, statistics::units::Count::get(),
+               "Number of misses of Belady's MIN on the trace"),
+      ADD_STAT(missRate, statistics::units::Ratio::get(),
+               "Miss rate of the replay", misses / accesses),
+      ADD_STAT(recordedMissRate, statistics::units::Ratio::get(),
+               "Miss rate of the recorded run",
+               recordedMisses / accesses),
+      ADD_STAT(optMissRate, statistics::units::Ratio::get(),
+               "Miss rate of Belady's MIN", optMisses / accesses),
+      ADD_STAT(hostSeconds, statistics::units::Second::get(),
+               "Host time spent replaying the trace through the tags")
+{
+}
+
+} // namespace gem5
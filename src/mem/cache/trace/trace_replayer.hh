@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Replay a cache trace through a tag store and its replacement policy.
+ */
+
+#ifndef __MEM_CACHE_TRACE_TRACE_REPLAYER_HH__
+#define __MEM_CACHE_TRACE_TRACE_REPLAYER_HH__
+
+#include <string>
+
+#include "base/statistics.hh"
+#include "mem/cache/trace/cache_trace.hh"
+#include "mem/request.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class BaseTags;
+class Packet;
+struct CacheTraceReplayerParams;
+
+/**
+ * Build the request a trace record is replayed with, covering the whole
+ * block it accessed and carrying its PC and context when recorded.
+ */
+RequestPtr makeReplayRequest(const CacheTraceRecord &record,
+                             unsigned blk_size, RequestorID requestor_id);
+
+/**
+ * Turn a replayed miss into the packet its block is allocated with. A
+ * cache allocates on the response to the miss, and the policies that
+ * only learn on fills (e.g. Hawkeye and Mockingjay) ignore requests.
+ * Requests without a response, such as writebacks, allocate as is.
+ */
+void makeReplayFill(Packet &pkt);
+
+/**
+ * Drive a tag store (e.g. BaseSetAssoc) and its replacement policy
+ * directly from a cache trace recorded by CacheTraceProbe, without any
+ * CPU, interconnect or memory model, to quickly compare replacement
+ * policies. Each request of the trace is looked up in the tags and,
+ * when it misses, allocated in the victim chosen by the replacement
+ * policy. The miss rate is compared against the one of Belady's MIN on
+ * the same trace, and the host time spent in the tags is measured.
+ *
+ * The replay is started from Python with run(), after instantiation.
+ * As no simulation runs, every replayed request advances the current
+ * tick by one, so that the policies ordering blocks by the tick they
+ * were touched at (e.g. LRU) see the order of the requests.
+ */
+class CacheTraceReplayer : public SimObject
+{
+  public:
+    CacheTraceReplayer(const CacheTraceReplayerParams &p);
+
+    /** Replay the whole trace */
+    void run();
+
+  private:
+    BaseTags *const tags;
+
+    const std::string traceFile;
+
+    const std::string indexFile;
+
+    const unsigned blkSize;
+
+    const unsigned assoc;
+
+    const unsigned numSets;
+
+    /** Requestor id the replayed requests are issued with */
+    const RequestorID requestorId;
+
+    /** Look up a request in the tags and allocate it on a miss */
+    void replay(const CacheTraceRecord &record);
+
+    struct ReplayerStats : public statistics::Group
+    {
+        ReplayerStats(statistics::Group *parent);
+
+        statistics::Scalar accesses;
+        statistics::Scalar misses;
+        statistics::Scalar evictions;
+        statistics::Scalar recordedMisses;
+        statistics::Scalar optMisses;
+        statistics::Formula missRate;
+        statistics::Formula recordedMissRate;
+        statistics::Formula optMissRate;
+        statistics::Scalar hostSeconds;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TRACE_TRACE_REPLAYER_HH__
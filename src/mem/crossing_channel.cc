@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/crossing_channel.hh"
+
+#include <utility>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+/** The actions of a channel due on one tick. */
+class CrossingChannel::CrossingEvent : public Event
+{
+  private:
+    std::vector<std::function<void()>> actions;
+    const std::string &_name;
+
+  public:
+    CrossingEvent(std::function<void()> action, const std::string &name)
+        : Event(Default_Pri, AutoDelete), _name(name)
+    {
+        actions.push_back(std::move(action));
+    }
+
+    void
+    append(std::function<void()> action)
+    {
+        actions.push_back(std::move(action));
+    }
+
+    void
+    process() override
+    {
+        for (auto &action : actions)
+            action();
+    }
+
+    const std::string name() const override { return _name; }
+};
+
+CrossingChannel::CrossingChannel(EventQueue *_queue,
+                                 const std::string &_name)
+    : queue(_queue), _name(_name), lastPosted(0), last(nullptr)
+{
+}
+
+void
+CrossingChannel::post(Tick when, std::function<void()> action)
+{
+    if (last && when <= lastPosted) {
+        last->append(std::move(action));
+        return;
+    }
+
+    last = new CrossingEvent(std::move(action), _name);
+    lastPosted = when;
+    queue->schedule(last, when);
+}
+
+} // namespace gem5
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * One direction of a link between the event queues of two threads.
+ */
+
+#ifndef __MEM_CROSSING_CHANNEL_HH__
+#define __MEM_CROSSING_CHANNEL_HH__
+
+#include <functional>
+#include <string>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class EventQueue;
+
+/**
+ * Carry actions from the thread of one event queue to another event
+ * queue, e.g. the packets crossing a bridge whose sides run on
+ * different threads. Each post becomes an event on the target queue, at
+ * least one lookahead in the future.
+ *
+ * The actions run in posting order. An action posted for an earlier
+ * tick than the previous one (e.g. a packet with a shorter payload
+ * delay following a longer one) waits for it, so the tick of the posts
+ * never decreases. The actions due on the same tick share an event and
+ * run in posting order, as the queue would run separate events with the
+ * same tick and priority in reverse order.
+ *
+ * A channel is only used by the posting thread. The event of the last
+ * post is due at least one lookahead after the current tick of that
+ * thread, so the target thread has not run it yet when a later post is
+ * appended to it.
+ */
+class CrossingChannel
+{
+  private:
+    class CrossingEvent;
+
+    /** Queue the actions run on. */
+    EventQueue *const queue;
+
+    /** Name of the events, for debugging. */
+    const std::string _name;
+
+    /** Tick of the last post. */
+    Tick lastPosted;
+
+    /** Event of the last post, extended by the posts due before it. */
+    CrossingEvent *last;
+
+  public:
+    CrossingChannel(EventQueue *_queue, const std::string &_name);
+
+    /**
+     * Run an action on the target queue, at the given tick or after the
+     * actions posted before it, whichever is later.
+     */
+    void post(Tick when, std::function<void()> action);
+};
+
+} // namespace gem5
+
+#endif // __MEM_CROSSING_CHANNEL_HH__
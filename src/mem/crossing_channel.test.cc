@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "mem/crossing_channel.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Actions run by a queue, as (action index, tick) pairs. */
+typedef std::vector<std::pair<int, Tick>> Trace;
+
+/** Post actions due at the given ticks and run them all. */
+Trace
+run(const std::vector<Tick> &ticks)
+{
+    EventQueue eq("test_queue");
+    CrossingChannel channel(&eq, "channel");
+
+    Trace trace;
+    for (int i = 0; i < int(ticks.size()); i++) {
+        channel.post(ticks[i], [&trace, &eq, i]() {
+            trace.emplace_back(i, eq.getCurTick());
+        });
+    }
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    return trace;
+}
+
+} // anonymous namespace
+
+/**
+ * Packets sent back to back across a bridge are due one bridge delay
+ * plus their own header and payload delays later. A packet with a short
+ * payload waits for the one with a longer payload in front of it.
+ */
+TEST(CrossingChannelTest, PayloadDelays)
+{
+    const Tick period = 500;
+    const Tick delay = 2 * period;
+    // A write with a 64-byte payload over a 16-byte bus, then reads
+    // without payload, then another write and a read
+    const std::vector<Tick> ticks = {
+        delay + 4 * period,
+        period + delay,
+        2 * period + delay,
+        3 * period + delay + 4 * period,
+        4 * period + delay,
+    };
+
+    const Trace expected = {
+        {0, 3000}, {1, 3000}, {2, 3000}, {3, 4500}, {4, 4500},
+    };
+    EXPECT_EQ(run(ticks), expected);
+}
+
+/** Actions due on the same tick run in posting order. */
+TEST(CrossingChannelTest, SameTick)
+{
+    const Trace trace = run({1000, 1000, 1000, 2000, 2000});
+    const Trace expected = {
+        {0, 1000}, {1, 1000}, {2, 1000}, {3, 2000}, {4, 2000},
+    };
+    EXPECT_EQ(trace, expected);
+}
+
+/** Actions run at their own tick when it is later than the last one. */
+TEST(CrossingChannelTest, InOrder)
+{
+    const Trace trace = run({1000, 1500, 1501, 4000});
+    const Trace expected = {
+        {0, 1000}, {1, 1500}, {2, 1501}, {3, 4000},
+    };
+    EXPECT_EQ(trace, expected);
+}
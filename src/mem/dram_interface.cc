@@ -46,6 +46,8 @@
 #include "debug/DRAM.hh"
 #include "debug/DRAMPower.hh"
 #include "debug/DRAMState.hh"
+#include "mem/dram_sched.hh"
+#include "mem/mem_telemetry.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -59,116 +61,7 @@ namespace memory
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
 {
-    std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
-
-    // Has minBankPrep been called to populate earliest_banks?
-    bool filled_earliest_banks = false;
-    // can the PRE/ACT sequence be done without impacting utlization?
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    Tick selected_col_at = MaxTick;
-    auto selected_pkt_it = queue.end();
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        MemPacket* pkt = *i;
-
-        // select optimal DRAM packet in Q
-        if (pkt->isDram() && (pkt->pseudoChannel == pseudoChannel)) {
-            const Bank& bank = ranks[pkt->rank]->banks[pkt->bank];
-            const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
-                                                        bank.wrAllowedAt;
-
-            DPRINTF(DRAM, "%s checking DRAM packet in bank %d, row %d\n",
-                    __func__, pkt->bank, pkt->row);
-
-            // check if rank is not doing a refresh and thus is available,
-            // if not, jump to the next packet
-            if (burstReady(pkt)) {
-
-                DPRINTF(DRAM,
-                        "%s bank %d - Rank %d available\n", __func__,
-                        pkt->bank, pkt->rank);
-
-                // check if it is a row hit
-                if (bank.openRow == pkt->row) {
-                    // no additional rank-to-rank or same bank-group
-                    // delays, or we switched read/write and might as well
-                    // go for the row hit
-                    if (col_allowed_at <= min_col_at) {
-                        // FCFS within the hits, giving priority to
-                        // commands that can issue seamlessly, without
-                        // additional delay, such as same rank accesses
-                        // and/or different bank-group accesses
-                        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        // no need to look through the remaining queue entries
-                        break;
-                    } else if (!found_hidden_bank && !found_prepped_pkt) {
-                        // if we did not find a packet to a closed row that can
-                        // issue the bank commands without incurring delay, and
-                        // did not yet find a packet to a prepped row, remember
-                        // the current one
-                        selected_pkt_it = i;
-                        selected_col_at = col_allowed_at;
-                        found_prepped_pkt = true;
-                        DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
-                    }
-                } else if (!found_earliest_pkt) {
-                    // if we have not initialised the bank status, do it
-                    // now, and only once per scheduling decisions
-                    if (!filled_earliest_banks) {
-                        // determine entries with earliest bank delay
-                        std::tie(earliest_banks, hidden_bank_prep) =
-                            minBankPrep(queue, min_col_at);
-                        filled_earliest_banks = true;
-                    }
-
-                    // bank is amongst first available banks
-                    // minBankPrep will give priority to packets that can
-                    // issue seamlessly
-                    if (bits(earliest_banks[pkt->rank],
-                             pkt->bank, pkt->bank)) {
-                        found_earliest_pkt = true;
-                        found_hidden_bank = hidden_bank_prep;
-
-                        // give priority to packets that can issue
-                        // bank commands 'behind the scenes'
-                        // any additional delay if any will be due to
-                        // col-to-col command requirements
-                        if (hidden_bank_prep || !found_prepped_pkt) {
-                            selected_pkt_it = i;
-                            selected_col_at = col_allowed_at;
-                        }
-                    }
-                }
-            } else {
-                DPRINTF(DRAM, "%s bank %d - Rank %d not available\n", __func__,
-                        pkt->bank, pkt->rank);
-            }
-        }
-    }
-
-    if (selected_pkt_it == queue.end()) {
-        DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
-    }
-
-    return std::make_pair(selected_pkt_it, selected_col_at);
+    return dram_sched::chooseNextFRFCFS(SchedView(*this), queue, min_col_at);
 }
 
 void
@@ -344,12 +237,6 @@ DRAMInterface::prechargeBank(Rank& rank_ref, Bank& bank, Tick pre_tick,
 }
 
 
-void DRAMInterface::getMemStats(PacketPtr pkt) {
-    if (pkt->isRequest() || pkt->isResponse()) {
-        pkt->req->setDRAMStats(stats.readBursts.total() + stats.writeBursts.total(), stats.readRowHits.total() + stats.writeRowHits.total(), stats.avgMemAccLat.total());
-    }
-}
-
 std::pair<Tick, Tick>
 DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
                              const std::vector<MemPacketQueue>& queue)
@@ -514,37 +401,25 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         bool got_more_hits = false;
         bool got_bank_conflict = false;
 
-        for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
-            // keep on looking until we find a hit or reach the end of the
-            // queue
-            // 1) if a hit is found, then both open and close adaptive
-            //    policies keep the page open
-            // 2) if no hit is found, got_bank_conflict is set to true if a
-            //    bank conflict request is waiting in the queue
-            // 3) make sure we are not considering the packet that we are
-            //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-
-                if ((*p)->pseudoChannel != pseudoChannel) {
-                    // only consider if this pkt belongs to this interface
-                    ++p;
+        // 1) if a hit is found, then both open and close adaptive
+        //    policies keep the page open
+        // 2) if no hit is found, got_bank_conflict is set to true if a
+        //    bank conflict request is waiting in the queue
+        // 3) make sure we are not considering the packet that we are
+        //    currently dealing with
+        // The packets to the other interface of a heterogeneous
+        // controller are matched on their rank and bank as well.
+        for (uint8_t i = 0; i < ctrl->numPriorities() && !got_more_hits;
+             ++i) {
+            for (bool is_dram : {true, false}) {
+                const MemPacketQueue::BankQueue *bank_queue =
+                    queue[i].bankQueue(pseudoChannel, is_dram,
+                                       mem_pkt->rank, mem_pkt->bank);
+                if (!bank_queue)
                     continue;
-                }
-
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
-                }
-                ++p;
+                got_more_hits |= bank_queue->hasHit(mem_pkt->row, mem_pkt);
+                got_bank_conflict |= bank_queue->hasMiss(mem_pkt->row);
             }
-
-            if (got_more_hits)
-                break;
         }
 
         // auto pre-charge when either
@@ -593,6 +468,9 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         stats.totMemAccLat += mem_pkt->readyTime - mem_pkt->entryTime;
         stats.totQLat += cmd_at - mem_pkt->entryTime;
         stats.totBusLat += tBURST;
+
+        ctrl->system()->getMemTelemetry().dramBurst(true, row_hit,
+            mem_pkt->readyTime - mem_pkt->entryTime);
     } else {
         // Schedule write done event to decrement event count
         // after the readyTime has been reached
@@ -618,6 +496,7 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         stats.bytesWritten += burstSize;
         stats.perBankWrBursts[mem_pkt->bankId]++;
 
+        ctrl->system()->getMemTelemetry().dramBurst(false, row_hit, 0);
     }
     // Update bus state to reflect when previous command was issued
     return std::make_pair(cmd_at, cmd_at + burst_gap);
@@ -664,6 +543,7 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
+      lazyRefresh(_p.lazy_refresh),
       lastStatsResetTick(0),
       stats(*this)
 {
@@ -1031,101 +911,20 @@ DRAMInterface::suspend()
     }
 }
 
-std::pair<std::vector<uint32_t>, bool>
-DRAMInterface::minBankPrep(const MemPacketQueue& queue,
-                      Tick min_col_at) const
+void
+DRAMInterface::catchUpRefresh()
 {
-    Tick min_act_at = MaxTick;
-    std::vector<uint32_t> bank_mask(ranksPerChannel, 0);
-
-    // Flag condition when burst can issue back-to-back with previous burst
-    bool found_seamless_bank = false;
-
-    // Flag condition when bank can be opened without incurring additional
-    // delay on the data bus
-    bool hidden_bank_prep = false;
-
-    // determine if we have queued transactions targetting the
-    // bank in question
-    std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
-            continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
-    // Find command with optimal bank timing
-    // Will prioritize commands that can issue seamlessly.
-    for (int i = 0; i < ranksPerChannel; i++) {
-        for (int j = 0; j < banksPerRank; j++) {
-            uint16_t bank_id = i * banksPerRank + j;
-
-            // if we have waiting requests for the bank, and it is
-            // amongst the first available, update the mask
-            if (got_waiting[bank_id]) {
-                // make sure this rank is not currently refreshing.
-                assert(ranks[i]->inRefIdleState());
-                // simplistic approximation of when the bank can issue
-                // an activate, ignoring any rank-to-rank switching
-                // cost in this calculation
-                Tick act_at = ranks[i]->banks[j].openRow == Bank::NO_ROW ?
-                    std::max(ranks[i]->banks[j].actAllowedAt, curTick()) :
-                    std::max(ranks[i]->banks[j].preAllowedAt, curTick()) + tRP;
-
-                // latest Tick for which ACT can occur without
-                // incurring additoinal delay on the data bus
-                const Tick tRCD = ctrl->inReadBusState(false) ?
-                                                 tRCD_RD : tRCD_WR;
-                const Tick hidden_act_max =
-                            std::max(min_col_at - tRCD, curTick());
-
-                // When is the earliest the R/W burst can issue?
-                const Tick col_allowed_at = ctrl->inReadBusState(false) ?
-                                              ranks[i]->banks[j].rdAllowedAt :
-                                              ranks[i]->banks[j].wrAllowedAt;
-                Tick col_at = std::max(col_allowed_at, act_at + tRCD);
-
-                // bank can issue burst back-to-back (seamlessly) with
-                // previous burst
-                bool new_seamless_bank = col_at <= min_col_at;
-
-                // if we found a new seamless bank or we have no
-                // seamless banks, and got a bank with an earlier
-                // activate time, it should be added to the bit mask
-                if (new_seamless_bank ||
-                    (!found_seamless_bank && act_at <= min_act_at)) {
-                    // if we did not have a seamless bank before, and
-                    // we do now, reset the bank mask, also reset it
-                    // if we have not yet found a seamless bank and
-                    // the activate time is smaller than what we have
-                    // seen so far
-                    if (!found_seamless_bank &&
-                        (new_seamless_bank || act_at < min_act_at)) {
-                        std::fill(bank_mask.begin(), bank_mask.end(), 0);
-                    }
-
-                    found_seamless_bank |= new_seamless_bank;
-
-                    // ACT can occur 'behind the scenes'
-                    hidden_bank_prep = act_at <= hidden_act_max;
-
-                    // set the bit corresponding to the available bank
-                    replaceBits(bank_mask[i], j, j, 1);
-                    min_act_at = act_at;
-                }
-            }
-        }
+    for (auto r : ranks) {
+        r->catchUpRefresh();
     }
-
-    return std::make_pair(bank_mask, hidden_bank_prep);
 }
 
 DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
-      pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
+      pwrStateTick(0), refreshDueAt(0), refreshSkipped(false),
+      pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
@@ -1174,10 +973,13 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
+    // make sure the refresh event is scheduled
+    catchUpRefresh();
+
     deschedule(refreshEvent);
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // don't automatically transition back to LP state after next REF
     pwrStatePostRefresh = PWR_IDLE;
@@ -1210,7 +1012,7 @@ DRAMInterface::Rank::checkDrainDone()
 }
 
 void
-DRAMInterface::Rank::flushCmdList()
+DRAMInterface::Rank::flushCmdList(Tick until)
 {
     // at the moment sort the list of commands and update the counters
     // for DRAMPower libray when doing a refresh
@@ -1220,19 +1022,19 @@ DRAMInterface::Rank::flushCmdList()
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
          Command cmd = *next_iter;
-         if (cmd.timeStamp <= curTick()) {
-             // Move all commands at or before curTick to DRAMPower
+         if (cmd.timeStamp <= until) {
+             // Move all commands at or before until to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
                                       divCeil(cmd.timeStamp, dram.tCK) -
                                       dram.timeStampOffset);
          } else {
-             // done - found all commands at or before curTick()
-             // next_iter references the 1st command after curTick
+             // done - found all commands at or before until
+             // next_iter references the 1st command after until
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
+    // reset cmdList to only contain commands after until
+    // if there are no commands after until, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
     cmdList.assign(next_iter, cmdList.end());
 }
@@ -1418,9 +1220,10 @@ DRAMInterface::Rank::processRefreshEvent()
 
         // at the moment this affects all ranks
         cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
+        ++stats.numRefreshes;
 
         // Update the stats
-        updatePowerStats();
+        updatePowerStats(curTick());
 
         DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
                 dram.timeStampOffset, rank);
@@ -1487,13 +1290,98 @@ DRAMInterface::Rank::processRefreshEvent()
         // refresh STM and therefore can always schedule next event.
         // Compensate for the delay in actually performing the refresh
         // when scheduling the next one
-        schedule(refreshEvent, refreshDueAt - dram.tRP);
+        // While the controller is idle, and the rank is not powered
+        // down, the refreshes follow each other without interacting with
+        // anything else. Skip their events then, and account for them
+        // once the controller is accessed again.
+        if (dram.lazyRefresh && !dram.enableDRAMPowerdown &&
+            dram.ctrl->schedulerIdle(dram.pseudoChannel)) {
+            refreshSkipped = true;
+        } else {
+            schedule(refreshEvent, refreshDueAt - dram.tRP);
+        }
 
         DPRINTF(DRAMState, "Refresh done at %llu and next refresh"
                 " at %llu\n", curTick(), refreshDueAt);
     }
 }
 
+void
+DRAMInterface::Rank::catchUpRefresh()
+{
+    if (!refreshSkipped)
+        return;
+
+    refreshSkipped = false;
+
+    // Each skipped refresh would have been started tRP ahead of being
+    // due, taking the rank from the idle to the refresh power state for
+    // tRFC, with the next one due tREFI after it was started
+    const Tick period = dram.tREFI - dram.tRP;
+    Tick ref_at = refreshDueAt - dram.tRP;
+
+    // account in bulk for the refreshes done by now, handing their
+    // commands to DRAMPower in batches to bound the size of its command
+    // list over long idle phases
+    if (ref_at + dram.tRFC < curTick()) {
+        const uint64_t batch_size = 1024;
+        uint64_t num_refs = (curTick() - ref_at - dram.tRFC - 1) / period + 1;
+        Tick last_ref_at = ref_at + (num_refs - 1) * period;
+
+        for (uint64_t i = 0; i < num_refs; i++) {
+            Tick at = ref_at + i * period;
+            cmdList.push_back(Command(MemCommand::REF, 0, at));
+            if ((i + 1) % batch_size == 0 || at == last_ref_at)
+                updatePowerStats(at);
+        }
+
+        Tick ref_done_at = last_ref_at + dram.tRFC;
+        for (auto &b : banks) {
+            b.actAllowedAt = ref_done_at;
+        }
+
+        stats.numRefreshes += num_refs;
+        stats.pwrStateTime[PWR_REF] += num_refs * dram.tRFC;
+        stats.pwrStateTime[PWR_IDLE] += ref_done_at - pwrStateTick -
+            num_refs * dram.tRFC;
+        pwrStateTick = ref_done_at;
+
+        // each refresh restarted the idle scheduler when done
+        dram.ctrl->recordIdleRestarts(num_refs);
+
+        refreshDueAt = last_ref_at + dram.tREFI;
+        ref_at = refreshDueAt - dram.tRP;
+
+        DPRINTF(DRAM, "Caught up with %llu refreshes, last at %llu\n",
+                num_refs, last_ref_at);
+    }
+
+    if (ref_at < curTick()) {
+        // a refresh is in progress, start it as processRefreshEvent
+        // would have and let the events complete it
+        ++outstandingEvents;
+        stats.pwrStateTime[PWR_IDLE] += ref_at - pwrStateTick;
+        pwrStateTrans = PWR_REF;
+        pwrState = PWR_REF;
+        pwrStateTick = ref_at;
+        refreshState = REF_RUN;
+
+        Tick ref_done_at = ref_at + dram.tRFC;
+        for (auto &b : banks) {
+            b.actAllowedAt = ref_done_at;
+        }
+
+        cmdList.push_back(Command(MemCommand::REF, 0, ref_at));
+        ++stats.numRefreshes;
+        updatePowerStats(ref_at);
+
+        refreshDueAt = ref_at + dram.tREFI;
+        schedule(refreshEvent, ref_done_at);
+    } else {
+        schedule(refreshEvent, ref_at);
+    }
+}
+
 void
 DRAMInterface::Rank::schedulePowerEvent(PowerState pwr_state, Tick tick)
 {
@@ -1770,17 +1658,18 @@ DRAMInterface::Rank::processPowerEvent()
 }
 
 void
-DRAMInterface::Rank::updatePowerStats()
+DRAMInterface::Rank::updatePowerStats(Tick until)
 {
     // All commands up to refresh have completed
     // flush cmdList to DRAMPower
-    flushCmdList();
+    flushCmdList(until);
 
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
-    // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    // and is upto until, the current time unless catching up with skipped
+    // refreshes.
+    power.powerlib.calcWindowEnergy(divCeil(until, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1808,7 +1697,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (until - dram.lastStatsResetTick)) *
                     (sim_clock::Frequency / 1000000000.0);
 }
 
@@ -1818,7 +1707,7 @@ DRAMInterface::Rank::computeStats()
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // final update of power state times
     stats.pwrStateTime[pwrState] += (curTick() - pwrStateTick);
@@ -1995,6 +1884,8 @@ DRAMInterface::RankStats::RankStats(DRAMInterface &_dram, Rank &_rank)
              "Total energy per rank (pJ)"),
     ADD_STAT(averagePower, statistics::units::Watt::get(),
              "Core power per rank (mW)"),
+    ADD_STAT(numRefreshes, statistics::units::Count::get(),
+             "Number of refresh commands per rank"),
 
     ADD_STAT(totalIdleTime, statistics::units::Tick::get(),
              "Total Idle time Per DRAM Rank"),
@@ -207,6 +207,12 @@ class DRAMInterface : public MemInterface
         statistics::Scalar totalEnergy;
         statistics::Scalar averagePower;
 
+        /**
+         * Number of refresh commands issued, including those accounted
+         * for in bulk after a lazy refresh idle phase
+         */
+        statistics::Scalar numRefreshes;
+
         /**
          * Stat to track total DRAM idle time
          *
@@ -256,10 +262,18 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * Refresh events are not scheduled while the controller is idle,
+         * the refreshes are instead accounted for in catchUpRefresh.
+         */
+        bool refreshSkipped;
+
         /**
          * Function to update Power Stats
+         *
+         * @param until Tick up to which the stats are updated
          */
-        void updatePowerStats();
+        void updatePowerStats(Tick until);
 
         /**
          * Schedule a power state transition in the future, and
@@ -365,6 +379,14 @@ class DRAMInterface : public MemInterface
          */
         void suspend();
 
+        /**
+         * Account for the refreshes skipped while the controller was
+         * idle, bringing the refresh and power state machines and their
+         * stats to where the events would have left them, and schedule
+         * the next refresh event.
+         */
+        void catchUpRefresh();
+
         /**
          * Check if there is no refresh and no preparation of refresh ongoing
          * i.e. the refresh state machine is in idle
@@ -410,11 +432,13 @@ class DRAMInterface : public MemInterface
 
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
+         * or before until to DRAMPower library
          * All commands before curTick are guaranteed to be complete
          * and can safely be flushed.
+         *
+         * @param until Tick of the last command to flush
          */
-        void flushCmdList();
+        void flushCmdList(Tick until);
 
         /**
          * Computes stats just prior to dump event
@@ -533,6 +557,9 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /** Skip the refresh events of the ranks of an idle controller. */
+    const bool lazyRefresh;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
@@ -626,17 +653,39 @@ class DRAMInterface : public MemInterface
     Tick writeToReadDelay() const override { return tBURST + tWTR + tWL; }
 
     /**
-     * Find which are the earliest banks ready to issue an activate
-     * for the enqueued requests. Assumes maximum of 32 banks per rank
-     * Also checks if the bank is already prepped.
-     *
-     * @param queue Queued requests to consider
-     * @param min_col_at time of seamless burst command
-     * @return One-hot encoded mask of bank indices
-     * @return boolean indicating burst can issue seamlessly, with no gaps
+     * The ranks of the interface as the FR-FCFS scheduler of
+     * dram_sched.hh sees them.
      */
-    std::pair<std::vector<uint32_t>, bool>
-    minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
+    class SchedView
+    {
+      private:
+        const DRAMInterface &dram;
+
+      public:
+        typedef MemInterface::Bank Bank;
+
+        SchedView(const DRAMInterface &_dram) : dram(_dram) { }
+
+        std::string name() const { return dram.name(); }
+        uint8_t pseudoChannel() const { return dram.pseudoChannel; }
+        int ranks() const { return dram.ranksPerChannel; }
+
+        bool
+        rankAvailable(int rank) const
+        {
+            return dram.ranks[rank]->inRefIdleState();
+        }
+
+        const Bank &
+        bank(int rank, int bank) const
+        {
+            return dram.ranks[rank]->banks[bank];
+        }
+
+        bool readBus() const { return dram.ctrl->inReadBusState(false); }
+        Tick tRP() const { return dram.tRP; }
+        Tick tRCD() const { return readBus() ? dram.tRCD_RD : dram.tRCD_WR; }
+    };
 
     /*
      * @return time to send a burst of data without gaps
@@ -691,6 +740,12 @@ class DRAMInterface : public MemInterface
      */
     void suspend() override;
 
+    /**
+     * Iterate through DRAM ranks and account for the refreshes they
+     * skipped while the controller was idle
+     */
+    void catchUpRefresh() override;
+
     /*
      * @return time to offset next command
      */
@@ -746,8 +801,6 @@ class DRAMInterface : public MemInterface
         return ranks[pkt->rank]->inRefIdleState();
     }
 
-    void getMemStats(PacketPtr pkt) override;
-
     /**
      * This function checks if ranks are actively refreshing and
      * therefore busy. The function also checks if ranks are in
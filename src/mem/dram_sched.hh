@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * The FR-FCFS selection of the DRAM interface, written against a view of
+ * the ranks so that it can be checked without a memory controller. A view
+ * provides:
+ * - Bank, the type of its banks, with openRow (Bank::NO_ROW when the row
+ *   buffer is closed), rdAllowedAt, wrAllowedAt, preAllowedAt and
+ *   actAllowedAt;
+ * - name(), used in the debug output;
+ * - pseudoChannel() and ranks(), the pseudo channel and the number of
+ *   ranks of the interface;
+ * - rankAvailable(rank), false while the rank is refreshing;
+ * - bank(rank, bank);
+ * - readBus(), whether the controller is in the read bus state;
+ * - tRP(), and tRCD() for the current bus direction.
+ */
+
+#ifndef __MEM_DRAM_SCHED_HH__
+#define __MEM_DRAM_SCHED_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/trace.hh"
+#include "base/types.hh"
+#include "debug/DRAM.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/mem_packet_queue.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace dram_sched
+{
+
+/**
+ * Find which are the earliest banks ready to issue an activate for the
+ * queued requests. Also checks if the bank is already prepped.
+ *
+ * @param view The ranks of the interface
+ * @param queue Queued requests to consider
+ * @param min_col_at time of seamless burst command
+ * @return One-hot encoded mask of bank indices, for each rank
+ * @return boolean indicating burst can issue seamlessly, with no gaps
+ */
+template <class View>
+std::pair<std::vector<uint64_t>, bool>
+minBankPrep(const View &view, const MemPacketQueue &queue, Tick min_col_at)
+{
+    typedef typename View::Bank Bank;
+
+    Tick min_act_at = MaxTick;
+    std::vector<uint64_t> bank_mask(view.ranks(), 0);
+
+    // Flag condition when burst can issue back-to-back with previous burst
+    bool found_seamless_bank = false;
+
+    // Flag condition when bank can be opened without incurring additional
+    // delay on the data bus
+    bool hidden_bank_prep = false;
+
+    // Find command with optimal bank timing
+    // Will prioritize commands that can issue seamlessly.
+    for (int i = 0; i < view.ranks(); i++) {
+        // the requests to a rank currently refreshing are not considered
+        if (!view.rankAvailable(i))
+            continue;
+
+        // only the banks with queued transactions are considered
+        for (uint64_t busy = queue.busyBanks(view.pseudoChannel(), true, i);
+             busy; busy &= busy - 1) {
+            const int j = findLsbSet(busy);
+            const Bank &bank = view.bank(i, j);
+
+            // simplistic approximation of when the bank can issue
+            // an activate, ignoring any rank-to-rank switching
+            // cost in this calculation
+            Tick act_at = bank.openRow == Bank::NO_ROW ?
+                std::max(bank.actAllowedAt, curTick()) :
+                std::max(bank.preAllowedAt, curTick()) + view.tRP();
+
+            // latest Tick for which ACT can occur without
+            // incurring additoinal delay on the data bus
+            const Tick tRCD = view.tRCD();
+            const Tick hidden_act_max =
+                        std::max(min_col_at - tRCD, curTick());
+
+            // When is the earliest the R/W burst can issue?
+            const Tick col_allowed_at = view.readBus() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
+            Tick col_at = std::max(col_allowed_at, act_at + tRCD);
+
+            // bank can issue burst back-to-back (seamlessly) with
+            // previous burst
+            bool new_seamless_bank = col_at <= min_col_at;
+
+            // if we found a new seamless bank or we have no
+            // seamless banks, and got a bank with an earlier
+            // activate time, it should be added to the bit mask
+            if (new_seamless_bank ||
+                (!found_seamless_bank && act_at <= min_act_at)) {
+                // if we did not have a seamless bank before, and
+                // we do now, reset the bank mask, also reset it
+                // if we have not yet found a seamless bank and
+                // the activate time is smaller than what we have
+                // seen so far
+                if (!found_seamless_bank &&
+                    (new_seamless_bank || act_at < min_act_at)) {
+                    std::fill(bank_mask.begin(), bank_mask.end(), 0);
+                }
+
+                found_seamless_bank |= new_seamless_bank;
+
+                // ACT can occur 'behind the scenes'
+                hidden_bank_prep = act_at <= hidden_act_max;
+
+                // set the bit corresponding to the available bank
+                replaceBits(bank_mask[i], j, j, 1);
+                min_act_at = act_at;
+            }
+        }
+    }
+
+    return std::make_pair(bank_mask, hidden_bank_prep);
+}
+
+/**
+ * For FR-FCFS policy, find first DRAM command that can issue
+ *
+ * @param view The ranks of the interface
+ * @param queue Queued requests to consider
+ * @param min_col_at Minimum tick for 'seamless' issue
+ * @return an iterator to the selected packet, else queue.end()
+ * @return the tick when the packet selected will issue
+ */
+template <class View>
+std::pair<MemPacketQueue::iterator, Tick>
+chooseNextFRFCFS(const View &view, MemPacketQueue &queue, Tick min_col_at)
+{
+    typedef typename View::Bank Bank;
+
+    // The queue is searched bank by bank, through its bank index, for the
+    // packet that a search of the queue in arrival order would pick:
+    // 1) the oldest row hit that can issue seamlessly, without additional
+    //    delay (e.g., same rank accesses and/or different bank-group
+    //    accesses);
+    // 2) otherwise, the oldest row miss to one of the earliest banks to
+    //    prepare, if its PRE/ACT sequence can be hidden (this selects
+    //    closed rows first to enable more open row possibilities in
+    //    future selections);
+    // 3) otherwise, the oldest row hit, which has its bank prepped;
+    // 4) otherwise, the oldest row miss to one of the earliest banks
+    const MemPacketQueue::Entry *seamless_pkt = nullptr;
+    const MemPacketQueue::Entry *prepped_pkt = nullptr;
+    Tick seamless_col_at = MaxTick;
+    Tick prepped_col_at = MaxTick;
+
+    // are there row misses in available ranks?
+    bool got_miss = false;
+
+    for (int i = 0; i < view.ranks(); i++) {
+        // check if rank is not doing a refresh and thus is available,
+        // if not, skip its packets
+        if (!view.rankAvailable(i)) {
+            DPRINTFS(DRAM, &view, "%s Rank %d not available\n", __func__, i);
+            continue;
+        }
+
+        for (uint64_t busy = queue.busyBanks(view.pseudoChannel(), true, i);
+             busy; busy &= busy - 1) {
+            const int j = findLsbSet(busy);
+            const MemPacketQueue::BankQueue *bank_queue =
+                queue.bankQueue(view.pseudoChannel(), true, i, j);
+
+            const Bank &bank = view.bank(i, j);
+            const MemPacketQueue::Entry *hit =
+                bank_queue->firstHit(bank.openRow);
+            if (!hit) {
+                got_miss = true;
+                continue;
+            }
+            got_miss |= bank_queue->hasMiss(bank.openRow);
+
+            // as the packets of a queue are either all reads or all
+            // writes, all the hits of the bank are seamless, or none is
+            const Tick col_allowed_at = (*hit->it)->isRead() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
+            if (col_allowed_at <= min_col_at) {
+                if (!seamless_pkt || hit->seq < seamless_pkt->seq) {
+                    seamless_pkt = hit;
+                    seamless_col_at = col_allowed_at;
+                }
+            } else if (!prepped_pkt || hit->seq < prepped_pkt->seq) {
+                prepped_pkt = hit;
+                prepped_col_at = col_allowed_at;
+            }
+        }
+    }
+
+    if (seamless_pkt) {
+        DPRINTFS(DRAM, &view, "%s Seamless buffer hit\n", __func__);
+        return std::make_pair(seamless_pkt->it, seamless_col_at);
+    }
+
+    if (got_miss) {
+        // determine entries with earliest bank delay
+        std::vector<uint64_t> earliest_banks;
+        // can the PRE/ACT sequence be done without impacting utlization?
+        bool hidden_bank_prep;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(view, queue, min_col_at);
+
+        const MemPacketQueue::Entry *earliest_pkt = nullptr;
+        Tick earliest_col_at = MaxTick;
+        for (int i = 0; i < view.ranks(); i++) {
+            // minBankPrep only considers the banks of available ranks
+            // with queued packets
+            for (uint64_t mask = earliest_banks[i]; mask; mask &= mask - 1) {
+                const int j = findLsbSet(mask);
+                const Bank &bank = view.bank(i, j);
+                const MemPacketQueue::Entry *miss =
+                    queue.bankQueue(view.pseudoChannel(), true, i, j)->
+                        firstMiss(bank.openRow);
+                if (miss && (!earliest_pkt || miss->seq < earliest_pkt->seq)) {
+                    earliest_pkt = miss;
+                    earliest_col_at = (*miss->it)->isRead() ?
+                        bank.rdAllowedAt : bank.wrAllowedAt;
+                }
+            }
+        }
+
+        // give priority to packets that can issue bank commands 'behind
+        // the scenes', any additional delay if any will be due to
+        // col-to-col command requirements
+        if (earliest_pkt && (hidden_bank_prep || !prepped_pkt)) {
+            DPRINTFS(DRAM, &view, "%s Earliest bank prep, hidden %d\n",
+                     __func__, hidden_bank_prep);
+            return std::make_pair(earliest_pkt->it, earliest_col_at);
+        }
+    }
+
+    if (prepped_pkt) {
+        DPRINTFS(DRAM, &view, "%s Prepped row buffer hit\n", __func__);
+        return std::make_pair(prepped_pkt->it, prepped_col_at);
+    }
+
+    DPRINTFS(DRAM, &view, "%s no available DRAM ranks found\n", __func__);
+    return std::make_pair(queue.end(), MaxTick);
+}
+
+} // namespace dram_sched
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_DRAM_SCHED_HH__
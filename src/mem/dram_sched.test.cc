@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/dram_sched.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+const unsigned numRows = 4;
+
+struct TestBank
+{
+    static const uint32_t NO_ROW = -1;
+
+    uint32_t openRow = NO_ROW;
+    Tick rdAllowedAt = 0;
+    Tick wrAllowedAt = 0;
+    Tick preAllowedAt = 0;
+    Tick actAllowedAt = 0;
+};
+
+/** The ranks of a DRAM interface, as dram_sched.hh expects them */
+class TestView
+{
+  public:
+    typedef TestBank Bank;
+
+    uint8_t channel = 0;
+    std::vector<std::vector<Bank>> banks;
+    std::vector<bool> available;
+    bool read = true;
+    Tick rp = 0;
+    Tick rcdRd = 0;
+    Tick rcdWr = 0;
+
+    std::string name() const { return "dram"; }
+    uint8_t pseudoChannel() const { return channel; }
+    int ranks() const { return banks.size(); }
+    bool rankAvailable(int rank) const { return available[rank]; }
+    const Bank &bank(int rank, int bank) const { return banks[rank][bank]; }
+    bool readBus() const { return read; }
+    Tick tRP() const { return rp; }
+    Tick tRCD() const { return read ? rcdRd : rcdWr; }
+};
+
+/**
+ * DRAMInterface::minBankPrep before the queues were indexed, going
+ * through every packet of the queue.
+ */
+std::pair<std::vector<uint64_t>, bool>
+scanMinBankPrep(const TestView &view, const MemPacketQueue &queue,
+                Tick min_col_at)
+{
+    const int banks_per_rank = view.banks[0].size();
+    Tick min_act_at = MaxTick;
+    std::vector<uint64_t> bank_mask(view.ranks(), 0);
+    bool found_seamless_bank = false;
+    bool hidden_bank_prep = false;
+
+    std::vector<bool> got_waiting(view.ranks() * banks_per_rank, false);
+    for (const auto &p : queue) {
+        if (p->pseudoChannel != view.pseudoChannel())
+            continue;
+        if (p->isDram() && view.rankAvailable(p->rank))
+            got_waiting[p->bankId] = true;
+    }
+
+    for (int i = 0; i < view.ranks(); i++) {
+        for (int j = 0; j < banks_per_rank; j++) {
+            if (!got_waiting[i * banks_per_rank + j])
+                continue;
+
+            const TestBank &bank = view.bank(i, j);
+            Tick act_at = bank.openRow == TestBank::NO_ROW ?
+                std::max(bank.actAllowedAt, curTick()) :
+                std::max(bank.preAllowedAt, curTick()) + view.tRP();
+            const Tick tRCD = view.tRCD();
+            const Tick hidden_act_max =
+                std::max(min_col_at - tRCD, curTick());
+            const Tick col_allowed_at = view.readBus() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
+            Tick col_at = std::max(col_allowed_at, act_at + tRCD);
+            bool new_seamless_bank = col_at <= min_col_at;
+
+            if (new_seamless_bank ||
+                (!found_seamless_bank && act_at <= min_act_at)) {
+                if (!found_seamless_bank &&
+                    (new_seamless_bank || act_at < min_act_at)) {
+                    std::fill(bank_mask.begin(), bank_mask.end(), 0);
+                }
+                found_seamless_bank |= new_seamless_bank;
+                hidden_bank_prep = act_at <= hidden_act_max;
+                replaceBits(bank_mask[i], j, j, 1);
+                min_act_at = act_at;
+            }
+        }
+    }
+
+    return std::make_pair(bank_mask, hidden_bank_prep);
+}
+
+/**
+ * DRAMInterface::chooseNextFRFCFS before the queues were indexed,
+ * searching the queue in arrival order.
+ */
+std::pair<MemPacketQueue::iterator, Tick>
+scanChooseNextFRFCFS(const TestView &view, MemPacketQueue &queue,
+                     Tick min_col_at)
+{
+    std::vector<uint64_t> earliest_banks(view.ranks(), 0);
+    bool filled_earliest_banks = false;
+    bool hidden_bank_prep = false;
+    bool found_hidden_bank = false;
+    bool found_prepped_pkt = false;
+    bool found_earliest_pkt = false;
+
+    Tick selected_col_at = MaxTick;
+    auto selected_pkt_it = queue.end();
+
+    for (auto i = queue.begin(); i != queue.end() ; ++i) {
+        MemPacket *pkt = *i;
+        if (!pkt->isDram() || pkt->pseudoChannel != view.pseudoChannel() ||
+            !view.rankAvailable(pkt->rank)) {
+            continue;
+        }
+
+        const TestBank &bank = view.bank(pkt->rank, pkt->bank);
+        const Tick col_allowed_at = pkt->isRead() ? bank.rdAllowedAt :
+                                                    bank.wrAllowedAt;
+        if (bank.openRow == pkt->row) {
+            if (col_allowed_at <= min_col_at) {
+                selected_pkt_it = i;
+                selected_col_at = col_allowed_at;
+                break;
+            } else if (!found_hidden_bank && !found_prepped_pkt) {
+                selected_pkt_it = i;
+                selected_col_at = col_allowed_at;
+                found_prepped_pkt = true;
+            }
+        } else if (!found_earliest_pkt) {
+            if (!filled_earliest_banks) {
+                std::tie(earliest_banks, hidden_bank_prep) =
+                    scanMinBankPrep(view, queue, min_col_at);
+                filled_earliest_banks = true;
+            }
+
+            if (bits(earliest_banks[pkt->rank], pkt->bank, pkt->bank)) {
+                found_earliest_pkt = true;
+                found_hidden_bank = hidden_bank_prep;
+                if (hidden_bank_prep || !found_prepped_pkt) {
+                    selected_pkt_it = i;
+                    selected_col_at = col_allowed_at;
+                }
+            }
+        }
+    }
+
+    return std::make_pair(selected_pkt_it, selected_col_at);
+}
+
+/** A memory packet and the packet it was made for. */
+struct TestPacket
+{
+    TestPacket(bool is_read, uint8_t pseudo_channel, bool is_dram,
+               uint8_t rank, uint8_t bank, uint16_t bank_id, uint32_t row)
+        : req(std::make_shared<Request>(0, 64, 0, 0)),
+          pkt(req, is_read ? MemCmd::ReadReq : MemCmd::WriteReq),
+          memPkt(&pkt, is_read, is_dram, pseudo_channel, rank, bank, row,
+                 bank_id, 0, 64)
+    {}
+
+    RequestPtr req;
+    Packet pkt;
+    MemPacket memPkt;
+};
+
+/**
+ * Random scheduling decisions of a controller queue: packets arrive, and
+ * each decision picks a packet, which then leaves the queue, with random
+ * bank timings, open rows and refreshing ranks in between. The packets
+ * of the other pseudo channel and of an NVM interface share the queue.
+ */
+void
+replayDecisions(unsigned seed, int num_ranks, int banks_per_rank,
+                bool is_read)
+{
+    std::mt19937 rng(seed);
+    TestView view;
+    view.banks.assign(num_ranks, std::vector<TestBank>(banks_per_rank));
+    view.available.assign(num_ranks, true);
+    view.rp = 14;
+    view.rcdRd = 14;
+    view.rcdWr = 16;
+
+    MemPacketQueue queue;
+    std::vector<std::unique_ptr<TestPacket>> packets;
+
+    // Small tick ranges, so that many banks tie
+    Tick now = 1000;
+    auto timing = [&]() { return now - 20 + rng() % 60; };
+
+    for (int decision = 0; decision < 2000; decision++) {
+        const unsigned arrivals = queue.size() < 4 ? 4 : rng() % 3;
+        for (unsigned n = 0; n < arrivals && queue.size() < 64; n++) {
+            const uint8_t pseudo_channel = rng() % 4 == 0;
+            const bool is_dram = rng() % 8 != 0;
+            const uint8_t rank = rng() % num_ranks;
+            // Few banks, so that they have several packets, and now and
+            // then the last bank of the mask
+            uint8_t bank = rng() % std::min(banks_per_rank, 6);
+            if (rng() % 8 == 0)
+                bank = banks_per_rank - 1;
+            packets.emplace_back(new TestPacket(is_read, pseudo_channel,
+                is_dram, rank, bank, rank * banks_per_rank + bank,
+                rng() % numRows));
+            queue.push_back(&packets.back()->memPkt);
+        }
+
+        now += rng() % 20;
+        tickHandler.setCurTick(now);
+        view.read = rng() % 4 != 0;
+        for (int rank = 0; rank < num_ranks; rank++) {
+            view.available[rank] = rng() % 6 != 0;
+            for (TestBank &bank : view.banks[rank]) {
+                bank.openRow = rng() % 3 == 0 ? TestBank::NO_ROW :
+                    rng() % numRows;
+                bank.rdAllowedAt = timing();
+                bank.wrAllowedAt = timing();
+                bank.preAllowedAt = timing();
+                bank.actAllowedAt = timing();
+            }
+        }
+        const Tick min_col_at = now + rng() % 40;
+
+        ASSERT_EQ(dram_sched::minBankPrep(view, queue, min_col_at),
+                  scanMinBankPrep(view, queue, min_col_at))
+            << "decision " << decision;
+
+        const auto indexed =
+            dram_sched::chooseNextFRFCFS(view, queue, min_col_at);
+        const auto scanned = scanChooseNextFRFCFS(view, queue, min_col_at);
+        ASSERT_EQ(indexed.first == queue.end(), scanned.first == queue.end())
+            << "decision " << decision;
+        if (indexed.first == queue.end())
+            continue;
+        ASSERT_EQ(*indexed.first, *scanned.first)
+            << "decision " << decision;
+        ASSERT_EQ(indexed.second, scanned.second)
+            << "decision " << decision;
+
+        queue.erase(indexed.first);
+    }
+}
+
+} // anonymous namespace
+
+TEST(DRAMSchedTest, ReadsMatchLinearScan)
+{
+    for (unsigned seed = 0; seed < 10; seed++) {
+        for (int num_ranks : {1, 2, 4}) {
+            for (int banks_per_rank : {8, 16, 64}) {
+                ASSERT_NO_FATAL_FAILURE(replayDecisions(
+                    seed, num_ranks, banks_per_rank, true));
+            }
+        }
+    }
+}
+
+TEST(DRAMSchedTest, WritesMatchLinearScan)
+{
+    for (unsigned seed = 0; seed < 10; seed++) {
+        for (int num_ranks : {1, 2, 4}) {
+            for (int banks_per_rank : {8, 16, 64}) {
+                ASSERT_NO_FATAL_FAILURE(replayDecisions(
+                    seed, num_ranks, banks_per_rank, false));
+            }
+        }
+    }
+}
@@ -171,7 +171,7 @@ class HBMCtrl : public MemCtrl
      * Response queue for pkts sent to second pseudo channel
      * The first pseudo channel uses MemCtrl::respQueue
      */
-    std::deque<MemPacket*> respQueuePC1;
+    MemRespQueue respQueuePC1;
 
     /**
      * Holds count of row commands issued in burst window starting at
@@ -249,6 +249,8 @@ class HBMCtrl : public MemCtrl
         }
     }
 
+    void catchUpRefresh() override;
+
 
     virtual void init() override;
     virtual void startup() override;
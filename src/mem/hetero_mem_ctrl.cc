@@ -194,7 +194,7 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 HeteroMemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        MemRespQueue& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -415,6 +415,8 @@ HeteroMemCtrl::allIntfDrained() const
 DrainState
 HeteroMemCtrl::drain()
 {
+    catchUpRefresh();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
@@ -484,7 +484,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        MemRespQueue& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -639,7 +639,6 @@ MemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
         // Here we reset the timing of the packet before sending it out.
         pkt->headerDelay = pkt->payloadDelay = 0;
 
-        mem_intr->getMemStats(pkt);
         // queue the packet in the response queue to be sent out after
         // the static latency has passed
         port.schedTimingResp(pkt, response_time);
@@ -875,7 +874,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        MemRespQueue& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -1400,6 +1399,8 @@ MemCtrl::allIntfDrained() const
 DrainState
 MemCtrl::drain()
 {
+    catchUpRefresh();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
@@ -1441,6 +1442,46 @@ MemCtrl::drainResume()
     isTimingMode = system()->isTimingMode();
 }
 
+bool
+MemCtrl::schedulerIdle(uint8_t pseudo_channel)
+{
+    // mirror processNextReqEvent staying in the read state, with
+    // nothing to do and no reason to switch to writes
+    return !turnPolicy && busState == READ && busStateNext == READ &&
+        totalReadQueueSize == 0 && totalWriteQueueSize <= writeLowThreshold &&
+        respQEmpty() && drainState() == DrainState::Running &&
+        !requestEventScheduled(pseudo_channel);
+}
+
+void
+MemCtrl::recordIdleRestarts(uint64_t count)
+{
+    qos::MemCtrl::stats.numStayReadState += count;
+}
+
+void
+MemCtrl::catchUpRefresh()
+{
+    dram->catchUpRefresh();
+}
+
+void
+MemCtrl::preDumpStats()
+{
+    catchUpRefresh();
+
+    qos::MemCtrl::preDumpStats();
+}
+
+void
+MemCtrl::resetStats()
+{
+    // the refreshes skipped so far belong to the stats being reset
+    catchUpRefresh();
+
+    qos::MemCtrl::resetStats();
+}
+
 AddrRangeList
 MemCtrl::getAddrRanges()
 {
@@ -1492,6 +1533,9 @@ MemCtrl::MemoryPort::recvAtomicBackdoor(
 bool
 MemCtrl::MemoryPort::recvTimingReq(PacketPtr pkt)
 {
+    // the controller is no longer idle
+    ctrl.catchUpRefresh();
+
     // pass it to the memory controller
     return ctrl.recvTimingReq(pkt);
 }
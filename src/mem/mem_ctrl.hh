@@ -55,6 +55,7 @@
 #include "base/callback.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
+#include "mem/mem_packet_queue.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
 #include "params/MemCtrl.hh"
@@ -215,10 +216,8 @@ class MemPacket
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
-
+// The responses are kept in a plain queue, in the order they are ready
+typedef std::deque<MemPacket*> MemRespQueue;
 
 /**
  * The memory controller is a single-channel memory controller capturing
@@ -298,14 +297,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          MemRespQueue& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        MemRespQueue& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -487,7 +486,7 @@ class MemCtrl : public qos::MemCtrl
      * as sizing the read queue, this and the main read queue need to
      * be added together.
      */
-    std::deque<MemPacket*> respQueue;
+    MemRespQueue respQueue;
 
     /**
      * Holds count of commands issued in burst window starting at
@@ -758,6 +757,32 @@ class MemCtrl : public qos::MemCtrl
         schedule(nextReqEvent, tick);
     }
 
+    /**
+     * Check if the scheduler is idle, i.e. restarting it would have no
+     * effect but to record that the bus stays in the read state, and
+     * will remain so until the controller is accessed again. Used by
+     * the interfaces to skip their periodic maintenance events.
+     *
+     * @param pseudo_channel pseudo channel number of the scheduler
+     * @return True if the scheduler is idle
+     */
+    bool schedulerIdle(uint8_t pseudo_channel = 0);
+
+    /**
+     * Record the restarts of an idle scheduler that followed the
+     * maintenance skipped by the interfaces.
+     *
+     * @param count Number of restarts
+     */
+    void recordIdleRestarts(uint64_t count);
+
+    /**
+     * Let the interfaces account for the maintenance they skipped while
+     * the scheduler was idle, before the controller is accessed, drained
+     * or its stats are observed.
+     */
+    virtual void catchUpRefresh();
+
     /**
      * Check the current direction of the memory channel
      *
@@ -781,6 +806,9 @@ class MemCtrl : public qos::MemCtrl
     virtual void startup() override;
     virtual void drainResume() override;
 
+    void preDumpStats() override;
+    void resetStats() override;
+
   protected:
 
     virtual Tick recvAtomic(PacketPtr pkt);
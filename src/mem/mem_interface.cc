@@ -77,6 +77,11 @@ void
 MemInterface::setCtrl(MemCtrl* _ctrl, unsigned int command_window,
                                             uint8_t pseudo_channel)
 {
+    fatal_if(banksPerRank > MemPacketQueue::maxBanksPerRank,
+             "%s: the memory controller queues track up to %d banks per "
+             "rank, %d requested\n", name(), MemPacketQueue::maxBanksPerRank,
+             banksPerRank);
+
     ctrl = _ctrl;
     maxCommandsPerWindow = command_window / tCK;
     // setting the pseudo channel number for this interface
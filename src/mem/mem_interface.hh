@@ -328,10 +328,6 @@ class MemInterface : public AbstractMemory
     doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
                   const std::vector<MemPacketQueue>& queue) = 0;
 
-    virtual void getMemStats(PacketPtr pkt) {
-        panic("Only DRAM can provide these two stats");
-    }
-
     /**
      * This function is DRAM specific.
      */
@@ -367,6 +363,12 @@ class MemInterface : public AbstractMemory
         "not be executed from here.\n");
     }
 
+    /**
+     * This function is DRAM specific, and a no-op for interfaces without
+     * refresh.
+     */
+    virtual void catchUpRefresh() {}
+
     /**
      * This function is NVM specific.
      */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/mem_packet_queue.hh"
+
+#include <cassert>
+
+#include "mem/mem_ctrl.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+void
+MemPacketQueue::push_back(MemPacket *pkt)
+{
+    const Entry entry{nextSeq++, packets.insert(packets.end(), pkt)};
+
+    const unsigned media = pkt->pseudoChannel * 2 + pkt->isDram();
+    if (media >= ranks.size())
+        ranks.resize(media + 1);
+    if (pkt->rank >= ranks[media].size())
+        ranks[media].resize(pkt->rank + 1);
+    RankQueue &rank_queue = ranks[media][pkt->rank];
+    if (pkt->bank >= rank_queue.banks.size())
+        rank_queue.banks.resize(pkt->bank + 1);
+    BankQueue &bank_queue = rank_queue.banks[pkt->bank];
+    rank_queue.busy |= 1ULL << pkt->bank;
+
+    BankQueue::Row *free_row = nullptr;
+    for (auto &r : bank_queue.rows) {
+        if (r.entries.empty()) {
+            free_row = &r;
+        } else if (r.row == pkt->row) {
+            free_row = &r;
+            break;
+        }
+    }
+    if (!free_row)
+        free_row = &bank_queue.rows.emplace_back();
+    free_row->row = pkt->row;
+    free_row->entries.push_back(entry);
+    ++bank_queue.numPackets;
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    const MemPacket *pkt = *it;
+
+    RankQueue &rank_queue =
+        ranks[pkt->pseudoChannel * 2 + pkt->isDram()][pkt->rank];
+    BankQueue &bank_queue = rank_queue.banks[pkt->bank];
+    auto r = bank_queue.rows.begin();
+    while (r->row != pkt->row || r->entries.empty()) {
+        ++r;
+        assert(r != bank_queue.rows.end());
+    }
+
+    // The packets are mostly taken from the head of their row
+    auto entry = r->entries.begin();
+    while (entry->it != it) {
+        ++entry;
+        assert(entry != r->entries.end());
+    }
+    r->entries.erase(entry);
+    if (--bank_queue.numPackets == 0)
+        rank_queue.busy &= ~(1ULL << pkt->bank);
+
+    return packets.erase(it);
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * MemPacketQueue declaration
+ */
+
+#ifndef __MEM_MEM_PACKET_QUEUE_HH__
+#define __MEM_MEM_PACKET_QUEUE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+class MemPacket;
+
+/**
+ * The queue of the memory packets of a QoS priority (the controllers
+ * keep one per priority). The packets are kept in arrival order, and are
+ * also indexed by bank and row, so that the schedulers can find the
+ * oldest row hit or the oldest row miss of a bank without going through
+ * the whole queue.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::list<MemPacket*>::iterator iterator;
+    typedef std::list<MemPacket*>::const_iterator const_iterator;
+
+    /** Banks per rank the masks of the busy banks can track */
+    static constexpr unsigned maxBanksPerRank = 64;
+
+    /** A packet of a bank, and its position in the queue. */
+    struct Entry
+    {
+        /** Order of arrival in the queue */
+        uint64_t seq;
+        iterator it;
+    };
+
+    /** The packets of a bank, by row, in queue order. */
+    class BankQueue
+    {
+      public:
+        bool empty() const { return numPackets == 0; }
+        size_t size() const { return numPackets; }
+
+        /** The number of packets to the given row. */
+        size_t
+        hits(uint32_t row) const
+        {
+            const Row *r = findRow(row);
+            return r ? r->entries.size() : 0;
+        }
+
+        /** The oldest packet to the given row, if any. */
+        const Entry *
+        firstHit(uint32_t row) const
+        {
+            const Row *r = findRow(row);
+            return r ? &r->entries.front() : nullptr;
+        }
+
+        /** The oldest packet to another row than the given one, if any. */
+        const Entry *
+        firstMiss(uint32_t row) const
+        {
+            const Entry *first = nullptr;
+            for (const auto &r : rows) {
+                if (r.row != row && !r.entries.empty() &&
+                    (!first || r.entries.front().seq < first->seq)) {
+                    first = &r.entries.front();
+                }
+            }
+            return first;
+        }
+
+        /** Is there a packet to the given row, other than the given one? */
+        bool
+        hasHit(uint32_t row, const MemPacket *except) const
+        {
+            const Row *r = findRow(row);
+            return r && (r->entries.size() > 1 ||
+                         *r->entries.front().it != except);
+        }
+
+        /** Is there a packet to another row than the given one? */
+        bool hasMiss(uint32_t row) const { return numPackets > hits(row); }
+
+      private:
+        friend class MemPacketQueue;
+
+        /**
+         * The packets of a row, in queue order. The rows left without
+         * packets are reused for the next new row of the bank.
+         */
+        struct Row
+        {
+            uint32_t row;
+            std::vector<Entry> entries;
+        };
+
+        const Row *
+        findRow(uint32_t row) const
+        {
+            for (const auto &r : rows) {
+                if (r.row == row && !r.entries.empty())
+                    return &r;
+            }
+            return nullptr;
+        }
+
+        /** The rows of the queued packets (few per bank) */
+        std::vector<Row> rows;
+
+        size_t numPackets = 0;
+    };
+
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    bool empty() const { return packets.empty(); }
+    size_t size() const { return packets.size(); }
+
+    void push_back(MemPacket *pkt);
+
+    /** Remove a packet, and return the position of the next one. */
+    iterator erase(iterator it);
+
+    /**
+     * The packets of a bank, or nullptr if the queue never held any.
+     *
+     * @param pseudo_channel Pseudo channel of the packets
+     * @param is_dram Whether the packets access DRAM or NVM
+     * @param rank Rank of the packets
+     * @param bank Bank of the packets within their rank
+     */
+    const BankQueue *
+    bankQueue(uint8_t pseudo_channel, bool is_dram, uint8_t rank,
+              uint8_t bank) const
+    {
+        const RankQueue *rank_queue =
+            rankQueue(pseudo_channel, is_dram, rank);
+        if (!rank_queue || bank >= rank_queue->banks.size())
+            return nullptr;
+        return &rank_queue->banks[bank];
+    }
+
+    /**
+     * The banks of a rank with queued packets, as a mask with one bit per
+     * bank (the same arguments as bankQueue).
+     */
+    uint64_t
+    busyBanks(uint8_t pseudo_channel, bool is_dram, uint8_t rank) const
+    {
+        const RankQueue *rank_queue =
+            rankQueue(pseudo_channel, is_dram, rank);
+        return rank_queue ? rank_queue->busy : 0;
+    }
+
+  private:
+    struct RankQueue
+    {
+        std::vector<BankQueue> banks;
+        uint64_t busy = 0;
+    };
+
+    const RankQueue *
+    rankQueue(uint8_t pseudo_channel, bool is_dram, uint8_t rank) const
+    {
+        const unsigned media = pseudo_channel * 2 + is_dram;
+        if (media >= ranks.size() || rank >= ranks[media].size())
+            return nullptr;
+        return &ranks[media][rank];
+    }
+
+    std::list<MemPacket*> packets;
+
+    /**
+     * The packets of the queue, by media (pseudo channel and DRAM or
+     * NVM), rank and bank, allocated as packets show up
+     */
+    std::vector<std::vector<RankQueue>> ranks;
+
+    /** Arrival order of the next packet */
+    uint64_t nextSeq = 0;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_MEM_PACKET_QUEUE_HH__
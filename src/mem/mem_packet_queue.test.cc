@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/mem_ctrl.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+const unsigned numPseudoChannels = 2;
+const unsigned numRanks = 3;
+const unsigned numBanks = MemPacketQueue::maxBanksPerRank;
+const unsigned numRows = 6;
+
+/** A memory packet and the packet it was made for. */
+struct TestPacket
+{
+    TestPacket(uint8_t pseudo_channel, bool is_dram, uint8_t rank,
+               uint8_t bank, uint32_t row)
+        : req(std::make_shared<Request>(0, 64, 0, 0)),
+          pkt(req, MemCmd::ReadReq),
+          memPkt(&pkt, true, is_dram, pseudo_channel, rank, bank, row,
+                 rank * numBanks + bank, 0, 64)
+    {}
+
+    RequestPtr req;
+    Packet pkt;
+    MemPacket memPkt;
+};
+
+/**
+ * Check the bank index of a queue against a scan of its packets in
+ * arrival order, which is how the schedulers looked for the oldest row
+ * hit or row miss of a bank before the queues were indexed.
+ */
+void
+checkIndex(const MemPacketQueue &queue,
+           const std::vector<MemPacket *> &arrivals)
+{
+    ASSERT_EQ(queue.size(), arrivals.size());
+    auto it = queue.begin();
+    for (MemPacket *pkt : arrivals)
+        ASSERT_EQ(*it++, pkt);
+
+    for (unsigned pc = 0; pc < numPseudoChannels; pc++)
+    for (bool is_dram : {false, true})
+    for (unsigned rank = 0; rank < numRanks; rank++) {
+        std::vector<std::vector<MemPacket *>> banks(numBanks);
+        for (MemPacket *pkt : arrivals) {
+            if (pkt->pseudoChannel == pc && pkt->isDram() == is_dram &&
+                pkt->rank == rank) {
+                banks[pkt->bank].push_back(pkt);
+            }
+        }
+
+        uint64_t busy = 0;
+        for (unsigned bank = 0; bank < numBanks; bank++) {
+            if (!banks[bank].empty())
+                busy |= 1ULL << bank;
+        }
+        ASSERT_EQ(queue.busyBanks(pc, is_dram, rank), busy);
+
+        for (unsigned bank = 0; bank < numBanks; bank++) {
+            const auto &scan = banks[bank];
+            const MemPacketQueue::BankQueue *bank_queue =
+                queue.bankQueue(pc, is_dram, rank, bank);
+            if (!bank_queue) {
+                ASSERT_TRUE(scan.empty());
+                continue;
+            }
+            ASSERT_EQ(bank_queue->size(), scan.size());
+            ASSERT_EQ(bank_queue->empty(), scan.empty());
+
+            // Every row, and no open row at all
+            for (uint32_t row = 0; row <= numRows; row++) {
+                const uint32_t open_row = row == numRows ? -1 : row;
+
+                MemPacket *first_hit = nullptr;
+                MemPacket *first_miss = nullptr;
+                size_t hits = 0;
+                for (MemPacket *pkt : scan) {
+                    if (pkt->row == open_row) {
+                        hits++;
+                        if (!first_hit)
+                            first_hit = pkt;
+                    } else if (!first_miss) {
+                        first_miss = pkt;
+                    }
+                }
+
+                ASSERT_EQ(bank_queue->hits(open_row), hits);
+                const MemPacketQueue::Entry *hit =
+                    bank_queue->firstHit(open_row);
+                ASSERT_EQ(hit ? *hit->it : nullptr, first_hit);
+                const MemPacketQueue::Entry *miss =
+                    bank_queue->firstMiss(open_row);
+                ASSERT_EQ(miss ? *miss->it : nullptr, first_miss);
+                ASSERT_EQ(bank_queue->hasMiss(open_row),
+                          first_miss != nullptr);
+                if (first_hit) {
+                    ASSERT_EQ(bank_queue->hasHit(open_row, first_hit),
+                              hits > 1);
+                }
+                if (hit && miss)
+                    ASSERT_EQ(hit->seq < miss->seq, first_hit == scan[0]);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+/**
+ * Random traces of packet arrivals and removals, with removals mostly
+ * at the head of a row as the schedulers do.
+ */
+TEST(MemPacketQueueTest, MatchesLinearScan)
+{
+    std::mt19937 rng(1);
+    for (int trace = 0; trace < 20; trace++) {
+        MemPacketQueue queue;
+        std::vector<MemPacket *> arrivals;
+        std::vector<std::unique_ptr<TestPacket>> packets;
+
+        // Few banks and rows, so that the rows fill up and the banks
+        // empty and refill, and the last bank of the mask now and then
+        const unsigned banks = trace % 2 ? 4 : numBanks;
+        for (int op = 0; op < 600; op++) {
+            const bool push = arrivals.empty() ||
+                (arrivals.size() < 48 && rng() % 2);
+            if (push) {
+                unsigned bank = rng() % banks;
+                if (rng() % 8 == 0)
+                    bank = numBanks - 1;
+                packets.emplace_back(new TestPacket(
+                    rng() % numPseudoChannels, rng() % 2, rng() % numRanks,
+                    bank, rng() % numRows));
+                MemPacket *pkt = &packets.back()->memPkt;
+                queue.push_back(pkt);
+                arrivals.push_back(pkt);
+            } else {
+                // The head of the queue, the oldest hit of a row, or any
+                size_t victim = 0;
+                if (rng() % 3 != 0) {
+                    victim = rng() % arrivals.size();
+                    if (rng() % 2) {
+                        for (size_t i = 0; i < victim; i++) {
+                            if (arrivals[i]->bankId ==
+                                    arrivals[victim]->bankId &&
+                                arrivals[i]->row == arrivals[victim]->row) {
+                                victim = i;
+                                break;
+                            }
+                        }
+                    }
+                }
+                auto it = queue.begin();
+                std::advance(it, victim);
+                auto next = queue.erase(it);
+                arrivals.erase(arrivals.begin() + victim);
+                if (victim < arrivals.size())
+                    ASSERT_EQ(*next, arrivals[victim]);
+                else
+                    ASSERT_EQ(next, queue.end());
+            }
+            ASSERT_NO_FATAL_FAILURE(checkIndex(queue, arrivals));
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/mem_telemetry.hh"
+
+#include "base/statistics.hh"
+
+namespace gem5
+{
+
+MemTelemetry::MemTelemetry()
+{
+    // Consumers compare the counters against the statistics, so they
+    // must follow the same reset points.
+    statistics::registerResetCallback([this]() { reset(); });
+}
+
+MemTelemetry::CacheSnapshot
+MemTelemetry::cache(int level, ContextID ctx) const
+{
+    checkSlot(level, ctx);
+
+    CacheSnapshot snapshot;
+    const CacheSlot &slot = caches[level][ctx];
+    snapshot.accesses = load(slot.accesses);
+    snapshot.misses = load(slot.misses);
+    snapshot.missLatency = load(slot.missLatency);
+    return snapshot;
+}
+
+MemTelemetry::DRAMSnapshot
+MemTelemetry::dramStats() const
+{
+    DRAMSnapshot snapshot;
+    snapshot.bursts = load(dram.bursts);
+    snapshot.rowHits = load(dram.rowHits);
+    snapshot.readBursts = load(dram.readBursts);
+    snapshot.readLatency = load(dram.readLatency);
+    return snapshot;
+}
+
+void
+MemTelemetry::reset()
+{
+    for (auto &level : caches) {
+        for (auto &slot : level) {
+            slot.accesses.store(0, std::memory_order_relaxed);
+            slot.misses.store(0, std::memory_order_relaxed);
+            slot.missLatency.store(0, std::memory_order_relaxed);
+        }
+    }
+    dram.bursts.store(0, std::memory_order_relaxed);
+    dram.rowHits.store(0, std::memory_order_relaxed);
+    dram.readBursts.store(0, std::memory_order_relaxed);
+    dram.readLatency.store(0, std::memory_order_relaxed);
+}
+
+} // namespace gem5
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Side-channel telemetry shared between the caches, the DRAM interfaces
+ * and the replacement policies that need system-wide feedback.
+ */
+
+#ifndef __MEM_MEM_TELEMETRY_HH__
+#define __MEM_MEM_TELEMETRY_HH__
+
+#include <atomic>
+
+#include "base/logging.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A fixed-size table of per-level, per-context cache counters and
+ * system-wide DRAM counters. Publishers bump the counters as the events
+ * happen, and consumers (e.g. the Flock partitioning logic) take a
+ * snapshot whenever they start a new epoch. This replaces attaching a
+ * copy of the statistics to every Request, which required evaluating
+ * the formula stats on each miss.
+ *
+ * Each System owns its table, so the counters of systems simulated
+ * together are not mixed. All counters are relaxed atomics: the table
+ * may be shared by event queues running on different host threads, and
+ * readers only need a recent, not an exact, view.
+ */
+class MemTelemetry
+{
+  public:
+    /** Maximum number of cache levels that can publish. */
+    static constexpr int MaxCacheLevels = 8;
+
+    /** Maximum number of hardware contexts tracked per level. */
+    static constexpr int MaxContexts = 64;
+
+    /** Counters of a (cache level, context) pair at a point in time. */
+    struct CacheSnapshot
+    {
+        Counter accesses = 0;
+        Counter misses = 0;
+        /** Total ticks spent waiting on misses. */
+        Counter missLatency = 0;
+
+        /**
+         * Average access latency in ticks. Hits are not charged any
+         * latency, which matches BaseCache's overallAccessLatency.
+         */
+        double
+        avgAccessLatency() const
+        {
+            return accesses ? (double)missLatency / accesses : 0.0;
+        }
+    };
+
+    /** DRAM counters aggregated over all the DRAM interfaces. */
+    struct DRAMSnapshot
+    {
+        Counter bursts = 0;
+        Counter rowHits = 0;
+        Counter readBursts = 0;
+        /** Total ticks from entering the controller to data ready. */
+        Counter readLatency = 0;
+
+        /** Average read latency, as DRAMInterface's avgMemAccLat. */
+        double
+        avgAccessLatency() const
+        {
+            return readBursts ? (double)readLatency / readBursts : 0.0;
+        }
+    };
+
+    MemTelemetry();
+
+    /**
+     * Record a cache access.
+     *
+     * @param level The level of the cache as set by its cache_level.
+     * @param ctx The context the access originates from.
+     * @param miss Whether the access missed.
+     */
+    void
+    cacheAccess(int level, ContextID ctx, bool miss)
+    {
+        CacheSlot &slot = cacheSlot(level, ctx);
+        bump(slot.accesses, 1);
+        if (miss)
+            bump(slot.misses, 1);
+    }
+
+    /** Record the latency of a serviced miss. */
+    void
+    cacheMissLatency(int level, ContextID ctx, Tick latency)
+    {
+        bump(cacheSlot(level, ctx).missLatency, latency);
+    }
+
+    /**
+     * Record a DRAM burst.
+     *
+     * @param read Whether the burst is a read.
+     * @param row_hit Whether the burst hit in an open row.
+     * @param latency Latency of a read burst, ignored for writes.
+     */
+    void
+    dramBurst(bool read, bool row_hit, Tick latency)
+    {
+        bump(dram.bursts, 1);
+        if (row_hit)
+            bump(dram.rowHits, 1);
+        if (read) {
+            bump(dram.readBursts, 1);
+            bump(dram.readLatency, latency);
+        }
+    }
+
+    /** Snapshot the counters of a (cache level, context) pair. */
+    CacheSnapshot cache(int level, ContextID ctx) const;
+
+    /** Snapshot the DRAM counters. */
+    DRAMSnapshot dramStats() const;
+
+    /** Clear all the counters, e.g. when the statistics are reset. */
+    void reset();
+
+  private:
+    /** Keep slots written by different caches on separate lines. */
+    struct alignas(64) CacheSlot
+    {
+        std::atomic<Counter> accesses{0};
+        std::atomic<Counter> misses{0};
+        std::atomic<Counter> missLatency{0};
+    };
+
+    struct alignas(64) DRAMSlot
+    {
+        std::atomic<Counter> bursts{0};
+        std::atomic<Counter> rowHits{0};
+        std::atomic<Counter> readBursts{0};
+        std::atomic<Counter> readLatency{0};
+    };
+
+    static void
+    bump(std::atomic<Counter> &counter, Counter value)
+    {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    static Counter
+    load(const std::atomic<Counter> &counter)
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    static void
+    checkSlot(int level, ContextID ctx)
+    {
+        fatal_if(level < 0 || level >= MaxCacheLevels,
+                 "Memory telemetry only tracks cache levels 0 to %d, got %d",
+                 MaxCacheLevels - 1, level);
+        fatal_if(ctx < 0 || ctx >= MaxContexts,
+                 "Memory telemetry only tracks contexts 0 to %d, got %d",
+                 MaxContexts - 1, ctx);
+    }
+
+    CacheSlot &
+    cacheSlot(int level, ContextID ctx)
+    {
+        checkSlot(level, ctx);
+        return caches[level][ctx];
+    }
+
+    CacheSlot caches[MaxCacheLevels][MaxContexts];
+
+    DRAMSlot dram;
+};
+
+} // namespace gem5
+
+#endif // __MEM_MEM_TELEMETRY_HH__
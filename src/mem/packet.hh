@@ -56,6 +56,7 @@
 #include "base/cast.hh"
 #include "base/compiler.hh"
 #include "base/flags.hh"
+#include "base/free_list.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
@@ -352,6 +353,9 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data has been taken from the packet data pool
+        /// rather than the heap, and goes back there when freed.
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -385,6 +389,13 @@ class Packet : public Printable
     */
     PacketDataPtr data;
 
+    /**
+     * Payloads up to a cache line of the common sizes are taken from a
+     * pool of fixed-size buffers instead of the heap.
+     */
+    static constexpr unsigned MaxPooledDataSize = 64;
+    typedef FreeList<MaxPooledDataSize> DataPool;
+
     /// The address of the request.  This address could be virtual or
     /// physical, depending on the system configuration.
     Addr addr;
@@ -1051,6 +1062,30 @@ class Packet : public Printable
         deleteData();
     }
 
+    /**
+     * Packets are recycled through a free list rather than going
+     * through the heap every time. Objects of a different size, which
+     * would be classes deriving from Packet, use the global heap.
+     * @{
+     */
+    static void *
+    operator new(std::size_t size)
+    {
+        if (size == sizeof(Packet))
+            return FreeList<sizeof(Packet)>::allocate();
+        return ::operator new(size);
+    }
+
+    static void
+    operator delete(void *ptr, std::size_t size)
+    {
+        if (size == sizeof(Packet))
+            FreeList<sizeof(Packet)>::deallocate(ptr);
+        else
+            ::operator delete(ptr);
+    }
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1342,10 +1377,12 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            DataPool::deallocate(data);
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1357,8 +1394,13 @@ class Packet : public Printable
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            if (getSize() <= MaxPooledDataSize) {
+                flags.set(DYNAMIC_DATA|POOLED_DATA);
+                data = static_cast<PacketDataPtr>(DataPool::allocate());
+            } else {
+                flags.set(DYNAMIC_DATA);
+                data = new uint8_t[getSize()];
+            }
         }
     }
 
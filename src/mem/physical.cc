@@ -55,6 +55,7 @@
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/store_image.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -80,10 +81,13 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               enums::MemoryCheckpointFormat checkpoint_format,
+                               unsigned checkpoint_threads) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), checkpointFormat(checkpoint_format),
+    checkpointThreads(checkpoint_threads)
 {
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
@@ -376,8 +380,16 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
 
-    // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    if (checkpointFormat == enums::chunked) {
+        store_image::write(filepath, pmem, range.size(), checkpointThreads);
+        return;
+    } else if (checkpointFormat == enums::mapped) {
+        store_image::writeRaw(filepath, pmem, range.size());
+        return;
+    }
+
+    // write memory file
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
@@ -443,11 +455,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -462,6 +469,23 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // The format of the file does not depend on the configuration of
+    // the system that wrote it, but on its content. Raw images are
+    // mapped unless the backing store is shared with other processes.
+    if (store_image::isRawImage(filepath) &&
+        backingStore[store_id].shmFd == -1) {
+        store_image::map(filepath, pmem, range.size(), mmapUsingNoReserve);
+        return;
+    } else if (store_image::isStoreImage(filepath)) {
+        store_image::read(filepath, pmem, range.size(), checkpointThreads);
+        return;
+    }
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -44,6 +44,7 @@
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "enums/MemoryCheckpointFormat.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -158,6 +159,13 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // Format of the checkpoints of the backing stores
+    const enums::MemoryCheckpointFormat checkpointFormat;
+
+    // Number of threads (de)compressing store images, 0 for one per
+    // host core
+    const unsigned checkpointThreads;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -191,7 +199,9 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   enums::MemoryCheckpointFormat checkpoint_format,
+                   unsigned checkpoint_threads);
 
     /**
      * Unmap all the backing store we have used.
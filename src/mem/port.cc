@@ -157,7 +157,7 @@ RequestPort::getAddrRanges() const
 void
 RequestPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    auto req = makeRequest(
         a, 1, 0, Request::funcRequestorId);
 
     Packet pkt(req, MemCmd::PrintReq);
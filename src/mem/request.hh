@@ -59,6 +59,7 @@
 #include "base/amo.hh"
 #include "base/compiler.hh"
 #include "base/flags.hh"
+#include "base/free_list.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
@@ -94,6 +95,9 @@ class ThreadContext;
 typedef std::shared_ptr<Request> RequestPtr;
 typedef uint16_t RequestorID;
 
+template <typename... Args>
+RequestPtr makeRequest(Args &&...args);
+
 class Request
 {
   public:
@@ -370,9 +374,8 @@ class Request
         VALID_HTM_ABORT_CAUSE = 0x00000400,
         /** Whether or not the instruction count is valid. */
         VALID_INST_COUNT      = 0x00000800,
-        /** Whether DRAM stats is valid */
-        VALID_DRAM_STATS      = 0x00001000,
-        VALID_INST_CYCLES     = 0x00002000,
+        /** Whether the cycle count of the issuing CPU is valid. */
+        VALID_INST_CYCLES     = 0x00001000,
         /**
          * These flags are *not* cleared when a Request object is reused
          * (assigned a new address).
@@ -473,22 +476,9 @@ class Request
     /** The cause for HTM transaction abort */
     HtmFailureFaultCause _htmAbortCause = HtmFailureFaultCause::INVALID;
 
-    /** Level -> Cache Miss */
-    std::unordered_map<int, std::pair<double, double>> cache_miss_stats;
-
+    /** The cycle count of the issuing CPU when this request is created */
     double num_cycles = 0;
 
-    /** DRAM total access count */
-    double dram_tot_access_count = 0;
-
-    /** DRAM row hit rate */
-    double dram_row_hit = 0;
-
-    /** DRAM row miss rate */
-    double dram_row_miss = 0;
-
-    double dram_avg_latency = 0;
-
   public:
 
     /**
@@ -548,7 +538,7 @@ class Request
     static RequestPtr
     createMemManagement(Flags flags, RequestorID id)
     {
-        auto mgmt_req = std::make_shared<Request>();
+        auto mgmt_req = makeRequest();
         mgmt_req->_flags.set(flags);
         mgmt_req->_requestorId = id;
         mgmt_req->_time = curTick();
@@ -582,12 +572,6 @@ class Request
         privateFlags.set(VALID_SUBSTREAM_ID);
     }
 
-    void 
-    setCacheStats(int level, double miss, double avg_latency)
-    {   
-        cache_miss_stats[level] = std::make_pair(miss, avg_latency);
-    }
-
     void
     setNumCycles(double cycles) {
         num_cycles = cycles;
@@ -599,16 +583,6 @@ class Request
         return num_cycles;
     }
 
-    void
-    setDRAMStats(double access, double row_hits, double avg_latency)
-    {
-        dram_row_hit = row_hits;
-        dram_tot_access_count = access;
-        dram_row_miss = access - row_hits;
-        dram_avg_latency = avg_latency;
-        privateFlags.set(privateFlags | VALID_DRAM_STATS);
-    }
-
     /**
      * Set up a virtual (e.g., CPU) request in a previously
      * allocated Request object.
@@ -657,8 +631,8 @@ class Request
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = makeRequest(*this);
+        req2 = makeRequest(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -875,56 +849,12 @@ class Request
         return privateFlags.isSet(VALID_VADDR);
     }
 
-    bool
-    hasDRAMStats() const
-    {
-        return privateFlags.isSet(VALID_DRAM_STATS);
-    }
-
-    std::unordered_map<int, std::pair<double, double>>::iterator
-    getCacheStatsBegin() 
-    {
-        return cache_miss_stats.begin();
-    }
-
-    std::unordered_map<int, std::pair<double, double>>::iterator
-    getCacheStatsEnd() 
-    {
-        return cache_miss_stats.end();
-    }
-
-    bool
-    hasCacheStats() const
-    {
-        return cache_miss_stats.size() != 0;
-    }
-
     bool
     hasNumCycles() const
     {
         return privateFlags.isSet(VALID_INST_CYCLES);
     }
 
-    double getDRAMAccess() 
-    {
-        return dram_tot_access_count;
-    }
-
-    double getDRAMRowHit()
-    {
-        return dram_row_hit;
-    }
-
-    double getDRAMRowMiss()
-    {
-        return dram_row_miss;
-    }
-
-    double getDRAMAccessLatency()
-    {
-        return dram_avg_latency;
-    }
-
     Addr
     getVaddr() const
     {
@@ -1198,6 +1128,22 @@ class Request
     /** @} */
 };
 
+/**
+ * Create a new request. The request and the reference counts of its
+ * RequestPtr share a single block, recycled through a free list, so
+ * creating and dropping requests on the hot path does not go through
+ * the heap.
+ *
+ * @param args Arguments forwarded to the Request constructor.
+ */
+template <typename... Args>
+RequestPtr
+makeRequest(Args &&...args)
+{
+    return std::allocate_shared<Request>(PoolAllocator<Request>(),
+                                         std::forward<Args>(args)...);
+}
+
 } // namespace gem5
 
 #endif // __MEM_REQUEST_HH__
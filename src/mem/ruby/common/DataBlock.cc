@@ -40,6 +40,8 @@
 
 #include "mem/ruby/common/DataBlock.hh"
 
+#include <utility>
+
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -51,17 +53,33 @@ namespace ruby
 
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+    alloc();
     memcpy(m_data, cp.m_data, RubySystem::getBlockSizeBytes());
-    m_alloc = true;
+}
+
+DataBlock::DataBlock(DataBlock &&other) noexcept
+{
+    if (other.m_alloc) {
+        m_data = other.m_data;
+        m_alloc = true;
+        other.alloc();
+        other.clear();
+    } else {
+        alloc();
+        memcpy(m_data, other.m_data, RubySystem::getBlockSizeBytes());
+    }
 }
 
 void
 DataBlock::alloc()
 {
-    m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
-    m_alloc = true;
-    clear();
+    if (RubySystem::getBlockSizeBytes() <= inlineBytes) {
+        m_data = m_inline;
+        m_alloc = false;
+    } else {
+        m_data = new uint8_t[RubySystem::getBlockSizeBytes()];
+        m_alloc = true;
+    }
 }
 
 void
@@ -141,5 +159,17 @@ DataBlock::operator=(const DataBlock & obj)
     return *this;
 }
 
+DataBlock &
+DataBlock::operator=(DataBlock && obj) noexcept
+{
+    // Blocks assigned external storage have to be written through
+    if (obj.m_alloc && m_alloc) {
+        std::swap(m_data, obj.m_data);
+        std::swap(m_alloc, obj.m_alloc);
+        return *this;
+    }
+    return *this = obj;
+}
+
 } // namespace ruby
 } // namespace gem5
@@ -60,13 +60,27 @@ class WriteMask;
 class DataBlock
 {
   public:
+    /**
+     * Blocks of up to this many bytes, the default Ruby block size, are
+     * stored within the DataBlock itself. Larger ones are allocated on
+     * the heap.
+     */
+    static constexpr int inlineBytes = 64;
+
     DataBlock()
     {
         alloc();
+        clear();
     }
 
     DataBlock(const DataBlock &cp);
 
+    /**
+     * Take over the heap storage of other if it has any. Other is then
+     * given new, cleared storage, like a default-constructed block.
+     */
+    DataBlock(DataBlock &&other) noexcept;
+
     ~DataBlock()
     {
         if (m_alloc)
@@ -74,6 +88,7 @@ class DataBlock
     }
 
     DataBlock& operator=(const DataBlock& obj);
+    DataBlock& operator=(DataBlock&& obj) noexcept;
 
     void assign(uint8_t *data);
 
@@ -93,7 +108,9 @@ class DataBlock
   private:
     void alloc();
     uint8_t *m_data;
+    // Whether m_data has been allocated on the heap by the block
     bool m_alloc;
+    alignas(8) uint8_t m_inline[inlineBytes];
 };
 
 inline void
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+uint32_t *blockSizeBytes;
+uint32_t *blockSizeBits;
+
+} // anonymous namespace
+
+// RubySystem.cc is not linked in, so its block size is defined here. The
+// initializers are in the scope of RubySystem, which lets the tests get
+// to the block size to change it.
+uint32_t gem5::ruby::RubySystem::m_block_size_bytes = 64;
+uint32_t gem5::ruby::RubySystem::m_block_size_bits =
+    (blockSizeBytes = &RubySystem::m_block_size_bytes, 6);
+uint32_t gem5::ruby::RubySystem::m_memory_size_bits =
+    (blockSizeBits = &RubySystem::m_block_size_bits, 0);
+
+namespace
+{
+
+/** Run the tests with inline (64 bytes) and heap (128 bytes) storage. */
+class DataBlockTest : public testing::TestWithParam<uint32_t>
+{
+  protected:
+    int size;
+
+    void
+    SetUp() override
+    {
+        size = GetParam();
+        *blockSizeBytes = size;
+        *blockSizeBits = size == 64 ? 6 : 7;
+    }
+
+    /** Fill a block with a pattern depending on seed. */
+    void
+    fill(DataBlock &blk, int seed)
+    {
+        for (int i = 0; i < size; i++)
+            blk.setByte(i, seed + i);
+    }
+
+    /** Check that a block holds the pattern of seed. */
+    void
+    expectFilled(const DataBlock &blk, int seed)
+    {
+        for (int i = 0; i < size; i++)
+            ASSERT_EQ(blk.getByte(i), uint8_t(seed + i)) << "byte " << i;
+    }
+
+    void
+    expectCleared(const DataBlock &blk)
+    {
+        for (int i = 0; i < size; i++)
+            ASSERT_EQ(blk.getByte(i), 0) << "byte " << i;
+    }
+};
+
+} // anonymous namespace
+
+/** Test that copies do not share their storage. */
+TEST_P(DataBlockTest, Copy)
+{
+    DataBlock a;
+    expectCleared(a);
+    fill(a, 1);
+
+    DataBlock b(a);
+    expectFilled(b, 1);
+    EXPECT_NE(a.getData(0, size), b.getData(0, size));
+
+    DataBlock c;
+    c = a;
+    fill(a, 2);
+    expectFilled(b, 1);
+    expectFilled(c, 1);
+    EXPECT_FALSE(a == c);
+}
+
+/** Test that a block moved from is cleared and can still be used. */
+TEST_P(DataBlockTest, MoveConstruct)
+{
+    DataBlock a;
+    fill(a, 3);
+    const uint8_t *data = a.getData(0, size);
+
+    DataBlock b(std::move(a));
+    expectFilled(b, 3);
+    if (size > DataBlock::inlineBytes) {
+        // Heap storage is taken over, and replaced by cleared storage
+        EXPECT_EQ(b.getData(0, size), data);
+        expectCleared(a);
+    } else {
+        expectFilled(a, 3);
+    }
+
+    DataBlock c(a);
+    EXPECT_TRUE(c == a);
+    fill(a, 4);
+    expectFilled(a, 4);
+    expectFilled(b, 3);
+    EXPECT_TRUE(a == a);
+    EXPECT_FALSE(a == b);
+}
+
+/** Test move assignments, including to and from blocks moved from. */
+TEST_P(DataBlockTest, MoveAssign)
+{
+    DataBlock a, b;
+    fill(a, 5);
+    fill(b, 6);
+
+    b = std::move(a);
+    expectFilled(b, 5);
+
+    DataBlock c(std::move(b));
+    b = std::move(c);
+    expectFilled(b, 5);
+
+    // Blocks moved from can be copied and assigned to
+    c = a;
+    a = std::move(c);
+    c = b;
+    expectFilled(c, 5);
+    fill(a, 7);
+    b = std::move(a);
+    expectFilled(b, 7);
+}
+
+/** Test that blocks given external storage are written through. */
+TEST_P(DataBlockTest, Assigned)
+{
+    std::vector<uint8_t> storage(size, 0xff);
+    DataBlock ext;
+    ext.assign(storage.data());
+
+    DataBlock a;
+    fill(a, 8);
+    ext = std::move(a);
+    expectFilled(ext, 8);
+    EXPECT_EQ(ext.getData(0, size), storage.data());
+    EXPECT_EQ(storage[1], 9);
+    expectFilled(a, 8);
+
+    DataBlock b;
+    fill(b, 9);
+    ext = b;
+    EXPECT_EQ(storage[0], 9);
+
+    // Moving an assigned block copies its data
+    DataBlock c(std::move(ext));
+    expectFilled(c, 9);
+    fill(c, 10);
+    EXPECT_EQ(storage[0], 9);
+    EXPECT_EQ(ext.getData(0, size), storage.data());
+
+    // Moving into a block moved from after it was assigned
+    DataBlock d;
+    fill(d, 11);
+    DataBlock e(std::move(d));
+    d.assign(storage.data());
+    d = std::move(e);
+    EXPECT_EQ(storage[0], 11);
+}
+
+INSTANTIATE_TEST_SUITE_P(BlockSizes, DataBlockTest,
+                         testing::Values(64, 128));
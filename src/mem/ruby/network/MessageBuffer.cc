@@ -92,7 +92,6 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_msgs_this_cycle = 0;
     m_priority_rank = 0;
 
-    m_stall_msg_map.clear();
     m_input_link_id = 0;
     m_vnet_id = 0;
 
@@ -278,7 +277,7 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     msg_ptr->setMsgCounter(m_msg_counter);
 
     // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
+    m_prio_heap.push_back(std::move(message));
     push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
     // Increment the number of messages statistic
     m_buf_msgs++;
@@ -287,7 +286,7 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
            ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
 
     DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
-            arrival_time, *(message.get()));
+            arrival_time, *msg_ptr);
 
     // Schedule the wakeup
     assert(m_consumer != NULL);
@@ -301,8 +300,9 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     DPRINTF(RubyQueue, "Popping\n");
     assert(isReady(current_time));
 
-    // get MsgPtr of the message about to be dequeued
-    MsgPtr message = m_prio_heap.front();
+    // get the message about to be dequeued, which the heap keeps a
+    // reference to until it is popped
+    Message *message = m_prio_heap.front().get();
 
     // get the delay cycles
     message->updateDelayedTicks(current_time);
@@ -318,8 +318,6 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
     }
     ++m_dequeues_this_cy;
 
-    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
-    m_prio_heap.pop_back();
     if (decrement_messages) {
         // Record how much time is passed since the message was enqueued
         m_stall_time += curTick() - message->getLastEnqueueTime();
@@ -330,6 +328,9 @@ MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
         m_buf_msgs--;
     }
 
+    pop_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
+    m_prio_heap.pop_back();
+
     // if a dequeue callback was requested, call it now
     if (m_dequeue_callback) {
         m_dequeue_callback();
@@ -380,41 +381,36 @@ MessageBuffer::recycle(Tick current_time, Tick recycle_latency)
 }
 
 void
-MessageBuffer::reanalyzeList(std::list<MsgPtr> &lt, Tick schdTick)
+MessageBuffer::requeue(MsgPtr message, Tick schdTick)
 {
-    while (!lt.empty()) {
-        MsgPtr m = lt.front();
-        assert(m->getLastEnqueueTime() <= schdTick);
-
-        m_prio_heap.push_back(m);
-        push_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                  std::greater<MsgPtr>());
+    assert(message->getLastEnqueueTime() <= schdTick);
+    m_stall_map_size--;
+    assert(m_stall_map_size >= 0);
 
-        m_consumer->scheduleEventAbsolute(schdTick);
+    DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
+        schdTick, *message);
 
-        DPRINTF(RubyQueue, "Requeue arrival_time: %lld, Message: %s\n",
-            schdTick, *(m.get()));
+    m_prio_heap.push_back(std::move(message));
+    push_heap(m_prio_heap.begin(), m_prio_heap.end(),
+              std::greater<MsgPtr>());
 
-        lt.pop_front();
-    }
+    m_consumer->scheduleEventAbsolute(schdTick);
 }
 
 void
 MessageBuffer::reanalyzeMessages(Addr addr, Tick current_time)
 {
     DPRINTF(RubyQueue, "ReanalyzeMessages %#x\n", addr);
-    assert(m_stall_msg_map.count(addr) > 0);
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The requeue call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle
     //
-    m_stall_map_size -= m_stall_msg_map[addr].size();
-    assert(m_stall_map_size >= 0);
-    reanalyzeList(m_stall_msg_map[addr], current_time);
-    m_stall_msg_map.erase(addr);
+    m_stall_msg_map.reanalyze(addr, [&](MsgPtr message) {
+        requeue(std::move(message), current_time);
+    });
 }
 
 void
@@ -424,17 +420,13 @@ MessageBuffer::reanalyzeAllMessages(Tick current_time)
 
     //
     // Put all stalled messages associated with this address back on the
-    // prio heap.  The reanalyzeList call will make sure the consumer is
+    // prio heap.  The requeue call will make sure the consumer is
     // scheduled for the current cycle so that the previously stalled messages
     // will be observed before any younger messages that may arrive this cycle.
     //
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end(); ++map_iter) {
-        m_stall_map_size -= map_iter->second.size();
-        assert(m_stall_map_size >= 0);
-        reanalyzeList(map_iter->second, current_time);
-    }
-    m_stall_msg_map.clear();
+    m_stall_msg_map.reanalyzeAll([&](MsgPtr message) {
+        requeue(std::move(message), current_time);
+    });
 }
 
 void
@@ -443,7 +435,9 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     DPRINTF(RubyQueue, "Stalling due to %#x\n", addr);
     assert(isReady(current_time));
     assert(getOffset(addr) == 0);
-    MsgPtr message = m_prio_heap.front();
+    // The stall map takes a reference before the heap drops its own
+    Message *message = m_prio_heap.front().get();
+    m_stall_msg_map.stall(addr, message);
 
     // Since the message will just be moved to stall map, indicate that the
     // buffer should not decrement the m_buf_msgs statistic
@@ -454,7 +448,6 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
     // Instead the controller is responsible to call reanalyzeMessages when
     // these addresses change state.
     //
-    (m_stall_msg_map[addr]).push_back(message);
     m_stall_map_size++;
     m_stall_count++;
 }
@@ -462,7 +455,7 @@ MessageBuffer::stallMessage(Addr addr, Tick current_time)
 bool
 MessageBuffer::hasStalledMsg(Addr addr) const
 {
-    return (m_stall_msg_map.count(addr) != 0);
+    return m_stall_msg_map.hasLine(addr);
 }
 
 void
@@ -470,7 +463,7 @@ MessageBuffer::deferEnqueueingMessage(Addr addr, MsgPtr message)
 {
     DPRINTF(RubyQueue, "Deferring enqueueing message: %s, Address %#x\n",
             *(message.get()), addr);
-    (m_deferred_msg_map[addr]).push_back(message);
+    (m_deferred_msg_map[addr]).push_back(std::move(message));
 }
 
 void
@@ -555,22 +548,17 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
 
     // Check the stall queue and write any messages that may
     // correspond to the address in the packet.
-    for (StallMsgMapType::iterator map_iter = m_stall_msg_map.begin();
-         map_iter != m_stall_msg_map.end();
-         ++map_iter) {
-
-        for (std::list<MsgPtr>::iterator it = (map_iter->second).begin();
-            it != (map_iter->second).end(); ++it) {
-
-            Message *msg = (*it).get();
-            if (is_read && !mask && msg->functionalRead(pkt))
-                return 1;
-            else if (is_read && mask && msg->functionalRead(pkt, *mask))
-                num_functional_accesses++;
-            else if (!is_read && msg->functionalWrite(pkt))
-                num_functional_accesses++;
-        }
-    }
+    bool found = m_stall_msg_map.find([&](Message *msg) {
+        if (is_read && !mask && msg->functionalRead(pkt))
+            return true;
+        else if (is_read && mask && msg->functionalRead(pkt, *mask))
+            num_functional_accesses++;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
+        return false;
+    });
+    if (found)
+        return 1;
 
     return num_functional_accesses;
 }
@@ -60,6 +60,7 @@
 #include "mem/port.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/network/MessageStallMap.hh"
 #include "mem/ruby/network/dummy_port.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 #include "params/MessageBuffer.hh"
@@ -92,11 +93,11 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
         std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
                       std::greater<MsgPtr>());
+        MsgPtr m = std::move(m_prio_heap.back());
         m_prio_heap.pop_back();
-        enqueue(m, current_time, delta);
+        enqueue(std::move(m), current_time, delta);
     }
 
     bool areNSlotsAvailable(unsigned int n, Tick curTime);
@@ -146,8 +147,8 @@ class MessageBuffer : public SimObject
 
     void recycle(Tick current_time, Tick recycle_latency);
     bool isEmpty() const { return m_prio_heap.size() == 0; }
-    bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
-    unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
+    bool isStallMapEmpty() { return m_stall_msg_map.empty(); }
+    unsigned int getStallMapSize() { return m_stall_msg_map.numLines(); }
 
     unsigned int getSize(Tick curTime);
 
@@ -193,7 +194,7 @@ class MessageBuffer : public SimObject
     int routingPriority() const { return m_routing_priority; }
 
   private:
-    void reanalyzeList(std::list<MsgPtr> &, Tick);
+    void requeue(MsgPtr message, Tick schdTick);
 
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
@@ -205,10 +206,6 @@ class MessageBuffer : public SimObject
 
     std::function<void()> m_dequeue_callback;
 
-    // use a std::map for the stalled messages as this container is
-    // sorted and ensures a well-defined iteration order
-    typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
-
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
@@ -221,8 +218,12 @@ class MessageBuffer : public SimObject
      * initially received, and when a line is unblocked, the messages are
      * moved back to the m_prio_heap in the same order. This prevents starving
      * older requests with younger ones.
+     *
+     * The stalled messages go back to the heap, which orders them by
+     * enqueue time and counter, so the order in which the lines are
+     * reanalyzed does not matter.
      */
-    StallMsgMapType m_stall_msg_map;
+    MessageStallMap m_stall_msg_map;
 
     /**
      * A map from line addresses to corresponding vectors of messages that
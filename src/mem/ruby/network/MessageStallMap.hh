@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_MESSAGESTALLMAP_HH__
+#define __MEM_RUBY_NETWORK_MESSAGESTALLMAP_HH__
+
+#include <cassert>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "base/free_list.hh"
+#include "mem/ruby/common/Address.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Messages stalled by a MessageBuffer, grouped by line. The messages of a
+ * line are kept in the order they were stalled, linked through their
+ * m_stall_next, and the map holds a reference to each of them. The map
+ * nodes are recycled as lines stall and get reanalyzed, so once warmed up
+ * stalling and reanalyzing allocate nothing.
+ */
+class MessageStallMap
+{
+  private:
+    struct StallList
+    {
+        Message *head = nullptr;
+        Message *tail = nullptr;
+    };
+
+    typedef std::unordered_map<Addr, StallList, std::hash<Addr>,
+                               std::equal_to<Addr>,
+                               PoolAllocator<std::pair<const Addr, StallList>>
+                              > LineMap;
+
+  public:
+    MessageStallMap() = default;
+    MessageStallMap(const MessageStallMap &) = delete;
+    MessageStallMap &operator=(const MessageStallMap &) = delete;
+
+    ~MessageStallMap()
+    {
+        for (auto &[addr, lt] : lines) {
+            while (Message *m = lt.head) {
+                lt.head = m->m_stall_next;
+                m->m_stall_next = nullptr;
+                m->decref();
+            }
+        }
+    }
+
+    /** Stall a message behind the ones already stalled for its line. */
+    void
+    stall(Addr addr, Message *message)
+    {
+        assert(!message->m_stall_next);
+        message->incref();
+
+        StallList &lt = lines[addr];
+        if (lt.tail)
+            lt.tail->m_stall_next = message;
+        else
+            lt.head = message;
+        lt.tail = message;
+    }
+
+    /**
+     * Hand the messages stalled for a line over to requeue, in the order
+     * they were stalled, and forget the line.
+     */
+    template <typename Requeue>
+    void
+    reanalyze(Addr addr, Requeue &&requeue)
+    {
+        auto it = lines.find(addr);
+        assert(it != lines.end());
+        release(it->second, requeue);
+        lines.erase(it);
+    }
+
+    /** Hand the messages of all the lines over to requeue. */
+    template <typename Requeue>
+    void
+    reanalyzeAll(Requeue &&requeue)
+    {
+        for (auto &[addr, lt] : lines)
+            release(lt, requeue);
+        lines.clear();
+    }
+
+    bool hasLine(Addr addr) const { return lines.count(addr) != 0; }
+    bool empty() const { return lines.empty(); }
+    /** Number of lines with stalled messages. */
+    unsigned int numLines() const { return lines.size(); }
+
+    /**
+     * Call f on the stalled messages until it returns true.
+     *
+     * @return Whether f returned true.
+     */
+    template <typename F>
+    bool
+    find(F &&f) const
+    {
+        for (const auto &[addr, lt] : lines) {
+            for (Message *m = lt.head; m; m = m->m_stall_next) {
+                if (f(m))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    template <typename Requeue>
+    void
+    release(StallList &lt, Requeue &requeue)
+    {
+        while (Message *m = lt.head) {
+            lt.head = m->m_stall_next;
+            m->m_stall_next = nullptr;
+
+            // Hand the reference of the list over
+            MsgPtr ptr(m);
+            m->decref();
+            requeue(std::move(ptr));
+        }
+    }
+
+    LineMap lines;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif //__MEM_RUBY_NETWORK_MESSAGESTALLMAP_HH__
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "mem/ruby/network/MessageStallMap.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+/** A message that counts how many of its kind are alive. */
+class TestMessage : public Message
+{
+  public:
+    static int live;
+
+    TestMessage(Tick enqueue_time, uint64_t counter)
+        : Message(enqueue_time)
+    {
+        setMsgCounter(counter);
+        live++;
+    }
+
+    ~TestMessage() { live--; }
+
+    MsgPtr clone() const override { return nullptr; }
+    void print(std::ostream &out) const override {}
+};
+
+int TestMessage::live = 0;
+
+/** A priority heap ordered like the one of MessageBuffer. */
+class Heap
+{
+  public:
+    void
+    push(MsgPtr message)
+    {
+        heap.push_back(std::move(message));
+        std::push_heap(heap.begin(), heap.end(), std::greater<MsgPtr>());
+    }
+
+    MsgPtr
+    pop()
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<MsgPtr>());
+        MsgPtr message = std::move(heap.back());
+        heap.pop_back();
+        return message;
+    }
+
+    bool empty() const { return heap.empty(); }
+
+  private:
+    std::vector<MsgPtr> heap;
+};
+
+const Addr lines[] = {0x1000, 0x40, 0x8000};
+
+class MessageStallMapTest : public testing::Test
+{
+  protected:
+    void SetUp() override { TestMessage::live = 0; }
+    void TearDown() override { EXPECT_EQ(TestMessage::live, 0); }
+
+    /**
+     * Stall the messages [0, num) the way a MessageBuffer does: each one
+     * is taken from the heap, which drops its reference once the map
+     * holds one.
+     */
+    void
+    stallMessages(MessageStallMap &map, int num)
+    {
+        for (int i = 0; i < num; i++) {
+            MsgPtr message = new TestMessage(100 + i, i);
+            map.stall(lines[i % 3], message.get());
+        }
+    }
+};
+
+} // anonymous namespace
+
+/** Test that the messages of a line come back in the order they stalled. */
+TEST_F(MessageStallMapTest, ReanalyzeLine)
+{
+    MessageStallMap map;
+    EXPECT_TRUE(map.empty());
+    stallMessages(map, 9);
+
+    // Only the map keeps the messages alive
+    EXPECT_EQ(TestMessage::live, 9);
+    EXPECT_EQ(map.numLines(), 3);
+    for (Addr addr : lines)
+        EXPECT_TRUE(map.hasLine(addr));
+    EXPECT_FALSE(map.hasLine(0x80));
+
+    std::vector<uint64_t> requeued;
+    map.reanalyze(lines[1], [&](MsgPtr message) {
+        requeued.push_back(message->getMsgCounter());
+    });
+    EXPECT_EQ(requeued, (std::vector<uint64_t>{1, 4, 7}));
+    EXPECT_EQ(TestMessage::live, 6);
+    EXPECT_EQ(map.numLines(), 2);
+    EXPECT_FALSE(map.hasLine(lines[1]));
+
+    // A line can stall again once reanalyzed
+    MsgPtr message = new TestMessage(200, 9);
+    map.stall(lines[1], message.get());
+    message = nullptr;
+    EXPECT_EQ(map.numLines(), 3);
+    EXPECT_EQ(TestMessage::live, 7);
+}
+
+/** Test the order in which the reanalyzed messages are dequeued. */
+TEST_F(MessageStallMapTest, DequeueOrder)
+{
+    Heap heap;
+    {
+        MessageStallMap map;
+        stallMessages(map, 12);
+
+        // Reanalyze one line, while younger messages arrive
+        map.reanalyze(lines[2], [&](MsgPtr message) {
+            heap.push(std::move(message));
+        });
+        heap.push(new TestMessage(150, 12));
+        heap.push(new TestMessage(100, 13));
+        EXPECT_EQ(map.numLines(), 2);
+
+        // Then all of them
+        map.reanalyzeAll([&](MsgPtr message) {
+            heap.push(std::move(message));
+        });
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.numLines(), 0);
+        EXPECT_EQ(TestMessage::live, 14);
+    }
+
+    // The messages are ordered by enqueue time, then by counter, whatever
+    // their line and the order in which they were reanalyzed
+    std::vector<uint64_t> dequeued;
+    while (!heap.empty())
+        dequeued.push_back(heap.pop()->getMsgCounter());
+    EXPECT_EQ(dequeued, (std::vector<uint64_t>{
+        0, 13, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}));
+}
+
+/** Test that the messages still stalled are freed with the map. */
+TEST_F(MessageStallMapTest, DestroyStalled)
+{
+    {
+        MessageStallMap map;
+        stallMessages(map, 5);
+        map.reanalyze(lines[0], [](MsgPtr message) {});
+        EXPECT_EQ(TestMessage::live, 3);
+    }
+    EXPECT_EQ(TestMessage::live, 0);
+}
+
+/** Test that find walks all the stalled messages until it succeeds. */
+TEST_F(MessageStallMapTest, Find)
+{
+    MessageStallMap map;
+    stallMessages(map, 7);
+
+    int visited = 0;
+    EXPECT_FALSE(map.find([&](Message *message) {
+        visited++;
+        return false;
+    }));
+    EXPECT_EQ(visited, 7);
+
+    EXPECT_TRUE(map.find([](Message *message) {
+        return message->getMsgCounter() == 5;
+    }));
+}
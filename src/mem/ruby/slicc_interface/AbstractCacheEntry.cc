@@ -40,6 +40,10 @@
 
 #include "mem/ruby/slicc_interface/AbstractCacheEntry.hh"
 
+#include <array>
+#include <utility>
+
+#include "base/free_list.hh"
 #include "base/trace.hh"
 #include "debug/RubyCache.hh"
 
@@ -49,9 +53,60 @@ namespace gem5
 namespace ruby
 {
 
+namespace
+{
+
+// Entries are pooled in blocks of up to maxEntryLines host cache lines,
+// larger ones come straight from the heap
+constexpr std::size_t entryLineSize = 64;
+constexpr std::size_t maxEntryLines = 16;
+
+template <std::size_t... Lines>
+constexpr std::array<void *(*)(), sizeof...(Lines)>
+entryAllocators(std::index_sequence<Lines...>)
+{
+    return {{&FreeList<(Lines + 1) * entryLineSize,
+                       entryLineSize>::allocate...}};
+}
+
+template <std::size_t... Lines>
+constexpr std::array<void (*)(void *), sizeof...(Lines)>
+entryDeallocators(std::index_sequence<Lines...>)
+{
+    return {{&FreeList<(Lines + 1) * entryLineSize,
+                       entryLineSize>::deallocate...}};
+}
+
+constexpr auto allocateEntry =
+    entryAllocators(std::make_index_sequence<maxEntryLines>());
+constexpr auto deallocateEntry =
+    entryDeallocators(std::make_index_sequence<maxEntryLines>());
+
+} // anonymous namespace
+
+void *
+AbstractCacheEntry::operator new(std::size_t size)
+{
+    std::size_t lines = (size + entryLineSize - 1) / entryLineSize;
+    if (lines > maxEntryLines)
+        return ::operator new(size, std::align_val_t(entryLineSize));
+    return allocateEntry[lines - 1]();
+}
+
+void
+AbstractCacheEntry::operator delete(void *ptr, std::size_t size)
+{
+    std::size_t lines = (size + entryLineSize - 1) / entryLineSize;
+    if (lines > maxEntryLines)
+        ::operator delete(ptr, std::align_val_t(entryLineSize));
+    else
+        deallocateEntry[lines - 1](ptr);
+}
+
 AbstractCacheEntry::AbstractCacheEntry() : ReplaceableEntry()
 {
     m_Permission = AccessPermission_NotPresent;
+    m_permission_copy = nullptr;
     m_Address = 0;
     m_locked = -1;
     m_last_touch_tick = 0;
@@ -74,6 +129,8 @@ void
 AbstractCacheEntry::changePermission(AccessPermission new_perm)
 {
     m_Permission = new_perm;
+    if (m_permission_copy)
+        *m_permission_copy = new_perm;
     if ((new_perm == AccessPermission_Invalid) ||
         (new_perm == AccessPermission_NotPresent)) {
         m_locked = -1;
@@ -45,6 +45,8 @@
 #ifndef __MEM_RUBY_SLICC_INTERFACE_ABSTRACTCACHEENTRY_HH__
 #define __MEM_RUBY_SLICC_INTERFACE_ABSTRACTCACHEENTRY_HH__
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 
 #include "base/logging.hh"
@@ -59,6 +61,8 @@ namespace gem5
 namespace ruby
 {
 
+class CacheMemory;
+
 class AbstractCacheEntry : public ReplaceableEntry
 {
   private:
@@ -69,6 +73,11 @@ class AbstractCacheEntry : public ReplaceableEntry
     AbstractCacheEntry();
     virtual ~AbstractCacheEntry() = 0;
 
+    // Entries are allocated and freed whenever a block is, take them
+    // from free lists of host cache line aligned blocks
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size);
+
     // Get/Set permission of the entry
     AccessPermission getPermission() const;
     void changePermission(AccessPermission new_perm);
@@ -106,9 +115,6 @@ class AbstractCacheEntry : public ReplaceableEntry
     // Required for implementing LL/SC operations.
     int m_locked;
 
-    AccessPermission m_Permission; // Access permission for this
-                                   // block, required by CacheMemory
-
     // Get the last access Tick.
     Tick getLastAccess() { return m_last_touch_tick; }
 
@@ -123,6 +129,16 @@ class AbstractCacheEntry : public ReplaceableEntry
     virtual void invalidateEntry() {}
 
   private:
+    // Only changePermission and the CacheMemory holding the entry update
+    // the permission, so that it stays in sync with its copy
+    friend class CacheMemory;
+
+    AccessPermission m_Permission; // Access permission for this
+                                   // block, required by CacheMemory
+    // Copy of the permission kept next to the tag of the entry by the
+    // CacheMemory holding it, if any, updated along with m_Permission
+    uint8_t *m_permission_copy;
+
     // hardware transactional memory
     bool m_htmInReadSet;
     bool m_htmInWriteSet;
@@ -373,7 +373,7 @@ AbstractController::recvTimingResp(PacketPtr pkt)
     assert(getMemRespQueue());
     assert(pkt->isResponse());
 
-    std::shared_ptr<MemoryMsg> msg = std::make_shared<MemoryMsg>(clockEdge());
+    RefCountingPtr<MemoryMsg> msg = new MemoryMsg(clockEdge());
     (*msg).m_addr = pkt->getAddr();
     (*msg).m_Sender = m_machineID;
 
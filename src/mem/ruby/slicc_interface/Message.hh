@@ -45,6 +45,7 @@
 #include <memory>
 #include <stack>
 
+#include "base/refcnt.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -57,18 +58,40 @@ namespace ruby
 {
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
+typedef RefCountingPtr<Message> MsgPtr;
 
-class Message
+class MessageBuffer;
+
+class Message : public RefCounted
 {
   public:
     Message(Tick curTime)
         : m_time(curTime),
           m_LastEnqueueTime(curTime),
-          m_DelayedTicks(0), m_msg_counter(0)
+          m_DelayedTicks(0), m_msg_counter(0), m_stall_next(nullptr)
+    { }
+
+    // A copy has its own reference count and is not stalled
+    Message(const Message &other)
+        : RefCounted(), m_time(other.m_time),
+          m_LastEnqueueTime(other.m_LastEnqueueTime),
+          m_DelayedTicks(other.m_DelayedTicks),
+          m_msg_counter(other.m_msg_counter),
+          incoming_link(other.incoming_link), vnet(other.vnet),
+          m_stall_next(nullptr)
     { }
 
-    Message(const Message &other) = default;
+    Message &
+    operator=(const Message &other)
+    {
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        incoming_link = other.incoming_link;
+        vnet = other.vnet;
+        return *this;
+    }
 
     virtual ~Message() { }
 
@@ -130,6 +153,11 @@ class Message
     // Variables for required network traversal
     int incoming_link;
     int vnet;
+
+    // Next message in the stall list of the MessageBuffer this message
+    // is stalled in, if any
+    friend class MessageStallMap;
+    Message *m_stall_next;
 };
 
 inline bool
@@ -152,6 +180,13 @@ operator<<(std::ostream& out, const Message& obj)
     return out;
 }
 
+inline std::ostream&
+operator<<(std::ostream& out, const MsgPtr& obj)
+{
+    out << obj.get();
+    return out;
+}
+
 } // namespace ruby
 } // namespace gem5
 
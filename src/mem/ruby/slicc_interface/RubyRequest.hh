@@ -41,9 +41,11 @@
 #ifndef __MEM_RUBY_SLICC_INTERFACE_RUBYREQUEST_HH__
 #define __MEM_RUBY_SLICC_INTERFACE_RUBYREQUEST_HH__
 
+#include <cstddef>
 #include <ostream>
 #include <vector>
 
+#include "base/free_list.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -181,7 +183,30 @@ class RubyRequest : public Message
 
     RubyRequest(Tick curTime) : Message(curTime) {}
     MsgPtr clone() const
-    { return std::shared_ptr<Message>(new RubyRequest(*this)); }
+    { return MsgPtr(new RubyRequest(*this)); }
+
+    /**
+     * Requests are recycled through a free list rather than going
+     * through the heap every time.
+     * @{
+     */
+    static void *
+    operator new(std::size_t size)
+    {
+        if (size == sizeof(RubyRequest))
+            return FreeList<sizeof(RubyRequest)>::allocate();
+        return ::operator new(size);
+    }
+
+    static void
+    operator delete(void *ptr, std::size_t size)
+    {
+        if (size == sizeof(RubyRequest))
+            FreeList<sizeof(RubyRequest)>::deallocate(ptr);
+        else
+            ::operator delete(ptr);
+    }
+    /** @} */
 
     Addr getLineAddress() const { return m_LineAddress; }
     Addr getPhysicalAddress() const { return m_PhysicalAddress; }
@@ -41,6 +41,8 @@
 
 #include "mem/ruby/structures/CacheMemory.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
@@ -97,8 +99,18 @@ CacheMemory::init()
     m_cache_num_set_bits = floorLog2(m_cache_num_sets);
     assert(m_cache_num_set_bits > 0);
 
-    m_cache.resize(m_cache_num_sets,
-                    std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    // The entries point into m_permissions, it can't move once they exist
+    assert(std::all_of(m_cache.begin(), m_cache.end(),
+                       [](AbstractCacheEntry *entry) { return !entry; }));
+    static_assert(AccessPermission_NUM <= UINT8_MAX,
+                  "Permissions are kept in bytes");
+    int num_blocks = m_cache_num_sets * m_cache_assoc;
+    int tags_per_line = sizeof(TagLine) / sizeof(Addr);
+    m_tag_lines.resize((num_blocks + tags_per_line - 1) / tags_per_line);
+    m_tags = m_tag_lines.front().tags;
+    std::fill(m_tags, m_tags + num_blocks, MaxAddr);
+    m_permissions.resize(num_blocks, AccessPermission_NotPresent);
+    m_cache.resize(num_blocks, nullptr);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -114,10 +126,8 @@ CacheMemory::~CacheMemory()
 {
     if (m_replacementPolicy_ptr)
         delete m_replacementPolicy_ptr;
-    for (int i = 0; i < m_cache_num_sets; i++) {
-        for (int j = 0; j < m_cache_assoc; j++) {
-            delete m_cache[i][j];
-        }
+    for (auto entry : m_cache) {
+        delete entry;
     }
 }
 
@@ -137,11 +147,15 @@ CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc == -1)
+        return -1; // Not found
+    int64_t idx = setIndex(cacheSet) + loc;
+    // the entry holding the tag changes its permission and the copy
+    // together
+    assert(m_cache[idx] && m_cache[idx]->m_Permission == m_permissions[idx]);
+    if (m_permissions[idx] != AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -153,9 +167,11 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
+    const Addr *tags = m_tags + setIndex(cacheSet);
+    for (int i = 0; i < m_cache_assoc; i++) {
+        if (tags[i] == tag)
+            return i;
+    }
     return -1; // Not found
 }
 
@@ -173,13 +189,11 @@ CacheMemory::getAddressAtIdx(int idx) const
     int way = idx - set * m_cache_assoc;
     assert (way < m_cache_assoc);
 
-    AbstractCacheEntry* entry = m_cache[set][way];
-    if (entry == NULL ||
-        entry->m_Permission == AccessPermission_Invalid ||
-        entry->m_Permission == AccessPermission_NotPresent) {
+    if (m_permissions[idx] == AccessPermission_Invalid ||
+        m_permissions[idx] == AccessPermission_NotPresent) {
         return tmp;
     }
-    return entry->m_Address;
+    return m_cache[idx]->m_Address;
 }
 
 bool
@@ -250,15 +264,11 @@ CacheMemory::cacheAvail(Addr address) const
 
     int64_t cacheSet = addressToCacheSet(address);
 
+    const Addr *tags = m_tags + setIndex(cacheSet);
+    const uint8_t *perms = m_permissions.data() + setIndex(cacheSet);
     for (int i = 0; i < m_cache_assoc; i++) {
-        AbstractCacheEntry* entry = m_cache[cacheSet][i];
-        if (entry != NULL) {
-            if (entry->m_Address == address ||
-                entry->m_Permission == AccessPermission_NotPresent) {
-                // Already in the cache or we found an empty entry
-                return true;
-            }
-        } else {
+        if (tags[i] == address || perms[i] == AccessPermission_NotPresent) {
+            // Already in the cache or we found an empty entry
             return true;
         }
     }
@@ -275,23 +285,33 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
 
     // Find the first open slot
     int64_t cacheSet = addressToCacheSet(address);
-    std::vector<AbstractCacheEntry*> &set = m_cache[cacheSet];
+    AbstractCacheEntry **set = m_cache.data() + setIndex(cacheSet);
+    Addr *tags = m_tags + setIndex(cacheSet);
+    uint8_t *perms = m_permissions.data() + setIndex(cacheSet);
     for (int i = 0; i < m_cache_assoc; i++) {
-        if (!set[i] || set[i]->m_Permission == AccessPermission_NotPresent) {
+        if (perms[i] == AccessPermission_NotPresent) {
             if (set[i] && (set[i] != entry)) {
                 warn_once("This protocol contains a cache entry handling bug: "
                     "Entries in the cache should never be NotPresent! If\n"
                     "this entry (%#x) is not tracked elsewhere, it will memory "
                     "leak here. Fix your protocol to eliminate these!",
                     address);
+                set[i]->m_permission_copy = nullptr;
             }
+            // forget any NotPresent entry left with the same tag
+            int stale = findTagInSetIgnorePermissions(cacheSet, address);
+            if (stale != -1)
+                tags[stale] = MaxAddr;
+
             set[i] = entry;  // Init entry
             set[i]->m_Address = address;
             set[i]->m_Permission = AccessPermission_Invalid;
+            set[i]->m_permission_copy = &perms[i];
+            perms[i] = AccessPermission_Invalid;
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            tags[i] = address;
             set[i]->setPosition(cacheSet, i);
             set[i]->replacementData = replacement_data[cacheSet][i];
             set[i]->setLastAccess(curTick());
@@ -316,8 +336,10 @@ CacheMemory::deallocate(Addr address)
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
     delete entry;
-    m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    int64_t idx = setIndex(cache_set) + way;
+    m_cache[idx] = NULL;
+    m_tags[idx] = MaxAddr;
+    m_permissions[idx] = AccessPermission_NotPresent;
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -328,13 +350,10 @@ CacheMemory::cacheProbe(Addr address) const
     assert(!cacheAvail(address));
 
     int64_t cacheSet = addressToCacheSet(address);
-    std::vector<ReplaceableEntry*> candidates;
-    for (int i = 0; i < m_cache_assoc; i++) {
-        candidates.push_back(static_cast<ReplaceableEntry*>(
-                                                       m_cache[cacheSet][i]));
-    }
-    return m_cache[cacheSet][m_replacementPolicy_ptr->
-                        getVictim(candidates)->getWay()]->m_Address;
+    AbstractCacheEntry *const *set = m_cache.data() + setIndex(cacheSet);
+    std::vector<ReplaceableEntry*> candidates(set, set + m_cache_assoc);
+    return set[m_replacementPolicy_ptr->
+               getVictim(candidates)->getWay()]->m_Address;
 }
 
 // looks an address up in the cache
@@ -345,7 +364,7 @@ CacheMemory::lookup(Addr address)
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return m_cache[setIndex(cacheSet) + loc];
 }
 
 // looks an address up in the cache
@@ -356,7 +375,7 @@ CacheMemory::lookup(Addr address) const
     int64_t cacheSet = addressToCacheSet(address);
     int loc = findTagInSet(cacheSet, address);
     if (loc == -1) return NULL;
-    return m_cache[cacheSet][loc];
+    return m_cache[setIndex(cacheSet) + loc];
 }
 
 // Sets the most recently used bit for a cache block
@@ -403,8 +422,8 @@ CacheMemory::getReplacementWeight(int64_t set, int64_t loc)
     assert(set < m_cache_num_sets);
     assert(loc < m_cache_assoc);
     int ret = 0;
-    if (m_cache[set][loc] != NULL) {
-        ret = m_cache[set][loc]->getNumValidBlocks();
+    if (m_cache[setIndex(set) + loc] != NULL) {
+        ret = m_cache[setIndex(set) + loc]->getNumValidBlocks();
         assert(ret >= 0);
     }
 
@@ -420,8 +439,9 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
 
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
-                AccessPermission perm = m_cache[i][j]->m_Permission;
+            AbstractCacheEntry *entry = m_cache[setIndex(i) + j];
+            if (entry != NULL) {
+                AccessPermission perm = entry->m_Permission;
                 RubyRequestType request_type = RubyRequestType_NULL;
                 if (perm == AccessPermission_Read_Only) {
                     if (m_is_instruction_only_cache) {
@@ -435,10 +455,10 @@ CacheMemory::recordCacheContents(int cntrl, CacheRecorder* tr) const
 
                 if (request_type != RubyRequestType_NULL) {
                     Tick lastAccessTick;
-                    lastAccessTick = m_cache[i][j]->getLastAccess();
-                    tr->addRecord(cntrl, m_cache[i][j]->m_Address,
+                    lastAccessTick = entry->getLastAccess();
+                    tr->addRecord(cntrl, entry->m_Address,
                                   0, request_type, lastAccessTick,
-                                  m_cache[i][j]->getDataBlk());
+                                  entry->getDataBlk());
                     warmedUpBlocks++;
                 }
             }
@@ -456,10 +476,11 @@ CacheMemory::print(std::ostream& out) const
     out << "Cache dump: " << name() << std::endl;
     for (int i = 0; i < m_cache_num_sets; i++) {
         for (int j = 0; j < m_cache_assoc; j++) {
-            if (m_cache[i][j] != NULL) {
+            AbstractCacheEntry *entry = m_cache[setIndex(i) + j];
+            if (entry != NULL) {
                 out << "  Index: " << i
                     << " way: " << j
-                    << " entry: " << *m_cache[i][j] << std::endl;
+                    << " entry: " << *entry << std::endl;
             } else {
                 out << "  Index: " << i
                     << " way: " << j
@@ -497,15 +518,11 @@ void
 CacheMemory::clearLockedAll(int context)
 {
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i) {
-        std::vector<AbstractCacheEntry*> set = *i;
-        for (auto j = set.begin(); j != set.end(); ++j) {
-            AbstractCacheEntry *line = *j;
-            if (line && line->isLocked(context)) {
-                DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
-                    line->m_Address);
-                line->clearLocked();
-            }
+    for (AbstractCacheEntry *line : m_cache) {
+        if (line && line->isLocked(context)) {
+            DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
+                line->m_Address);
+            line->clearLocked();
         }
     }
 }
@@ -672,13 +689,15 @@ CacheMemory::checkResourceAvailable(CacheResourceType res, Addr addr)
 bool
 CacheMemory::isBlockInvalid(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission == AccessPermission_Invalid);
+  return (m_permissions[setIndex(cache_set) + loc] ==
+          AccessPermission_Invalid);
 }
 
 bool
 CacheMemory::isBlockNotBusy(int64_t cache_set, int64_t loc)
 {
-  return (m_cache[cache_set][loc]->m_Permission != AccessPermission_Busy);
+  return (m_permissions[setIndex(cache_set) + loc] !=
+          AccessPermission_Busy);
 }
 
 /* hardware transactional memory */
@@ -690,24 +709,16 @@ CacheMemory::htmAbortTransaction()
     uint64_t htmWriteSetSize = 0;
 
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                if (line->getInHtmWriteSet()) {
-                    line->invalidateEntry();
-                }
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
+    for (AbstractCacheEntry *line : m_cache) {
+        if (line != nullptr) {
+            htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+            htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+            if (line->getInHtmWriteSet()) {
+                line->invalidateEntry();
             }
+            line->setInHtmWriteSet(false);
+            line->setInHtmReadSet(false);
+            line->clearLocked();
         }
     }
 
@@ -724,20 +735,13 @@ CacheMemory::htmCommitTransaction()
     uint64_t htmWriteSetSize = 0;
 
     // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-             }
+    for (AbstractCacheEntry *line : m_cache) {
+        if (line != nullptr) {
+            htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+            htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+            line->setInHtmWriteSet(false);
+            line->setInHtmReadSet(false);
+            line->clearLocked();
         }
     }
 
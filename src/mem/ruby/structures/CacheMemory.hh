@@ -42,8 +42,8 @@
 #ifndef __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -176,10 +176,28 @@ class CacheMemory : public SimObject
     // Data Members (m_prefix)
     bool m_is_instruction_only_cache;
 
-    // The first index is the # of cache lines.
-    // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
-    std::vector<std::vector<AbstractCacheEntry*> > m_cache;
+    // Host cache line worth of tags, to align the tag array on lines
+    struct alignas(64) TagLine
+    {
+        Addr tags[64 / sizeof(Addr)];
+    };
+
+    // The tags, permissions and entries of the blocks are kept in flat
+    // arrays indexed by set * associativity + way, so that searching a
+    // set scans contiguous tags, and permissions when checking for room,
+    // without touching the entries themselves. An empty way has MaxAddr
+    // as tag, NotPresent as permission, and no entry.
+    std::vector<TagLine> m_tag_lines;
+    Addr *m_tags;
+    std::vector<uint8_t> m_permissions;
+    std::vector<AbstractCacheEntry*> m_cache;
+
+    // Index of the first way of a set in the flat arrays
+    int64_t
+    setIndex(int64_t cache_set) const
+    {
+        return cache_set * m_cache_assoc;
+    }
 
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
@@ -40,8 +40,6 @@
 
 #include "mem/ruby/system/DMASequencer.hh"
 
-#include <memory>
-
 #include "debug/RubyDma.hh"
 #include "debug/RubyStats.hh"
 #include "mem/ruby/protocol/SequencerMsg.hh"
@@ -110,8 +108,7 @@ DMASequencer::makeRequest(PacketPtr pkt)
 
     DPRINTF(RubyDma, "DMA req created: addr %p, len %d\n", line_addr, len);
 
-    std::shared_ptr<SequencerMsg> msg =
-        std::make_shared<SequencerMsg>(clockEdge());
+    RefCountingPtr<SequencerMsg> msg = new SequencerMsg(clockEdge());
     msg->getPhysicalAddress() = paddr;
     msg->getLineAddress() = line_addr;
 
@@ -183,8 +180,7 @@ DMASequencer::issueNext(const Addr& address)
         return;
     }
 
-    std::shared_ptr<SequencerMsg> msg =
-        std::make_shared<SequencerMsg>(clockEdge());
+    RefCountingPtr<SequencerMsg> msg = new SequencerMsg(clockEdge());
     msg->getPhysicalAddress() = active_request.start_paddr +
                                 active_request.bytes_completed;
 
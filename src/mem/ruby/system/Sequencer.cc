@@ -887,12 +887,11 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
 
     // check if the packet has data as for example prefetch and flush
     // requests do not
-    std::shared_ptr<RubyRequest> msg;
+    RefCountingPtr<RubyRequest> msg;
     if (pkt->req->isMemMgmt()) {
-        msg = std::make_shared<RubyRequest>(clockEdge(),
-                                            pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            proc_id, core_id);
+        msg = new RubyRequest(clockEdge(), pc, secondary_type,
+                              RubyAccessMode_Supervisor, pkt, proc_id,
+                              core_id);
 
         DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %s\n",
                 curTick(), m_version, "Seq", "Begin", "", "",
@@ -916,10 +915,9 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
                     msg->m_tlbiTransactionUid);
         }
     } else {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
-                                            pkt->getSize(), pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            PrefetchBit_No, proc_id, core_id);
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(), pkt->getSize(),
+                              pc, secondary_type, RubyAccessMode_Supervisor,
+                              pkt, PrefetchBit_No, proc_id, core_id);
 
         DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %#x %s\n",
                 curTick(), m_version, "Seq", "Begin", "", "",
@@ -67,8 +67,8 @@ class DeferEnqueueingStatementAST(StatementAST):
 
         # Declare message
         code(
-            "std::shared_ptr<${{msg_type.c_ident}}> out_msg = "
-            "std::make_shared<${{msg_type.c_ident}}>(clockEdge());"
+            "RefCountingPtr<${{msg_type.c_ident}}> out_msg = "
+            "new ${{msg_type.c_ident}}(clockEdge());"
         )
 
         # The other statements
@@ -77,7 +77,7 @@ class DeferEnqueueingStatementAST(StatementAST):
 
         code(
             "(${{self.queue_name.var.code}}).deferEnqueueingMessage(addr, "
-            "out_msg);"
+            "std::move(out_msg));"
         )
 
         # End scope
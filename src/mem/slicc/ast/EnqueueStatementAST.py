@@ -66,8 +66,8 @@ class EnqueueStatementAST(StatementAST):
 
         # Declare message
         code(
-            "std::shared_ptr<${{msg_type.c_ident}}> out_msg = "
-            "std::make_shared<${{msg_type.c_ident}}>(clockEdge());"
+            "RefCountingPtr<${{msg_type.c_ident}}> out_msg = "
+            "new ${{msg_type.c_ident}}(clockEdge());"
         )
 
         # The other statements
@@ -78,12 +78,13 @@ class EnqueueStatementAST(StatementAST):
             ret_type, rcode = self.latexpr.inline(True)
             code(
                 "(${{self.queue_name.var.code}}).enqueue("
-                "out_msg, clockEdge(), cyclesToTicks(Cycles($rcode)));"
+                "std::move(out_msg), clockEdge(), "
+                "cyclesToTicks(Cycles($rcode)));"
             )
         else:
             code(
-                "(${{self.queue_name.var.code}}).enqueue(out_msg, "
-                "clockEdge(), cyclesToTicks(Cycles(1)));"
+                "(${{self.queue_name.var.code}}).enqueue("
+                "std::move(out_msg), clockEdge(), cyclesToTicks(Cycles(1)));"
             )
 
         # End scope
@@ -226,8 +226,11 @@ class Type(Symbol):
 #ifndef __${{self.c_ident}}_HH__
 #define __${{self.c_ident}}_HH__
 
+#include <cstddef>
 #include <iostream>
+#include <utility>
 
+#include "base/free_list.hh"
 #include "mem/ruby/slicc_interface/RubySlicc_Util.hh"
 
 """
@@ -283,13 +286,16 @@ $klass ${{self.c_ident}}$parent
             code.dedent()
         code("}")
 
-        # ******** Copy constructor ********
+        # ******** Copy and move constructors ********
         code("${{self.c_ident}}(const ${{self.c_ident}}&) = default;")
+        code("${{self.c_ident}}(${{self.c_ident}}&&) = default;")
 
-        # ******** Assignment operator ********
+        # ******** Assignment operators ********
 
         code("${{self.c_ident}}")
         code("&operator=(const ${{self.c_ident}}&) = default;")
+        code("${{self.c_ident}}")
+        code("&operator=(${{self.c_ident}}&&) = default;")
 
         # ******** Full init constructor ********
         if not self.isGlobal:
@@ -326,8 +332,31 @@ $klass ${{self.c_ident}}$parent
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return MsgPtr(new ${{self.c_ident}}(*this));
+}
+
+/**
+ * Messages are recycled through a free list rather than going
+ * through the heap every time.
+ * @{
+ */
+static void *
+operator new(std::size_t size)
+{
+    if (size == sizeof(${{self.c_ident}}))
+        return FreeList<sizeof(${{self.c_ident}})>::allocate();
+    return ::operator new(size);
+}
+
+static void
+operator delete(void *ptr, std::size_t size)
+{
+    if (size == sizeof(${{self.c_ident}}))
+        FreeList<sizeof(${{self.c_ident}})>::deallocate(ptr);
+    else
+        ::operator delete(ptr);
 }
+/** @} */
 """
             )
         else:
@@ -387,6 +416,16 @@ set${{dm.ident}}(const ${{dm.real_c_type}}& local_${{dm.ident}})
 }
 """
                 )
+                if not (dm.type.isPrimitive or dm.type.isEnumeration):
+                    code(
+                        """
+void
+set${{dm.ident}}(${{dm.real_c_type}}&& local_${{dm.ident}})
+{
+    m_${{dm.ident}} = std::move(local_${{dm.ident}});
+}
+"""
+                    )
 
         code("void print(std::ostream& out) const;")
         code.dedent()
@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/store_image.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "config/have_zstd.hh"
+
+#if HAVE_ZSTD
+#include <zstd.h>
+
+#endif
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace store_image
+{
+
+namespace
+{
+
+constexpr char Magic[8] = {'g', 'e', 'm', '5', 'm', 'e', 'm', '\0'};
+constexpr uint32_t Version = 1;
+
+/** Granularity at which the zeros of the image are not written back. */
+constexpr uint64_t PageSize = 4096;
+
+/** Number of chunks per thread which may be compressed ahead. */
+constexpr uint64_t ChunksPerThread = 4;
+
+enum Codec : uint32_t
+{
+    /** Raw image, the content is not compressed nor chunked. */
+    Raw = 0,
+    Zlib = 1,
+    Zstd = 2,
+};
+
+#if HAVE_ZSTD
+constexpr Codec DefaultCodec = Zstd;
+#else
+constexpr Codec DefaultCodec = Zlib;
+#endif
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t codec;
+    uint64_t chunkSize;
+    /** Size of the backing store. */
+    uint64_t size;
+    uint64_t numChunks;
+    /** Position of the index in the file. */
+    uint64_t indexOffset;
+};
+
+Header
+makeHeader(Codec codec, uint64_t chunk_size, uint64_t size)
+{
+    Header header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.codec = codec;
+    header.chunkSize = chunk_size;
+    header.size = size;
+    header.numChunks = divCeil(size, chunk_size);
+    return header;
+}
+
+/** Position of a chunk in the file, with a length of 0 for zero chunks. */
+struct IndexEntry
+{
+    uint64_t offset;
+    uint64_t length;
+};
+
+/** Compression context of one thread. */
+class Compressor
+{
+  private:
+    const Codec codec;
+#if HAVE_ZSTD
+    ZSTD_CCtx *cctx = nullptr;
+    ZSTD_DCtx *dctx = nullptr;
+#endif
+
+  public:
+    explicit Compressor(Codec _codec) : codec(_codec) {}
+
+    ~Compressor()
+    {
+#if HAVE_ZSTD
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+#endif
+    }
+
+    /** Compress size bytes of src into out. */
+    void
+    compress(const uint8_t *src, uint64_t size, std::vector<uint8_t> &out)
+    {
+#if HAVE_ZSTD
+        if (codec == Zstd) {
+            if (!cctx)
+                cctx = ZSTD_createCCtx();
+            out.resize(ZSTD_compressBound(size));
+            const size_t length = ZSTD_compressCCtx(
+                cctx, out.data(), out.size(), src, size, 1);
+            fatal_if(ZSTD_isError(length), "zstd compression failed: %s\n",
+                     ZSTD_getErrorName(length));
+            out.resize(length);
+            return;
+        }
+#endif
+        uLongf length = compressBound(size);
+        out.resize(length);
+        fatal_if(compress2(out.data(), &length, src, size,
+                           Z_BEST_SPEED) != Z_OK,
+                 "zlib compression failed\n");
+        out.resize(length);
+    }
+
+    /**
+     * Decompress length bytes of src into size bytes of dst, returning
+     * whether the decompressed size matches.
+     */
+    bool
+    decompress(const uint8_t *src, uint64_t length, uint8_t *dst,
+               uint64_t size)
+    {
+#if HAVE_ZSTD
+        if (codec == Zstd) {
+            if (!dctx)
+                dctx = ZSTD_createDCtx();
+            return ZSTD_decompressDCtx(dctx, dst, size, src, length) == size;
+        }
+#endif
+        uLongf dst_length = size;
+        return uncompress(dst, &dst_length, src, length) == Z_OK &&
+            dst_length == size;
+    }
+};
+
+unsigned
+numThreads(unsigned threads, uint64_t num_chunks)
+{
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    return std::max<uint64_t>(1, std::min<uint64_t>(threads, num_chunks));
+}
+
+bool
+isZero(const uint8_t *data, uint64_t size)
+{
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if (word)
+            return false;
+    }
+    for (; i < size; i++) {
+        if (data[i])
+            return false;
+    }
+    return true;
+}
+
+void
+writeAll(int fd, const void *buf, uint64_t size, uint64_t offset,
+         const std::string &path)
+{
+    const uint8_t *ptr = static_cast<const uint8_t *>(buf);
+    while (size) {
+        const ssize_t written = pwrite(fd, ptr, size, offset);
+        fatal_if(written < 0, "Write failed on memory store image '%s'\n",
+                 path);
+        ptr += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+void
+readAll(int fd, void *buf, uint64_t size, uint64_t offset,
+        const std::string &path)
+{
+    uint8_t *ptr = static_cast<uint8_t *>(buf);
+    while (size) {
+        const ssize_t bytes_read = pread(fd, ptr, size, offset);
+        fatal_if(bytes_read <= 0, "Read failed on memory store image '%s'\n",
+                 path);
+        ptr += bytes_read;
+        size -= bytes_read;
+        offset += bytes_read;
+    }
+}
+
+/** Read and check the header of an image of a store of the given size. */
+Header
+readHeader(int fd, const std::string &path, uint64_t size)
+{
+    Header header;
+    readAll(fd, &header, sizeof(header), 0, path);
+    fatal_if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0,
+             "'%s' is not a memory store image\n", path);
+    fatal_if(header.version != Version,
+             "Unsupported version %d of memory store image '%s'\n",
+             header.version, path);
+#if !HAVE_ZSTD
+    fatal_if(header.codec == Zstd, "Memory store image '%s' is compressed "
+             "with zstd, which gem5 has not been built with\n", path);
+#endif
+    fatal_if(header.codec != Raw && header.codec != Zlib &&
+             header.codec != Zstd,
+             "Unknown codec %d in memory store image '%s'\n",
+             header.codec, path);
+    fatal_if(header.size != size, "Memory store image '%s' holds %d bytes, "
+             "expected %d\n", path, header.size, size);
+    fatal_if(!header.chunkSize ||
+             header.numChunks != divCeil(size, header.chunkSize),
+             "Corrupted header in memory store image '%s'\n", path);
+    return header;
+}
+
+/** Read the header of a file, returning whether it is a store image. */
+bool
+peekHeader(const std::string &path, Header &header)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    const bool is_image = pread(fd, &header, sizeof(header), 0) ==
+        sizeof(header) &&
+        std::memcmp(header.magic, Magic, sizeof(Magic)) == 0;
+    close(fd);
+    return is_image;
+}
+
+} // anonymous namespace
+
+bool
+isStoreImage(const std::string &path)
+{
+    Header header;
+    return peekHeader(path, header);
+}
+
+bool
+isRawImage(const std::string &path)
+{
+    Header header;
+    return peekHeader(path, header) && header.codec == Raw;
+}
+
+void
+write(const std::string &path, const uint8_t *data, uint64_t size,
+      unsigned threads, uint64_t chunk_size)
+{
+    fatal_if(!chunk_size, "Memory store image chunks cannot be empty\n");
+
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    fatal_if(fd < 0, "Can't open memory store image '%s'\n", path);
+
+    Header header = makeHeader(DefaultCodec, chunk_size, size);
+    const uint64_t num_chunks = header.numChunks;
+    const unsigned num_threads = numThreads(threads, num_chunks);
+
+    // The threads compress the chunks in order, at most window chunks
+    // ahead of the chunk being written, each to the slot of the window
+    // associated with it.
+    struct Slot
+    {
+        std::vector<uint8_t> data;
+        bool ready = false;
+    };
+    const uint64_t window = num_threads * ChunksPerThread;
+    std::vector<Slot> slots(window);
+    std::mutex lock;
+    std::condition_variable cond;
+    uint64_t next = 0;
+    uint64_t written = 0;
+
+    auto compress_chunks = [&]() {
+        Compressor compressor(DefaultCodec);
+        std::unique_lock<std::mutex> guard(lock);
+        while (true) {
+            cond.wait(guard, [&]() {
+                return next == num_chunks || next < written + window;
+            });
+            if (next == num_chunks)
+                return;
+            const uint64_t chunk = next++;
+            guard.unlock();
+
+            Slot &slot = slots[chunk % window];
+            const uint8_t *src = data + chunk * chunk_size;
+            const uint64_t src_size =
+                std::min(chunk_size, size - chunk * chunk_size);
+            if (isZero(src, src_size))
+                slot.data.clear();
+            else
+                compressor.compress(src, src_size, slot.data);
+
+            guard.lock();
+            slot.ready = true;
+            cond.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < num_threads; i++)
+        workers.emplace_back(compress_chunks);
+
+    std::vector<IndexEntry> index(num_chunks);
+    uint64_t offset = sizeof(header);
+    for (uint64_t chunk = 0; chunk < num_chunks; chunk++) {
+        Slot &slot = slots[chunk % window];
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            cond.wait(guard, [&]() { return slot.ready; });
+        }
+
+        index[chunk] = {offset, slot.data.size()};
+        writeAll(fd, slot.data.data(), slot.data.size(), offset, path);
+        offset += slot.data.size();
+
+        std::lock_guard<std::mutex> guard(lock);
+        slot.ready = false;
+        written = chunk + 1;
+        cond.notify_all();
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    header.indexOffset = offset;
+    writeAll(fd, index.data(), index.size() * sizeof(IndexEntry), offset,
+             path);
+    writeAll(fd, &header, sizeof(header), 0, path);
+
+    fatal_if(close(fd) != 0, "Close failed on memory store image '%s'\n",
+             path);
+}
+
+void
+writeRaw(const std::string &path, const uint8_t *data, uint64_t size)
+{
+    const std::string tmp_path = path + ".tmp";
+    int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    fatal_if(fd < 0, "Can't open memory store image '%s'\n", tmp_path);
+
+    const Header header = makeHeader(Raw, DefaultChunkSize, size);
+    writeAll(fd, &header, sizeof(header), 0, tmp_path);
+    fatal_if(ftruncate(fd, RawDataOffset + size) != 0,
+             "Can't resize memory store image '%s'\n", tmp_path);
+
+    // Only the runs of non-zero pages are written, the zero pages are
+    // left as holes in the file
+    uint64_t page = 0;
+    while (page < size) {
+        const uint64_t page_size = std::min(PageSize, size - page);
+        if (isZero(data + page, page_size)) {
+            page += page_size;
+            continue;
+        }
+        uint64_t end = page + page_size;
+        while (end < size &&
+               !isZero(data + end, std::min(PageSize, size - end))) {
+            end += std::min(PageSize, size - end);
+        }
+        writeAll(fd, data + page, end - page, RawDataOffset + page,
+                 tmp_path);
+        page = end;
+    }
+
+    fatal_if(close(fd) != 0, "Close failed on memory store image '%s'\n",
+             tmp_path);
+    fatal_if(rename(tmp_path.c_str(), path.c_str()) != 0,
+             "Can't rename memory store image '%s' to '%s'\n", tmp_path,
+             path);
+}
+
+void
+read(const std::string &path, uint8_t *data, uint64_t size,
+     unsigned threads)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open memory store image '%s'\n", path);
+
+    const Header header = readHeader(fd, path, size);
+    const Codec codec = static_cast<Codec>(header.codec);
+    const uint64_t chunk_size = header.chunkSize;
+
+    std::vector<IndexEntry> index;
+    if (codec != Raw) {
+        index.resize(header.numChunks);
+        readAll(fd, index.data(), index.size() * sizeof(IndexEntry),
+                header.indexOffset, path);
+    }
+
+    std::atomic<uint64_t> next(0);
+    auto read_chunks = [&]() {
+        Compressor compressor(codec);
+        std::vector<uint8_t> compressed;
+        std::vector<uint8_t> chunk_data(chunk_size);
+        for (uint64_t chunk; (chunk = next++) < header.numChunks; ) {
+            const uint64_t dst_size =
+                std::min(chunk_size, size - chunk * chunk_size);
+            if (codec == Raw) {
+                readAll(fd, chunk_data.data(), dst_size,
+                        RawDataOffset + chunk * chunk_size, path);
+            } else {
+                const IndexEntry &entry = index[chunk];
+                if (!entry.length)
+                    continue;
+
+                compressed.resize(entry.length);
+                readAll(fd, compressed.data(), entry.length, entry.offset,
+                        path);
+                fatal_if(!compressor.decompress(compressed.data(),
+                                                entry.length,
+                                                chunk_data.data(), dst_size),
+                         "Corrupted chunk %d in memory store image '%s'\n",
+                         chunk, path);
+            }
+
+            // Only copy the pages that are non-zero, so that the host
+            // does not have to allocate them
+            uint8_t *dst = data + chunk * chunk_size;
+            for (uint64_t page = 0; page < dst_size; page += PageSize) {
+                const uint64_t page_size = std::min(PageSize,
+                                                    dst_size - page);
+                if (!isZero(chunk_data.data() + page, page_size))
+                    std::memcpy(dst + page, chunk_data.data() + page,
+                                page_size);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const unsigned num_threads = numThreads(threads, header.numChunks);
+    for (unsigned i = 0; i < num_threads; i++)
+        workers.emplace_back(read_chunks);
+    for (auto &worker : workers)
+        worker.join();
+
+    close(fd);
+}
+
+void
+map(const std::string &path, uint8_t *data, uint64_t size, bool no_reserve)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open memory store image '%s'\n", path);
+
+    const Header header = readHeader(fd, path, size);
+    fatal_if(header.codec != Raw,
+             "Memory store image '%s' is compressed, it cannot be mapped\n",
+             path);
+    fatal_if(RawDataOffset % sysconf(_SC_PAGE_SIZE) != 0,
+             "The host pages are too large to map memory store images\n");
+
+    // Pages mapped past the end of the file would fault when touched
+    struct stat st;
+    fatal_if(fstat(fd, &st) != 0, "Can't stat memory store image '%s'\n",
+             path);
+    fatal_if((uint64_t)st.st_size < RawDataOffset + size,
+             "Memory store image '%s' is truncated, the file holds %d "
+             "bytes, expected %d\n", path, st.st_size, RawDataOffset + size);
+
+    int flags = MAP_PRIVATE | MAP_FIXED;
+#ifdef MAP_NORESERVE
+    if (no_reserve)
+        flags |= MAP_NORESERVE;
+#endif
+    // The pages stay writable: the stores of the simulation go to
+    // private copies of the pages of the image
+    void *addr = mmap(data, size, PROT_READ | PROT_WRITE, flags, fd,
+                      RawDataOffset);
+    fatal_if(addr == MAP_FAILED, "Could not map memory store image '%s': "
+             "%s\n", path, std::strerror(errno));
+
+    // The mapping keeps a reference to the file
+    close(fd);
+}
+
+} // namespace store_image
+} // namespace memory
+} // namespace gem5
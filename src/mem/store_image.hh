@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Images of memory backing stores, used to checkpoint the physical
+ * memory.
+ */
+
+#ifndef __MEM_STORE_IMAGE_HH__
+#define __MEM_STORE_IMAGE_HH__
+
+#include <cstdint>
+#include <string>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A store image holds the content of a backing store in one of two
+ * layouts, both starting with a header whose fields are stored in the
+ * byte order of the host.
+ *
+ * A chunked image cuts the content in chunks of a fixed size which are
+ * compressed independently, so that several host threads can compress,
+ * and later decompress, the chunks in parallel. Chunks only holding
+ * zeros are not stored at all. The compressed chunks follow the header,
+ * and the file ends with an index giving the position of every chunk.
+ * The chunks are compressed with zstd when gem5 is built with it, and
+ * with zlib otherwise. The codec is recorded in the header, an image
+ * compressed with zstd can therefore only be read by a gem5 built with
+ * zstd.
+ *
+ * A raw image holds the content uncompressed, at an offset aligned on
+ * host pages (RawDataOffset), so that it can be mapped copy-on-write
+ * over a backing store: restoring then takes constant time, pages are
+ * only read when the simulation first touches them, and the page cache
+ * of the host is shared by all the gem5 processes restoring the same
+ * image. Zero pages are left as holes of a sparse file.
+ */
+namespace store_image
+{
+
+/** Default size of the chunks, in bytes. */
+constexpr uint64_t DefaultChunkSize = 1 << 20;
+
+/**
+ * Offset of the content in a raw image, which must be a multiple of the
+ * page size of the hosts mapping the image.
+ */
+constexpr uint64_t RawDataOffset = 1 << 16;
+
+/**
+ * Whether a file is a store image, as opposed to the gzip compressed
+ * checkpoints of backing stores written by older versions of gem5.
+ */
+bool isStoreImage(const std::string &path);
+
+/** Whether a file is a raw store image, which can be mapped. */
+bool isRawImage(const std::string &path);
+
+/**
+ * Write a chunked store image.
+ *
+ * @param path File to write.
+ * @param data Content of the backing store.
+ * @param size Size of the backing store, in bytes.
+ * @param threads Number of threads compressing chunks, 0 for one per
+ *        host core.
+ * @param chunk_size Size of the chunks, in bytes.
+ */
+void write(const std::string &path, const uint8_t *data, uint64_t size,
+           unsigned threads, uint64_t chunk_size=DefaultChunkSize);
+
+/**
+ * Write a raw store image. The image is written to a temporary file
+ * renamed once complete, so that an image mapped by this process can be
+ * overwritten safely.
+ *
+ * @param path File to write.
+ * @param data Content of the backing store.
+ * @param size Size of the backing store, in bytes.
+ */
+void writeRaw(const std::string &path, const uint8_t *data, uint64_t size);
+
+/**
+ * Read a store image, chunked or raw, back into a backing store. The
+ * backing store is assumed to be zeroed: the pages which are zero in the
+ * image are not written, so that they do not need to be allocated by
+ * the host.
+ *
+ * @param path File to read.
+ * @param data Content of the backing store.
+ * @param size Size of the backing store, in bytes, which must match the
+ *        one of the image.
+ * @param threads Number of threads decompressing chunks, 0 for one per
+ *        host core.
+ */
+void read(const std::string &path, uint8_t *data, uint64_t size,
+          unsigned threads);
+
+/**
+ * Map a raw store image copy-on-write over a backing store, replacing
+ * its current content. The image must not be modified while mapped.
+ *
+ * @param path File to map.
+ * @param data Content of the backing store, aligned on host pages.
+ * @param size Size of the backing store, in bytes, which must match the
+ *        one of the image.
+ * @param no_reserve Whether to map the store without reserving swap.
+ */
+void map(const std::string &path, uint8_t *data, uint64_t size,
+         bool no_reserve);
+
+} // namespace store_image
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_STORE_IMAGE_HH__
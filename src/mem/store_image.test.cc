@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "mem/store_image.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+/** A temporary file, removed on destruction. */
+class TempFile
+{
+  public:
+    TempFile()
+    {
+        char name[] = "store-image-XXXXXX";
+        int fd = mkstemp(name);
+        EXPECT_NE(-1, fd);
+        close(fd);
+        path = name;
+    }
+
+    ~TempFile() { unlink(path.c_str()); }
+
+    std::string path;
+};
+
+/** Backing store content mixing random, zero and constant regions. */
+std::vector<uint8_t>
+makeStore(uint64_t size)
+{
+    std::vector<uint8_t> store(size, 0);
+    std::mt19937 rng(42);
+    for (uint64_t i = 0; i < size; i++) {
+        switch ((i / 10000) % 4) {
+          case 0:
+            store[i] = rng();
+            break;
+          case 2:
+            store[i] = 0xa5;
+            break;
+          default:
+            break;
+        }
+    }
+    return store;
+}
+
+} // anonymous namespace
+
+/** Stores are read back as they were written, whatever the threads. */
+TEST(StoreImageTest, RoundTrip)
+{
+    for (unsigned threads : {1, 3, 0}) {
+        // The size is not a multiple of the chunk size
+        const std::vector<uint8_t> store = makeStore(123457);
+        TempFile file;
+        store_image::write(file.path, store.data(), store.size(), threads,
+                           8192);
+        EXPECT_TRUE(store_image::isStoreImage(file.path));
+        EXPECT_FALSE(store_image::isRawImage(file.path));
+
+        std::vector<uint8_t> restored(store.size(), 0);
+        store_image::read(file.path, restored.data(), restored.size(),
+                          threads);
+        EXPECT_EQ(store, restored);
+    }
+}
+
+/** Zero chunks are not stored. */
+TEST(StoreImageTest, ZeroChunks)
+{
+    std::vector<uint8_t> data(1 << 20, 0);
+    TempFile file;
+    store_image::write(file.path, data.data(), data.size(), 2, 4096);
+
+    // Only the header and the index of the 256 chunks are left
+    struct stat st;
+    ASSERT_EQ(0, stat(file.path.c_str(), &st));
+    EXPECT_LT(st.st_size, 256 * 16 + 64);
+
+    data[300000] = 1;
+    store_image::write(file.path, data.data(), data.size(), 2, 4096);
+
+    std::vector<uint8_t> restored(data.size(), 0);
+    store_image::read(file.path, restored.data(), restored.size(), 2);
+    EXPECT_EQ(data, restored);
+}
+
+/** Raw images are read back, or mapped, as they were written. */
+TEST(StoreImageTest, RawRoundTrip)
+{
+    const std::vector<uint8_t> store = makeStore(123457);
+    TempFile file;
+    store_image::writeRaw(file.path, store.data(), store.size());
+    EXPECT_TRUE(store_image::isStoreImage(file.path));
+    EXPECT_TRUE(store_image::isRawImage(file.path));
+
+    std::vector<uint8_t> restored(store.size(), 0);
+    store_image::read(file.path, restored.data(), restored.size(), 2);
+    EXPECT_EQ(store, restored);
+
+    uint8_t *pmem = (uint8_t *)mmap(nullptr, store.size(),
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_ANON | MAP_PRIVATE, -1, 0);
+    ASSERT_NE(MAP_FAILED, pmem);
+    store_image::map(file.path, pmem, store.size(), false);
+    EXPECT_TRUE(std::equal(store.begin(), store.end(), pmem));
+
+    // Stores to the mapped backing store do not reach the image
+    pmem[0] ^= 0xff;
+    restored.assign(store.size(), 0);
+    store_image::read(file.path, restored.data(), restored.size(), 1);
+    EXPECT_EQ(store, restored);
+    munmap(pmem, store.size());
+}
+
+/** Truncated raw images are not mapped. */
+TEST(StoreImageTest, TruncatedRawImage)
+{
+    const std::vector<uint8_t> store = makeStore(123457);
+    TempFile file;
+    store_image::writeRaw(file.path, store.data(), store.size());
+    struct stat st;
+    ASSERT_EQ(0, stat(file.path.c_str(), &st));
+    ASSERT_EQ(0, truncate(file.path.c_str(), st.st_size - 1));
+
+    uint8_t *pmem = (uint8_t *)mmap(nullptr, store.size(),
+                                    PROT_READ | PROT_WRITE,
+                                    MAP_ANON | MAP_PRIVATE, -1, 0);
+    ASSERT_NE(MAP_FAILED, pmem);
+    gtestLogOutput.str("");
+    ASSERT_ANY_THROW(
+        store_image::map(file.path, pmem, store.size(), false));
+    EXPECT_NE(std::string::npos, gtestLogOutput.str().find("truncated"));
+    munmap(pmem, store.size());
+}
+
+/** Files which are not store images are recognized as such. */
+TEST(StoreImageTest, NotAnImage)
+{
+    TempFile file;
+    EXPECT_FALSE(store_image::isStoreImage(file.path));
+    EXPECT_FALSE(store_image::isRawImage(file.path));
+    EXPECT_FALSE(store_image::isStoreImage(file.path + ".missing"));
+}
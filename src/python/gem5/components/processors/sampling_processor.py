@@ -0,0 +1,140 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from ..boards.abstract_board import AbstractBoard
+from ..processors.simple_core import SimpleCore
+from ..processors.cpu_types import CPUTypes, get_mem_mode
+from .switchable_processor import SwitchableProcessor
+from ...isas import ISA
+
+from ...utils.override import *
+
+from typing import Optional
+
+
+class SamplingProcessor(SwitchableProcessor):
+    """
+    A processor for sampled simulation (SMARTS-style), switching between
+    three sets of cores:
+
+    * The fast-forwarding cores, running between the samples. These are
+      typically KVM cores, which do not access the caches.
+    * The warming cores, running just before each sample in atomic mode so
+      that the accesses update the tags, the replacement state and (if the
+      caches have `warm_prefetcher` set) the prefetchers, without timing.
+    * The detailed cores, running the samples.
+
+    When the fast-forwarding cores are atomic cores, they also serve as
+    warming cores: the caches are then warmed continuously between the
+    samples (functional warming).
+
+    See `gem5.simulate.sampler.Sampler` for the driver of the samples.
+    """
+
+    def __init__(
+        self,
+        fast_forward_core_type: CPUTypes,
+        detailed_core_type: CPUTypes,
+        num_cores: int,
+        isa: ISA,
+    ) -> None:
+        """
+        :param fast_forward_core_type: The CPU type of the cores running
+        between the samples, and at the start of the simulation.
+        :param detailed_core_type: The CPU type of the cores running the
+        samples.
+        :param num_cores: The number of cores of each type.
+        :param isa: The ISA of the processor.
+        """
+
+        if num_cores <= 0:
+            raise AssertionError("Number of cores must be a positive integer!")
+
+        if detailed_core_type in (CPUTypes.ATOMIC, CPUTypes.KVM):
+            raise AssertionError(
+                "The detailed cores of a SamplingProcessor must model timing."
+            )
+
+        self._fast_forward_key = "fast_forward"
+        self._warming_key = "warming"
+        self._detailed_key = "detailed"
+
+        self._mem_mode = get_mem_mode(fast_forward_core_type)
+
+        def make_cores(cpu_type):
+            return [
+                SimpleCore(cpu_type=cpu_type, core_id=i, isa=isa)
+                for i in range(num_cores)
+            ]
+
+        switchable_cores = {
+            self._fast_forward_key: make_cores(fast_forward_core_type),
+            self._detailed_key: make_cores(detailed_core_type),
+        }
+
+        # Atomic fast-forwarding cores warm the caches on their own
+        self._continuous_warming = fast_forward_core_type == CPUTypes.ATOMIC
+        if self._continuous_warming:
+            self._warming_key = self._fast_forward_key
+        else:
+            switchable_cores[self._warming_key] = make_cores(CPUTypes.ATOMIC)
+
+        self._current_key = self._fast_forward_key
+
+        super().__init__(
+            switchable_cores=switchable_cores,
+            starting_cores=self._fast_forward_key,
+        )
+
+    @overrides(SwitchableProcessor)
+    def incorporate_processor(self, board: AbstractBoard) -> None:
+        super().incorporate_processor(board=board)
+
+        board.set_mem_mode(self._mem_mode)
+
+    def has_continuous_warming(self) -> bool:
+        """
+        Whether the caches are warmed while fast-forwarding, in which case
+        no warming cores are needed.
+        """
+        return self._continuous_warming
+
+    def _switch_to(self, key: str) -> None:
+        if key != self._current_key:
+            self.switch_to_processor(key)
+            self._current_key = key
+
+    def switch_to_fast_forward(self) -> None:
+        """Switches to the fast-forwarding cores."""
+        self._switch_to(self._fast_forward_key)
+
+    def switch_to_warming(self) -> None:
+        """Switches to the warming cores."""
+        self._switch_to(self._warming_key)
+
+    def switch_to_detailed(self) -> None:
+        """Switches to the detailed cores."""
+        self._switch_to(self._detailed_key)
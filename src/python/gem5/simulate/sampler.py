@@ -0,0 +1,308 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Periodic sampling (SMARTS-style) of a simulation: fast-forward, warm the
+microarchitectural state, simulate a sample in detail, and repeat, then
+estimate the metrics of the whole run, with their confidence, from the
+samples.
+"""
+
+import math
+from enum import Enum
+from typing import Callable, Dict, Generator, List, Optional
+
+import m5
+import m5.stats
+from m5.util import warn
+
+from ..components.boards.abstract_board import AbstractBoard
+from ..components.processors.sampling_processor import SamplingProcessor
+
+
+class SamplingPhase(Enum):
+    IDLE = "idle"
+    FAST_FORWARD = "fast-forward"
+    WARMING = "warming"
+    DETAILED = "detailed"
+    DONE = "done"
+
+
+class MetricEstimate:
+    """
+    The estimate of a metric from its values over the samples, assuming
+    the samples are taken systematically over a long run (the sample mean
+    is then normally distributed).
+    """
+
+    # Quantile of the normal distribution for a 95% confidence
+    Z_95 = 1.96
+
+    def __init__(self, name: str, values: List[float]) -> None:
+        self.name = name
+        self.values = values
+        self.num_samples = len(values)
+        self.mean = sum(values) / len(values) if values else float("nan")
+        if len(values) > 1:
+            self.stdev = math.sqrt(
+                sum((v - self.mean) ** 2 for v in values) / (len(values) - 1)
+            )
+        else:
+            self.stdev = float("nan")
+
+    def coefficient_of_variation(self) -> float:
+        """The standard deviation of the samples relative to their mean."""
+        return self.stdev / self.mean if self.mean else float("nan")
+
+    def confidence_interval(self, z: float = Z_95) -> float:
+        """
+        The half-width of the confidence interval of the mean, relative to
+        the mean. With the default z, the true mean is within
+        `mean * (1 +/- confidence_interval())` with a 95% confidence.
+        """
+        return (
+            z * self.coefficient_of_variation() / math.sqrt(self.num_samples)
+        )
+
+    def required_samples(self, error: float, z: float = Z_95) -> int:
+        """
+        The number of samples needed for the confidence interval to be
+        within +/- error (relative to the mean).
+        """
+        return math.ceil((z * self.coefficient_of_variation() / error) ** 2)
+
+    def __str__(self) -> str:
+        cov = self.coefficient_of_variation()
+        return (
+            f"{self.name}: {self.mean:.6g} +/- "
+            f"{100 * self.confidence_interval():.2f}% (95% confidence, "
+            f"{self.num_samples} samples, CoV {cov:.3f}, "
+            f"{self.required_samples(0.03)} samples needed for +/- 3%)"
+        )
+
+
+class Sampler:
+    """
+    Drives a sampled simulation on a `SamplingProcessor`. Each period
+    fast-forwards `fast_forward_insts` instructions, warms the caches for
+    `warming_insts` instructions with atomic cores, and simulates a sample
+    of `detailed_insts` instructions with the detailed cores. Instructions
+    are counted on the first thread of the first core.
+
+    The statistics are reset at the start of every sample, and dumped at
+    its end (if `dump_stats`), so that stats.txt holds one section per
+    sample. The metrics of each sample are recorded, and their estimates
+    over the whole run are given by `get_estimates()`.
+
+    The sampler is scheduled through `Simulator.schedule_sampling()`,
+    which routes the MAX_INSTS exit events to it.
+
+    Example:
+
+    ```
+    processor = SamplingProcessor(
+        fast_forward_core_type=CPUTypes.KVM,
+        detailed_core_type=CPUTypes.O3,
+        num_cores=1,
+        isa=ISA.X86,
+    )
+    ...
+    sampler = Sampler(
+        board=board,
+        fast_forward_insts=10_000_000,
+        warming_insts=1_000_000,
+        detailed_insts=100_000,
+        num_samples=100,
+    )
+    simulator = Simulator(board=board)
+    simulator.schedule_sampling(sampler)
+    simulator.run()
+    for estimate in sampler.get_estimates().values():
+        print(estimate)
+    ```
+    """
+
+    def __init__(
+        self,
+        board: AbstractBoard,
+        fast_forward_insts: int,
+        warming_insts: int,
+        detailed_insts: int,
+        num_samples: Optional[int] = None,
+        metrics: Optional[Dict[str, Callable[[], float]]] = None,
+        dump_stats: bool = True,
+    ) -> None:
+        """
+        :param board: The board simulated, whose processor must be a
+        `SamplingProcessor`.
+        :param fast_forward_insts: The number of instructions between the
+        end of a sample and the start of the warming of the next one.
+        :param warming_insts: The number of instructions executed by the
+        warming cores before each sample. When the processor warms the
+        caches continuously this is simply added to the fast-forwarding.
+        :param detailed_insts: The number of instructions of each sample.
+        :param num_samples: The number of samples after which the
+        simulation exits, or None to sample until the workload exits.
+        :param metrics: The metrics to record at the end of each sample, as
+        functions called once the statistics of the sample have been
+        dumped. The instructions per cycle of the first core over the
+        sample are recorded as "ipc" in any case.
+        :param dump_stats: Whether to dump the statistics of each sample.
+        """
+
+        processor = board.get_processor()
+        if not isinstance(processor, SamplingProcessor):
+            raise AssertionError(
+                "Sampling requires the processor to be a SamplingProcessor."
+            )
+        if detailed_insts <= 0:
+            raise AssertionError("Samples must have a positive length.")
+        if fast_forward_insts < 0 or warming_insts < 0:
+            raise AssertionError("Phase lengths cannot be negative.")
+
+        self._board = board
+        self._processor = processor
+        self._lengths = {
+            SamplingPhase.FAST_FORWARD: fast_forward_insts,
+            SamplingPhase.WARMING: warming_insts,
+            SamplingPhase.DETAILED: detailed_insts,
+        }
+        self._num_samples = num_samples
+        self._metrics = dict(metrics) if metrics else {}
+        self._dump_stats = dump_stats
+
+        self._phase = SamplingPhase.IDLE
+        self._sample_start_tick = 0
+        self._values = {name: [] for name in ["ipc"] + list(self._metrics)}
+
+    def enable_prefetcher_warming(self) -> None:
+        """
+        Have the atomic accesses train the prefetchers of the caches of the
+        board. This must be called before the simulation is instantiated.
+        """
+        from m5.objects import BaseCache
+
+        for obj in self._board.descendants():
+            if isinstance(obj, BaseCache):
+                obj.warm_prefetcher = True
+
+    def get_phase(self) -> SamplingPhase:
+        return self._phase
+
+    def get_num_samples(self) -> int:
+        """The number of samples simulated so far."""
+        return len(self._values["ipc"])
+
+    def start(self) -> None:
+        """
+        Start sampling from the current point of the simulation, e.g., at
+        the start of the region of interest. The simulation must have been
+        instantiated.
+        """
+        self._enter(SamplingPhase.FAST_FORWARD)
+
+    def _enter(self, phase: SamplingPhase) -> None:
+        """Switch the cores to a phase, skipping the empty phases."""
+        order = [
+            SamplingPhase.FAST_FORWARD,
+            SamplingPhase.WARMING,
+            SamplingPhase.DETAILED,
+        ]
+        while self._lengths[phase] == 0:
+            phase = order[(order.index(phase) + 1) % len(order)]
+
+        if phase == SamplingPhase.FAST_FORWARD:
+            self._processor.switch_to_fast_forward()
+        elif phase == SamplingPhase.WARMING:
+            self._processor.switch_to_warming()
+        else:
+            self._processor.switch_to_detailed()
+            m5.stats.reset()
+            self._sample_start_tick = m5.curTick()
+
+        self._phase = phase
+        core = self._processor.get_cores()[0].get_simobject()
+        core.scheduleInstStop(
+            0,
+            self._lengths[phase],
+            "a thread reached the max instruction count",
+        )
+
+    def _end_sample(self) -> None:
+        if self._dump_stats:
+            m5.stats.dump()
+
+        clock = self._board.get_clock_domain().clock[0].getValue()
+        cycles = (m5.curTick() - self._sample_start_tick) / clock
+        self._values["ipc"].append(
+            self._lengths[SamplingPhase.DETAILED] / cycles
+            if cycles
+            else float("nan")
+        )
+        for name, metric in self._metrics.items():
+            self._values[name].append(metric())
+
+    def max_insts_generator(self) -> Generator[Optional[bool], None, None]:
+        """
+        The generator handling the MAX_INSTS exit events, which end the
+        phases of the sampling. It yields True once all the samples have
+        been simulated.
+        """
+        while True:
+            if self._phase == SamplingPhase.IDLE:
+                warn("MAX_INSTS exit event received before sampling started.")
+                yield True
+                continue
+
+            if self._phase == SamplingPhase.FAST_FORWARD:
+                self._enter(SamplingPhase.WARMING)
+            elif self._phase == SamplingPhase.WARMING:
+                self._enter(SamplingPhase.DETAILED)
+            elif self._phase == SamplingPhase.DETAILED:
+                self._end_sample()
+                if (
+                    self._num_samples is not None
+                    and self.get_num_samples() >= self._num_samples
+                ):
+                    self._phase = SamplingPhase.DONE
+                    yield True
+                    continue
+                self._enter(SamplingPhase.FAST_FORWARD)
+            else:
+                yield True
+                continue
+            yield False
+
+    def get_samples(self) -> Dict[str, List[float]]:
+        """The values of the metrics over the samples."""
+        return {name: list(values) for name, values in self._values.items()}
+
+    def get_estimates(self) -> Dict[str, MetricEstimate]:
+        """The estimates of the metrics over the whole sampled run."""
+        return {
+            name: MetricEstimate(name, values)
+            for name, values in self._values.items()
+        }
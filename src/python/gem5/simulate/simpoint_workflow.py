@@ -0,0 +1,423 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+An end-to-end SimPoint workflow for SE workloads: profile the BBVs of the
+workload, pick the SimPoints with the built-in clustering, take one
+checkpoint per SimPoint in a single pass, simulate the SimPoint regions in
+parallel local gem5 processes, and aggregate their statistics with the
+SimPoint weights.
+
+Each simulation runs in its own gem5 process (started with
+`gem5.utils.multiprocessing`) in a subdirectory of the output directory:
+`profile`, `checkpoint`, and `region<N>` for each SimPoint. The boards are
+built by a user function, which is called with the phase of the workflow
+and must return a board without workload. As for any target of
+`gem5.utils.multiprocessing`, the function must be importable, i.e., it
+cannot be defined in the script run by gem5.
+
+Usage
+-----
+
+boards.py:
+
+```python
+def make_board(phase):
+    if phase == SimPointPhase.REGION:
+        cpu_type, cache_hierarchy = CPUTypes.O3, MyCacheHierarchy()
+    else:
+        cpu_type, cache_hierarchy = CPUTypes.ATOMIC, NoCache()
+    ...
+    return SimpleBoard(...)
+```
+
+run.py:
+
+```python
+from boards import make_board
+
+workflow = SimPointWorkflow(
+    board_factory=make_board,
+    binary=Resource("x86-print-this"),
+    arguments=["print this", "15000"],
+    simpoint_interval=1_000_000,
+    warmup_interval=1_000_000,
+)
+stats = workflow.run()
+print(stats["board.processor.cores.core.cpi"])
+```
+"""
+
+import os
+from enum import Enum
+from multiprocessing.connection import wait
+from pathlib import Path
+from typing import Callable, Dict, List, Optional
+
+import m5
+from m5.util import fatal, inform, warn
+
+from .exit_event import ExitEvent
+from .exit_event_generators import simpoints_save_checkpoint_generator
+from .simulator import Simulator
+from ..components.boards.abstract_board import AbstractBoard
+from ..resources.resource import AbstractResource
+from ..utils.multiprocessing import Process
+from ..utils.simpoint import SimPoint
+from ..utils.simpoint_clustering import (
+    SimPointSelection,
+    select_simpoints_from_file,
+)
+
+
+class SimPointPhase(Enum):
+    PROFILE = "profile"  # BBV profiling, needs an atomic CPU
+    CHECKPOINT = "checkpoint"  # Checkpointing of the SimPoints
+    REGION = "region"  # Detailed simulation of a SimPoint
+
+
+def read_text_stats(stats_path: Path) -> Dict[str, float]:
+    """
+    Read the numerical values of the first dump of a text stats file. The
+    rows of the distributions are read as their counts.
+    """
+    stats = {}
+    in_dump = False
+    with open(stats_path) as stats_file:
+        for line in stats_file:
+            if line.startswith("---------- Begin"):
+                in_dump = True
+                continue
+            if line.startswith("---------- End"):
+                break
+            fields = line.split()
+            if not in_dump or len(fields) < 2:
+                continue
+            try:
+                stats[fields[0]] = float(fields[1])
+            except ValueError:
+                pass
+    return stats
+
+
+def aggregate_stats(
+    region_stats: List[Dict[str, float]], weights: List[float]
+) -> Dict[str, float]:
+    """
+    Compute the weighted mean of the stats over the SimPoint regions, i.e.,
+    their estimate for an interval of the whole run. Stats missing from a
+    region (e.g., because they are zero and not printed) count as zero.
+
+    Counts and per-instruction rates (e.g., CPI, since all the regions
+    have the same number of instructions) are estimated exactly this way;
+    other ratios (e.g., IPC or miss rates) must be derived from the
+    aggregated counts instead.
+    """
+    total_weight = sum(weights)
+    aggregated = {}
+    for stats, weight in zip(region_stats, weights):
+        for name, value in stats.items():
+            aggregated[name] = (
+                aggregated.get(name, 0.0) + value * weight / total_weight
+            )
+    return aggregated
+
+
+def _run_phase(
+    phase: SimPointPhase,
+    board_factory: Callable[[SimPointPhase], AbstractBoard],
+    binary: AbstractResource,
+    arguments: List[str],
+    simpoint_interval: int,
+    checkpoint_dir: Path,
+    simpoint_paths: Optional[List[Path]] = None,
+    warmup_interval: int = 0,
+    warmup_insts: int = 0,
+) -> None:
+    """The body of the gem5 process running a phase of the workflow."""
+    board = board_factory(phase)
+
+    if phase == SimPointPhase.PROFILE:
+        cores = board.get_processor().get_cores()
+        core = cores[0].get_simobject()
+        if len(cores) > 1 or not hasattr(core, "addSimPointProbe"):
+            fatal("BBV profiling needs a board with a single atomic core.")
+        core.addSimPointProbe(simpoint_interval)
+        board.set_se_binary_workload(binary=binary, arguments=arguments)
+        Simulator(board=board).run()
+
+    elif phase == SimPointPhase.CHECKPOINT:
+        simpoint = SimPoint(
+            simpoint_interval=simpoint_interval,
+            simpoint_file_path=simpoint_paths[0],
+            weight_file_path=simpoint_paths[1],
+            warmup_interval=warmup_interval,
+        )
+        board.set_se_simpoint_workload(
+            binary=binary, arguments=arguments, simpoint=simpoint
+        )
+        Simulator(
+            board=board,
+            on_exit_event={
+                ExitEvent.SIMPOINT_BEGIN: simpoints_save_checkpoint_generator(
+                    checkpoint_dir, simpoint
+                )
+            },
+        ).run()
+
+    else:
+        board.set_se_binary_workload(
+            binary=binary, arguments=arguments, checkpoint=checkpoint_dir
+        )
+
+        def region_generator():
+            if warmup_insts:
+                m5.stats.reset()
+                simulator.schedule_max_insts(simpoint_interval)
+                yield False
+            m5.stats.dump()
+            yield True
+
+        simulator = Simulator(
+            board=board,
+            on_exit_event={ExitEvent.MAX_INSTS: region_generator()},
+        )
+        simulator.schedule_max_insts(warmup_insts or simpoint_interval)
+        simulator.run()
+
+
+class SimPointWorkflow:
+    """
+    Runs the SimPoint methodology on an SE workload, from the BBV profiling
+    to the weighted statistics of the SimPoints. The steps can be run one
+    by one (e.g., to reuse the SimPoints of a previous profiling), or all
+    together with `run()`.
+    """
+
+    def __init__(
+        self,
+        board_factory: Callable[[SimPointPhase], AbstractBoard],
+        binary: AbstractResource,
+        simpoint_interval: int,
+        arguments: List[str] = [],
+        warmup_interval: int = 0,
+        max_simpoints: int = 30,
+        processes: Optional[int] = None,
+        **clustering_args,
+    ) -> None:
+        """
+        :param board_factory: The function building the boards, called with
+        the phase of the workflow. It must be importable by the gem5
+        processes started by the workflow.
+        :param binary: The binary of the workload.
+        :param simpoint_interval: The length of the intervals, in
+        instructions.
+        :param arguments: The arguments of the workload.
+        :param warmup_interval: The number of instructions simulated in
+        detail before each SimPoint, to warm up the microarchitectural
+        state. They are not accounted in the stats.
+        :param max_simpoints: The maximum number of SimPoints.
+        :param processes: The maximum number of regions simulated in
+        parallel. By default, the number of host CPUs.
+        :param clustering_args: Other arguments of `select_simpoints`.
+        """
+        self._board_factory = board_factory
+        self._binary = binary
+        self._arguments = arguments
+        self._simpoint_interval = simpoint_interval
+        self._warmup_interval = warmup_interval
+        self._processes = processes or os.cpu_count()
+        self._clustering_args = dict(clustering_args, max_k=max_simpoints)
+
+        self._outdir = Path(m5.options.outdir).absolute()
+        self._bbv_path = self._outdir / "profile" / "simpoint.bb.gz"
+        self._simpoint_paths = [
+            self._outdir / "simpoint.simpt",
+            self._outdir / "simpoint.weight",
+        ]
+        self._checkpoint_dir = self._outdir / "checkpoint" / "cpts"
+
+    def _phase_args(self) -> List:
+        return [
+            self._board_factory,
+            self._binary,
+            self._arguments,
+            self._simpoint_interval,
+        ]
+
+    def _run_processes(self, processes: List[Process]) -> List[int]:
+        """
+        Run the processes, at most `self._processes` at a time, and return
+        their exit codes.
+        """
+        pending = list(processes)
+        running = []
+        while pending or running:
+            while pending and len(running) < self._processes:
+                process = pending.pop(0)
+                process.start()
+                running.append(process)
+            done = wait([process.sentinel for process in running])
+            for process in list(running):
+                if process.sentinel in done:
+                    process.join()
+                    running.remove(process)
+        return [process.exitcode for process in processes]
+
+    def _run_single(self, name: str, *args) -> None:
+        (exitcode,) = self._run_processes(
+            [Process(target=_run_phase, args=args, name=name)]
+        )
+        if exitcode != 0:
+            fatal(f"The {name} simulation failed, see {self._outdir / name}")
+
+    def profile(self) -> Path:
+        """Profile the BBVs of the workload, and return their file."""
+        inform("SimPoint workflow: profiling the BBVs")
+        self._run_single(
+            "profile",
+            SimPointPhase.PROFILE,
+            *self._phase_args(),
+            self._checkpoint_dir,
+        )
+        return self._bbv_path
+
+    def select(self) -> SimPointSelection:
+        """
+        Pick the SimPoints from the profiled BBVs, and write them (in the
+        SimPoint 3.2 format) to simpoint.simpt and simpoint.weight.
+        """
+        selection = select_simpoints_from_file(
+            self._bbv_path, **self._clustering_args
+        )
+        selection.write(*self._simpoint_paths)
+        inform(
+            f"SimPoint workflow: {len(selection.simpoints)} SimPoints "
+            f"picked from {len(selection.labels)} intervals"
+        )
+        return selection
+
+    def get_simpoint(self) -> SimPoint:
+        """The SimPoints picked, as used to checkpoint and restore them."""
+        return SimPoint(
+            simpoint_interval=self._simpoint_interval,
+            simpoint_file_path=self._simpoint_paths[0],
+            weight_file_path=self._simpoint_paths[1],
+            warmup_interval=self._warmup_interval,
+        )
+
+    def take_checkpoints(self) -> Path:
+        """
+        Take the checkpoints of all the SimPoints in a single run, and
+        return their directory.
+        """
+        inform("SimPoint workflow: taking the checkpoints")
+        self._checkpoint_dir.mkdir(parents=True, exist_ok=True)
+        self._run_single(
+            "checkpoint",
+            SimPointPhase.CHECKPOINT,
+            *self._phase_args(),
+            self._checkpoint_dir,
+            self._simpoint_paths,
+            self._warmup_interval,
+        )
+        return self._checkpoint_dir
+
+    def simulate_regions(self) -> List[Optional[Path]]:
+        """
+        Simulate the SimPoint regions in parallel, and return the stats
+        file of each region (None if its simulation failed).
+        """
+        warmups = self.get_simpoint().get_warmup_list()
+        inform(
+            f"SimPoint workflow: simulating {len(warmups)} regions, "
+            f"{self._processes} at a time"
+        )
+        processes = [
+            Process(
+                target=_run_phase,
+                args=[
+                    SimPointPhase.REGION,
+                    *self._phase_args(),
+                    self._checkpoint_dir / f"cpt.SimPoint{index}",
+                    None,
+                    0,
+                    warmup,
+                ],
+                name=f"region{index}",
+            )
+            for index, warmup in enumerate(warmups)
+        ]
+        stats_name = Path(m5.options.stats_file).name
+        stats_paths = []
+        for index, exitcode in enumerate(self._run_processes(processes)):
+            stats_path = self._outdir / f"region{index}" / stats_name
+            if exitcode != 0 or not stats_path.exists():
+                warn(f"The simulation of SimPoint region {index} failed.")
+                stats_path = None
+            stats_paths.append(stats_path)
+        return stats_paths
+
+    def aggregate(self, stats_paths: List[Optional[Path]]) -> Dict[str, float]:
+        """
+        Aggregate the stats of the regions with the SimPoint weights (see
+        `aggregate_stats`), and write them to simpoint_stats.txt. The
+        regions whose simulation failed are left out, and the weights of
+        the others are rescaled.
+        """
+        weights = self.get_simpoint().get_weight_list()
+        regions = [
+            (read_text_stats(path), weight)
+            for path, weight in zip(stats_paths, weights)
+            if path is not None
+        ]
+        if not regions:
+            fatal("No SimPoint region was simulated successfully.")
+        covered = sum(weight for _, weight in regions)
+        if len(regions) < len(weights):
+            warn(
+                f"The stats are estimated from {len(regions)} SimPoint "
+                f"regions out of {len(weights)}, covering "
+                f"{100 * covered / sum(weights):.1f}% of the run."
+            )
+
+        stats = aggregate_stats(*zip(*regions))
+        with open(self._outdir / "simpoint_stats.txt", "w") as stats_file:
+            stats_file.write(
+                f"# Estimated stats of a {self._simpoint_interval} "
+                f"instruction interval, weighted over {len(regions)} "
+                "SimPoint regions\n"
+            )
+            for name, value in stats.items():
+                stats_file.write(f"{name} {value:.12g}\n")
+        return stats
+
+    def run(self) -> Dict[str, float]:
+        """Run all the steps of the workflow, and return the stats."""
+        self.profile()
+        self.select()
+        self.take_checkpoints()
+        return self.aggregate(self.simulate_regions())
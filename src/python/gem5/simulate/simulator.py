@@ -45,6 +45,7 @@ from .exit_event_generators import (
     dump_stats_generator,
 )
 from .exit_event import ExitEvent
+from .sampler import Sampler
 from ..components.boards.abstract_board import AbstractBoard
 from ..components.processors.switchable_processor import SwitchableProcessor
 
@@ -225,6 +226,9 @@ class Simulator:
         self._last_exit_event = None
         self._exit_event_count = 0
 
+        self._sampler = None
+        self._start_sampling = False
+
         if checkpoint_path:
             warn(
                 "Setting the checkpoint path via the Simulator constructor is "
@@ -252,6 +256,34 @@ class Simulator:
             simpoint_start_insts, self._instantiated
         )
 
+    def schedule_sampling(self, sampler: Sampler, start: bool = True) -> None:
+        """
+        Run a sampled simulation: the MAX_INSTS exit events are handled by
+        the sampler, which switches the cores between the phases of the
+        sampling, and exits the run loop after the last sample.
+
+        If the simulation has not been instantiated yet, the prefetchers
+        of the caches are set to be trained during the warming phases.
+
+        :param sampler: The sampler driving the simulation.
+        :param start: Whether to start sampling now (or as soon as the
+        simulation is instantiated). Otherwise `sampler.start()` must be
+        called later, e.g., from the generator handling the WORKBEGIN exit
+        event.
+        """
+        self._sampler = sampler
+        self._on_exit_event = dict(self._on_exit_event)
+        self._on_exit_event[
+            ExitEvent.MAX_INSTS
+        ] = sampler.max_insts_generator()
+
+        if self._instantiated:
+            if start:
+                sampler.start()
+        else:
+            sampler.enable_prefetcher_warming()
+            self._start_sampling = start
+
     def schedule_max_insts(self, inst: int) -> None:
         """
         Schedule a MAX_INSTS exit event when any thread in any core reaches the
@@ -433,6 +465,9 @@ class Simulator:
             # any final things.
             self._board._post_instantiate()
 
+            if self._sampler and self._start_sampling:
+                self._sampler.start()
+
     def run(self, max_ticks: int = m5.MaxTick) -> None:
         """
         This function will start or continue the simulator run and handle exit
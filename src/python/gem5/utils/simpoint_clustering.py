@@ -0,0 +1,340 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Selection of SimPoints from the basic block vectors (BBVs) profiled by the
+SimPoint probe, as done by SimPoint 3.2: the BBVs are normalized, reduced
+with a random projection, and clustered with k-means, the number of
+clusters being the smallest one whose BIC score is close enough to the
+best score. The interval closest to the centroid of each cluster is the
+SimPoint of the cluster, and its weight is the fraction of the intervals
+in the cluster.
+
+This is implemented in pure Python, so that no external SimPoint binary
+(nor numpy) is needed; the clustering is deterministic for a given seed.
+"""
+
+import gzip
+import math
+import random
+from pathlib import Path
+from typing import Dict, List, Optional, Sequence, Tuple
+
+from m5.util import fatal
+
+from .simpoint import SimPoint
+
+Vector = List[float]
+
+
+def read_bbv_file(bbv_path: Path) -> List[Dict[int, int]]:
+    """
+    Read the BBVs written by the SimPoint probe (optionally gzipped), one
+    interval per line: `T:<bb id>:<count> :<bb id>:<count> ...`.
+
+    :returns: The BBV of each interval, as a map from the basic block ids
+    to their instruction counts.
+    """
+    bbv_path = Path(bbv_path)
+    opener = gzip.open if bbv_path.suffix == ".gz" else open
+    bbvs = []
+    with opener(bbv_path, "rt") as bbv_file:
+        for line in bbv_file:
+            if not line.startswith("T"):
+                continue
+            bbv = {}
+            for entry in line[1:].split():
+                _, bb, count = entry.split(":")
+                bbv[int(bb)] = int(count)
+            bbvs.append(bbv)
+    return bbvs
+
+
+def project_bbvs(
+    bbvs: Sequence[Dict[int, int]], dimensions: int = 15, seed: int = 493575226
+) -> List[Vector]:
+    """
+    Normalize each BBV (so that its counts sum to 1) and project it on
+    `dimensions` dimensions with a random matrix of values uniformly
+    distributed in [-1, 1]. The row of a basic block is drawn the first
+    time the basic block is seen.
+    """
+    rng = random.Random(seed)
+    rows = {}
+    points = []
+    for bbv in bbvs:
+        total = sum(bbv.values())
+        point = [0.0] * dimensions
+        for bb, count in sorted(bbv.items()):
+            row = rows.get(bb)
+            if row is None:
+                row = [rng.uniform(-1.0, 1.0) for _ in range(dimensions)]
+                rows[bb] = row
+            frac = count / total
+            for d in range(dimensions):
+                point[d] += frac * row[d]
+        points.append(point)
+    return points
+
+
+if hasattr(math, "dist"):
+
+    def _sq_dist(a: Vector, b: Vector) -> float:
+        return math.dist(a, b) ** 2
+
+else:
+
+    def _sq_dist(a: Vector, b: Vector) -> float:
+        return sum((x - y) * (x - y) for x, y in zip(a, b))
+
+
+def _nearest(point: Vector, centers: Sequence[Vector]) -> Tuple[int, float]:
+    best, best_dist = 0, math.inf
+    for c, center in enumerate(centers):
+        dist = _sq_dist(point, center)
+        if dist < best_dist:
+            best, best_dist = c, dist
+    return best, best_dist
+
+
+class Clustering:
+    """The result of a k-means clustering of the projected BBVs."""
+
+    def __init__(
+        self, points: Sequence[Vector], centers: List[Vector]
+    ) -> None:
+        self.centers = centers
+        self.labels = []
+        self.distortion = 0.0
+        for point in points:
+            label, dist = _nearest(point, centers)
+            self.labels.append(label)
+            self.distortion += dist
+        self.sizes = [0] * len(centers)
+        for label in self.labels:
+            self.sizes[label] += 1
+
+    def bic(self, num_points: int, dimensions: int) -> float:
+        """
+        The Bayesian Information Criterion of the clustering, modelling the
+        clusters as identical spherical gaussians (as in X-means).
+        """
+        k = len(self.centers)
+        n = num_points
+        if n <= k:
+            return -math.inf
+        variance = max(self.distortion / (dimensions * (n - k)), 1e-300)
+        log_likelihood = (
+            -n * dimensions / 2 * math.log(2 * math.pi * variance)
+            - dimensions * (n - k) / 2
+        )
+        for size in self.sizes:
+            if size:
+                log_likelihood += size * math.log(size / n)
+        num_params = (k - 1) + k * dimensions + 1
+        return log_likelihood - num_params / 2 * math.log(n)
+
+
+def kmeans(
+    points: Sequence[Vector],
+    k: int,
+    rng: random.Random,
+    max_iterations: int = 100,
+) -> Clustering:
+    """
+    Cluster the points with Lloyd's algorithm, seeded with k-means++.
+    Empty clusters are reseeded with the point farthest from its center.
+    """
+    k = min(k, len(points))
+    centers = [list(rng.choice(points))]
+    dists = [_sq_dist(p, centers[0]) for p in points]
+    while len(centers) < k:
+        total = sum(dists)
+        if total == 0:
+            # Fewer distinct points than clusters
+            break
+        target = rng.uniform(0, total)
+        for i, dist in enumerate(dists):
+            target -= dist
+            if target <= 0:
+                break
+        centers.append(list(points[i]))
+        dists = [min(d, _sq_dist(p, points[i])) for d, p in zip(dists, points)]
+
+    dimensions = len(points[0])
+    labels = None
+    for _ in range(max_iterations):
+        assignment = [_nearest(p, centers) for p in points]
+        new_labels = [label for label, _ in assignment]
+        if new_labels == labels:
+            break
+        labels = new_labels
+
+        sums = [[0.0] * dimensions for _ in centers]
+        counts = [0] * len(centers)
+        for point, label in zip(points, labels):
+            counts[label] += 1
+            acc = sums[label]
+            for d in range(dimensions):
+                acc[d] += point[d]
+        for c, count in enumerate(counts):
+            if count:
+                centers[c] = [s / count for s in sums[c]]
+            else:
+                far = max(range(len(points)), key=lambda i: assignment[i][1])
+                centers[c] = list(points[far])
+                assignment[far] = (c, 0.0)
+    return Clustering(points, centers)
+
+
+class SimPointSelection:
+    """
+    The SimPoints picked from a BBV profile: the index of the
+    representative interval of each cluster and the weight of the cluster.
+    """
+
+    def __init__(
+        self,
+        simpoints: List[int],
+        weights: List[float],
+        labels: List[int],
+        bic_scores: Dict[int, float],
+    ) -> None:
+        self.simpoints = simpoints
+        self.weights = weights
+        self.labels = labels
+        self.bic_scores = bic_scores
+
+    def write(self, simpoint_path: Path, weight_path: Path) -> None:
+        """
+        Write the SimPoints and their weights in the format of SimPoint 3.2
+        (`<interval> <cluster>` and `<weight> <cluster>` lines), as read by
+        `SimPoint`.
+        """
+        with open(simpoint_path, "w") as simpoint_file:
+            for cluster, simpoint in enumerate(self.simpoints):
+                simpoint_file.write(f"{simpoint} {cluster}\n")
+        with open(weight_path, "w") as weight_file:
+            for cluster, weight in enumerate(self.weights):
+                weight_file.write(f"{weight:.17g} {cluster}\n")
+
+    def to_simpoint(
+        self, simpoint_interval: int, warmup_interval: int = 0
+    ) -> SimPoint:
+        order = sorted(
+            range(len(self.simpoints)), key=self.simpoints.__getitem__
+        )
+        return SimPoint(
+            simpoint_interval=simpoint_interval,
+            simpoint_list=[self.simpoints[i] for i in order],
+            weight_list=[self.weights[i] for i in order],
+            warmup_interval=warmup_interval,
+        )
+
+
+def select_simpoints(
+    bbvs: Sequence[Dict[int, int]],
+    max_k: int = 30,
+    dimensions: int = 15,
+    bic_threshold: float = 0.9,
+    num_init_seeds: int = 5,
+    sample_size: Optional[int] = None,
+    seed: int = 493575226,
+) -> SimPointSelection:
+    """
+    Pick SimPoints from the BBVs of the intervals of a run.
+
+    :param max_k: The maximum number of clusters (SimPoints).
+    :param dimensions: The number of dimensions the BBVs are projected on.
+    :param bic_threshold: The number of clusters picked is the smallest one
+    whose BIC score is at least this fraction of the way from the worst to
+    the best score. The number of clusters is binary searched between 1 and
+    max_k, as SimPoint 3.2 does.
+    :param num_init_seeds: The number of k-means runs (with different
+    initial centers) for each number of clusters; the run with the lowest
+    distortion is kept.
+    :param sample_size: If given, the clusterings are computed on a random
+    sample of this many intervals, then all the intervals are assigned to
+    the nearest center. This bounds the cost on very long runs.
+    :param seed: The seed of the random projection and of the k-means
+    initializations.
+    """
+    if not bbvs:
+        fatal("No BBV to pick SimPoints from.")
+    if max_k < 1:
+        fatal("The maximum number of SimPoints must be at least 1.")
+
+    points = project_bbvs(bbvs, dimensions, seed)
+    rng = random.Random(seed)
+    sample = points
+    if sample_size is not None and sample_size < len(points):
+        sample = rng.sample(points, sample_size)
+
+    clusterings = {}
+    bic_scores = {}
+
+    def cluster(k: int) -> float:
+        if k not in clusterings:
+            runs = [kmeans(sample, k, rng) for _ in range(num_init_seeds)]
+            best = min(runs, key=lambda run: run.distortion)
+            clusterings[k] = best
+            bic_scores[k] = best.bic(len(sample), dimensions)
+        return bic_scores[k]
+
+    max_k = min(max_k, len(sample))
+    low, high = 1, max_k
+    worst, best = cluster(low), cluster(high)
+    target = worst + bic_threshold * (best - worst)
+    while low < high:
+        mid = (low + high) // 2
+        score = cluster(mid)
+        worst, best = min(worst, score), max(best, score)
+        target = worst + bic_threshold * (best - worst)
+        if score >= target:
+            high = mid
+        else:
+            low = mid + 1
+    # The bounds may have moved after the search passed a k, so pick the
+    # smallest k evaluated that reaches the final target
+    k = min(c for c, score in bic_scores.items() if score >= target)
+
+    result = Clustering(points, clusterings[k].centers)
+    simpoints, weights, cluster_ids = [], [], {}
+    for c, center in enumerate(result.centers):
+        if not result.sizes[c]:
+            continue
+        members = [i for i, label in enumerate(result.labels) if label == c]
+        closest = min(members, key=lambda i: _sq_dist(points[i], center))
+        cluster_ids[c] = len(simpoints)
+        simpoints.append(closest)
+        weights.append(result.sizes[c] / len(points))
+    labels = [cluster_ids[label] for label in result.labels]
+    return SimPointSelection(simpoints, weights, labels, bic_scores)
+
+
+def select_simpoints_from_file(bbv_path: Path, **kwargs) -> SimPointSelection:
+    """Pick SimPoints from a BBV file. See `select_simpoints`."""
+    return select_simpoints(read_bbv_file(bbv_path), **kwargs)
@@ -207,6 +207,14 @@ def parse_options():
         callback=_stats_help,
         help="Display documentation for available stat visitors",
     )
+    option(
+        "--event-profile",
+        metavar="PERIOD",
+        type="int",
+        default=0,
+        help="Profile the host time of one event out of PERIOD and dump "
+        "it to event_profile.txt along with the statistics",
+    )
 
     # Configuration Options
     group("Configuration Options")
@@ -275,6 +283,12 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-binary",
+        action="store_true",
+        help="Record debug output in a compact binary form, to be decoded "
+        "with util/decode_debug_trace.py",
+    )
     option(
         "--debug-ignore",
         metavar="EXPR",
@@ -502,6 +516,8 @@ def main():
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    if options.event_profile:
+        stats.enableEventProfile(options.event_profile)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -554,7 +570,7 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    trace.output(options.debug_file, options.debug_binary)
 
     for ignore in options.debug_ignore:
         _check_tracing()
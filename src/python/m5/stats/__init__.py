@@ -191,6 +191,26 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["bin", "bstats"])
+def _binaryFactory(fn, desc=True):
+    """Output stats in a compact binary format.
+
+    The schema of the stats is written once, and every dump only holds
+    the values that changed since the previous one. This keeps periodic
+    dumps small and fast to write. The file is designed to be
+    memory-mapped, and util/bstats.py reads it into pandas data frames.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+
+    Example:
+      bin://stats.bin?desc=False
+
+    """
+
+    return _m5.stats.initBinary(fn, desc)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -430,6 +450,9 @@ def dump(roots=None):
                 _dump_to_visitor(output, roots=all_roots)
                 output.end()
 
+    if new_dump and _m5.stats.eventProfileEnabled():
+        dumpEventProfile()
+
 
 def reset():
     """Reset all statistics to the base state"""
@@ -445,6 +468,38 @@ def reset():
 
     _m5.stats.processResetQueue()
 
+    if _m5.stats.eventProfileEnabled():
+        resetEventProfile()
+
+
+def enableEventProfile(period=128):
+    """Profile the host time spent processing events.
+
+    One event out of period on average is timed. The profile, aggregated
+    per event type and per object, is then dumped and reset along with
+    the statistics. Changing the period resets the profile.
+    """
+
+    _m5.stats.enableEventProfile(period)
+
+
+def disableEventProfile():
+    """Stop profiling events, the profile gathered so far is kept"""
+
+    _m5.stats.disableEventProfile()
+
+
+def resetEventProfile():
+    """Forget the events profiled so far"""
+
+    _m5.stats.resetEventProfile()
+
+
+def dumpEventProfile(filename="event_profile.txt"):
+    """Append the event profile to a file of the output directory"""
+
+    _m5.stats.dumpEventProfile(filename)
+
 
 flags = attrdict(
     {
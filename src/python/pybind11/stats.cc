@@ -41,7 +41,9 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include "base/output.hh"
 #include "base/statistics.hh"
+#include "base/stats/binary.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -49,6 +51,7 @@
 #include "base/stats/hdf5.hh"
 
 #endif
+#include "sim/event_profile.hh"
 #include "sim/stat_control.hh"
 #include "sim/stat_register.hh"
 
@@ -103,6 +106,14 @@ pythonReset()
 
 }
 
+static void
+dumpEventProfile(const std::string &filename)
+{
+    std::ostream &os = *simout.findOrCreate(filename)->stream();
+    event_profile::dump(os);
+    os.flush();
+}
+
 void
 pybind_init_stats(py::module_ &m_native)
 {
@@ -112,6 +123,7 @@ pybind_init_stats(py::module_ &m_native)
         .def("initSimStats", &statistics::initSimStats)
         .def("initText", &statistics::initText,
             py::return_value_policy::reference)
+        .def("initBinary", &statistics::initBinary)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
@@ -125,6 +137,11 @@ pybind_init_stats(py::module_ &m_native)
         .def("enable", &statistics::enable)
         .def("enabled", &statistics::enabled)
         .def("statsList", &statistics::statsList)
+        .def("enableEventProfile", &event_profile::enable)
+        .def("disableEventProfile", &event_profile::disable)
+        .def("eventProfileEnabled", &event_profile::enabled)
+        .def("resetEventProfile", &event_profile::reset)
+        .def("dumpEventProfile", &dumpEventProfile)
         ;
 
     py::class_<statistics::Output>(m, "Output")
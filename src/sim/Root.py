@@ -68,6 +68,11 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Calendar queues scale better than sorted lists when many events are
+    # scheduled at once; both service the events in the same order.
+    calendar_eventq = Param.Bool(False, "keep the scheduled events in "
+                                 "calendar queues rather than sorted lists")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
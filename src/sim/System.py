@@ -50,6 +50,10 @@ class MemoryMode(Enum):
     vals = ["invalid", "atomic", "timing", "atomic_noncaching"]
 
 
+class MemoryCheckpointFormat(Enum):
+    vals = ["gzip", "chunked", "mapped"]
+
+
 class System(SimObject):
     type = "System"
     cxx_header = "sim/system.hh"
@@ -105,6 +109,21 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # Checkpoints of the memory are chunked and compressed in parallel
+    # by default; the gzip format is the one of older versions of gem5.
+    # Mapped checkpoints are not compressed, they are mapped copy-on-write
+    # when restored, which is the fastest when restoring the same
+    # checkpoint many times. All the formats can be restored from,
+    # whatever the format chosen here.
+    memory_checkpoint_format = Param.MemoryCheckpointFormat(
+        "chunked", "Format of the checkpoints of the backing store"
+    )
+    memory_checkpoint_threads = Param.Unsigned(
+        0,
+        "Number of host threads compressing and decompressing chunked "
+        "memory checkpoints, 0 for one per host core",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_calendar.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+EventCalendar::EventCalendar()
+    : buckets(MinBuckets, nullptr), widthBits(10), _top(nullptr), _size(0)
+{
+}
+
+void
+EventCalendar::insert(Event *event)
+{
+    Event *&list = bucket(event->when());
+    list = Event::insertInList(event, list);
+
+    // An event of the same bin as the top is pushed on top of it
+    if (!_top || *event <= *_top)
+        _top = event;
+
+    if (++_size > 2 * buckets.size())
+        resize(2 * buckets.size());
+}
+
+void
+EventCalendar::remove(Event *event)
+{
+    if (!_top)
+        panic("event not found!");
+
+    Event *&list = bucket(event->when());
+    list = Event::removeFromList(event, list);
+
+    if (event == _top)
+        findTop(event->when());
+
+    if (--_size < buckets.size() / 2 && buckets.size() > MinBuckets)
+        resize(buckets.size() / 2);
+}
+
+Event *
+EventCalendar::pop()
+{
+    Event *event = _top;
+    assert(event);
+
+    Event *&list = bucket(event->when());
+    assert(list == event);
+    if (Event *next = event->nextInBin) {
+        // update the next bin pointer since it could be stale
+        next->nextBin = event->nextBin;
+        list = next;
+        _top = next;
+    } else {
+        list = event->nextBin;
+        findTop(event->when());
+    }
+
+    if (--_size < buckets.size() / 2 && buckets.size() > MinBuckets)
+        resize(buckets.size() / 2);
+
+    return event;
+}
+
+void
+EventCalendar::findTop(Tick from)
+{
+    const size_t mask = buckets.size() - 1;
+    size_t index = (from >> widthBits) & mask;
+    Tick window_end = ((from >> widthBits) + 1) << widthBits;
+
+    // Visit the windows in time order for a year. The first bucket
+    // whose earliest event falls in the window being visited holds the
+    // earliest event overall, as no event is earlier than from. A
+    // wrapping window end makes the scan fall through to the search.
+    for (size_t i = 0; i < buckets.size() && window_end > from; ++i) {
+        Event *list = buckets[index];
+        if (list && list->when() < window_end) {
+            _top = list;
+            return;
+        }
+        index = (index + 1) & mask;
+        window_end += Tick(1) << widthBits;
+    }
+
+    // The next event is more than a year away, look at every bucket
+    _top = nullptr;
+    for (Event *list : buckets) {
+        if (list && (!_top || *list < *_top))
+            _top = list;
+    }
+}
+
+std::vector<Event *>
+EventCalendar::bins() const
+{
+    std::vector<Event *> sorted;
+    sorted.reserve(_size);
+    for (Event *list : buckets) {
+        for (Event *bin = list; bin; bin = bin->nextBin)
+            sorted.push_back(bin);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Event *l, const Event *r) { return *l < *r; });
+    return sorted;
+}
+
+void
+EventCalendar::estimateWidth(const std::vector<Event *> &sorted)
+{
+    // Average spacing of the earliest bins, ignoring the gaps larger
+    // than twice the average so that a few far away events (e.g., the
+    // end of the simulation) do not stretch the windows.
+    const size_t samples = std::min(sorted.size(), WidthSamples);
+    Tick total = 0;
+    size_t gaps = 0;
+    for (size_t i = 1; i < samples; ++i) {
+        total += sorted[i]->when() - sorted[i - 1]->when();
+        ++gaps;
+    }
+    if (total == 0)
+        return;
+
+    const Tick limit = 2 * (total / gaps);
+    Tick kept_total = 0;
+    size_t kept_gaps = 0;
+    for (size_t i = 1; i < samples; ++i) {
+        const Tick gap = sorted[i]->when() - sorted[i - 1]->when();
+        if (gap <= limit) {
+            kept_total += gap;
+            ++kept_gaps;
+        }
+    }
+
+    // Aim for a few bins per window, i.e., about four times the spacing
+    const Tick spacing = std::max<Tick>(kept_total / kept_gaps, 1);
+    widthBits = std::min(ceilLog2(spacing) + 2, MaxWidthBits);
+}
+
+void
+EventCalendar::resize(size_t num_buckets)
+{
+    const std::vector<Event *> sorted = bins();
+    estimateWidth(sorted);
+
+    buckets.assign(num_buckets, nullptr);
+    std::vector<Event *> tails(num_buckets, nullptr);
+
+    // The bins are visited in order, so they are appended to the lists
+    for (Event *bin : sorted) {
+        const size_t index = (bin->when() >> widthBits) & (num_buckets - 1);
+        bin->nextBin = nullptr;
+        if (tails[index])
+            tails[index]->nextBin = bin;
+        else
+            buckets[index] = bin;
+        tails[index] = bin;
+    }
+
+    _top = sorted.empty() ? nullptr : sorted.front();
+}
+
+Event *
+EventCalendar::release()
+{
+    const std::vector<Event *> sorted = bins();
+    for (size_t i = 0; i < sorted.size(); ++i)
+        sorted[i]->nextBin = i + 1 < sorted.size() ? sorted[i + 1] : nullptr;
+
+    std::fill(buckets.begin(), buckets.end(), nullptr);
+    _top = nullptr;
+    _size = 0;
+
+    return sorted.empty() ? nullptr : sorted.front();
+}
+
+void
+EventCalendar::load(Event *list)
+{
+    assert(empty());
+
+    size_t size = 0;
+    for (Event *bin = list; bin; bin = bin->nextBin) {
+        for (Event *event = bin; event; event = event->nextInBin)
+            ++size;
+    }
+
+    // Let resize() distribute the bins: it collects them from the
+    // buckets, so hand the whole list over as the first bucket
+    buckets[0] = list;
+    _size = size;
+    size_t num_buckets = MinBuckets;
+    while (num_buckets < _size)
+        num_buckets *= 2;
+    resize(num_buckets);
+}
+
+} // namespace gem5
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Calendar queue backend of the EventQueue.
+ */
+
+#ifndef __SIM_EVENT_CALENDAR_HH__
+#define __SIM_EVENT_CALENDAR_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * Calendar queue (R. Brown, CACM 1988) holding the events of an
+ * EventQueue. Time is cut in windows of a power-of-two number of ticks,
+ * and window n is kept in bucket n modulo the number of buckets. Each
+ * bucket is a sorted list of bins, exactly like the list the EventQueue
+ * uses on its own: a bin gathers the events of the same time and
+ * priority in a LIFO stack. The service order is therefore the one of
+ * the list backend, while scheduling only walks the bins of one bucket.
+ *
+ * The number of buckets follows the number of events, and the window
+ * width is re-estimated from the spacing of the earliest events every
+ * time the calendar is resized.
+ */
+class EventCalendar
+{
+  public:
+    EventCalendar();
+
+    /** The earliest event, i.e., the top of the earliest bin. */
+    Event *top() const { return _top; }
+
+    bool empty() const { return _top == nullptr; }
+
+    /** Number of events in the calendar. */
+    size_t size() const { return _size; }
+
+    /** Number of buckets of the calendar. */
+    size_t numBuckets() const { return buckets.size(); }
+
+    void insert(Event *event);
+    void remove(Event *event);
+
+    /** Remove and return the earliest event. */
+    Event *pop();
+
+    /**
+     * Empty the calendar.
+     *
+     * @return Its events as a sorted list of bins, the format used by
+     *         the list backend of the EventQueue.
+     */
+    Event *release();
+
+    /**
+     * Take the events of a sorted list of bins, as returned by
+     * release(). The calendar must be empty.
+     */
+    void load(Event *list);
+
+    /** The tops of all the bins in service order. */
+    std::vector<Event *> bins() const;
+
+  private:
+    /** Smallest number of buckets. */
+    static constexpr size_t MinBuckets = 16;
+
+    /** Log2 of the largest window width. */
+    static constexpr int MaxWidthBits = 48;
+
+    /** Number of bins sampled to estimate the window width. */
+    static constexpr size_t WidthSamples = 64;
+
+    Event *&
+    bucket(Tick when)
+    {
+        return buckets[(when >> widthBits) & (buckets.size() - 1)];
+    }
+
+    /**
+     * Find the earliest event knowing that no event is earlier than
+     * from.
+     */
+    void findTop(Tick from);
+
+    /** Redistribute the events among num_buckets buckets. */
+    void resize(size_t num_buckets);
+
+    /** Estimate the window width from sorted bins. */
+    void estimateWidth(const std::vector<Event *> &sorted);
+
+    /** Sorted lists of bins, one per bucket. */
+    std::vector<Event *> buckets;
+
+    /** Log2 of the width of a window, in ticks. */
+    unsigned widthBits;
+
+    Event *_top;
+    size_t _size;
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENT_CALENDAR_HH__
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profile.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace event_profile
+{
+
+unsigned period = 0;
+thread_local int countdown = 0;
+
+namespace
+{
+
+/** Host time accumulated by the sampled events of one key. */
+struct Record
+{
+    uint64_t samples = 0;
+    uint64_t cycles = 0;
+};
+
+/** Event type and owning object of a sampled event. */
+typedef std::pair<std::string, std::string> Key;
+
+/** Samples of one simulation thread. */
+struct Table
+{
+    std::mutex lock;
+    std::map<Key, Record> records;
+};
+
+std::mutex tablesLock;
+/** Tables of all the threads that have sampled an event. */
+std::vector<std::unique_ptr<Table>> tables;
+
+/** Sampling period of the samples gathered since the last reset. */
+unsigned samplesPeriod = 1;
+
+thread_local Table *localTable = nullptr;
+thread_local uint64_t randomState = 0;
+
+/** Host time reference taken on reset, to calibrate the timestamps. */
+uint64_t resetStamp = 0;
+std::chrono::steady_clock::time_point resetTime;
+
+/** Cheap timestamp of the host, in an arbitrary constant rate unit. */
+inline uint64_t
+timestamp()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/** Number of events to skip before the next sample, period on average. */
+int
+nextCountdown()
+{
+    if (period <= 1)
+        return 1;
+
+    if (!randomState)
+        randomState = (uintptr_t)&randomState | 1;
+    // xorshift64
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return 1 + randomState % (2 * period - 1);
+}
+
+Table &
+getLocalTable()
+{
+    if (!localTable) {
+        std::lock_guard<std::mutex> guard(tablesLock);
+        tables.emplace_back(new Table);
+        localTable = tables.back().get();
+    }
+    return *localTable;
+}
+
+/**
+ * Name of the object owning an event: the name of the event without the
+ * suffix added by the event wrappers. Events which do not override
+ * Event::name() are named after their instance number, they are all
+ * gathered under a single anonymous owner.
+ */
+std::string
+ownerName(const Event *event)
+{
+    std::string name = event->name();
+    for (const std::string suffix :
+            {".wrapped_function_event", ".wrapped_event"}) {
+        if (name.size() > suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(),
+                         suffix) == 0) {
+            name.resize(name.size() - suffix.size());
+            return name;
+        }
+    }
+    if (name.compare(0, 6, "Event_") == 0)
+        return "(anonymous)";
+    return name;
+}
+
+/** Print one table of the profile, sorted by decreasing host time. */
+void
+dumpTable(std::ostream &os, const char *title,
+          const std::map<std::string, Record> &records,
+          double seconds_per_cycle, double total_seconds)
+{
+    std::vector<std::pair<std::string, Record>> sorted(
+        records.begin(), records.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto &a, const auto &b) {
+                  return a.second.cycles > b.second.cycles;
+              });
+
+    ccprintf(os, "\n%s\n", title);
+    ccprintf(os, "%12s %14s %8s  %s\n", "samples", "est. seconds", "share",
+             "name");
+    for (const auto &[name, record] : sorted) {
+        const double seconds = record.cycles * seconds_per_cycle *
+            samplesPeriod;
+        ccprintf(os, "%12d %14.6f %7.2f%%  %s\n", record.samples, seconds,
+                 total_seconds ? 100 * seconds / total_seconds : 0.0, name);
+    }
+}
+
+} // anonymous namespace
+
+void
+process(Event *event)
+{
+    countdown = nextCountdown();
+
+    // The event may delete itself when processed, its key is therefore
+    // looked up first.
+    Table &table = getLocalTable();
+    std::unique_lock<std::mutex> guard(table.lock);
+    Record &record = table.records[Key(event->description(),
+                                       ownerName(event))];
+    guard.unlock();
+
+    const uint64_t start = timestamp();
+    event->process();
+    const uint64_t cycles = timestamp() - start;
+
+    guard.lock();
+    ++record.samples;
+    record.cycles += cycles;
+}
+
+void
+enable(unsigned sample_period)
+{
+    sample_period = std::max(sample_period, 1u);
+    if (sample_period != samplesPeriod || !resetStamp)
+        reset();
+    period = samplesPeriod = sample_period;
+}
+
+void
+disable()
+{
+    period = 0;
+}
+
+void
+reset()
+{
+    std::lock_guard<std::mutex> guard(tablesLock);
+    for (auto &table : tables) {
+        // Records are zeroed rather than erased: a thread processing a
+        // sampled event holds a reference to its record.
+        std::lock_guard<std::mutex> table_guard(table->lock);
+        for (auto &entry : table->records)
+            entry.second = Record();
+    }
+    resetStamp = timestamp();
+    resetTime = std::chrono::steady_clock::now();
+}
+
+void
+dump(std::ostream &os)
+{
+    std::map<std::string, Record> types;
+    std::map<std::string, Record> owners;
+    uint64_t samples = 0;
+    uint64_t cycles = 0;
+    {
+        std::lock_guard<std::mutex> guard(tablesLock);
+        for (auto &table : tables) {
+            std::lock_guard<std::mutex> table_guard(table->lock);
+            for (const auto &[key, record] : table->records) {
+                for (Record *sum : {&types[key.first],
+                                    &owners[key.second]}) {
+                    sum->samples += record.samples;
+                    sum->cycles += record.cycles;
+                }
+                samples += record.samples;
+                cycles += record.cycles;
+            }
+        }
+    }
+
+    const double host_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - resetTime).count();
+    const uint64_t host_cycles = timestamp() - resetStamp;
+    const double seconds_per_cycle =
+        host_cycles ? host_seconds / host_cycles : 0.0;
+    const double event_seconds = cycles * seconds_per_cycle * samplesPeriod;
+
+    ccprintf(os, "\n---------- Begin Host Event Profile ----------\n");
+    ccprintf(os, "%-24s %14d  # Average number of events per sample\n",
+             "samplePeriod", samplesPeriod);
+    ccprintf(os, "%-24s %14d  # Number of events sampled\n",
+             "sampledEvents", samples);
+    ccprintf(os, "%-24s %14.6f  # Host seconds since the profile was "
+             "reset\n", "hostSeconds", host_seconds);
+    ccprintf(os, "%-24s %14.6f  # Estimated host seconds processing "
+             "events, summed over threads\n", "eventSeconds",
+             event_seconds);
+    dumpTable(os, "Per event type:", types, seconds_per_cycle,
+              event_seconds);
+    dumpTable(os, "Per object:", owners, seconds_per_cycle, event_seconds);
+    ccprintf(os, "\n---------- End Host Event Profile ----------\n");
+}
+
+} // namespace event_profile
+} // namespace gem5
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Sampling profiler of the host time spent processing events.
+ */
+
+#ifndef __SIM_EVENT_PROFILE_HH__
+#define __SIM_EVENT_PROFILE_HH__
+
+#include <ostream>
+
+#include "base/compiler.hh"
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * The event profile measures the host time spent in Event::process(),
+ * aggregated per event type (Event::description()) and per owning
+ * object (Event::name() without the suffix of the event wrappers).
+ *
+ * Only one event out of samplePeriod() on average is timed, with the
+ * time stamp counter of the host when there is one, so that the
+ * profile can stay enabled for a whole run. The distance between two
+ * sampled events is randomized around the period, so that events
+ * occurring periodically are not systematically missed or sampled.
+ *
+ * Each simulation thread gathers its samples on its own; reset() and
+ * dump() must be called while the simulation is stopped.
+ */
+namespace event_profile
+{
+
+/** Sampling period of the events, 0 when the profile is disabled. */
+extern unsigned period;
+
+/** Number of events left before the next sampled one, per thread. */
+extern thread_local int countdown;
+
+/**
+ * Whether the next event serviced by this thread must be sampled. This
+ * is tested for every event, it therefore only touches two variables.
+ */
+static inline bool
+sampleNext()
+{
+    return GEM5_UNLIKELY(period != 0) && --countdown <= 0;
+}
+
+/** Process an event and account for the host time it took. */
+void process(Event *event);
+
+/**
+ * Enable the profile.
+ *
+ * @param sample_period Average number of events per sample.
+ */
+void enable(unsigned sample_period);
+
+/** Disable the profile, the samples taken so far are kept. */
+void disable();
+
+/** Whether the profile is enabled. */
+static inline bool enabled() { return period != 0; }
+
+/** Forget every sample and restart the host time reference. */
+void reset();
+
+/**
+ * Print the profile gathered since the last reset, as a table per event
+ * type and a table per object sorted by decreasing host time.
+ */
+void dump(std::ostream &os);
+
+} // namespace event_profile
+} // namespace gem5
+
+#endif // __SIM_EVENT_PROFILE_HH__
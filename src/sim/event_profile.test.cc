@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "sim/event_profile.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Service the events of a queue scheduled by a few objects. */
+std::string
+runProfile(unsigned period)
+{
+    EventQueue eq("test_queue");
+    EventFunctionWrapper cpu([]() {}, "system.cpu");
+    EventFunctionWrapper mem([]() {}, "system.mem_ctrl");
+
+    event_profile::enable(period);
+    event_profile::reset();
+    for (Tick when = 1; when <= 100; when++) {
+        eq.schedule(&cpu, when);
+        eq.schedule(&mem, when);
+        eq.serviceOne();
+        eq.serviceOne();
+    }
+    event_profile::disable();
+
+    std::ostringstream os;
+    event_profile::dump(os);
+    return os.str();
+}
+
+} // anonymous namespace
+
+/** Sampling every event accounts for all of them. */
+TEST(EventProfileTest, EveryEvent)
+{
+    const std::string profile = runProfile(1);
+
+    EXPECT_NE(profile.find("sampledEvents"), std::string::npos);
+    EXPECT_NE(profile.find("200  # Number of events sampled"),
+              std::string::npos);
+    EXPECT_NE(profile.find("         100 "), std::string::npos);
+    EXPECT_NE(profile.find("  EventFunctionWrapped\n"), std::string::npos);
+    EXPECT_NE(profile.find("  system.cpu\n"), std::string::npos);
+    EXPECT_NE(profile.find("  system.mem_ctrl\n"), std::string::npos);
+    EXPECT_EQ(profile.find("wrapped_function_event"), std::string::npos);
+}
+
+/** Only a fraction of the events is sampled with a longer period. */
+TEST(EventProfileTest, Sampled)
+{
+    const std::string profile = runProfile(10);
+
+    std::istringstream is(profile.substr(profile.find("sampledEvents")));
+    std::string name;
+    unsigned samples;
+    is >> name >> samples;
+    EXPECT_GT(samples, 0);
+    EXPECT_LT(samples, 100);
+}
+
+/** Events are not sampled while the profile is disabled. */
+TEST(EventProfileTest, Disabled)
+{
+    EXPECT_FALSE(event_profile::enabled());
+    for (int i = 0; i < 10; i++)
+        EXPECT_FALSE(event_profile::sampleNext());
+
+    // Every event is sampled once the countdown of the previous period
+    // has elapsed.
+    event_profile::enable(1);
+    EXPECT_TRUE(event_profile::enabled());
+    bool sampled = false;
+    for (int i = 0; i < 100 && !sampled; i++)
+        sampled = event_profile::sampleNext();
+    EXPECT_TRUE(sampled);
+    EXPECT_TRUE(event_profile::sampleNext());
+    event_profile::disable();
+}
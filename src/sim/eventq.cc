@@ -41,6 +41,7 @@
 #include "base/trace.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/event_profile.hh"
 
 namespace gem5
 {
@@ -57,6 +58,7 @@ uint32_t numMainEventQueues = 0;
 std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+bool useEventCalendar = false;
 
 EventQueue *
 getEventQueue(uint32_t index)
@@ -108,14 +110,12 @@ Event::insertBefore(Event *event, Event *curr)
     return event;
 }
 
-void
-EventQueue::insert(Event *event)
+Event *
+Event::insertInList(Event *event, Event *head)
 {
     // Deal with the head case
-    if (!head || *event <= *head) {
-        head = Event::insertBefore(event, head);
-        return;
-    }
+    if (!head || *event <= *head)
+        return insertBefore(event, head);
 
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
@@ -128,7 +128,19 @@ EventQueue::insert(Event *event)
 
     // Note: this operation may render all nextBin pointers on the
     // prev 'in bin' list stale (except for the top one)
-    prev->nextBin = Event::insertBefore(event, curr);
+    prev->nextBin = insertBefore(event, curr);
+    return head;
+}
+
+void
+EventQueue::insert(Event *event)
+{
+    if (calendar) {
+        calendar->insert(event);
+        head = calendar->top();
+    } else {
+        head = Event::insertInList(event, head);
+    }
 }
 
 Event *
@@ -162,20 +174,16 @@ Event::removeItem(Event *event, Event *top)
     return top;
 }
 
-void
-EventQueue::remove(Event *event)
+Event *
+Event::removeFromList(Event *event, Event *head)
 {
     if (head == NULL)
         panic("event not found!");
 
-    assert(event->queue == this);
-
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
-    if (*head == *event) {
-        head = Event::removeItem(event, head);
-        return;
-    }
+    if (*head == *event)
+        return removeItem(event, head);
 
     // Find the 'in bin' list that this event belongs on
     Event *prev = head;
@@ -191,7 +199,21 @@ EventQueue::remove(Event *event)
     // curr points to the top item of the the correct 'in bin' list, when
     // we remove an item, it returns the new top item (which may be
     // unchanged)
-    prev->nextBin = Event::removeItem(event, curr);
+    prev->nextBin = removeItem(event, curr);
+    return head;
+}
+
+void
+EventQueue::remove(Event *event)
+{
+    assert(event->queue == this);
+
+    if (calendar) {
+        calendar->remove(event);
+        head = calendar->top();
+    } else {
+        head = Event::removeFromList(event, head);
+    }
 }
 
 Event *
@@ -202,7 +224,10 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (calendar) {
+        calendar->pop();
+        head = calendar->top();
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -220,7 +245,10 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (event_profile::sampleNext())
+            event_profile::process(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -295,15 +323,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
-            Event *nextInBin = nextBin;
+        for (Event *bin : bins()) {
+            Event *nextInBin = bin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -318,9 +343,8 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
-        Event *nextInBin = nextBin;
+    for (Event *bin : bins()) {
+        Event *nextInBin = bin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
                 cprintf("time goes backwards!");
@@ -345,21 +369,56 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::bins() const
+{
+    if (calendar)
+        return calendar->bins();
+
+    std::vector<Event *> list;
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        list.push_back(bin);
+    return list;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    if (calendar) {
+        // Hand the events over in, and take them back from, the list
+        // format so that callers need not know about the backend
+        Event *t = calendar->release();
+        calendar->load(s);
+        head = calendar->top();
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
 }
 
+void
+EventQueue::useCalendar(bool enable)
+{
+    if (enable == usesCalendar())
+        return;
+
+    if (enable) {
+        calendar = std::make_unique<EventCalendar>();
+        calendar->load(head);
+        head = calendar->top();
+    } else {
+        head = calendar->release();
+        calendar.reset();
+    }
+}
+
 void
 dumpMainQueue()
 {
@@ -416,30 +475,43 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), asyncHead(nullptr)
 {
+    useCalendar(useEventCalendar);
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    Event *next = asyncHead.load(std::memory_order_relaxed);
+    do {
+        event->nextBin = next;
+    } while (!asyncHead.compare_exchange_weak(next, event,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    // Take all the posted events at once, and insert them in the order
+    // they have been posted
+    Event *posted = asyncHead.exchange(nullptr, std::memory_order_acquire);
+    Event *fifo = nullptr;
+    while (posted) {
+        Event *next = posted->nextBin;
+        posted->nextBin = fifo;
+        fifo = posted;
+        posted = next;
     }
 
-    async_queue_mutex.unlock();
+    while (fifo) {
+        Event *next = fifo->nextBin;
+        insert(fifo);
+        fifo = next;
+    }
 }
 
 } // namespace gem5
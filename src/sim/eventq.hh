@@ -36,6 +36,7 @@
 #define __SIM_EVENTQ_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <functional>
@@ -43,6 +44,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
@@ -50,6 +52,7 @@
 #include "base/uncontended_mutex.hh"
 #include "debug/Event.hh"
 #include "sim/cur_tick.hh"
+#include "sim/event_calendar.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
@@ -79,6 +82,10 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+//! Whether new event queues keep their events in a calendar queue
+//! rather than in a sorted list.
+extern bool useEventCalendar;
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -251,6 +258,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventCalendar;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -268,6 +276,11 @@ class Event : public EventBase, public Serializable
     static Event *insertBefore(Event *event, Event *curr);
     static Event *removeItem(Event *event, Event *last);
 
+    //! Insert / remove an event in the list of bins starting at head,
+    //! returning the new head of the list.
+    static Event *insertInList(Event *event, Event *head);
+    static Event *removeFromList(Event *event, Event *head);
+
     Tick _when;         //!< timestamp when event should be processed
     Priority _priority; //!< event priority
     Flags flags;
@@ -612,7 +625,7 @@ operator!=(const Event &l, const Event &r)
  * schedule() method with the 'global' parameter set to true. Unlike
  * the previous queue migration strategy, this strategy is fully
  * deterministic. This causes the event to be inserted in a separate
- * queue of asynchronous events (async_queue), which is merged main
+ * queue of asynchronous events (asyncHead), which is merged main
  * event queue at the end of each simulation quantum (by calling the
  * handleAsyncInsertions() method). Note that this implies that such
  * events must happen at least one simulation quantum into the future,
@@ -628,11 +641,15 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    UncontendedMutex async_queue_mutex;
+    //! Calendar holding the events, if any, in which case head mirrors
+    //! its earliest event. The events are in the list at head otherwise.
+    std::unique_ptr<EventCalendar> calendar;
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    //! Events added by other threads to this event queue, most recent
+    //! first. The events are linked through their nextBin pointer, which
+    //! is free until they are inserted, so that other threads can post
+    //! events without locking.
+    std::atomic<Event *> asyncHead;
 
     /**
      * Lock protecting event handling.
@@ -668,6 +685,9 @@ class EventQueue
 
     EventQueue(const EventQueue &);
 
+    //! The tops of the bins of scheduled events, in service order.
+    std::vector<Event *> bins() const;
+
   public:
     class ScopedMigration
     {
@@ -755,6 +775,15 @@ class EventQueue
     void name(const std::string &st) { objName = st; }
     /** @}*/ //end of api_eventq group
 
+    /**
+     * Select the backend keeping the scheduled events: a calendar
+     * queue, or a sorted list of bins. Both service the events in the
+     * same order, the calendar scales better with the number of
+     * scheduled events. Events already scheduled are moved over.
+     */
+    void useCalendar(bool enable);
+    bool usesCalendar() const { return calendar != nullptr; }
+
     /**
      * Schedule the given event on this queue. Safe to call from any thread.
      *
@@ -908,7 +937,7 @@ class EventQueue
     bool debugVerify() const;
 
     /**
-     * Function for moving events from the async_queue to the main queue.
+     * Function for moving events posted by other threads to the main queue.
      */
     void handleAsyncInsertions();
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Events serviced by a queue, as (event index, tick) pairs. */
+typedef std::vector<std::pair<int, Tick>> Trace;
+
+/**
+ * Drive an event queue with a random mix of schedule, deschedule,
+ * reschedule and service operations, and record the service order.
+ * The operations only depend on the seed and on the state of the
+ * events, so two queues servicing events in the same order see the
+ * same operations.
+ */
+Trace
+runScenario(bool calendar, unsigned seed, Tick max_delay)
+{
+    EventQueue eq("test_queue");
+    eq.useCalendar(calendar);
+
+    Trace trace;
+    std::vector<std::unique_ptr<EventFunctionWrapper>> events;
+    for (int i = 0; i < 300; i++) {
+        events.emplace_back(new EventFunctionWrapper(
+            [&trace, &eq, i]() {
+                trace.emplace_back(i, eq.getCurTick());
+            }, "event", false, Event::Priority(i % 5 - 2)));
+    }
+
+    std::mt19937 rng(seed);
+    for (int op = 0; op < 50000; op++) {
+        Event *event = events[rng() % events.size()].get();
+        // Many events share a few ticks to fill the bins
+        const Tick delay = rng() % 4 == 0 ? rng() % 4 : rng() % max_delay;
+        switch (rng() % 4) {
+          case 0:
+            if (!event->scheduled())
+                eq.schedule(event, eq.getCurTick() + delay);
+            break;
+          case 1:
+            if (event->scheduled())
+                eq.deschedule(event);
+            break;
+          case 2:
+            eq.reschedule(event, eq.getCurTick() + delay, true);
+            break;
+          case 3:
+            if (!eq.empty())
+                eq.serviceOne();
+            break;
+        }
+    }
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    return trace;
+}
+
+} // anonymous namespace
+
+/** The calendar services the events like the list, bins included. */
+TEST(EventQueueTest, CalendarMatchesList)
+{
+    for (Tick max_delay : {Tick(8), Tick(1000), Tick(1) << 40}) {
+        const Trace list = runScenario(false, 1, max_delay);
+        const Trace calendar = runScenario(true, 1, max_delay);
+        ASSERT_GT(list.size(), 1000);
+        EXPECT_EQ(list, calendar) << "max_delay " << max_delay;
+    }
+}
+
+/** Switching backend and replacing the head keep the scheduled events. */
+TEST(EventQueueTest, SwitchBackend)
+{
+    EventQueue eq("test_queue");
+    std::vector<int> order;
+    std::vector<std::unique_ptr<EventFunctionWrapper>> events;
+    for (int i = 0; i < 100; i++) {
+        events.emplace_back(new EventFunctionWrapper(
+            [&order, i]() { order.push_back(i); }, "event"));
+        eq.schedule(events.back().get(), 1000 - 10 * (i / 2));
+    }
+
+    eq.useCalendar(true);
+    EXPECT_TRUE(eq.usesCalendar());
+    EXPECT_TRUE(eq.debugVerify());
+
+    Event *saved = eq.replaceHead(nullptr);
+    EXPECT_TRUE(eq.empty());
+    eq.replaceHead(saved);
+    EXPECT_EQ(eq.nextTick(), 510);
+
+    eq.useCalendar(false);
+    EXPECT_TRUE(eq.debugVerify());
+    eq.useCalendar(true);
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    // Later ticks first scheduled, bins serviced in LIFO order
+    std::vector<int> expected;
+    for (int i = 99; i >= 0; i -= 2) {
+        expected.push_back(i);
+        expected.push_back(i - 1);
+    }
+    EXPECT_EQ(order, expected);
+}
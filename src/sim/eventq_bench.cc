@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Event throughput of the list and calendar backends of the EventQueue.
+ *
+ * The workload mimics a system of clocked objects: every object has a
+ * clock event rescheduling itself one period later, periods differing
+ * from object to object, and from time to time schedules a one-shot
+ * event a random number of cycles away (e.g., a memory response).
+ *
+ * Usage: eventqbench [events per run]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class ClockedThing
+{
+  public:
+    ClockedThing(EventQueue &_eq, Tick _period, unsigned seed)
+        : eq(_eq), period(_period), rng(seed),
+          clockEvent([this]() { tick(); }, "clock"),
+          responseEvent([]() {}, "response", false, Event::CPU_Tick_Pri)
+    {
+        eq.schedule(&clockEvent, period);
+    }
+
+    ~ClockedThing()
+    {
+        if (clockEvent.scheduled())
+            eq.deschedule(&clockEvent);
+        if (responseEvent.scheduled())
+            eq.deschedule(&responseEvent);
+    }
+
+  private:
+    void
+    tick()
+    {
+        const Tick now = eq.getCurTick();
+        eq.schedule(&clockEvent, now + period);
+        if (!responseEvent.scheduled() && rng() % 8 == 0)
+            eq.schedule(&responseEvent, now + period * (1 + rng() % 200));
+    }
+
+    EventQueue &eq;
+    const Tick period;
+    std::mt19937 rng;
+    EventFunctionWrapper clockEvent;
+    EventFunctionWrapper responseEvent;
+};
+
+double
+eventsPerSecond(bool calendar, int num_objects, uint64_t num_events)
+{
+    EventQueue eq("bench_queue");
+    eq.useCalendar(calendar);
+
+    std::vector<std::unique_ptr<ClockedThing>> objects;
+    for (int i = 0; i < num_objects; i++) {
+        // Clocks between 500MHz and 4GHz, on a 1ps tick
+        const Tick period = 250 + 250 * (i % 8);
+        objects.emplace_back(new ClockedThing(eq, period, i));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < num_events; i++)
+        eq.serviceOne();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return num_events / elapsed.count();
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const uint64_t num_events = argc > 1 ? std::atoll(argv[1]) : 10000000;
+
+    cprintf("%8s %16s %16s %8s\n",
+            "objects", "list (Mev/s)", "calendar (Mev/s)", "speedup");
+    for (int num_objects : {4, 16, 64, 256, 1024, 4096}) {
+        const double list = eventsPerSecond(false, num_objects, num_events);
+        const double calendar =
+            eventsPerSecond(true, num_objects, num_events);
+        cprintf("%8d %16.2f %16.2f %8.2f\n",
+                num_objects, list / 1e6, calendar / 1e6, calendar / list);
+    }
+
+    return 0;
+}
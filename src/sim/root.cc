@@ -188,6 +188,10 @@ Root::Root(const RootParams &p, int)
 
     simQuantum = p.sim_quantum;
 
+    useEventCalendar = p.calendar_eventq;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->useCalendar(useEventCalendar);
+
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
     // having a single global stat group for global stats. Merge that
@@ -167,6 +167,21 @@ class SimulatorThreads
 
 static std::unique_ptr<SimulatorThreads> simulatorThreads;
 
+/** Smallest lookahead declared by a link between event queues. */
+static Tick minLookahead = MaxTick;
+static std::string minLookaheadLink;
+
+void
+declareLookahead(const std::string &name, Tick lookahead)
+{
+    fatal_if(lookahead == 0, "%s: a link between event queues needs a "
+             "latency.", name);
+    if (lookahead < minLookahead) {
+        minLookahead = lookahead;
+        minLookaheadLink = name;
+    }
+}
+
 struct DescheduleDeleter
 {
     void operator()(BaseGlobalEvent *event)
@@ -213,6 +228,18 @@ simulate(Tick num_cycles)
     }
 
     if (numMainEventQueues > 1) {
+        // The queues can run as far apart as the shortest link between
+        // them allows, so derive the quantum from the links if none is
+        // given, and keep it within their lookahead otherwise
+        if (simQuantum == 0 && minLookahead != MaxTick) {
+            inform("Synchronizing event queues every %d ticks, the "
+                   "lookahead of %s.\n", minLookahead, minLookaheadLink);
+            simQuantum = minLookahead;
+        } else if (simQuantum > minLookahead) {
+            warn("Quantum of %d ticks reduced to the lookahead of %s, %d "
+                 "ticks.\n", simQuantum, minLookaheadLink, minLookahead);
+            simQuantum = minLookahead;
+        }
         fatal_if(simQuantum == 0,
                  "Quantum for multi-eventq simulation not specified");
 
@@ -38,6 +38,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <string>
+
 #include "base/types.hh"
 
 namespace gem5
@@ -75,6 +77,19 @@ Tick get_max_tick();
  */
 void terminateEventQueueThreads();
 
+/**
+ * Declare a link carrying timing traffic from one event queue to
+ * another, i.e., between two threads of a parallel simulation. Events
+ * posted over the link are at least lookahead ticks in the future of the
+ * sending queue, so the queues may run that far apart. Unless a quantum
+ * is given (Root.sim_quantum), simulate() synchronizes the event queues
+ * every smallest declared lookahead.
+ *
+ * @param name Name of the link, for diagnostics.
+ * @param lookahead Smallest latency of the link, in ticks.
+ */
+void declareLookahead(const std::string &name, Tick lookahead);
+
 extern GlobalSimLoopExitEvent *simulate_limit_event;
 
 } // namespace gem5
@@ -54,6 +54,7 @@
 #include "cpu/pc_event.hh"
 #include "enums/MemoryMode.hh"
 #include "mem/mem_requestor.hh"
+#include "mem/mem_telemetry.hh"
 #include "mem/physical.hh"
 #include "mem/port.hh"
 #include "mem/port_proxy.hh"
@@ -345,6 +346,10 @@ class System : public SimObject, public PCEventScope
     memory::PhysicalMemory& getPhysMem() { return physmem; }
     const memory::PhysicalMemory& getPhysMem() const { return physmem; }
 
+    /** Get the telemetry table the memory system publishes to */
+    MemTelemetry& getMemTelemetry() { return memTelemetry; }
+    const MemTelemetry& getMemTelemetry() const { return memTelemetry; }
+
     /** Amount of physical memory that exists */
     Addr memSize() const;
 
@@ -404,6 +409,8 @@ class System : public SimObject, public PCEventScope
 
     memory::PhysicalMemory physmem;
 
+    MemTelemetry memTelemetry;
+
     AddrRangeList ShadowRomRanges;
 
     enums::MemoryMode memoryMode;
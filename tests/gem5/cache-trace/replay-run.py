@@ -0,0 +1,207 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Replay a small synthetic cache trace through CacheTraceReplayer and check
+its hits, misses and evictions, and the misses of Belady's MIN, against a
+model of the replay written in Python.
+
+With LRU the trace loops over blocks that fit in the cache and then makes
+random accesses, and every count must match the model. With Hawkeye only
+the loop is replayed: as the fills train the policy, every way is used and
+only the first pass of the loop misses.
+"""
+
+import argparse
+import gzip
+import os
+import random
+import struct
+import sys
+
+import m5
+import _m5.stats
+from m5.objects import *
+
+parser = argparse.ArgumentParser(description="Check a cache trace replay")
+parser.add_argument(
+    "--repl",
+    choices=["lru", "hawkeye"],
+    default="lru",
+    help="Replacement policy of the replayed cache",
+)
+
+args = parser.parse_args()
+
+block_size = 64
+num_sets = 64
+assoc = 4
+
+# Layout of CacheTraceHeader and CacheTraceRecord, in host byte order
+header_format = "=QII"
+record_format = "=QQiBBH"
+trace_magic = 0x4543415254354D47
+trace_version = 1
+# MemCmd::ReadReq
+read_req = 1
+# CacheTraceRecord::HasPC | CacheTraceRecord::HasContext
+record_flags = 0x2 | 0x4
+
+
+def make_trace():
+    # Every set gets assoc blocks, accessed eight times in a row
+    blocks = [
+        way * num_sets + s for way in range(assoc) for s in range(num_sets)
+    ]
+    trace = blocks * 8
+    if args.repl == "lru":
+        # Twice as many blocks as the cache holds, so that the accesses
+        # both hit and evict
+        rng = random.Random(5)
+        trace += [rng.randrange(2 * assoc * num_sets) for _ in range(4000)]
+    return trace
+
+
+def write_trace(path, trace):
+    with gzip.open(path, "wb") as f:
+        f.write(
+            struct.pack(header_format, trace_magic, trace_version, block_size)
+        )
+        for i, block in enumerate(trace):
+            f.write(
+                struct.pack(
+                    record_format,
+                    block * block_size,
+                    0x400 + 4 * (i % 7),
+                    0,
+                    read_req,
+                    record_flags,
+                    0,
+                )
+            )
+
+
+def model_lru(trace):
+    """BaseSetAssoc with LRU, each access one tick after the previous one"""
+    # Block and last touch tick of every way, a never touched way is
+    # invalid and has a tick of 0
+    sets = [[[None, 0] for _ in range(assoc)] for _ in range(num_sets)]
+    hits = evictions = 0
+    for tick, block in enumerate(trace, 1):
+        ways = sets[block % num_sets]
+        way = next((w for w in ways if w[0] == block), None)
+        if way is not None:
+            hits += 1
+        else:
+            way = min(ways, key=lambda w: w[1])
+            if way[0] is not None:
+                evictions += 1
+            way[0] = block
+        way[1] = tick
+    return len(trace) - hits, evictions
+
+
+def model_belady(trace):
+    """countBeladyMisses(): allocate on every miss, evict the furthest use"""
+    never = len(trace)
+    next_use = [never] * len(trace)
+    last_seen = {}
+    for i in reversed(range(len(trace))):
+        next_use[i] = last_seen.get(trace[i], never)
+        last_seen[trace[i]] = i
+
+    sets = [{} for _ in range(num_sets)]
+    misses = 0
+    for i, block in enumerate(trace):
+        lines = sets[block % num_sets]
+        if block not in lines:
+            misses += 1
+            if len(lines) == assoc:
+                del lines[max(lines, key=lines.get)]
+        lines[block] = next_use[i]
+    return misses
+
+
+trace = make_trace()
+trace_file = os.path.join(m5.options.outdir, "replay.trc.gz")
+write_trace(trace_file, trace)
+
+if args.repl == "hawkeye":
+    repl = HawkeyeRP(
+        num_cache_sets=num_sets,
+        num_cache_ways=assoc,
+        num_sampled_sets=num_sets,
+        cache_level=2,
+    )
+else:
+    repl = LRURP()
+
+system = System(cache_line_size=block_size)
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=VoltageDomain()
+)
+system.replayer = CacheTraceReplayer(
+    trace_file=trace_file,
+    size=f"{num_sets * assoc * block_size}B",
+    assoc=assoc,
+    replacement_policy=repl,
+    tags=BaseSetAssoc(),
+)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+system.replayer.getCCObject().run()
+m5.stats.dump()
+
+stats = {}
+for stat in system.replayer.getStats():
+    stat.prepare()
+    if isinstance(stat, _m5.stats.ScalarInfo):
+        stats[stat.name] = stat.value
+
+if args.repl == "lru":
+    misses, evictions = model_lru(trace)
+else:
+    misses, evictions = assoc * num_sets, 0
+expected = {
+    "accesses": len(trace),
+    "misses": misses,
+    "evictions": evictions,
+    "optMisses": model_belady(trace),
+}
+
+failures = 0
+for name, value in expected.items():
+    print(f"{name}: replayed {int(stats[name])}, expected {value}")
+    if stats[name] != value:
+        failures += 1
+
+if failures:
+    print(f"{failures} replay stats differ from the model")
+    sys.exit(1)
+
+print("Replay stats match the model")
@@ -0,0 +1,209 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Run an eager and a lazy refresh DRAM controller side by side on the same
+sparse traffic and check that they report the same statistics.
+
+With lazy_refresh an idle controller stops scheduling its refresh events
+and accounts for the skipped refreshes when it is accessed again, drained,
+or when its stats are dumped or reset. Both systems are driven by the same
+deterministic traffic and observed at the same ticks, so the stats of the
+lazy controller must match the eager ones. The counts, including the
+refresh count, and the time spent in each power state must match exactly.
+The lazy controller hands the skipped refreshes to DRAMPower in batches,
+so DRAMPower sums their energy over fewer windows, and the energies and
+the average power may only differ by floating-point rounding. They must
+match to ENERGY_REL_TOL.
+The checkpoints land in long idle phases and in the middle of refreshes,
+and go through the dump, reset and drain/resume catch-up paths.
+"""
+
+import argparse
+import math
+import sys
+
+import m5
+import _m5.stats
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    description="Compare eager and lazy DRAM refresh"
+)
+parser.add_argument(
+    "--mem-type",
+    default="DDR3_1600_8x8",
+    help="DRAM interface to use in both systems",
+)
+parser.add_argument(
+    "--ranks", type=int, default=2, help="Number of ranks per channel"
+)
+
+args = parser.parse_args()
+
+us = 1000000
+
+# Relative tolerance of the energies and the average power, see above
+ENERGY_REL_TOL = 1e-9
+
+
+def build_system(lazy_refresh):
+    system = System(membus=IOXBar(width=32))
+    system.clk_domain = SrcClockDomain(
+        clock="2.0GHz", voltage_domain=VoltageDomain(voltage="1V")
+    )
+    system.mem_ranges = [AddrRange("256MB")]
+    system.mmap_using_noreserve = True
+
+    dram = getattr(m5.objects, args.mem_type)(range=system.mem_ranges[0])
+    dram.ranks_per_channel = args.ranks
+    dram.null = True
+    dram.lazy_refresh = lazy_refresh
+
+    system.mem_ctrl = MemCtrl(dram=dram)
+    system.mem_ctrl.port = system.membus.mem_side_ports
+
+    system.tgen = PyTrafficGen()
+    system.tgen.port = system.membus.cpu_side_ports
+    system.system_port = system.membus.cpu_side_ports
+
+    system.mem_mode = "timing"
+    return system
+
+
+def traffic(tgen):
+    # A short dense phase, long idle phases covering many refresh
+    # intervals, and a sparse phase where the requests are further apart
+    # than tREFI so that every request finds the controller idle
+    yield tgen.createLinear(20 * us, 0, 0x100000, 64, 500000, 500000, 100, 0)
+    yield tgen.createIdle(150 * us)
+    yield tgen.createLinear(200 * us, 0, 0x100000, 64, 25 * us, 25 * us, 50, 0)
+    yield tgen.createIdle(400 * us)
+    yield tgen.createLinear(
+        5 * us, 0x200000, 0x300000, 64, 1000000, 1000000, 0, 0
+    )
+    yield tgen.createIdle(1000 * us)
+
+
+def collect(group, prefix, values):
+    for stat in group.getStats():
+        stat.prepare()
+        if isinstance(stat, _m5.stats.ScalarInfo):
+            values[prefix + stat.name] = stat.value
+        elif isinstance(stat, _m5.stats.VectorInfo):
+            for i in range(stat.size):
+                values[f"{prefix}{stat.name}::{i}"] = stat.value[i]
+    for name, child in group.getStatGroups().items():
+        collect(child, f"{prefix}{name}.", values)
+    return values
+
+
+failures = 0
+
+
+def compare(what):
+    global failures
+
+    eager = collect(root.eager.mem_ctrl, "", {})
+    lazy = collect(root.lazy.mem_ctrl, "", {})
+    assert eager.keys() == lazy.keys()
+
+    refreshes = sum(v for k, v in eager.items() if k.endswith("numRefreshes"))
+    print(f"{what} at {m5.curTick()}: {int(refreshes)} refreshes")
+
+    for name in sorted(eager):
+        stat = name.split("::")[0].split(".")[-1]
+        if stat.endswith("Energy") or stat == "averagePower":
+            match = math.isclose(
+                eager[name], lazy[name], rel_tol=ENERGY_REL_TOL
+            )
+        else:
+            match = eager[name] == lazy[name]
+        if not match:
+            print(f"  mismatch {name}: eager {eager[name]} lazy {lazy[name]}")
+            failures += 1
+
+
+def run_until(tick):
+    exit_event = m5.simulate(tick - m5.curTick())
+    if exit_event.getCause() != "simulate() limit reached":
+        print(f"Unexpected exit: {exit_event.getCause()}")
+        sys.exit(1)
+
+
+root = Root(
+    full_system=False,
+    eager=build_system(False),
+    lazy=build_system(True),
+)
+
+m5.instantiate()
+
+root.eager.tgen.start(traffic(root.eager.tgen))
+root.lazy.tgen.start(traffic(root.lazy.tgen))
+
+# The odd offsets make some of the checkpoints fall in the middle of a
+# refresh rather than between two of them
+run_until(15 * us)
+m5.stats.dump()
+compare("dump during traffic")
+
+run_until(90 * us + 123457)
+m5.stats.dump()
+compare("dump while idle")
+
+run_until(140 * us + 777)
+m5.stats.reset()
+compare("reset while idle")
+
+run_until(165 * us + 4321)
+m5.stats.dump()
+compare("dump after reset")
+
+run_until(250 * us + 99999)
+m5.drain()
+compare("drained during sparse traffic")
+m5.stats.dump()
+compare("dump while drained")
+
+run_until(600 * us + 1)
+m5.drain()
+m5.stats.reset()
+compare("reset while drained")
+
+run_until(776 * us + 54321)
+m5.stats.dump()
+compare("dump after drain and reset")
+
+run_until(1500 * us + 7)
+m5.stats.dump()
+compare("final dump")
+
+if failures:
+    print(f"{failures} stats differ between eager and lazy refresh")
+    sys.exit(1)
+
+print("Eager and lazy refresh stats match")
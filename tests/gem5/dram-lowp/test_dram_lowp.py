@@ -47,3 +47,16 @@ gem5_verify_config(
     valid_isas=(constants.all_compiled_tag,),
     valid_hosts=constants.supported_hosts,
 )
+
+# Checks that lazily accounted refreshes match the eager ones, exits
+# non-zero on a mismatch
+for mem_type, ranks in (("DDR3_1600_8x8", 2), ("DDR4_2400_16x4", 1)):
+    gem5_verify_config(
+        name=f"test-lazy_refresh-{mem_type}",
+        fixtures=(),
+        verifiers=(),
+        config=joinpath(getcwd(), "lazy-refresh-run.py"),
+        config_args=["--mem-type", mem_type, "--ranks", str(ranks)],
+        valid_isas=(constants.all_compiled_tag,),
+        valid_hosts=constants.supported_hosts,
+    )
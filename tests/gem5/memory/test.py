@@ -119,6 +119,8 @@ null_tests = [
         ],
     ),
     ("ruby_random_test", None, ["--maxloads", "5000"]),
+    # Long enough for the tiny caches to replace and reuse every way
+    ("ruby_random_test-long", "ruby_random_test", ["--maxloads", "50000"]),
     ("ruby_direct_test", None, ["--requests", "50000"]),
 ]
 
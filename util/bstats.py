@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Reader of the binary stat files written by the bin:// stat output.
+
+The file holds the schema of the stats (one column per value) followed
+by every dump, each holding only the values that changed since the
+previous dump. This module memory-maps the file and rebuilds the stats
+as a pandas data frame with one row per dump and one column per value.
+
+Example:
+
+    import bstats
+    stats = bstats.StatsFile("m5out/stats.bin")
+    ipc = stats.frame(pattern=r"\\.ipc$")
+
+It can also be used as a script to convert a file to CSV:
+
+    util/bstats.py m5out/stats.bin --pattern '\\.ipc$' -o ipc.csv
+"""
+
+import argparse
+import mmap
+import re
+import struct
+import sys
+
+import numpy as np
+import pandas as pd
+
+MAGIC = b"gem5bst\0"
+VERSION = 1
+
+SCHEMA_RECORD = 1
+DUMP_RECORD = 2
+
+_header = struct.Struct("<8sII")
+_record = struct.Struct("<IIQ")
+_schema = struct.Struct("<II")
+_dump = struct.Struct("<QII")
+
+
+class StatsFile:
+    """A binary stat file.
+
+    Only the record headers and the schema are decoded when the file is
+    opened; the values are decoded by frame().
+    """
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version, _ = _header.unpack_from(self._map, 0)
+        if magic != MAGIC:
+            raise ValueError(f"{path} is not a binary stat file")
+        if version != VERSION:
+            raise ValueError(
+                f"{path} has version {version}, expected {VERSION}"
+            )
+
+        self.columns = []
+        self.descriptions = []
+        self.units = []
+        # (offset, count) of the changes of every dump
+        self._dumps = []
+
+        pos = _header.size
+        while pos + _record.size <= len(self._map):
+            rtype, _, size = _record.unpack_from(self._map, pos)
+            pos += _record.size
+            if pos + size > len(self._map):
+                # Truncated record, e.g. the simulation is still running
+                break
+            if rtype == SCHEMA_RECORD:
+                self._read_schema(pos)
+            elif rtype == DUMP_RECORD:
+                _, count, _ = _dump.unpack_from(self._map, pos)
+                self._dumps.append((pos + _dump.size, count))
+            pos += size
+
+    def _read_schema(self, pos):
+        first, count = _schema.unpack_from(self._map, pos)
+        if first != len(self.columns):
+            raise ValueError("Unexpected schema record")
+        pos += _schema.size
+        for _ in range(count):
+            fields = []
+            for _ in range(3):
+                end = self._map.find(b"\0", pos)
+                fields.append(self._map[pos:end].decode())
+                pos = end + 1
+            self.columns.append(fields[0])
+            self.descriptions.append(fields[1])
+            self.units.append(fields[2])
+
+    def __len__(self):
+        """Number of dumps in the file."""
+        return len(self._dumps)
+
+    def select(self, columns=None, pattern=None):
+        """Names of the columns matching a list of names and a regex."""
+        names = self.columns if columns is None else columns
+        if pattern is not None:
+            regex = re.compile(pattern)
+            names = [name for name in names if regex.search(name)]
+        return names
+
+    def frame(self, columns=None, pattern=None):
+        """Values of the stats at every dump.
+
+        Parameters:
+          * columns (list): Names of the columns to read (default: all)
+          * pattern (str): Regex the names of the columns read must match
+
+        Returns a data frame indexed by dump number. Only the selected
+        columns are materialised, so selecting a few stats of a large
+        file is cheap.
+        """
+
+        names = self.select(columns, pattern)
+        ids = {name: i for i, name in enumerate(self.columns)}
+        # Position in the frame of every column of the file, or -1
+        position = np.full(len(self.columns), -1, dtype=np.int64)
+        for i, name in enumerate(names):
+            position[ids[name]] = i
+
+        state = np.zeros(len(names))
+        values = np.empty((len(self._dumps), len(names)))
+        for row, (pos, count) in enumerate(self._dumps):
+            changed = np.frombuffer(
+                self._map, dtype="<u4", count=count, offset=pos
+            )
+            pos += (count * 4 + 7) // 8 * 8
+            new = np.frombuffer(
+                self._map, dtype="<f8", count=count, offset=pos
+            )
+            where = position[changed]
+            selected = where >= 0
+            state[where[selected]] = new[selected]
+            values[row] = state
+
+        frame = pd.DataFrame(values, columns=names)
+        frame.index.name = "dump"
+        return frame
+
+    def info(self, columns=None, pattern=None):
+        """Descriptions and units of the columns."""
+        names = self.select(columns, pattern)
+        ids = {name: i for i, name in enumerate(self.columns)}
+        return pd.DataFrame(
+            {
+                "description": [self.descriptions[ids[n]] for n in names],
+                "unit": [self.units[ids[n]] for n in names],
+            },
+            index=pd.Index(names, name="stat"),
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert a binary stat file to CSV"
+    )
+    parser.add_argument("file", help="Binary stat file")
+    parser.add_argument(
+        "-p", "--pattern", help="Only output the stats matching a regex"
+    )
+    parser.add_argument(
+        "-o", "--output", default="-", help="Output CSV file (default: stdout)"
+    )
+    args = parser.parse_args()
+
+    stats = StatsFile(args.file)
+    frame = stats.frame(pattern=args.pattern)
+    frame.to_csv(sys.stdout if args.output == "-" else args.output)
+
+
+if __name__ == "__main__":
+    main()
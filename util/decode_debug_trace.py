@@ -0,0 +1,657 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Decode the binary debug traces recorded with --debug-binary.
+
+In binary mode, debug messages are recorded as a reference to their
+format string and their raw arguments (see trace::BinaryLogger). This
+script formats them the way gem5's cprintf would have, and prints the
+resulting text, identical to a text trace.
+
+Usage:
+    util/decode_debug_trace.py m5out/trace.bin [-o trace.txt] [--merge]
+"""
+
+import argparse
+import heapq
+import math
+import struct
+import sys
+
+MAGIC = b"gem5dbt\0"
+VERSION = 1
+
+MAX_TICK = 2**64 - 1
+
+FORMAT_RECORD = 1
+STRING_RECORD = 2
+MESSAGE_RECORD = 3
+TEXT_RECORD = 4
+
+SIGNED_ARG = 0x10
+UNSIGNED_ARG = 0x20
+SIGNED_CHAR_ARG = 0x31
+UNSIGNED_CHAR_ARG = 0x32
+BOOL_ARG = 0x40
+FLOAT_ARG = 0x50
+STRING_ARG = 0x60
+POINTER_ARG = 0x70
+
+_header = struct.Struct("<8sII")
+_chunk = struct.Struct("<IIQ")
+_u32 = struct.Struct("<I")
+_u64 = struct.Struct("<Q")
+_f64 = struct.Struct("<d")
+_message = struct.Struct("<BBQIIQ")
+_text = struct.Struct("<BQIII")
+
+
+class Arg:
+    """A raw argument, with the C++ type it had."""
+
+    def __init__(self, kind, value, size=8):
+        self.kind = kind
+        self.value = value
+        self.size = size
+
+
+class Format:
+    """Port of gem5::cp::Format."""
+
+    def __init__(self):
+        self.clear()
+
+    def clear(self):
+        self.alternate_form = False
+        self.flush_left = False
+        self.print_sign = False
+        self.fill_zero = False
+        self.uppercase = False
+        self.base = 10
+        self.format = None
+        self.float_format = "best"
+        self.precision = -1
+        self.width = 0
+        self.get_precision = False
+        self.get_width = False
+
+
+class Stream:
+    """The state of the ostream a message is formatted to."""
+
+    def __init__(self):
+        self.out = []
+        # The precision is the only state kept from an argument to
+        # another, the other flags being reset for every argument
+        self.precision = 6
+
+    def pad(self, text, width, fill=" ", left=False):
+        if width > len(text):
+            padding = fill * (width - len(text))
+            text = text + padding if left else padding + text
+        self.out.append(text)
+
+
+def _float_text(value, precision, floatfield=None, uppercase=False):
+    """Output of an ostream << double."""
+    if math.isnan(value):
+        text = "-nan" if math.copysign(1, value) < 0 else "nan"
+    elif math.isinf(value):
+        text = "-inf" if value < 0 else "inf"
+    elif floatfield == "fixed":
+        text = "%.*f" % (precision, value)
+    elif floatfield == "scientific":
+        text = "%.*e" % (precision, value)
+    else:
+        text = "%.*g" % (precision, value)
+    return text.upper() if uppercase else text
+
+
+def _int_text(value, size, signed, base, showbase, showpos, uppercase):
+    """Output of an ostream << integer."""
+    if base == 10:
+        text = str(value)
+        if showpos and signed and value >= 0:
+            text = "+" + text
+        return text
+
+    value &= (1 << (8 * size)) - 1
+    if base == 16:
+        text = "%x" % value
+        if showbase and value:
+            text = "0x" + text
+        return text.upper() if uppercase else text
+
+    text = "%o" % value
+    if showbase and value:
+        text = "0" + text
+    return text
+
+
+def _plain_text(arg, precision):
+    """Output of an ostream << arg with the default flags."""
+    if arg.kind in (SIGNED_CHAR_ARG, UNSIGNED_CHAR_ARG):
+        return chr(arg.value & 0xFF)
+    if arg.kind == BOOL_ARG:
+        return "1" if arg.value else "0"
+    if arg.kind == FLOAT_ARG:
+        return _float_text(arg.value, precision)
+    if arg.kind == STRING_ARG:
+        return arg.value
+    if arg.kind == POINTER_ARG:
+        return _int_text(arg.value, 8, False, 16, True, False, False)
+    return str(arg.value)
+
+
+def _format_integer(stream, arg, fmt):
+    """Port of cp::_formatInteger."""
+    prefix = ""
+    width = fmt.width
+    if fmt.alternate_form and fmt.fill_zero:
+        if fmt.base == 16:
+            prefix = "0x"
+            width -= 2
+        elif fmt.base == 8:
+            prefix = "0"
+            width -= 1
+    showbase = fmt.alternate_form and not fmt.fill_zero
+
+    kind = arg.kind
+    if kind in (SIGNED_CHAR_ARG, UNSIGNED_CHAR_ARG):
+        # Characters are printed as an int
+        text = _int_text(
+            arg.value,
+            4,
+            True,
+            fmt.base,
+            showbase,
+            fmt.print_sign,
+            fmt.uppercase,
+        )
+    elif kind == BOOL_ARG:
+        text = _int_text(
+            int(arg.value),
+            8,
+            True,
+            fmt.base,
+            showbase,
+            fmt.print_sign,
+            fmt.uppercase,
+        )
+    elif kind in (SIGNED_ARG, UNSIGNED_ARG):
+        text = _int_text(
+            arg.value,
+            arg.size,
+            kind == SIGNED_ARG,
+            fmt.base,
+            showbase,
+            fmt.print_sign,
+            fmt.uppercase,
+        )
+    elif kind == POINTER_ARG:
+        text = _int_text(arg.value, 8, False, 16, True, False, False)
+    elif kind == FLOAT_ARG:
+        text = _float_text(
+            arg.value, stream.precision, uppercase=fmt.uppercase
+        )
+        if fmt.print_sign and not text.startswith("-"):
+            text = "+" + text
+    else:
+        text = arg.value
+
+    stream.out.append(prefix)
+    stream.pad(
+        text,
+        width,
+        "0" if fmt.fill_zero else " ",
+        fmt.flush_left and not fmt.fill_zero,
+    )
+
+
+def _format_float(stream, arg, fmt):
+    """Port of cp::_formatFloat."""
+    if arg.kind != FLOAT_ARG:
+        stream.out.append("<bad arg type for float format>")
+        return
+
+    floatfield = None
+    uppercase = False
+    if fmt.float_format == "scientific":
+        if fmt.precision != -1:
+            if fmt.precision == 0:
+                fmt.precision = 1
+            else:
+                floatfield = "scientific"
+            stream.precision = fmt.precision
+        uppercase = fmt.uppercase
+    elif fmt.float_format == "fixed":
+        if fmt.precision != -1:
+            floatfield = "fixed"
+            stream.precision = fmt.precision
+    elif fmt.precision != -1:
+        stream.precision = fmt.precision
+
+    text = _float_text(arg.value, stream.precision, floatfield, uppercase)
+    stream.pad(text, fmt.width, "0" if fmt.fill_zero else " ")
+
+
+def _format_string(stream, arg, fmt):
+    """Port of cp::_formatString."""
+    if fmt.width > 0:
+        # The length is measured with a fresh stream
+        text = _plain_text(arg, 6)
+        if fmt.width > len(text):
+            stream.pad(text, fmt.width, " ", fmt.flush_left)
+            return
+    stream.out.append(_plain_text(arg, stream.precision))
+
+
+def _format_char(stream, arg, fmt):
+    if arg.kind in (
+        SIGNED_CHAR_ARG,
+        UNSIGNED_CHAR_ARG,
+        SIGNED_ARG,
+        UNSIGNED_ARG,
+    ):
+        stream.out.append(chr(arg.value & 0xFF))
+    else:
+        stream.out.append("<bad arg type for char format>")
+
+
+class Printer:
+    """Port of gem5::cp::Print."""
+
+    def __init__(self, fmt):
+        self.stream = Stream()
+        self.format = fmt
+        self.ptr = 0
+        self.cont = False
+        self.fmt = Format()
+
+    def _char(self, offset=0):
+        pos = self.ptr + offset
+        return self.format[pos] if pos < len(self.format) else ""
+
+    def _text(self, extra):
+        out = self.stream.out
+        while self.ptr < len(self.format):
+            c = self.format[self.ptr]
+            if c == "%":
+                if self._char(1) != "%":
+                    if not extra:
+                        self._process_flag()
+                        return
+                    out.append("<extra arg>")
+                out.append("%")
+                self.ptr += 2
+            elif c == "\n":
+                out.append("\n")
+                self.ptr += 1
+            elif c == "\r":
+                self.ptr += 1
+                if self._char() != "\n":
+                    out.append("\n")
+            else:
+                end = self.ptr
+                while end < len(self.format) and self.format[end] not in (
+                    "%\n\r"
+                ):
+                    end += 1
+                out.append(self.format[self.ptr : end])
+                self.ptr = end
+
+    def _process(self):
+        self.fmt.clear()
+        self._text(False)
+
+    def _process_flag(self):
+        fmt = self.fmt
+        done = False
+        end_number = False
+        have_precision = False
+        number = 0
+
+        while not done:
+            self.ptr += 1
+            c = self._char()
+            if "0" <= c <= "9":
+                if end_number:
+                    continue
+            elif number > 0:
+                end_number = True
+
+            if c == "s":
+                fmt.format = "string"
+                done = True
+            elif c == "c":
+                fmt.format = "char"
+                done = True
+            elif c == "l":
+                continue
+            elif c == "p":
+                fmt.format = "integer"
+                fmt.base = 16
+                fmt.alternate_form = True
+                done = True
+            elif c in "xX" and c:
+                fmt.uppercase = fmt.uppercase or c == "X"
+                fmt.base = 16
+                fmt.format = "integer"
+                done = True
+            elif c == "o" and c:
+                fmt.base = 8
+                fmt.format = "integer"
+                done = True
+            elif c in "diu" and c:
+                fmt.format = "integer"
+                done = True
+            elif c in "gG" and c:
+                fmt.uppercase = fmt.uppercase or c == "G"
+                fmt.format = "float"
+                fmt.float_format = "best"
+                done = True
+            elif c in "eE" and c:
+                fmt.uppercase = fmt.uppercase or c == "E"
+                fmt.format = "float"
+                fmt.float_format = "scientific"
+                done = True
+            elif c == "f":
+                fmt.format = "float"
+                fmt.float_format = "fixed"
+                done = True
+            elif c == "n":
+                self.stream.out.append("we don't do %n!!!\n")
+                done = True
+            elif c == "#":
+                fmt.alternate_form = True
+            elif c == "-":
+                fmt.flush_left = True
+            elif c == "+":
+                fmt.print_sign = True
+            elif c == " ":
+                pass
+            elif c == ".":
+                fmt.width = number
+                fmt.precision = 0
+                have_precision = True
+                number = 0
+                end_number = False
+            elif c == "0" and number == 0:
+                fmt.fill_zero = True
+            elif "0" <= c <= "9" and c:
+                number = number * 10 + int(c)
+            elif c == "*":
+                if have_precision:
+                    fmt.get_precision = True
+                else:
+                    fmt.get_width = True
+            else:
+                done = True
+
+            if end_number:
+                if have_precision:
+                    fmt.precision = number
+                else:
+                    fmt.width = number
+                end_number = False
+                number = 0
+
+            if done:
+                if fmt.format == "integer" and have_precision:
+                    fmt.width = fmt.precision
+                    fmt.fill_zero = True
+                elif (
+                    fmt.format == "float"
+                    and not have_precision
+                    and fmt.fill_zero
+                ):
+                    fmt.precision = fmt.width
+
+        self.ptr += 1
+
+    def add_arg(self, arg):
+        if not self.cont:
+            self._process()
+
+        fmt = self.fmt
+        if fmt.get_width or fmt.get_precision:
+            # Only an int can be used as a width or a precision
+            number = (
+                arg.value if arg.kind == SIGNED_ARG and arg.size == 4 else 0
+            )
+            if fmt.get_width:
+                fmt.get_width = False
+                fmt.width = number
+            else:
+                fmt.get_precision = False
+                fmt.precision = number
+            self.cont = True
+            return
+
+        if fmt.format == "char":
+            _format_char(self.stream, arg, fmt)
+        elif fmt.format == "integer":
+            _format_integer(self.stream, arg, fmt)
+        elif fmt.format == "float":
+            _format_float(self.stream, arg, fmt)
+        elif fmt.format == "string":
+            _format_string(self.stream, arg, fmt)
+        else:
+            self.stream.out.append("<bad format>")
+
+    def end_args(self):
+        self._text(True)
+        return "".join(self.stream.out)
+
+
+def cprintf(fmt, args):
+    """Format a message the way gem5's ccprintf does."""
+    printer = Printer(fmt)
+    for arg in args:
+        printer.add_arg(arg)
+    return printer.end_args()
+
+
+def _decode(data):
+    """Decode a string from the trace, preserving all its bytes."""
+    return data.decode("latin-1")
+
+
+def _read_args(data, pos, count):
+    args = []
+    for _ in range(count):
+        kind = data[pos]
+        pos += 1
+        if kind & 0xF0 in (SIGNED_ARG, UNSIGNED_ARG):
+            size = kind & 0x0F
+            value = int.from_bytes(
+                data[pos : pos + size], "little", signed=kind < UNSIGNED_ARG
+            )
+            args.append(Arg(kind & 0xF0, value, size))
+            pos += size
+        elif kind in (SIGNED_CHAR_ARG, UNSIGNED_CHAR_ARG):
+            value = int.from_bytes(
+                data[pos : pos + 1], "little", signed=kind == SIGNED_CHAR_ARG
+            )
+            args.append(Arg(kind, value, 1))
+            pos += 1
+        elif kind == BOOL_ARG:
+            args.append(Arg(kind, data[pos] != 0, 1))
+            pos += 1
+        elif kind == FLOAT_ARG:
+            args.append(Arg(kind, _f64.unpack_from(data, pos)[0]))
+            pos += 8
+        elif kind == POINTER_ARG:
+            args.append(Arg(kind, _u64.unpack_from(data, pos)[0]))
+            pos += 8
+        elif kind == STRING_ARG:
+            (length,) = _u32.unpack_from(data, pos)
+            pos += 4
+            args.append(Arg(kind, _decode(data[pos : pos + length])))
+            pos += length
+        else:
+            raise ValueError(f"Unknown argument type {kind:#x}")
+    return args, pos
+
+
+def _line(tick, name, flag, options, message):
+    """Port of OstreamLogger::logMessage."""
+    prefix = ""
+    if not options & 2 and tick != MAX_TICK:
+        prefix += "%7d: " % tick
+    if options & 1 and flag:
+        prefix += flag + ": "
+    if name:
+        prefix += name + ": "
+    return prefix + message
+
+
+class ThreadDecoder:
+    """The strings and format strings defined by a thread."""
+
+    def __init__(self):
+        self.strings = {0: ""}
+        self.formats = {}
+        self.tick = 0
+
+    def records(self, data):
+        """Decode the records of a chunk, as (tick, text) tuples."""
+        pos = 0
+        while pos < len(data):
+            rtype = data[pos]
+            if rtype == FORMAT_RECORD:
+                key, length = struct.unpack_from("<QI", data, pos + 1)
+                pos += 13
+                self.formats[key] = _decode(data[pos : pos + length])
+                pos += length
+            elif rtype == STRING_RECORD:
+                sid, length = struct.unpack_from("<II", data, pos + 1)
+                pos += 9
+                self.strings[sid] = _decode(data[pos : pos + length])
+                pos += length
+            elif rtype == MESSAGE_RECORD:
+                options, count, tick, name, flag, key = _message.unpack_from(
+                    data, pos + 1
+                )
+                args, pos = _read_args(data, pos + 1 + _message.size, count)
+                message = cprintf(self.formats[key], args)
+                yield self._emit(tick, name, flag, options, message)
+            elif rtype == TEXT_RECORD:
+                options, tick, name, flag, length = _text.unpack_from(
+                    data, pos + 1
+                )
+                pos += 1 + _text.size
+                message = _decode(data[pos : pos + length])
+                pos += length
+                yield self._emit(tick, name, flag, options, message)
+            else:
+                raise ValueError(f"Unknown record type {rtype}")
+
+    def _emit(self, tick, name, flag, options, message):
+        # Messages without a tick are ordered with the previous one
+        if tick != MAX_TICK:
+            self.tick = tick
+        return self.tick, _line(
+            tick, self.strings[name], self.strings[flag], options, message
+        )
+
+
+def chunks(f):
+    """The (thread, data) chunks of a trace file."""
+    magic, version, _ = _header.unpack(f.read(_header.size))
+    if magic != MAGIC:
+        raise ValueError("Not a binary debug trace")
+    if version != VERSION:
+        raise ValueError(f"Version {version} unsupported, expected {VERSION}")
+
+    while True:
+        header = f.read(_chunk.size)
+        if len(header) < _chunk.size:
+            return
+        thread, _, size = _chunk.unpack(header)
+        data = f.read(size)
+        if len(data) < size:
+            # Truncated trace, e.g. the simulation was killed
+            return
+        yield thread, data
+
+
+def decode(f, merge=False):
+    """Decode a trace file, yielding the lines of text of the messages.
+
+    The records of a thread are in order, but the threads are interleaved
+    at the granularity of their buffers. When merging, the records of all
+    the threads are ordered by tick instead, which requires holding the
+    whole trace in memory.
+    """
+    threads = {}
+    if not merge:
+        for thread, data in chunks(f):
+            decoder = threads.setdefault(thread, ThreadDecoder())
+            for _, text in decoder.records(data):
+                yield text
+        return
+
+    lines = {}
+    for thread, data in chunks(f):
+        decoder = threads.setdefault(thread, ThreadDecoder())
+        lines.setdefault(thread, []).extend(decoder.records(data))
+    for _, text in heapq.merge(*lines.values(), key=lambda line: line[0]):
+        yield text
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a binary debug trace to text"
+    )
+    parser.add_argument("trace", help="Binary debug trace")
+    parser.add_argument(
+        "-o", "--output", default="-", help="Output file (default: stdout)"
+    )
+    parser.add_argument(
+        "--merge",
+        action="store_true",
+        help="Order the messages of all the threads by tick",
+    )
+    args = parser.parse_args()
+
+    out = (
+        sys.stdout
+        if args.output == "-"
+        else open(args.output, "w", encoding="latin-1", newline="")
+    )
+    if out is sys.stdout:
+        sys.stdout.reconfigure(encoding="latin-1", newline="")
+    with open(args.trace, "rb") as f:
+        for text in decode(f, args.merge):
+            out.write(text)
+    out.flush()
+
+
+if __name__ == "__main__":
+    main()